@@ -70,6 +70,20 @@ namespace sf
         */
         void setWatchdog(Scalar timeout);
 
+        //! A method saving the command state of the actuator (setpoints and watchdog).
+        /*!
+         The state is used by the command journal to detect and reproduce the commands exactly, bypassing the limits
+         and scaling applied by the public setters.
+         \param state a vector to which the state is appended
+         */
+        virtual void getCommandState(std::vector<Scalar>& state) const;
+        
+        //! A method restoring the command state of the actuator.
+        /*!
+         \param state a pointer to the state saved with getCommandState
+         */
+        virtual void setCommandState(const Scalar* state);
+
         //! A method returning the type of the actuator.
         virtual ActuatorType getType() const = 0;
 
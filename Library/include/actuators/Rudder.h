@@ -72,6 +72,18 @@ namespace sf
         //! A method returning the angular position of the rudder [rad]
         Scalar getAngle() const;
         
+        //! A method saving the command state of the actuator.
+        /*!
+         \param state a vector to which the state is appended
+         */
+        void getCommandState(std::vector<Scalar>& state) const override;
+        
+        //! A method restoring the command state of the actuator.
+        /*!
+         \param state a pointer to the state saved with getCommandState
+         */
+        void setCommandState(const Scalar* state) override;
+        
         //! A method returning the type of the actuator.
         ActuatorType getType() const;
         
@@ -99,6 +99,18 @@ public:
   //! A method returning the diameter of the propeller.
   Scalar getPropellerDiameter() const;
 
+  //! A method saving the command state of the actuator.
+  /*!
+   \param state a vector to which the state is appended
+   */
+  void getCommandState(std::vector<Scalar>& state) const override;
+
+  //! A method restoring the command state of the actuator.
+  /*!
+   \param state a pointer to the state saved with getCommandState
+   */
+  void setCommandState(const Scalar* state) override;
+
   //! A method returning the type of the actuator.
   ActuatorType getType() const;
 
@@ -28,6 +28,7 @@
 
 #include <map>
 #include "comms/Comm.h"
+#include "comms/ChannelModel.h"
 
 namespace sf
 {
@@ -80,6 +81,12 @@ namespace sf
          */
         void setOcclusionTest(bool enabled);
 
+        //! A method to set the probability of a byte error in the received messages.
+        /*!
+         \param rate the byte error rate [0,1] (in the good state of the burst model)
+         */
+        void setByteErrorRate(Scalar rate);
+
         //! A method to retrieve the position of the device in the designated reference frame.
         /*!
          \param pos a pointer to the position vector
@@ -89,6 +96,12 @@ namespace sf
 
         //! A method informing if occlusion testing is enabled for the modem device.
         bool getOcclusionTest() const;
+
+        //! A method returning the probability of a byte error in the received messages.
+        Scalar getByteErrorRate() const;
+
+        //! A method returning the model of the channel errors.
+        ChannelModel& getChannelModel();
         
         //! A method returning the type of the comm.
         virtual CommType getType() const;
@@ -99,6 +112,12 @@ namespace sf
          \param dt the step time of the simulation [s]
          */
         virtual void InternalUpdate(Scalar dt) override;
+
+        //! A method called when a message reaches the modem.
+        /*!
+         \param message a pointer to the received message
+         */
+        virtual void MessageReceived(std::shared_ptr<CommDataFrame> message) override;
         
         static AcousticModem* getNode(uint64_t deviceId);
         
@@ -111,6 +130,8 @@ namespace sf
         Vector3 position;
         std::string frame;
         bool occlusion;
+        Scalar byteErrorRate;
+        ChannelModel channel;
         
         static void addNode(AcousticModem* node);
         static void removeNode(uint64_t deviceId);
@@ -0,0 +1,114 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  ChannelModel.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_ChannelModel__
+#define __Stonefish_ChannelModel__
+
+#include <map>
+#include <random>
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    //! An enum defining the types of channel error models.
+    enum class ChannelErrorModel {INDEPENDENT, BURST};
+
+    //! A class implementing a seedable model of the byte errors introduced by a communication channel.
+    /*!
+     Each link (pair of source and destination devices) uses its own random number stream, derived from the seed of the model
+     and the identifiers of the devices, so the errors are reproducible and do not depend on the traffic on other links.
+     The positions of the corrupted bytes are sampled by skipping geometrically distributed runs of correct bytes, which makes
+     the cost proportional to the number of errors instead of the length of the payload. A corrupted byte is always changed.
+     The burst model is a two-state (Gilbert-Elliott) Markov chain with geometrically distributed lengths of the good and the
+     burst periods. The state of the chain is kept between messages and the channel starts in the good state.
+     */
+    class ChannelModel
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param seed the seed of the random number streams
+         */
+        ChannelModel(uint64_t seed = 0);
+
+        //! A method setting the seed of the random number streams (restarts all links).
+        /*!
+         \param seed the seed of the random number streams
+         */
+        void setSeed(uint64_t seed);
+
+        //! A method selecting the model of independent byte errors (restarts all links).
+        void setIndependentErrors();
+
+        //! A method selecting the two-state model of burst errors (restarts all links).
+        /*!
+         In the good state the byte error rate passed to ApplyErrors is used.
+         \param goodLength the mean length of the good periods [bytes]
+         \param burstLength the mean length of the bursts [bytes]
+         \param burstErrorRate the probability of a byte error during a burst [0,1]
+         */
+        void setBurstErrors(Scalar goodLength, Scalar burstLength, Scalar burstErrorRate);
+
+        //! A method introducing errors in the data received through a link.
+        /*!
+         \param data the data to be modified
+         \param source the identifier of the transmitting device
+         \param destination the identifier of the receiving device
+         \param errorRate the probability of a byte error (in the good state of the burst model) [0,1]
+         \return the number of corrupted bytes
+         */
+        size_t ApplyErrors(std::vector<uint8_t>& data, uint64_t source, uint64_t destination, Scalar errorRate);
+
+        //! A method restarting the random number streams and the states of all links.
+        void Reset();
+
+        //! A method returning the type of the error model.
+        ChannelErrorModel getErrorModel() const;
+
+        //! A method returning the seed of the random number streams.
+        uint64_t getSeed() const;
+
+    private:
+        struct Link
+        {
+            std::mt19937_64 rng;
+            bool burst;
+            uint64_t remaining; //Number of bytes left in the current state
+        };
+
+        Link& getLink(uint64_t source, uint64_t destination);
+        static uint64_t SampleSkip(std::mt19937_64& rng, double p);
+        static size_t CorruptRange(std::vector<uint8_t>& data, size_t begin, size_t end, double p, std::mt19937_64& rng);
+
+        uint64_t seed;
+        ChannelErrorModel model;
+        Scalar goodLength;
+        Scalar burstLength;
+        Scalar burstErrorRate;
+        std::map<std::pair<uint64_t, uint64_t>, Link> links;
+    };
+}
+
+#endif
@@ -28,6 +28,7 @@
 
 #include <map>
 #include "comms/Comm.h"
+#include "comms/ChannelModel.h"
 
 namespace sf
 {
@@ -54,6 +55,9 @@ namespace sf
         //! A method returnign the reception quality.
         Scalar getReceptionQuality() const;
 
+        //! A method returning the model of the channel errors (byte error rate equal to one minus the reception quality).
+        ChannelModel& getChannelModel();
+
         //! A method returning the type of the comm.
         virtual CommType getType() const;
         
@@ -68,7 +72,6 @@ namespace sf
         bool isReceptionPossible(Vector3 worldDir, Scalar distance);
         
         static OpticalModem* getNode(uint64_t deviceId);
-        static std::vector<uint8_t> introduceErrors(const std::vector<uint8_t>& data, Scalar linkQuality);
         
     private:
         Scalar maxRange;
@@ -76,6 +79,7 @@ namespace sf
         Scalar ambientLightSens;
         Scalar receptionQuality;
         Scalar trueRange;
+        ChannelModel channel;
         
         static void addNode(OpticalModem* node);
         static void removeNode(uint64_t deviceId);
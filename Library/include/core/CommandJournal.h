@@ -0,0 +1,157 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  CommandJournal.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_CommandJournal__
+#define __Stonefish_CommandJournal__
+
+#include <fstream>
+#include <cstdint>
+#include "StonefishCommon.h"
+
+/*
+ Binary layout of the journal file (native byte order):
+
+ Header:
+    uint32_t magic, uint32_t version, double stepsPerSecond
+    uint32_t numActuators, then for each actuator: uint16_t nameLength, char name[nameLength]
+    uint32_t numSolids, then for each solid: uint16_t nameLength, char name[nameLength]
+    uint32_t numMultibodies, then for each multibody: uint16_t nameLength, char name[nameLength]
+    for each actuator and then each multibody: varint count, double state[count] (command state at the start of the recording)
+
+ Records (one byte type followed by the payload, indices, counts and ticks stored as unsigned LEB128 varints):
+    SF_JOURNAL_ACTUATOR   varint actuator, varint count, double state[count]
+    SF_JOURNAL_WRENCH     varint solid, double force[3], double torque[3]
+    SF_JOURNAL_POSE       varint solid, double basis[9] (row-major), double origin[3]
+    SF_JOURNAL_TICK       varint tick, uint64_t stateHash (closes the records of a tick)
+    SF_JOURNAL_MULTIBODY  varint multibody, varint count, double state[count]
+ */
+#define SF_JOURNAL_MAGIC        0x524A4653 //"SFJR"
+#define SF_JOURNAL_VERSION      2
+#define SF_JOURNAL_ACTUATOR     1
+#define SF_JOURNAL_WRENCH       2
+#define SF_JOURNAL_POSE         3
+#define SF_JOURNAL_TICK         4
+#define SF_JOURNAL_MULTIBODY    5
+
+namespace sf
+{
+    class SimulationManager;
+    class Actuator;
+    class SolidEntity;
+    class FeatherstoneEntity;
+    struct ExternalOverride;
+
+    //! An enum defining the modes of the command journal.
+    enum class JournalMode {RECORD, REPLAY, VERIFY};
+
+    //! A class implementing a deterministic journal of actuator commands and external overrides.
+    /*!
+     In the record mode the command state of every actuator and multibody (setpoints of the joint motors and joint efforts) is compared,
+     before each tick, with the state left by the previous tick. Every difference, caused by a controller or the shared memory bridge, is written to the journal
+     together with the external forces and pose overrides applied in the tick. A hash of the state of all bodies closes
+     the records of each tick. In the replay mode the recorded commands are applied instead of the commands coming from
+     controllers, which reproduces the recorded run bit by bit in the same scenario. The verify mode additionally
+     compares the state hashes and reports the first tick at which the trajectories diverge.
+     */
+    class CommandJournal
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param sm a pointer to the simulation manager
+         \param path the path to the journal file
+         \param mode the mode of the journal
+         */
+        CommandJournal(SimulationManager* sm, const std::string& path, JournalMode mode);
+
+        //! A destructor.
+        ~CommandJournal();
+
+        //! A method recording or replaying the commands (called before the actuators are updated).
+        /*!
+         \param overrides the external overrides requested for the tick (replaced by the recorded ones in the replay modes)
+         */
+        void BeginTick(std::vector<ExternalOverride>& overrides);
+
+        //! A method saving the command state left by the actuator update (called after the actuators are updated).
+        void ActuatorsUpdated();
+
+        //! A method closing the tick (called after each tick).
+        void EndTick();
+
+        //! A method returning the first tick at which the replay diverged from the recording (-1 if none).
+        int64_t getFirstDivergingTick() const;
+
+        //! A method returning the number of processed ticks.
+        uint64_t getNumOfTicks() const;
+
+        //! A method returning the mode of the journal.
+        JournalMode getMode() const;
+
+        //! A method returning the path to the journal file.
+        std::string getPath() const;
+
+        //! A method informing if the journal is replaying commands.
+        bool isReplaying() const;
+
+        //! A method informing if the replay reached the end of the journal.
+        bool isFinished() const;
+
+        //! A method informing if the journal file was opened successfully.
+        bool isOpen() const;
+
+    private:
+        void WriteVarint(uint64_t v);
+        void WriteScalars(const Scalar* values, unsigned int count);
+        void WriteName(const std::string& name);
+        bool ReadVarint(uint64_t& v);
+        bool ReadScalars(Scalar* values, unsigned int count);
+        bool ReadName(std::string& name);
+        bool ReadHeader();
+        void WriteHeader();
+        uint64_t ComputeStateHash() const;
+        size_t getNumOfSources() const;
+        void CaptureCommandState(size_t source, std::vector<Scalar>& state) const;
+        void RestoreCommandState(size_t source, const std::vector<Scalar>& state);
+
+        SimulationManager* sm;
+        std::string path;
+        JournalMode mode;
+        std::ofstream out;
+        std::ifstream in;
+        std::vector<Actuator*> actuators;
+        std::vector<SolidEntity*> solids;
+        std::vector<FeatherstoneEntity*> multibodies;
+        std::vector<std::vector<Scalar>> expected; //Actuators followed by multibodies
+        std::vector<Scalar> current;
+        uint64_t tick;
+        uint64_t recordedHash;
+        int64_t divergedTick;
+        bool open;
+        bool finished;
+    };
+}
+
+#endif
@@ -20,15 +20,23 @@
 //  Stonefish
 //
 //  Created by Patryk Cieslak on 24/05/2014.
-//  Copyright (c) 2014-2021 Patryk Cieslak. All rights reserved.
+//  Copyright (c) 2014-2026 Patryk Cieslak. All rights reserved.
 //
 
 #ifndef __Stonefish_Console__
 #define __Stonefish_Console__
 
 #include <SDL2/SDL_thread.h>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
 #include "StonefishCommon.h"
 
+#define CONSOLE_HISTORY_LENGTH 10000 //Lines kept in memory by the application console
+#define CONSOLE_QUEUE_LENGTH 4096    //Capacity of the asynchronous message queue (power of 2)
+
 namespace sf
 {
     //! An enum defining types of messages.
@@ -42,14 +50,20 @@ namespace sf
     };
     
     //! A class implementing a text console.
+    /*!
+     In the asynchronous mode, messages are formatted by the calling thread, pushed to a bounded lock-free queue
+     and written to the standard output and the history by a background thread. Critical messages are always flushed immediately.
+     */
     class Console
     {
     public:
         //! A constructor.
         /*!
          \param useStdout a flag enabling message printing on the system standard output
+         \param asynchronous a flag enabling output through a background thread
+         \param historyLength maximum number of lines kept in memory (0 means unlimited)
          */
-        Console(bool useStdout = true);
+        Console(bool useStdout = true, bool asynchronous = false, size_t historyLength = 0);
         
         //! A destructor.
         virtual ~Console();
@@ -67,6 +81,9 @@ namespace sf
          \param msg a message to append to the console lines
          */
         void AppendMessage(const ConsoleMessage& msg);
+
+        //! A method that writes all queued messages before returning.
+        void Flush();
         
         //! A method that clears the console.
         void Clear();
@@ -77,17 +94,68 @@ namespace sf
          \return success
          */
         bool SaveToFile(std::string filename);
+
+        //! A method setting the lowest type of message that is printed (messages are discarded before formatting).
+        /*!
+         \param t the minimum message type
+         */
+        void setMinimumSeverity(MessageType t);
+
+        //! A method setting the number of identical consecutive messages printed before the next ones are suppressed.
+        /*!
+         \param n the maximum number of repetitions (0 disables suppression)
+         */
+        void setRepeatLimit(unsigned int n);
     
         //! A method that returns a pointer to the console data mutex.
         SDL_mutex* getLinesMutex();
         
         //! A method that returns a copy of the console lines.
         std::vector<ConsoleMessage> getLines();
+
+        //! A method returning the lowest type of message that is printed.
+        MessageType getMinimumSeverity() const;
+
+        //! A method returning the number of identical consecutive messages printed before suppression.
+        unsigned int getRepeatLimit() const;
+
+        //! A method informing if the console is writing messages asynchronously.
+        bool isAsynchronous() const;
         
     protected:
         bool stdoutEnabled;
-        std::vector<ConsoleMessage> lines;
+        std::deque<ConsoleMessage> lines;
         SDL_mutex* linesMutex;
+
+    private:
+        struct QueueSlot
+        {
+            std::atomic<size_t> sequence;
+            ConsoleMessage msg;
+        };
+
+        bool Enqueue(ConsoleMessage& msg);
+        bool Drain();
+        void Output(const ConsoleMessage& msg);
+        void Write(const ConsoleMessage& msg);
+        static void FlushThread(Console* console);
+
+        size_t maxLines;
+        std::atomic<MessageType> minSeverity;
+        std::atomic<unsigned int> repeatLimit;
+        std::mutex outputMutex;
+        ConsoleMessage lastMsg;
+        unsigned int repeatCount;
+        unsigned int suppressedCount;
+        
+        //Asynchronous output
+        bool async;
+        std::unique_ptr<QueueSlot[]> queue;
+        std::atomic<size_t> enqueuePos;
+        size_t dequeuePos;
+        std::atomic<size_t> droppedCount;
+        std::atomic<bool> stop;
+        std::thread flushThread;
     };
 }
 
@@ -27,11 +27,13 @@
 #define __Stonefish_ConsoleSimulationApp__
 
 #include <SDL2/SDL_thread.h>
+#include <functional>
 #include "core/SimulationApp.h"
 
 namespace sf
 {
     class Console;
+    struct SharedMemoryBridgeSettings;
     
     //! A class that defines a console application interface.
     class ConsoleSimulationApp : public SimulationApp
@@ -56,6 +58,31 @@ namespace sf
 
         //! A method that resumes the simulation on demand.
         void ResumeSimulation() override;
+
+        //! A method that initializes and starts the simulation without the application loop and the simulation thread.
+        /*!
+         The simulation has to be advanced by calling the Step method (lockstep mode).
+         */
+        void StartLockstep();
+
+        //! A method that performs a number of simulation ticks as fast as possible (lockstep mode).
+        /*!
+         \param n number of physics ticks to perform
+         \param callStepCompleted a flag deciding if the SimulationStepCompleted method should be called after each tick
+         \param callback an optional function called after each tick (tick index, time step)
+         */
+        void Step(unsigned int n = 1, bool callStepCompleted = true, const std::function<void(unsigned int, Scalar)>& callback = nullptr);
+
+        //! A method that stops the simulation started in lockstep mode and cleans up.
+        void StopLockstep();
+        
+        //! A method that enables the shared memory bridge, allowing external processes to control the robots.
+        /*!
+         Has to be called before the simulation is started. In the synchronous mode each tick, also in lockstep mode,
+         waits for the commands of the connected controllers.
+         \param settings the settings of the bridge
+         */
+        void EnableSharedMemoryBridge(const SharedMemoryBridgeSettings& settings);
         
         //! A method informing if the application is graphical.
         bool hasGraphics();
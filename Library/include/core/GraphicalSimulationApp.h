@@ -142,7 +142,7 @@ namespace sf
         //! A method returning a pointer to the OpenGL pipeline.
         OpenGLPipeline* getGLPipeline();
         
-        //! A method returning a pointer to the GUI.
+        //! A method returning a pointer to the GUI (nullptr when rendering offscreen).
         IMGUI* getGUI();
 
         //! A method returning a pointer to the selected entity.
@@ -45,6 +45,7 @@ namespace sf
     class Comm;
     class VelocityField;
     class FixedJoint;
+    class ChannelModel;
     struct Color;
     enum class ColorMap;
   
@@ -296,6 +297,7 @@ namespace sf
         bool ParseTransform(XMLElement* element, Transform& T);
         bool ParseColor(XMLElement* element, Color& c);
         bool ParseColorMap(XMLElement* element, ColorMap& cm);
+        void ParseChannelErrors(XMLElement* element, const std::string& commName, ChannelModel& channel, Scalar* byteErrorRate);
     
         XMLDocument doc;
         SimulationManager* sm;
@@ -0,0 +1,266 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SharedMemoryBridge.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_SharedMemoryBridge__
+#define __Stonefish_SharedMemoryBridge__
+
+#include <atomic>
+#include <cstdint>
+#include "StonefishCommon.h"
+
+/*
+ Binary layout of the shared memory segment (native byte order, offsets in bytes from the start of the segment):
+
+ ShmHeader                                      at 0
+ ShmRobotDescriptor[numRobots]                  at sizeof(ShmHeader)
+ For each robot:
+    ShmSensorDescriptor[numSensors]             at sensorDescOffset
+    ShmActuatorDescriptor[numActuators]         at actuatorDescOffset
+    ShmRingHeader + ringCapacity sensor frames  at sensorRingOffset (simulation -> controller)
+    ShmRingHeader + ringCapacity command frames at commandRingOffset (controller -> simulation)
+
+ Sensor frame (sensorFrameSize bytes):
+    ShmSensorFrameHeader
+    uint64_t sampleCount[numSensors] (number of samples taken by each sensor, changes when new data is available)
+    double channels[numChannels] (last measurement of all channels of all sensors, in the order of the sensor descriptors)
+
+ Command frame (commandFrameSize bytes):
+    ShmCommandFrameHeader
+    ShmActuatorCommand[numActuators] (in the order of the actuator descriptors)
+
+ Each ring buffer is a single-producer single-consumer queue. Frame number k occupies slot k % ringCapacity.
+ The producer writes the slot at head and then increments head (release), the consumer reads the slot at tail
+ and then increments tail (release). The producer never blocks; frames that do not fit are dropped and counted.
+ The simulation uses its private copy of the layout and never trusts the values written by the controllers: command frames
+ exceeding the capacity of the ring (overwritten by the controller) are counted as dropped and a head behind the tail
+ is treated as a restarted controller.
+ */
+#define SF_SHM_MAGIC            0x4D485346 //"FSHM"
+#define SF_SHM_VERSION          1
+#define SF_SHM_NAME_LENGTH      64
+#define SF_SHM_COMMAND_VALID    0x1
+
+namespace sf
+{
+    class SimulationManager;
+    class Robot;
+    class ScalarSensor;
+    class Actuator;
+
+    //! A structure placed at the beginning of the shared memory segment.
+    struct ShmHeader
+    {
+        uint32_t magic; //Equal to SF_SHM_MAGIC
+        uint32_t version; //Equal to SF_SHM_VERSION
+        uint64_t size; //Total size of the segment [B]
+        uint32_t numRobots;
+        uint32_t ringCapacity; //Number of slots of each ring buffer
+        uint32_t synchronous; //1 if the simulation waits for the commands before each tick
+        std::atomic<uint32_t> open; //0 after the simulation closed the bridge
+        std::atomic<uint64_t> tick; //Number of the last published simulation tick
+        uint64_t reserved[3];
+    };
+
+    //! A structure describing a robot published in the shared memory segment.
+    struct ShmRobotDescriptor
+    {
+        char name[SF_SHM_NAME_LENGTH];
+        uint32_t numSensors;
+        uint32_t numActuators;
+        uint32_t numChannels; //Total number of sensor channels
+        uint32_t reserved;
+        uint64_t sensorDescOffset;
+        uint64_t actuatorDescOffset;
+        uint64_t sensorRingOffset;
+        uint64_t commandRingOffset;
+        uint64_t sensorFrameSize;
+        uint64_t commandFrameSize;
+    };
+
+    //! A structure describing a scalar sensor of a robot.
+    struct ShmSensorDescriptor
+    {
+        char name[SF_SHM_NAME_LENGTH];
+        uint32_t type; //Value of ScalarSensorType
+        uint32_t numChannels;
+        uint32_t firstChannel; //Index of the first channel in the sensor frame
+        uint32_t reserved;
+        double frequency; //Update frequency [Hz] (non-positive means every tick)
+    };
+
+    //! A structure describing an actuator of a robot.
+    struct ShmActuatorDescriptor
+    {
+        char name[SF_SHM_NAME_LENGTH];
+        uint32_t type; //Value of ActuatorType
+        uint32_t reserved;
+    };
+
+    //! A structure placed at the beginning of each ring buffer.
+    struct ShmRingHeader
+    {
+        alignas(64) std::atomic<uint64_t> head; //Number of frames written by the producer
+        std::atomic<uint64_t> dropped; //Number of frames dropped because the ring was full
+        alignas(64) std::atomic<uint64_t> tail; //Number of frames read by the consumer
+    };
+
+    //! A structure placed at the beginning of each sensor frame.
+    struct ShmSensorFrameHeader
+    {
+        uint64_t tick; //Simulation tick
+        double simulationTime; //Simulation time [s]
+        int64_t publishTime; //Wall time when the frame was published [ns]
+        uint64_t reserved;
+    };
+
+    //! A structure placed at the beginning of each command frame.
+    struct ShmCommandFrameHeader
+    {
+        uint64_t tick; //Simulation tick of the sensor frame the commands respond to
+        int64_t sendTime; //Wall time when the frame was sent [ns]
+        uint64_t reserved[2];
+    };
+
+    //! A structure representing a command of a single actuator.
+    /*!
+     The meaning of the values depends on the type of the actuator:
+     - motor: value[0] = torque [Nm] or voltage [V]
+     - servo: mode = 0 -> value[0] = position [rad or m], mode = 1 -> value[0] = velocity [rad/s or m/s]
+     - propeller, thruster, rudder: value[0] = setpoint
+     - variable buoyancy: value[0] = flow rate [m^3/s]
+     - push: value[0] = force [N]
+     - simple thruster: value[0] = thrust [N], value[1] = torque [Nm]
+     - light, suction cup: value[0] > 0.5 -> on
+     */
+    struct ShmActuatorCommand
+    {
+        uint32_t flags; //SF_SHM_COMMAND_VALID if the command should be applied
+        uint32_t mode;
+        double value[2];
+    };
+
+    static_assert(sizeof(ShmHeader) == 64, "Unexpected size of the shared memory header!");
+    static_assert(sizeof(ShmRobotDescriptor) == 128, "Unexpected size of the robot descriptor!");
+    static_assert(sizeof(ShmSensorDescriptor) == 88, "Unexpected size of the sensor descriptor!");
+    static_assert(sizeof(ShmActuatorDescriptor) == 72, "Unexpected size of the actuator descriptor!");
+    static_assert(sizeof(ShmRingHeader) == 128, "Unexpected size of the ring header!");
+    static_assert(sizeof(ShmSensorFrameHeader) == 32, "Unexpected size of the sensor frame header!");
+    static_assert(sizeof(ShmCommandFrameHeader) == 32, "Unexpected size of the command frame header!");
+    static_assert(sizeof(ShmActuatorCommand) == 24, "Unexpected size of the actuator command!");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory bridge requires lock-free 64-bit atomics!");
+
+    //! A structure holding the settings of the shared memory bridge.
+    struct SharedMemoryBridgeSettings
+    {
+        std::string name; //Name of the shared memory segment
+        unsigned int ringCapacity; //Number of frames in each ring buffer
+        bool synchronous; //Wait for the commands of the connected controllers before each tick
+        Scalar timeout; //Maximum time to wait for the commands [s]
+
+        //! A constructor setting the default values.
+        SharedMemoryBridgeSettings(const std::string& segmentName = "stonefish", unsigned int capacity = 16,
+                                   bool sync = false, Scalar waitTimeout = Scalar(1))
+            : name(segmentName), ringCapacity(capacity), synchronous(sync), timeout(waitTimeout) {}
+    };
+
+    //! A class implementing a zero-copy shared memory transport between the simulation and external controllers.
+    /*!
+     After each simulation tick the last measurements of the scalar sensors of every robot are published to a ring buffer.
+     Before each tick the actuator commands sent by the controllers are applied. In the synchronous mode the simulation
+     waits for a command frame responding to the last published tick, once a controller sent its first frame.
+     */
+    class SharedMemoryBridge
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param sm a pointer to the simulation manager
+         \param settings the settings of the bridge
+         */
+        SharedMemoryBridge(SimulationManager* sm, const SharedMemoryBridgeSettings& settings);
+
+        //! A destructor.
+        ~SharedMemoryBridge();
+
+        //! A method applying the actuator commands received from the controllers (called before each tick).
+        void ReceiveCommands();
+
+        //! A method publishing the sensor measurements (called after each tick).
+        /*!
+         \param simulationTime the current simulation time [s]
+         */
+        void PublishSensors(Scalar simulationTime);
+
+        //! A method returning the statistics of the round-trip latency.
+        /*!
+         The round-trip latency is measured from publishing a sensor frame to receiving the command frame responding to it.
+         \param mean a reference to the mean latency [s]
+         \param max a reference to the maximum latency [s]
+         \return number of measured round trips
+         */
+        uint64_t getRoundTripLatency(Scalar& mean, Scalar& max) const;
+
+        //! A method returning the number of sensor frames dropped because the controllers did not keep up.
+        uint64_t getNumOfDroppedFrames() const;
+
+        //! A method returning the name of the shared memory segment.
+        std::string getName() const;
+
+        //! A method informing if the shared memory segment was created successfully.
+        bool isOpen() const;
+
+    private:
+        struct RobotChannel
+        {
+            ShmRobotDescriptor layout; //Private copy, the segment is writable by the controllers
+            ShmRingHeader* sensorRing;
+            ShmRingHeader* commandRing;
+            std::vector<ScalarSensor*> sensors;
+            std::vector<Actuator*> actuators;
+            int64_t publishTime;
+            bool connected;
+        };
+
+        void ApplyCommand(Actuator* act, const ShmActuatorCommand& cmd);
+
+        std::string name;
+        unsigned int capacity;
+        bool synchronous;
+        int64_t timeout;
+        uint8_t* mapping;
+        size_t mappingSize;
+#ifdef _WIN32
+        void* mappingHandle;
+#endif
+        ShmHeader* header;
+        std::vector<RobotChannel> channels;
+        uint64_t tick;
+        uint64_t roundTrips;
+        int64_t latencySum;
+        int64_t latencyMax;
+    };
+}
+
+#endif
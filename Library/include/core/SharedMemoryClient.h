@@ -0,0 +1,147 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SharedMemoryClient.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_SharedMemoryClient__
+#define __Stonefish_SharedMemoryClient__
+
+#include "core/SharedMemoryBridge.h"
+
+namespace sf
+{
+    //! A class implementing the controller side of the shared memory bridge.
+    /*!
+     The client maps the shared memory segment created by the SharedMemoryBridge and gives direct access to the frames
+     stored in the ring buffers. It does not depend on the simulation and is meant to be used in a separate process.
+     Each robot may be served by only one client at a time.
+     */
+    class SharedMemoryClient
+    {
+    public:
+        //! A constructor.
+        SharedMemoryClient();
+
+        //! A destructor.
+        ~SharedMemoryClient();
+
+        //! A method connecting to the shared memory segment.
+        /*!
+         \param name the name of the shared memory segment
+         \param timeout the maximum time to wait for the segment to appear [s]
+         \return true if the connection was successful
+         */
+        bool Connect(const std::string& name, Scalar timeout = Scalar(0));
+
+        //! A method disconnecting from the shared memory segment.
+        void Disconnect();
+
+        //! A method returning a pointer to the oldest unread sensor frame of a robot.
+        /*!
+         \param robot the index of the robot
+         \param latest a flag deciding if the older unread frames should be skipped
+         \return a pointer to the frame header or nullptr if no new frame is available
+         */
+        const ShmSensorFrameHeader* AcquireSensorFrame(unsigned int robot, bool latest = true);
+
+        //! A method releasing the sensor frame returned by AcquireSensorFrame (the frame may be overwritten afterwards).
+        /*!
+         \param robot the index of the robot
+         */
+        void ReleaseSensorFrame(unsigned int robot);
+
+        //! A method returning a pointer to the commands of the next command frame of a robot.
+        /*!
+         All commands are initially marked as invalid.
+         \param robot the index of the robot
+         \param tick the simulation tick of the sensor frame the commands respond to
+         \return a pointer to the array of actuator commands or nullptr if the ring buffer is full
+         */
+        ShmActuatorCommand* AcquireCommandFrame(unsigned int robot, uint64_t tick);
+
+        //! A method sending the command frame returned by AcquireCommandFrame.
+        /*!
+         \param robot the index of the robot
+         */
+        void CommitCommandFrame(unsigned int robot);
+
+        //! A method returning the index of a robot.
+        /*!
+         \param name the name of the robot
+         \return index of the robot or -1 if not found
+         */
+        int getRobotIndex(const std::string& name) const;
+
+        //! A method returning the index of a sensor of a robot.
+        /*!
+         \param robot the index of the robot
+         \param name the name of the sensor
+         \return index of the sensor or -1 if not found
+         */
+        int getSensorIndex(unsigned int robot, const std::string& name) const;
+
+        //! A method returning the index of an actuator of a robot.
+        /*!
+         \param robot the index of the robot
+         \param name the name of the actuator
+         \return index of the actuator or -1 if not found
+         */
+        int getActuatorIndex(unsigned int robot, const std::string& name) const;
+
+        //! A method returning the description of a robot.
+        const ShmRobotDescriptor* getRobot(unsigned int robot) const;
+
+        //! A method returning the description of a sensor of a robot.
+        const ShmSensorDescriptor* getSensor(unsigned int robot, unsigned int sensor) const;
+
+        //! A method returning the description of an actuator of a robot.
+        const ShmActuatorDescriptor* getActuator(unsigned int robot, unsigned int actuator) const;
+
+        //! A method returning a pointer to the sample counters stored in a sensor frame.
+        static const uint64_t* getSampleCounts(const ShmSensorFrameHeader* frame);
+
+        //! A method returning a pointer to the channel values stored in a sensor frame.
+        /*!
+         \param frame a pointer to the sensor frame
+         \param numSensors the number of sensors of the robot
+         \return a pointer to the array of channel values
+         */
+        static const double* getChannels(const ShmSensorFrameHeader* frame, unsigned int numSensors);
+
+        //! A method returning the number of robots.
+        unsigned int getNumOfRobots() const;
+
+        //! A method informing if the client is connected and the simulation did not close the bridge.
+        bool isConnected() const;
+
+    private:
+        uint8_t* mapping;
+        size_t mappingSize;
+#ifdef _WIN32
+        void* mappingHandle;
+#endif
+        ShmHeader* header;
+    };
+}
+
+#endif
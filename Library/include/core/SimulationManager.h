@@ -32,6 +32,8 @@
 #include "entities/SolidEntity.h"
 #include "utils/PerformanceMonitor.h"
 #include "BulletSoftBody/btSoftMultiBodyDynamicsWorld.h"
+#include <functional>
+#include <unordered_map>
 
 namespace sf
 {
@@ -51,6 +53,10 @@ namespace sf
     class Contact;
     class OpenGLTrackball;
     class OpenGLDebugDrawer;
+    class SharedMemoryBridge;
+    struct SharedMemoryBridgeSettings;
+    class CommandJournal;
+    enum class JournalMode;
     
     //! An enum designating the type of solver used for physics computation
     enum class Solver {SI, DANTZIG, PGS, LEMKE, NNCG};
@@ -65,6 +71,19 @@ namespace sf
         Entity* B;
     };
     
+    //! An enum designating the type of an external override.
+    enum class OverrideType {WRENCH, POSE};
+    
+    //! A structure used to queue external forces and pose overrides applied to bodies
+    struct ExternalOverride
+    {
+        SolidEntity* solid;
+        OverrideType type;
+        Vector3 force;
+        Vector3 torque;
+        Transform pose;
+    };
+    
     //! An abstract class managing the simulation world, the solver settings and implementing custom physics callbacks.
     class SimulationManager
     {
@@ -124,6 +143,14 @@ namespace sf
 
         //! A method that performs on simulation step of specified period.
         void StepSimulation(Scalar timeStep);
+
+        //! A method that performs a number of simulation ticks as fast as possible, without pacing (lockstep mode).
+        /*!
+         \param n number of physics ticks to perform
+         \param callStepCompleted a flag deciding if the SimulationStepCompleted method should be called after each tick
+         \param callback an optional function called after each tick (tick index, time step)
+         */
+        void Step(unsigned int n = 1, bool callStepCompleted = true, const std::function<void(unsigned int, Scalar)>& callback = nullptr);
         
         //! A method updating the drawing queue (thread safe)
         void UpdateDrawingQueue();
@@ -248,6 +275,38 @@ namespace sf
         //! A method used to enable atmosphere simulation.
         void EnableAtmosphere();
         
+        //! A method used to enable the shared memory bridge for external controllers.
+        /*!
+         The bridge is created when the simulation starts and publishes the sensors and receives the commands of all robots.
+         \param settings the settings of the bridge
+         */
+        void EnableSharedMemoryBridge(const SharedMemoryBridgeSettings& settings);
+        
+        //! A method used to enable recording or replaying of actuator commands and external overrides.
+        /*!
+         The journal is opened when the simulation starts. A replay has to be run in the same scenario, built in the same way
+         as the recorded one. In the replay modes the shared memory bridge is not opened and the commands of controllers
+         as well as the external overrides requested through the API are ignored.
+         \param path the path to the journal file
+         \param mode the mode of the journal
+         */
+        void EnableCommandJournal(const std::string& path, JournalMode mode);
+        
+        //! A method used to apply an external force and torque to a body during the next simulation tick.
+        /*!
+         \param solid a pointer to the body
+         \param force the force applied at the center of gravity, in the world frame [N]
+         \param torque the torque, in the world frame [Nm]
+         */
+        void ApplyExternalWrench(SolidEntity* solid, const Vector3& force, const Vector3& torque);
+        
+        //! A method used to move a free body to a new pose before the next simulation tick.
+        /*!
+         \param solid a pointer to the body (only bodies not being a part of a multibody are supported)
+         \param pose the new pose of the center of gravity, in the world frame
+         */
+        void OverridePose(SolidEntity* solid, const Transform& pose);
+        
         //! A method used to pick an entity by shooting a camera ray.
         /*!
          \param eye the position of the camera eye in the world frame
@@ -403,6 +462,15 @@ namespace sf
          */
         Contact* getContact(Entity* entA, Entity* entB);
         
+        //! A method returning the contact manifolds involving an entity.
+        /*!
+         The index of manifolds is built on first use after each simulation step and shared by all consumers
+         (has to be called from the simulation thread).
+         \param ent a pointer to the entity
+         \return a reference to a list of manifolds containing at least one contact point
+         */
+        const std::vector<btPersistentManifold*>& getContactManifolds(const Entity* ent);
+        
         //! A method returning an actuator by index.
         /*!
          \param index an id of the actuator
@@ -454,6 +522,12 @@ namespace sf
         //! A method returning a pointer to the atmosphere object.
         Atmosphere* getAtmosphere();
         
+        //! A method returning a pointer to the shared memory bridge (null if not running).
+        SharedMemoryBridge* getSharedMemoryBridge();
+        
+        //! A method returning a pointer to the command journal (null if not running).
+        CommandJournal* getCommandJournal();
+        
         //! A method setting the gravity constant used in the simulation.
         void setGravity(Scalar gravityConstant);
         
@@ -557,6 +631,8 @@ namespace sf
         void RenderBulletDebug();
         void InitializeSolver();
         void InitializeScenario();
+        void BuildContactIndex();
+        void ApplyExternalOverrides();
         
         // State
         Scalar simulationTime; // Time of simulation run in seconds
@@ -577,6 +653,7 @@ namespace sf
         SDL_mutex* simSettingsMutex;
         SDL_mutex* simInfoMutex;
         SDL_mutex* simHydroMutex;
+        SDL_mutex* simOverrideMutex;
         
         // IC solver settings
         bool icUseGravity;
@@ -607,9 +684,17 @@ namespace sf
         std::vector<Comm*> comms;
         std::vector<Contact*> contacts;
         std::vector<Collision> collisions;
+        std::unordered_map<const Entity*, std::vector<btPersistentManifold*>> contactIndex;
+        bool contactIndexValid;
         NED* ned;
         Ocean* ocean;
         Atmosphere* atmosphere;
+        SharedMemoryBridgeSettings* shmSettings;
+        SharedMemoryBridge* shmBridge;
+        std::string journalPath;
+        JournalMode journalMode;
+        CommandJournal* journal;
+        std::vector<ExternalOverride> overrides;
         Scalar g;
         DisplayMode sdm;
         
@@ -0,0 +1,116 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  TorusCollisionAlgorithm.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_TorusCollisionAlgorithm__
+#define __Stonefish_TorusCollisionAlgorithm__
+
+#include "BulletCollision/CollisionDispatch/btActivatingCollisionAlgorithm.h"
+#include "BulletCollision/CollisionDispatch/btCollisionCreateFunc.h"
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcher.h"
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    class TorusShape;
+
+    //! A structure representing a contact between a torus and another shape.
+    struct TorusContact
+    {
+        Vector3 normal; //Unit normal pointing from the torus to the other shape (world frame)
+        Vector3 point; //Contact point on the surface of the other shape (world frame)
+        Scalar distance; //Signed distance between the surfaces (negative when penetrating)
+    };
+
+    //! A class implementing analytic collision detection between a torus and a sphere, a plane, a box or a capsule.
+    /*!
+     The collision geometry of the torus is its convex hull, i.e., a disk swept by a sphere with the minor radius, exactly as seen
+     by the GJK algorithm. The closest points are found by alternating projections between the core disk and the core of the other
+     shape (point, segment or box, swept by the margin). Additional contacts are probed on the rim of the disk, to support resting contacts.
+     Deep penetrations, where the cores intersect, fall back to the GJK/EPA algorithm.
+     */
+    class TorusCollisionAlgorithm : public btActivatingCollisionAlgorithm
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param mf a pointer to a shared contact manifold (a new one is created if null)
+         \param ci the construction info of the algorithm
+         \param body0Wrap a pointer to the first collision object
+         \param body1Wrap a pointer to the second collision object
+         \param isSwapped a flag indicating if the torus is the second object
+         */
+        TorusCollisionAlgorithm(btPersistentManifold* mf, const btCollisionAlgorithmConstructionInfo& ci,
+                                const btCollisionObjectWrapper* body0Wrap, const btCollisionObjectWrapper* body1Wrap, bool isSwapped);
+
+        //! A destructor.
+        virtual ~TorusCollisionAlgorithm();
+
+        //! A method computing the contacts between the objects.
+        virtual void processCollision(const btCollisionObjectWrapper* body0Wrap, const btCollisionObjectWrapper* body1Wrap,
+                                      const btDispatcherInfo& dispatchInfo, btManifoldResult* resultOut);
+
+        //! A method computing the time of impact (not supported).
+        virtual Scalar calculateTimeOfImpact(btCollisionObject* body0, btCollisionObject* body1,
+                                             const btDispatcherInfo& dispatchInfo, btManifoldResult* resultOut);
+
+        //! A method returning the contact manifolds owned by the algorithm.
+        virtual void getAllContactManifolds(btManifoldArray& manifoldArray);
+
+        //! A method computing the closest contact between a torus and another shape.
+        /*!
+         \param torus a pointer to the torus shape
+         \param torusTrans the world transform of the torus
+         \param shape a pointer to the other shape (sphere, static plane, box or capsule)
+         \param shapeTrans the world transform of the other shape
+         \param contact a reference to the computed contact
+         \return true if the contact was computed analytically, false if the shape is not supported or the cores intersect
+         */
+        static bool ComputeContact(const TorusShape* torus, const Transform& torusTrans,
+                                   const btCollisionShape* shape, const Transform& shapeTrans, TorusContact& contact);
+
+        //! A method registering the algorithm with a collision dispatcher.
+        /*!
+         \param dispatcher a pointer to the collision dispatcher
+         */
+        static void Register(btCollisionDispatcher* dispatcher);
+
+        //! A structure used to create the algorithm by the dispatcher.
+        struct CreateFunc : public btCollisionAlgorithmCreateFunc
+        {
+            CreateFunc(bool isSwapped = false);
+            virtual btCollisionAlgorithm* CreateCollisionAlgorithm(btCollisionAlgorithmConstructionInfo& ci,
+                                                                   const btCollisionObjectWrapper* body0Wrap, const btCollisionObjectWrapper* body1Wrap);
+        };
+
+    private:
+        void AddContact(const TorusContact& contact, btManifoldResult* resultOut);
+
+        bool ownManifold;
+        btPersistentManifold* manifold;
+        bool swapped;
+    };
+}
+
+#endif
@@ -62,8 +62,9 @@ namespace sf
         PhysicsMode mode;
         bool collisions;
         bool buoyancy;
+        bool reducedDrag;
 
-        PhysicsSettings() : mode(PhysicsMode::SUBMERGED), collisions(true), buoyancy(true)
+        PhysicsSettings() : mode(PhysicsMode::SUBMERGED), collisions(true), buoyancy(true), reducedDrag(false)
         {
         }
     };
@@ -62,7 +62,8 @@ namespace sf
          \param c the id of the child link
          */
         FeatherstoneJoint(std::string n, btMultibodyLink::eFeatherstoneJointType t, unsigned int p, unsigned int c)
-        : name(n), type(t), feedback(NULL), limit(NULL), motor(NULL), parent(p), child(c), sigDamping(0), velDamping(0), lowerLimit(10e9), upperLimit(-10e9) {}
+        : name(n), type(t), feedback(NULL), limit(NULL), motor(NULL), parent(p), child(c), sigDamping(0), velDamping(0), lowerLimit(10e9), upperLimit(-10e9),
+          motorPosition(0), motorVelocity(0), motorKp(0), motorKd(1) {}
         
         std::string name;
         btMultibodyLink::eFeatherstoneJointType type;
@@ -78,6 +79,10 @@ namespace sf
         Scalar velDamping;
 		Scalar lowerLimit;
 		Scalar upperLimit;
+        Scalar motorPosition; //Setpoints and gains of the motor (the motor does not expose them)
+        Scalar motorVelocity;
+        Scalar motorKp;
+        Scalar motorKd;
     };
     
     //! A class that implements simplified creation of multi-body trees, using Roy Featherstone's algorithm.
@@ -180,7 +185,7 @@ namespace sf
          */
         void ApplyGravity(const Vector3& g);
         
-        //! A method to apply damping to the multibody.
+        //! A method to apply damping and the commanded efforts to the multibody, in a single pass over the moving joints.
         void ApplyDamping();
         
         //! A method to add a force acting directly on a link.
@@ -256,6 +261,56 @@ namespace sf
          */
         Scalar getJointTorque(unsigned int index);
         
+        //! A method returning the positions of all moving joints.
+        /*!
+         \param positions a pointer to an array of getNumOfMovingJoints() values, ordered by joint id ([m] or [rad])
+         */
+        void getJointPositions(Scalar* positions);
+        
+        //! A method returning the velocities of all moving joints.
+        /*!
+         \param velocities a pointer to an array of getNumOfMovingJoints() values, ordered by joint id ([m/s] or [rad/s])
+         */
+        void getJointVelocities(Scalar* velocities);
+        
+        //! A method returning the directly applied forces or torques of all moving joints.
+        /*!
+         \param torques a pointer to an array of getNumOfMovingJoints() values, ordered by joint id ([N] or [Nm])
+         */
+        void getJointTorques(Scalar* torques);
+        
+        //! A method returning the forces or torques generated by the motors of all moving joints (zero if no motor).
+        /*!
+         \param forceTorques a pointer to an array of getNumOfMovingJoints() values, ordered by joint id ([N] or [Nm])
+         */
+        void getMotorForceTorques(Scalar* forceTorques);
+        
+        //! A method setting the efforts applied to all moving joints in every simulation step, together with damping.
+        /*!
+         \param efforts a pointer to an array of getNumOfMovingJoints() values, ordered by joint id ([N] or [Nm])
+         */
+        void setJointEfforts(const Scalar* efforts);
+        
+        //! A method returning the efforts commanded for all moving joints.
+        /*!
+         \param efforts a pointer to an array of getNumOfMovingJoints() values, ordered by joint id ([N] or [Nm])
+         */
+        void getJointEfforts(Scalar* efforts);
+        
+        //! A method to change the position setpoints of the motors of all moving joints (joints without motors are skipped).
+        /*!
+         \param positions a pointer to an array of getNumOfMovingJoints() setpoints, ordered by joint id ([m] or [rad])
+         \param kp a pointer to an array of getNumOfMovingJoints() position control gains
+         */
+        void MotorPositionSetpoints(const Scalar* positions, const Scalar* kp);
+        
+        //! A method to change the velocity setpoints of the motors of all moving joints (joints without motors are skipped).
+        /*!
+         \param velocities a pointer to an array of getNumOfMovingJoints() setpoints, ordered by joint id ([m/s] or [rad/s])
+         \param kd a pointer to an array of getNumOfMovingJoints() velocity control gains
+         */
+        void MotorVelocitySetpoints(const Scalar* velocities, const Scalar* kd);
+        
         //! A method to change the maximum force/torque produced by the joint motor.
         /*!
          \param index the id of the joint
@@ -270,6 +325,18 @@ namespace sf
          */
         Scalar getMotorForceTorque(unsigned int index);
         
+        //! A method appending the command state of the multibody (setpoints, gains and force limits of the joint motors, joint efforts).
+        /*!
+         \param state a vector to which the state is appended
+         */
+        void getCommandState(std::vector<Scalar>& state);
+        
+        //! A method restoring the command state of the multibody.
+        /*!
+         \param state a pointer to the state saved with getCommandState
+         */
+        void setCommandState(const Scalar* state);
+        
         //! A method returning the axis of the joint.
         /*!
          \param index an id of the joint
@@ -396,9 +463,20 @@ namespace sf
         EntityType getType() const;
         
     private:
+        void UpdateJointTable();
+        
         btMultiBody* multiBody;
         std::vector<FeatherstoneLink> links;
         std::vector<FeatherstoneJoint> joints;
         bool baseRenderable;
+        
+        //Contiguous table of the moving joints, used by the batched methods
+        std::vector<unsigned int> movingJoints; //Joint ids
+        std::vector<int> movingLinks; //Multibody links moved by the joints
+        std::vector<int> movingDofs; //Offsets in the multibody velocity vector
+        std::vector<Scalar> movingSigDamping;
+        std::vector<Scalar> movingVelDamping;
+        std::vector<Scalar> efforts;
+        bool jointTableValid;
     };
 }
@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <unordered_map>
 #include "BulletCollision/CollisionDispatch/btGhostObject.h"
 #include "entities/Entity.h"
 
@@ -33,6 +34,42 @@ namespace sf
     //! An enum specifying the type of forcefield.
     enum class ForcefieldType {POOL, OCEAN, TRIGGER, ATMOSPHERE};
     
+    class ForcefieldEntity;
+    
+    //! A class implementing a ghost object which tracks the bodies overlapping a force field incrementally.
+    /*!
+     The set of overlapping bodies is updated only when the broadphase adds or removes a pair involving the ghost,
+     and the owning force field is notified about the bodies entering and leaving it.
+     */
+    class ForcefieldGhost : public btGhostObject
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param owner a pointer to the force field owning the ghost
+         */
+        ForcefieldGhost(ForcefieldEntity* owner);
+        
+        //! A method called by the broadphase when a new overlap is found.
+        /*!
+         \param otherProxy a pointer to the broadphase proxy of the overlapping body
+         \param thisProxy a pointer to the broadphase proxy of the ghost
+         */
+        void addOverlappingObjectInternal(btBroadphaseProxy* otherProxy, btBroadphaseProxy* thisProxy = 0) override;
+        
+        //! A method called by the broadphase when an overlap ends.
+        /*!
+         \param otherProxy a pointer to the broadphase proxy of the body
+         \param dispatcher a pointer to the collision dispatcher
+         \param thisProxy a pointer to the broadphase proxy of the ghost
+         */
+        void removeOverlappingObjectInternal(btBroadphaseProxy* otherProxy, btDispatcher* dispatcher, btBroadphaseProxy* thisProxy = 0) override;
+        
+    private:
+        ForcefieldEntity* owner;
+        std::unordered_map<const btCollisionObject*, int> indices;
+    };
+    
     //! An abstract class representing some kind of a force field.
     class ForcefieldEntity : public Entity
     {
@@ -62,8 +99,8 @@ namespace sf
          */
         virtual void getAABB(Vector3& min, Vector3& max);
         
-        //! A method returning the pair caching object for the force field.
-        btPairCachingGhostObject* getGhost();
+        //! A method returning the ghost object of the force field, holding the overlapping bodies.
+        btGhostObject* getGhost();
         
         //! A method returning the type of the force field.
         virtual ForcefieldType getForcefieldType() = 0;
@@ -72,6 +109,21 @@ namespace sf
         EntityType getType() const;
         
     protected:
-        btPairCachingGhostObject* ghost;
+        //! A method called when a body starts overlapping the force field.
+        /*!
+         \param co a pointer to the collision object of the body
+         */
+        virtual void BodyEntered(btCollisionObject* co);
+        
+        //! A method called when a body stops overlapping the force field.
+        /*!
+         \param co a pointer to the collision object of the body
+         */
+        virtual void BodyLeft(btCollisionObject* co);
+        
+        ForcefieldGhost* ghost;
+        
+    private:
+        friend class ForcefieldGhost;
     };
 }
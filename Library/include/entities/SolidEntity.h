@@ -41,9 +41,50 @@ namespace sf
     enum class BodyFluidPosition {INSIDE, OUTSIDE, CROSSING_SURFACE};
     
     struct HydrodynamicsSettings;
+    struct HydrodynamicsQuiescence;
     class Ocean;
     class Atmosphere;
     
+    //! A structure holding a reduced-order model of the drag acting on a fully submerged body.
+    /*!
+     The form drag is tabulated over a latitude-longitude grid of directions of the relative flow and of the rotation axis,
+     while the skin friction, which is linear in the velocities, is reduced to constant matrices. The tables are used only when
+     the translation or the rotation dominates the velocity of the faces. Otherwise the quadratic law couples the two motions
+     and the form drag is integrated over the faces stored in the model. All quantities are expressed in the physics frame of
+     the body, with moments taken about its centre of gravity.
+     */
+    struct ReducedDragModel
+    {
+        unsigned int nLat; //Number of latitude intervals (nLat+1 rows including poles)
+        unsigned int nLon; //Number of longitude intervals
+        std::vector<glm::vec4> flow; //Projected area and its first moment, for each direction of flow
+        std::vector<glm::vec3> rotF; //Form drag force for a unit angular velocity about each axis
+        std::vector<glm::vec3> rotT; //Form drag torque for a unit angular velocity about each axis
+        std::vector<glm::vec3> faceR; //Centroids of the faces, relative to the centre of gravity
+        std::vector<glm::vec3> faceN; //Unit normals of the faces
+        std::vector<GLfloat> faceA; //Areas of the faces
+        GLfloat length; //Maximum distance of a face centroid from the centre of gravity
+        glm::mat3 skinFv; //Skin friction force per relative flow velocity
+        glm::mat3 skinFw; //Skin friction force per angular velocity
+        glm::mat3 skinTv; //Skin friction torque per relative flow velocity
+        glm::mat3 skinTw; //Skin friction torque per angular velocity
+        GLfloat forceError; //Maximum relative error of the form drag force w.r.t. the integration over faces
+        GLfloat torqueError; //Maximum relative error of the form drag torque w.r.t. the integration over faces
+        
+        ReducedDragModel() : nLat(0), nLon(0), length(0.f), skinFv(0.f), skinFw(0.f), skinTv(0.f), skinTw(0.f), forceError(0.f), torqueError(0.f)
+        {
+        }
+    };
+    
+    //! A structure holding the face data buffers reused by the hydrodynamics computation over the faces of a mesh.
+    struct HydrodynamicsBuffers
+    {
+        std::vector<glm::vec3> faceC; //Centroids of the faces
+        std::vector<glm::vec3> faceN; //Unit normals of the faces
+        std::vector<GLfloat> faceA; //Areas of the faces
+        std::vector<glm::vec3> faceV; //Fluid velocity at the centroids of the faces
+    };
+    
     //! An abstract class representing a rigid body.
     class SolidEntity : public MovingEntity
     {
@@ -130,11 +171,12 @@ namespace sf
          \param _Tdf output of the torque induced by skin friction
          \param _Swet output of the wetted surface area
          \param _Vsub output of the submerged volume
-         \param debug output of the debug rendering
+         \param debug output of the debug lines outlining the submerged faces
+         \param buffers a pointer to the face data buffers reused between calls (temporary buffers are allocated if null)
         */
         static void ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings& settings, const Mesh* mesh, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
                                                      const Vector3& linearV, const Vector3& angularV, Vector3& _Fb, Vector3& _Tb, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf, 
-                                                     Scalar& _Swet, Scalar& _Vsub, Renderable& debug);
+                                                     Scalar& _Swet, Scalar& _Vsub, std::vector<glm::vec3>& debug, HydrodynamicsBuffers* buffers = nullptr);
         
         //! A static method that computes fluid dynamics when a body is completely submerged.
         /*!
@@ -148,10 +190,37 @@ namespace sf
          \param _Tdq output of the torque induced by form drag
          \param _Fdf output of the damping force resulting from skin friction
          \param _Tdf output of the torque induced by skin friction
+         \param buffers a pointer to the face data buffers reused between calls (temporary buffers are allocated if null)
         */
         static void ComputeHydrodynamicForcesSubmerged(const Mesh* mesh, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
+                                                       const Vector3& linearV, const Vector3& angularV, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf,
+                                                       HydrodynamicsBuffers* buffers = nullptr);
+        
+        //! A static method that computes fluid dynamics of a completely submerged body, using a reduced-order model.
+        /*!
+         The fluid velocity is sampled only at the centre of gravity of the body.
+         \param model a reference to the reduced-order drag model of the body
+         \param liquid a pointer to the fluid entity generating forces
+         \param T_CG a transform from the world frame to the body CG frame
+         \param T_C a transform from the world frame to the body physics frame
+         \param linearV the linear velocity of the body in the world frame
+         \param angularV the angular velocity of the body in the world frame
+         \param _Fdq output of the damping force resulting from form drag
+         \param _Tdq output of the torque induced by form drag
+         \param _Fdf output of the damping force resulting from skin friction
+         \param _Tdf output of the torque induced by skin friction
+        */
+        static void ComputeHydrodynamicForcesSubmerged(const ReducedDragModel& model, Ocean* liquid, const Transform& T_CG, const Transform& T_C,
                                                        const Vector3& linearV, const Vector3& angularV, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf);
         
+        //! A static method that precomputes the reduced-order drag model of a body.
+        /*!
+         \param mesh a pointer to the body physics mesh data
+         \param cg the position of the centre of gravity in the physics frame
+         \param model a reference to the model to be built
+        */
+        static void BuildReducedDragModel(const Mesh* mesh, const Vector3& cg, ReducedDragModel& model);
+        
         //! A method that computes aerodynamics.
         /*!
          \param atm a pointer to the atmosphere entity
@@ -201,6 +270,20 @@ namespace sf
         //! A method which applies precomputed hydrodynamic forces to the body.
         virtual void ApplyHydrodynamicForces();
         
+        //! A method checking if the hydrodynamic forces computed last time can be reused.
+        /*!
+         \param ocn a pointer to the ocean
+         \param q the thresholds of the quiescence
+         \return true if the body is hydrodynamically quiescent
+         */
+        bool isHydrodynamicallyQuiescent(Ocean* ocn, const HydrodynamicsQuiescence& q);
+        
+        //! A method storing the state of the body for which the hydrodynamic forces were computed.
+        /*!
+         \param ocn a pointer to the ocean
+         */
+        void StoreHydrodynamicState(Ocean* ocn);
+        
         //! A method which applies precomputed aerodynamic forces to the body.
         virtual void ApplyAerodynamicForces();
         
@@ -295,6 +378,9 @@ namespace sf
 
         //! A method returning the force applied to the body.
         Vector3 getAppliedForce();
+        
+        //! A method returning the torque applied to the body.
+        Vector3 getAppliedTorque();
 
         //! A method returning the hydrodynamic forces computed for the body.
         /*!
@@ -393,6 +479,7 @@ namespace sf
         Scalar LambKFactor(Scalar r1, Scalar r2);
         virtual void BuildRigidBody(btDynamicsWorld* world);
         void BuildMultibodyLinkCollider(btMultiBody* mb, unsigned int child, btSoftMultiBodyDynamicsWorld* world);
+        virtual void BuildReducedDragModels();
         
         //Body
         btMultiBodyLinkCollider* multibodyCollider;
@@ -425,6 +512,8 @@ namespace sf
         Vector3 fdCd;
         Vector3 fdCf;
         Transform T_CG2H; //Transform between CG and hydrodynamic proxy frame
+        ReducedDragModel dragModel;
+        HydrodynamicsBuffers hydroBuffers; //Face data reused in every computation of the hydrodynamic forces
         
         PhysicsSettings phy;
         Vector3 Fb;
@@ -436,6 +525,14 @@ namespace sf
         Scalar Swet; //Wetted surface of the body
         Scalar Vsub; //Submerged part of body
         
+        //Hydrodynamic quiescence
+        bool hydroStateValid;
+        Transform hydroT; //Pose of the CG at the last computation of forces
+        Vector3 hydroV; //Velocity of the water at the CG at the last computation of forces
+        Vector3 hydroAppF; //Force applied by other sources at the last computation of forces
+        Vector3 hydroAppT; //Torque applied by other sources at the last computation of forces
+        size_t hydroContacts; //Signature of the contacts at the last computation of forces
+        
         Vector3 Fda;
         Vector3 Tda;
         
@@ -445,7 +542,7 @@ namespace sf
         
         //Display
         int phyObjectId;
-        Renderable submerged;
+        std::vector<glm::vec3> submerged;
         
     private:
         friend class FeatherstoneEntity;
@@ -31,7 +31,7 @@
 namespace sf
 {
     //! An enum specifiying the type of the static entity.
-    enum class StaticEntityType {PLANE, TERRAIN, OBSTACLE};
+    enum class StaticEntityType {PLANE, TERRAIN, TILED_TERRAIN, OBSTACLE};
     
     struct Mesh;
     
@@ -80,7 +80,7 @@ namespace sf
         void setTransform(const Transform& trans);
         
         //! A method returning the transformation of the entity origin in the world frame.
-        Transform getTransform();
+        virtual Transform getTransform();
         
         //! A method returning the material of the entity.
         Material getMaterial() const;
@@ -110,6 +110,7 @@ namespace sf
         
     protected:
         void BuildRigidBody(btCollisionShape* shape);
+        btRigidBody* CreateRigidBody(btCollisionShape* shape);
         virtual void BuildGraphicalObject();
         
         btRigidBody* rigidBody;
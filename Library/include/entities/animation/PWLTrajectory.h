@@ -68,7 +68,7 @@ namespace sf
 
     protected:
         std::vector<KeyPoint> points;
-        std::vector<Renderable> vis;
+        std::vector<glm::vec3> vis[2];
     };
 }
 
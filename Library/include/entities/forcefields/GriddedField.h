@@ -0,0 +1,135 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  GriddedField.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#pragma once
+
+#include "entities/forcefields/VelocityField.h"
+
+namespace sf
+{
+    //! A structure representing the header of a gridded velocity field file.
+    /*!
+     The file starts with the header, followed by a table of maximum speeds in each tile (float32, over all time slices)
+     and the velocity data (3 x float32 per node). The data is stored slice by slice, each slice divided into cubic tiles
+     of nodes (x fastest, then y, then z, partial tiles padded with zeros), so that a query touches only the pages
+     of the tiles surrounding the query point.
+     */
+    struct GriddedFieldHeader
+    {
+        char magic[4];          //"SFVF"
+        uint32_t version;       //1
+        uint32_t size[3];       //Number of nodes along x, y, z
+        uint32_t slices;        //Number of time slices
+        uint32_t tile;          //Number of nodes along the edge of a tile
+        uint32_t reserved;
+        double origin[3];       //Position of the first node in the world frame [m]
+        double spacing[3];      //Distance between nodes along x, y, z [m]
+        double t0;              //Time of the first slice [s]
+        double dt;              //Time between slices [s]
+    };
+    
+    //! Gridded velocity field class.
+    /*!
+     Class implements a time-varying velocity field defined on a regular 3D grid, e.g., ocean currents from a hindcast model.
+     The data file is memory-mapped and paged in by the operating system only where the field is queried,
+     so that large datasets are not loaded into memory and are shared between processes.
+     The velocity is interpolated trilinearly in space and linearly in time. Outside of the grid the velocity is zero.
+     */
+    class GriddedField : public VelocityField
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param filename the path to the data file
+         \param loop a flag deciding if the time series should be repeated after its end (otherwise last slice is held)
+         \param timeOffset the time of the data corresponding to the start of the simulation [s]
+         */
+        GriddedField(const std::string& filename, bool loop = false, Scalar timeOffset = Scalar(0));
+        
+        //! A destructor.
+        ~GriddedField();
+        
+        //! A method returning velocity at a specified point.
+        /*!
+         \param p a point at which the velocity is requested
+         \return velocity [m/s]
+         */
+        Vector3 GetVelocityAtPoint(const Vector3& p) const;
+        
+        //! A method adding velocity at multiple points to a vector of velocities.
+        /*!
+         \param points the points at which the velocity is requested
+         \param velocities a vector of velocities to accumulate the result in (same size as points) [m/s]
+         */
+        void AddVelocityAtPoints(const std::vector<glm::vec3>& points, std::vector<glm::vec3>& velocities) const;
+        
+        //! A method checking if the velocity can be non-zero inside a box.
+        /*!
+         \param aabbMin the minimum corner of the box in the world frame [m]
+         \param aabbMax the maximum corner of the box in the world frame [m]
+         \return false if the box is outside of the grid or overlaps only tiles without flow
+         */
+        bool Overlaps(const Vector3& aabbMin, const Vector3& aabbMax) const;
+        
+        //! A method implementing the rendering of the grid extents.
+        std::vector<Renderable> Render(VelocityFieldUBO& ubo);
+        
+        //! A method returning the axis-aligned bounding box of the grid.
+        /*!
+         \param aabbMin the minimum corner of the box in the world frame [m]
+         \param aabbMax the maximum corner of the box in the world frame [m]
+         \return true
+         */
+        bool getBoundingBox(Vector3& aabbMin, Vector3& aabbMax) const;
+        
+        //! A method returning the type of the velocity field.
+        VelocityFieldType getType() const;
+        
+    private:
+        void GetSlices(size_t& s0, size_t& s1, float& ws) const;
+        glm::vec3 Interpolate(const glm::vec3& p, size_t s0, size_t s1, float ws) const;
+        glm::vec3 getNode(size_t s, uint32_t i, uint32_t j, uint32_t k) const;
+        
+        GriddedFieldHeader header;
+        uint32_t tiles[3];
+        size_t tileCount;
+        size_t tileNodes;
+        const float* tileMaxSpeed;
+        const float* data;
+        glm::vec3 gridMin;
+        glm::vec3 gridMax;
+        glm::vec3 invSpacing;
+        bool loopTime;
+        Scalar tOffset;
+        
+        //Mapping
+        void* mapping;
+        size_t mappingSize;
+#ifdef _WIN32
+        void* fileHandle;
+        void* mappingHandle;
+#endif
+    };
+}
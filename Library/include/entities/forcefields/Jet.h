@@ -34,6 +34,7 @@ namespace sf
      Class implements a velocity field coming from a water jet.
      The flow velocity is specified at the centre of the jet outlet.
      The closer to the outlet boundary the slower the flow (zero at boudary).
+     The field is truncated at the distance from the outlet where the centreline velocity decays below 1% of the outlet velocity.
      */
     class Jet : public VelocityField
     {
@@ -53,6 +54,25 @@ namespace sf
          \return velocity [m/s]
          */
         Vector3 GetVelocityAtPoint(const Vector3& p) const;
+
+        //! A method checking if the jet cone intersects a box.
+        /*!
+         \param aabbMin the minimum corner of the box in the world frame [m]
+         \param aabbMax the maximum corner of the box in the world frame [m]
+         \return false if the box is behind the outlet or outside of the cone
+         */
+        bool Overlaps(const Vector3& aabbMin, const Vector3& aabbMax) const;
+        
+        //! A method returning the extents of the truncated jet cone.
+        /*!
+         \param aabbMin the minimum corner of the bounding box in the world frame [m]
+         \param aabbMax the maximum corner of the bounding box in the world frame [m]
+         \return always true
+         */
+        bool getBoundingBox(Vector3& aabbMin, Vector3& aabbMax) const;
+        
+        //! A method returning the distance from the outlet at which the jet is truncated [m].
+        Scalar getLength() const;
         
         //! A method implementing the rendering of the jet.
         std::vector<Renderable> Render(VelocityFieldUBO& ubo);
@@ -72,6 +92,7 @@ namespace sf
     private:
         Vector3 c, n;
         Scalar r;
+        Scalar l;
         Scalar vout;
     };
 }
@@ -26,10 +26,13 @@
 #pragma once
 
 #include <SDL2/SDL_mutex.h>
+#include <unordered_map>
 #include "core/MaterialManager.h"
 #include "entities/ForcefieldEntity.h"
 #include "graphics/OpenGLOcean.h"
 
+#define CURRENTS_GRID_MAX_CELLS 4096 //Velocity fields spanning more cells are evaluated for every query
+
 namespace sf
 {
     //! A structure holding the settings of the hydrodynamics computation.
@@ -38,6 +41,15 @@ namespace sf
         bool dampingForces;
         bool reallisticBuoyancy;
     };
+
+    //! A structure holding the thresholds below which a body is considered hydrodynamically quiescent.
+    struct HydrodynamicsQuiescence
+    {
+        Scalar linearVelocity;  //Velocity of the body relative to the water and change of the water velocity [m/s]
+        Scalar angularVelocity; //Angular velocity of the body [rad/s]
+        Scalar position;        //Displacement since the last computation of forces [m]
+        Scalar orientation;     //Rotation since the last computation of forces [rad]
+    };
     
     class VelocityField;
     class Actuator;
@@ -63,6 +75,19 @@ namespace sf
         */
         void SetConditions(Scalar waterTemp);
 
+        //! A method to set the thresholds of the hydrodynamic quiescence.
+        /*!
+         The hydrodynamic forces of a quiescent body are not recomputed, instead the forces computed last time are applied.
+         A body wakes up when its motion exceeds the thresholds, the currents around it change, the waves pass through it,
+         the forces applied to it by other sources (e.g. actuators) change or it comes in or out of contact with other bodies.
+         Setting any of the thresholds to zero disables the quiescence detection (default).
+         \param linearVelocity the threshold of the velocity of the body relative to the water [m/s]
+         \param angularVelocity the threshold of the angular velocity of the body [rad/s]
+         \param position the threshold of the displacement of the body since the last computation [m]
+         \param orientation the threshold of the rotation of the body since the last computation [rad]
+         */
+        void setHydrodynamicsQuiescence(Scalar linearVelocity, Scalar angularVelocity, Scalar position, Scalar orientation);
+
         //! A method used to add a velocity field to the ocean.
         /*!
          \param field a pointer to a velocity field object
@@ -84,6 +109,14 @@ namespace sf
          */
         Vector3 GetFluidVelocity(const Vector3& point) const;
         glm::vec3 GetFluidVelocity(const glm::vec3& point) const;
+
+        //! A method returning the water velocity at multiple points.
+        /*!
+         Only the velocity fields overlapping the bounding box of all points are evaluated.
+         \param points the points in the ocean where the velocity should be measured [m]
+         \param velocities a vector to be filled with fluid velocities at the specified points [m/s]
+         */
+        void GetFluidVelocity(const std::vector<glm::vec3>& points, std::vector<glm::vec3>& velocities) const;
         
         //! A method checking if a point is inside fluid
         /*!
@@ -133,6 +166,12 @@ namespace sf
           
         //! A method informing if the ocean waves are simulated.
         bool hasWaves() const;
+
+        //! A method informing if the hydrodynamic quiescence of bodies is detected.
+        bool isHydrodynamicsQuiescenceEnabled() const;
+
+        //! A method returning the thresholds of the hydrodynamic quiescence.
+        HydrodynamicsQuiescence getHydrodynamicsQuiescence() const;
         
         //! A method returning a pointer to the fluid filling the ocean.
         Fluid getLiquid() const;
@@ -163,8 +202,21 @@ namespace sf
         std::vector<Renderable> Render(const std::vector<Actuator*>& act);
         
     private:
+        struct CurrentBounds
+        {
+            Vector3 aabbMin;
+            Vector3 aabbMax;
+            bool bounded;
+        };
+
+        void RebuildCurrentsIndex();
+
         Fluid liquid;
         std::vector<VelocityField*> currents;
+        std::vector<CurrentBounds> currentsBounds;
+        std::vector<size_t> unboundedCurrents;
+        std::unordered_map<uint64_t, std::vector<size_t>> currentsGrid;
+        Scalar currentsGridCell;
         OpenGLOcean* glOcean;
         OceanCurrentsUBO glOceanCurrentsUBOData;
         Scalar depth;
@@ -172,6 +224,7 @@ namespace sf
         Scalar salinity;
         Scalar oceanState;
         bool currentsEnabled;
-        Renderable wavesDebug;
+        HydrodynamicsQuiescence quiescence;
+        std::vector<glm::vec3> wavesDebug;
     };
 }
@@ -56,6 +56,14 @@ namespace sf
          */
         Vector3 GetVelocityAtPoint(const Vector3& p) const;
 
+        //! A method returning the axis-aligned bounding box of the pipe.
+        /*!
+         \param aabbMin the minimum corner of the box in the world frame [m]
+         \param aabbMax the maximum corner of the box in the world frame [m]
+         \return true
+         */
+        bool getBoundingBox(Vector3& aabbMin, Vector3& aabbMax) const;
+
         //! A method to set the inlet flow velocity.
         /*!
          \param v the velocity at the inlet [m/s]
@@ -68,15 +68,6 @@ namespace sf
          */
         void AddActiveSolid(SolidEntity* solid);
         
-        //! A method used to activate actions for a collision object.
-        /*!
-         \param co a pointer to a collision object
-         */
-        void Activate(btCollisionObject* co);
-        
-        //! A method that clears the activity flag.
-        void Clear();
-        
         //! A method implementing the rendering of the trigger.
         std::vector<Renderable> Render();
         
@@ -86,8 +77,14 @@ namespace sf
         //! A method returning the force field type.
         ForcefieldType getForcefieldType();
         
+    protected:
+        void BodyEntered(btCollisionObject* co);
+        void BodyLeft(btCollisionObject* co);
+        
     private:
-        bool active;
+        bool isActiveSolid(btCollisionObject* co) const;
+        
+        unsigned int active; //Number of active solids overlapping the trigger
         std::vector<SolidEntity*> solids;
         int objectId;
         int lookId;
@@ -31,7 +31,7 @@
 namespace sf
 {
     //! An enum representing the type of a velocity field.
-    enum class VelocityFieldType {UNIFORM, JET, PIPE};
+    enum class VelocityFieldType {UNIFORM, JET, PIPE, GRIDDED};
 
     //! An abstract class representing a velocity field.
     class VelocityField
@@ -49,6 +49,21 @@ namespace sf
          \return velocity [m/s]
          */
         virtual Vector3 GetVelocityAtPoint(const Vector3& p) const = 0;
+
+        //! A method adding velocity at multiple points to a vector of velocities.
+        /*!
+         \param points the points at which the velocity is requested
+         \param velocities a vector of velocities to accumulate the result in (same size as points) [m/s]
+         */
+        virtual void AddVelocityAtPoints(const std::vector<glm::vec3>& points, std::vector<glm::vec3>& velocities) const;
+
+        //! A method checking if the velocity can be non-zero inside a box.
+        /*!
+         \param aabbMin the minimum corner of the box in the world frame [m]
+         \param aabbMax the maximum corner of the box in the world frame [m]
+         \return false if the velocity is zero everywhere inside the box
+         */
+        virtual bool Overlaps(const Vector3& aabbMin, const Vector3& aabbMax) const;
         
         //! A method implementing the rendering of the velocity field.
         virtual std::vector<Renderable> Render(VelocityFieldUBO& ubo) = 0;
@@ -59,6 +74,14 @@ namespace sf
         //! A method informing if the velocity field is enabled.
         bool isEnabled() const;
 
+        //! A method returning the axis-aligned bounding box of the region where the velocity is non-zero.
+        /*!
+         \param aabbMin the minimum corner of the box in the world frame [m]
+         \param aabbMax the maximum corner of the box in the world frame [m]
+         \return false if the velocity field is unbounded
+         */
+        virtual bool getBoundingBox(Vector3& aabbMin, Vector3& aabbMax) const;
+
         //! A method returning the type of the velocity field.
         virtual VelocityFieldType getType() const = 0;
 
@@ -128,9 +128,11 @@ namespace sf
     private:
         std::vector<CompoundPart> parts; //Parts of the compound solid
         std::vector<size_t> collisionPartId;
+        std::vector<ReducedDragModel> partDragModels;
         bool displayInternals;
         
         void RecalculatePhysicalProperties();
+        void BuildReducedDragModels();
     };
 
 }
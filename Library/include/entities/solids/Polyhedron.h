@@ -27,6 +27,7 @@
 #define __Stonefish_Polyhedron__
 
 #include "entities/SolidEntity.h"
+#include "utils/ConvexHullUtil.h"
 
 namespace sf
 {
@@ -81,8 +82,29 @@ namespace sf
         //! A method used to build the graphical representation of the body.
         void BuildGraphicalObject();
         
+        //! A method that sets the tolerance of the convex hull used for collision.
+        /*!
+         \param tolerance the maximum distance of the mesh vertices from the reduced hull (zero uses all vertices of the exact hull, negative uses all vertices of the mesh) [m]
+         */
+        void setHullReduction(Scalar tolerance);
+        
+        //! A method that enables the approximate convex decomposition of the collision geometry (has to be called before adding the body to the simulation).
+        /*!
+         \param settings the settings of the decomposition
+         */
+        void setConvexDecomposition(const ConvexDecompositionSettings& settings);
+        
+        //! A method that returns the tolerance of the convex hull used for collision.
+        Scalar getHullReduction() const;
+        
+        //! A method informing if the collision geometry is decomposed into convex parts.
+        bool isConvexDecompositionEnabled() const;
+        
     private:
         Mesh *graMesh; //Mesh used for rendering
+        Scalar hullTolerance;
+        bool decompose;
+        ConvexDecompositionSettings decomposition;
     };
 }
 
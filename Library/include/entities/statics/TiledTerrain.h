@@ -0,0 +1,234 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  TiledTerrain.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_TiledTerrain__
+#define __Stonefish_TiledTerrain__
+
+#include <SDL2/SDL_mutex.h>
+#include "BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h"
+#include "entities/StaticEntity.h"
+
+namespace sf
+{
+    //! An enum defining the storage format of the tiled terrain heights.
+    enum class TiledTerrainFormat : uint32_t {FLOAT32 = 0, INT16 = 1};
+
+    //! A structure representing the header of a tiled terrain file.
+    /*!
+     The file starts with the header, followed by a table of minimum and maximum heights in each tile (2 x float32, decoded [m])
+     and the height data. The grid is divided into square tiles of cells, stored row by row (x fastest). Each tile stores
+     (tile+1) x (tile+1) nodes (x fastest), i.e., the border nodes are duplicated in the neighbouring tiles and nodes outside
+     of the grid are padded with the last valid node. The height of a node is the z coordinate of the seabed in the terrain frame
+     (positive down), computed as value * scale + offset. The node (0,0) is located at the origin of the terrain frame.
+     */
+    struct TiledTerrainHeader
+    {
+        char magic[4];          //"SFTT"
+        uint32_t version;       //1
+        uint32_t size[2];       //Number of nodes along x, y
+        uint32_t tile;          //Number of cells along the edge of a tile (power of 2)
+        TiledTerrainFormat format; //Storage format of heights
+        double spacing[2];      //Distance between nodes along x, y [m]
+        double scale;           //Scale of the stored values [m]
+        double offset;          //Offset of the stored values [m]
+    };
+
+    class OpenGLContent;
+
+    //! A class representing a large heightfield terrain divided into tiles, which are paged in and out on demand.
+    /*!
+     The data file is memory-mapped and only the tiles in the neighbourhood of the moving bodies and vision sensors
+     get a collision shape. The graphical meshes of the tiles are built around the active views, with a level of detail
+     decreasing with the distance from the eye.
+     */
+    class TiledTerrain : public StaticEntity
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param uniqueName a name for the terrain
+         \param pathToData a path to the tiled terrain data file
+         \param material the name of the material the terrain is made of
+         \param look the name of the graphical material used for rendering
+         \param uvScale scaling of texture coordinates
+         \param pagingRadius the distance from moving bodies and vision sensors within which the tiles are collidable [m]
+         \param lodDistance the distance from the eye up to which the tiles are rendered at full resolution [m]
+         \param drawRange the distance from the eye up to which the tiles are rendered [m]
+         */
+        TiledTerrain(std::string uniqueName, std::string pathToData, std::string material, std::string look = "", float uvScale = 1.f,
+                     Scalar pagingRadius = Scalar(100), Scalar lodDistance = Scalar(50), Scalar drawRange = Scalar(2000));
+
+        //! A destructor.
+        ~TiledTerrain();
+
+        //! A method used to add the terrain to the simulation.
+        /*!
+         \param sm a pointer to the simulation manager
+         \param origin the origin of the terrain in the world frame
+         */
+        void AddToSimulation(SimulationManager* sm, const Transform& origin);
+
+        //! A method updating the set of collidable tiles around the moving bodies and vision sensors.
+        /*!
+         \param sm a pointer to the simulation manager
+         */
+        void UpdateTiles(SimulationManager* sm);
+
+        //! A method building and destroying the graphical meshes of the tiles (has to be called from the rendering thread).
+        /*!
+         \param content a pointer to the OpenGL content
+         */
+        void UpdateGraphics(OpenGLContent* content);
+
+        //! A method implementing the rendering of the terrain.
+        std::vector<Renderable> Render();
+
+        //! A method returning the height of the terrain at a given point.
+        /*!
+         \param x the x coordinate in the terrain frame [m]
+         \param y the y coordinate in the terrain frame [m]
+         \return the z coordinate of the terrain in the terrain frame (bilinear interpolation) [m]
+         */
+        Scalar getHeight(Scalar x, Scalar y) const;
+
+        //! A method returning the number of tiles which are currently collidable.
+        unsigned int getNumOfLoadedTiles() const;
+
+        //! A method returning the number of tiles which currently have a graphical mesh.
+        unsigned int getNumOfDrawnTiles() const;
+
+        //! A method returning the level of detail used to render a tile at a given distance from the eye.
+        /*!
+         \param distance the distance from the eye to the tile [m]
+         \return the level of detail (0 is the full resolution, each level halves it) or -1 if the tile is not rendered
+         */
+        int getLevelOfDetail(Scalar distance) const;
+
+        //! A method returning the extents of the terrain axis alligned bounding box.
+        /*!
+         \param min a point located at the minimum coordinate corner
+         \param max a point located at the maximum coordinate corner
+         */
+        void getAABB(Vector3& min, Vector3& max);
+
+        //! A method returning the transformation of the terrain origin in the world frame.
+        Transform getTransform();
+
+        //! A method returning the type of static entity.
+        StaticEntityType getStaticType();
+
+        //! A static method writing a tiled terrain data file from a regular grid of heights.
+        /*!
+         \param path the path to the output file
+         \param heights a pointer to the heights of the nodes (z coordinate of the seabed, positive down), row by row (x fastest) [m]
+         \param sizeX the number of nodes along x
+         \param sizeY the number of nodes along y
+         \param spacingX the distance between nodes along x [m]
+         \param spacingY the distance between nodes along y [m]
+         \param tile the number of cells along the edge of a tile (power of 2, at least 4)
+         \param format the storage format of heights (int16 values use the scale and offset fitting the range of heights)
+         \return true if the file was written successfully
+         */
+        static bool WriteTerrainData(const std::string& path, const float* heights, uint32_t sizeX, uint32_t sizeY, double spacingX, double spacingY,
+                                     uint32_t tile = 64, TiledTerrainFormat format = TiledTerrainFormat::INT16);
+
+        //! A static method converting a heightmap image into a tiled terrain data file.
+        /*!
+         The heights are computed in the same way as for the Terrain class, i.e., white pixels correspond to the height 0 and black
+         pixels to the maximum height. The rows of the image are placed along the y axis.
+         \param pathToHeightmap the path to the heightmap image (8 or 16 bit greyscale)
+         \param path the path to the output file
+         \param spacingX the distance between pixels along x [m]
+         \param spacingY the distance between pixels along y [m]
+         \param height the maximum height of the terrain [m]
+         \param tile the number of cells along the edge of a tile (power of 2, at least 4)
+         \param format the storage format of heights
+         \return true if the file was written successfully
+         */
+        static bool ConvertHeightmap(const std::string& pathToHeightmap, const std::string& path, double spacingX, double spacingY, double height,
+                                     uint32_t tile = 64, TiledTerrainFormat format = TiledTerrainFormat::INT16);
+
+    private:
+        struct Tile
+        {
+            uint32_t nodes[2];
+            float minHeight;
+            float maxHeight;
+            Vector3 center;
+            Scalar radius;
+            Scalar* heights;
+            btHeightfieldTerrainShape* shape;
+            btRigidBody* body;
+            int objectId;
+            int objectLod;
+            glm::mat4 model;
+            uint64_t stamp;
+            uint64_t graphicsStamp;
+        };
+
+        Scalar getNode(uint32_t gx, uint32_t gy) const;
+        void RequestTileGraphics(size_t id);
+        void LoadTile(size_t id);
+        void UnloadTile(size_t id);
+        Mesh* BuildTileMesh(size_t id, int lod) const;
+
+        TiledTerrainHeader header;
+        uint32_t tiles[2];
+        size_t tileNodes;
+        const float* tileRange;
+        const void* data;
+        std::vector<Tile> tileInfo;
+        std::vector<size_t> loaded;
+        std::vector<Vector3> centres;
+        uint64_t pageCount;
+        Scalar maxTileRadius;
+        SimulationManager* sim;
+        Transform T;
+        Scalar pRadius;
+        Scalar lodDist;
+        Scalar range;
+        float uvs;
+        int maxLod;
+
+        //Graphics streaming
+        SDL_mutex* graphicsMutex;
+        std::vector<std::pair<int, uint64_t>> retired;
+        std::vector<size_t> drawn; //Tiles having a graphical mesh
+        std::vector<Vector3> eyes;
+        std::vector<std::pair<Scalar, size_t>> requests;
+        uint64_t renderCount;
+        uint64_t graphicsCount;
+
+        //Mapping
+        void* mapping;
+        size_t mappingSize;
+#ifdef _WIN32
+        void* fileHandle;
+        void* mappingHandle;
+#endif
+    };
+}
+
+#endif
@@ -27,6 +27,7 @@
 #define __Stonefish_GLSLShader__
 
 #include <utility>
+#include <unordered_map>
 #include "graphics/OpenGLDataStructs.h"
 
 namespace sf
@@ -98,7 +99,7 @@ namespace sf
          \param type the type of the attribute
          \return success
          */
-        bool AddAttribute(std::string name, ParameterType type);
+        bool AddAttribute(const std::string& name, ParameterType type);
         
         //! A method to define a GLSL uniform.
         /*!
@@ -106,7 +107,7 @@ namespace sf
          \param type the type of the uniform
          \return success
          */
-        bool AddUniform(std::string name, ParameterType type);
+        bool AddUniform(const std::string& name, ParameterType type);
         
         //! A method used to set a GLSL attribute.
         /*!
@@ -114,7 +115,7 @@ namespace sf
          \param x the value of the attribute
          \return success
          */
-        bool SetAttribute(std::string name, GLfloat x);
+        bool SetAttribute(const std::string& name, GLfloat x);
         
         //! A method used to set a GLSL uniform.
         /*!
@@ -122,7 +123,7 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, bool x);
+        bool SetUniform(const std::string& name, bool x);
         
         //! A method used to set a GLSL uniform.
         /*!
@@ -130,7 +131,7 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, GLfloat x);
+        bool SetUniform(const std::string& name, GLfloat x);
         
         //! A method used to set a GLSL uniform.
         /*!
@@ -138,7 +139,7 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, glm::vec2 x);
+        bool SetUniform(const std::string& name, glm::vec2 x);
         
         //! A method used to set a GLSL uniform.
         /*!
@@ -146,7 +147,7 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, glm::vec3 x);
+        bool SetUniform(const std::string& name, glm::vec3 x);
         
         //! A method used to set a GLSL uniform.
         /*!
@@ -154,7 +155,7 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, glm::vec4 x);
+        bool SetUniform(const std::string& name, glm::vec4 x);
         
         //! A method used to set a GLSL uniform.
         /*!
@@ -162,7 +163,7 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, GLuint x);
+        bool SetUniform(const std::string& name, GLuint x);
 
         //! A method used to set a GLSL uniform.
         /*!
@@ -170,7 +171,7 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, GLint x);
+        bool SetUniform(const std::string& name, GLint x);
         
         //! A method used to set a GLSL uniform.
         /*!
@@ -178,7 +179,7 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, glm::ivec2 x);
+        bool SetUniform(const std::string& name, glm::ivec2 x);
         
         //! A method used to set a GLSL uniform.
         /*!
@@ -186,7 +187,7 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, glm::ivec3 x);
+        bool SetUniform(const std::string& name, glm::ivec3 x);
         
         //! A method used to set a GLSL uniform.
         /*!
@@ -194,7 +195,7 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, glm::ivec4 x);
+        bool SetUniform(const std::string& name, glm::ivec4 x);
 
         //! A method used to set a GLSL uniform.
         /*!
@@ -202,7 +203,7 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, glm::uvec2 x);
+        bool SetUniform(const std::string& name, glm::uvec2 x);
         
         //! A method used to set a GLSL uniform.
         /*!
@@ -210,7 +211,7 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, glm::uvec3 x);
+        bool SetUniform(const std::string& name, glm::uvec3 x);
         
         //! A method used to set a GLSL uniform.
         /*!
@@ -218,7 +219,7 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, glm::uvec4 x);
+        bool SetUniform(const std::string& name, glm::uvec4 x);
         
         //! A method used to set a GLSL uniform.
         /*!
@@ -226,7 +227,7 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, glm::mat3 x);
+        bool SetUniform(const std::string& name, glm::mat3 x);
         
         //! A method used to set a GLSL uniform.
         /*!
@@ -234,21 +235,85 @@ namespace sf
          \param x the value of the uniform
          \return success
          */
-        bool SetUniform(std::string name, glm::mat4 x);
+        bool SetUniform(const std::string& name, glm::mat4 x);
+
+        //! A method used to get the location of a GLSL uniform, resolved when the uniform was added.
+        /*!
+         \param name the name of the uniform
+         \param type the expected type of the uniform
+         \return the location of the uniform or -1 if it doesn't exist or has a different type
+         */
+        GLint getUniformLocation(const std::string& name, ParameterType type) const;
+
+        //! A method used to set a GLSL uniform using a location obtained from getUniformLocation (shader has to be in use).
+        /*!
+         \param location the location of the uniform
+         \param x the value of the uniform
+         */
+        void SetUniform(GLint location, bool x);
+
+        //! A method used to set a GLSL uniform using a location obtained from getUniformLocation (shader has to be in use).
+        /*!
+         \param location the location of the uniform
+         \param x the value of the uniform
+         */
+        void SetUniform(GLint location, GLfloat x);
+
+        //! A method used to set a GLSL uniform using a location obtained from getUniformLocation (shader has to be in use).
+        /*!
+         \param location the location of the uniform
+         \param x the value of the uniform
+         */
+        void SetUniform(GLint location, GLint x);
+
+        //! A method used to set a GLSL uniform using a location obtained from getUniformLocation (shader has to be in use).
+        /*!
+         \param location the location of the uniform
+         \param x the value of the uniform
+         */
+        void SetUniform(GLint location, const glm::vec2& x);
+
+        //! A method used to set a GLSL uniform using a location obtained from getUniformLocation (shader has to be in use).
+        /*!
+         \param location the location of the uniform
+         \param x the value of the uniform
+         */
+        void SetUniform(GLint location, const glm::vec3& x);
+
+        //! A method used to set a GLSL uniform using a location obtained from getUniformLocation (shader has to be in use).
+        /*!
+         \param location the location of the uniform
+         \param x the value of the uniform
+         */
+        void SetUniform(GLint location, const glm::vec4& x);
+
+        //! A method used to set a GLSL uniform using a location obtained from getUniformLocation (shader has to be in use).
+        /*!
+         \param location the location of the uniform
+         \param x the value of the uniform
+         */
+        void SetUniform(GLint location, const glm::mat3& x);
+
+        //! A method used to set a GLSL uniform using a location obtained from getUniformLocation (shader has to be in use).
+        /*!
+         \param location the location of the uniform
+         \param x the value of the uniform
+         */
+        void SetUniform(GLint location, const glm::mat4& x);
 
         //! A method used to bind a GLSL uniform block.
         /*!
          \param name the name of the uniform block
          \param bindingPoint the index of the binding point
          */
-        bool BindUniformBlock(std::string name, GLuint bindingPoint);
+        bool BindUniformBlock(const std::string& name, GLuint bindingPoint);
 
         //! A method used to bind a GLSL shader storage block.
         /*!
          \param name the name of the shader storage block
          \param bindingPoint the index of the binding point
          */
-        bool BindShaderStorageBlock(std::string name, GLuint bindingPoint);
+        bool BindShaderStorageBlock(const std::string& name, GLuint bindingPoint);
 
         //! A method to check if the shader is valid.
         bool isValid();
@@ -279,17 +344,28 @@ namespace sf
         static GLuint LoadShader(GLenum shaderType, const std::string& filename, const std::string& header, GLint* shaderCompiled);
         
     private:
-        bool GetAttribute(std::string name, ParameterType type, GLint& index);
-        bool GetUniform(std::string name, ParameterType type, GLint& location);
+        void Build(const std::vector<GLSLSource>& sources, const std::vector<GLuint>& precompiled);
+        bool GetAttribute(const std::string& name, ParameterType type, GLint& index);
+        bool GetUniform(const std::string& name, ParameterType type, GLint& location);
         
         std::vector<GLSLAttribute> attributes;
-        std::vector<GLSLUniform> uniforms;
+        std::unordered_map<std::string, GLSLUniform> uniforms;
         GLuint program;
         bool valid;
         
         static GLuint saqVertexShader;
         static bool verbose;
+        static std::string cachePath;
+        static uint64_t driverHash;
+        static std::unordered_map<GLuint, uint64_t> shaderHashes; //Hashes of preprocessed sources of live shaders
         static GLuint CreateProgram(const std::vector<GLuint>& compiledShaders, unsigned int doNotDeleteNFirstShaders = 0);
+        static bool ReadShaderSource(const std::string& filename, const std::string& header, std::string& source);
+        static GLuint CompileShader(GLenum shaderType, const std::string& source, const std::string& filename, GLint* shaderCompiled);
+        static uint64_t HashSource(GLenum shaderType, const std::string& source, uint64_t seed = 14695981039346656037ULL);
+        static bool ProgramKey(const std::vector<GLuint>& precompiled, const std::vector<uint64_t>& sourceHashes, uint64_t& key);
+        static std::string ProgramBinaryPath(uint64_t key);
+        static GLuint LoadProgramBinary(uint64_t key);
+        static void SaveProgramBinary(GLuint prog, uint64_t key);
     };
 }
 
@@ -94,6 +94,7 @@ namespace sf
         
         //! A method that bakes the shadow maps for the sun.
         /*!
+         The shadow maps of the previous frame are reused if the light frusta did not change and no object moved inside them.
          \param pipe a pointer to the rendering pipeline
          \param view a pointer to the current view
          */
@@ -186,6 +187,8 @@ namespace sf
         glm::mat4x4 sunModelView;
         ViewFrustum* sunShadowFrustum;
         GLuint sunShadowFBO;
+        unsigned int sunShadowFrame; //Frame in which the shadow maps were baked (0 means never)
+        bool sunShadowDynamic; //Were dynamic objects drawn in the shadow maps?
 		GLSLShader* sunShadowmapShader; //debug draw shadowmap
         
         //Rendering
@@ -70,13 +70,46 @@ namespace sf
         glm::vec3 params; //Additional params
         GLuint type;      //Type of velocity field
     };
+    //! A structure representing a material UBO (std140 aligned).
+    struct MaterialUBO
+    {
+        glm::vec4 color;
+        glm::vec2 shadingParams;    //Parameters of the shading algorithm
+        glm::vec2 temperatureRange;
+        GLfloat reflectivity;
+        GLuint enableAlbedoTex;
+        GLuint enableNormalTex;
+        GLuint enableTemperatureTex;
+    };
     #pragma pack(0)
 
+    //! An enum defining the variants of a material shader.
+    enum class MaterialShaderMode {PLAIN, PLAIN_TEMPERATURE, PLAIN_UNDERWATER, PLAIN_UNDERWATER_WAVES,
+                                   TEXTURED, TEXTURED_TEMPERATURE, TEXTURED_UNDERWATER, TEXTURED_UNDERWATER_WAVES,
+                                   CABLE_TEXTURED, CABLE_TEXTURED_UNDERWATER, CABLE_TEXTURED_UNDERWATER_WAVES, COUNT};
+
+    //! A structure holding a material shader variant and the locations of its per-draw uniforms.
+    struct MaterialShaderVariant
+    {
+        GLSLShader* shader;
+        GLint MVP;
+        GLint M;
+        GLint N;
+        GLint MV;
+        GLint FC;
+        GLint eyePos;
+        GLint viewDir;
+        GLint cableRadius;
+
+        MaterialShaderVariant() : shader(nullptr), MVP(-1), M(-1), N(-1), MV(-1), FC(-1), eyePos(-1), viewDir(-1), cableRadius(-1) {}
+    };
+
     //! A structure representing a material shader collection.
     struct MaterialShader
     {
         std::string shadingAlgorithm;
         std::map<std::string, GLSLShader*> shaders;
+        MaterialShaderVariant variants[(size_t)MaterialShaderMode::COUNT];
 
         MaterialShader()
         {
@@ -88,6 +121,8 @@ namespace sf
             shadingAlgorithm = obj.shadingAlgorithm;
             for(auto i : obj.shaders)
                 shaders[i.first] = i.second;
+            for(size_t i=0; i<(size_t)MaterialShaderMode::COUNT; ++i)
+                variants[i] = obj.variants[i];
         }
     };
 
@@ -129,7 +164,7 @@ namespace sf
         //! A method returning the view matrix.
         glm::mat4 GetViewMatrix();
         
-        //! A method to set the current drawing mode.
+        //! A method to set the current drawing mode (invalidates the cached material state).
         /*!
          \param m drawing mode
          */
@@ -215,13 +250,50 @@ namespace sf
          */
         void DrawPrimitives(PrimitiveType type, std::vector<glm::vec3>* vertices, glm::vec4 color, glm::mat4 M = glm::mat4(1.f));
         
-        //! A method to draw an object.
+        //! A method to draw primitives stored in the helper geometry arena.
+        /*!
+         \param type the type of the primitive
+         \param vertices a range of vertices in the arena
+         \param color the color to be used when drawing
+         \param M the model matrix
+         */
+        void DrawPrimitives(PrimitiveType type, const HelperRange& vertices, glm::vec4 color, glm::mat4 M = glm::mat4(1.f));
+        
+        //! A method to set the frustum used to cull objects.
+        /*!
+         \param VP the view-projection matrix
+         \param eye the position of the eye [m]
+         \param maxRange the maximum distance from the eye at which objects are drawn [m] (0 means no limit)
+         */
+        void SetCullingFrustum(const glm::mat4& VP, const glm::vec3& eye, GLfloat maxRange = 0.f);
+        
+        //! A method to reset the culling frustum to the current view-projection matrix (no range limit).
+        void ResetCullingFrustum();
+        
+        //! A method to check if an object is inside the culling frustum.
+        /*!
+         \param objectId the id of the graphical object
+         \param M the model matrix
+         \return true if the object may be visible
+         */
+        bool isVisible(int objectId, const glm::mat4& M) const;
+        
+        //! A method returning the bounding sphere of an object in the world frame.
+        /*!
+         \param objectId the id of the graphical object
+         \param M the model matrix
+         \return the center (xyz) and radius (w) of the bounding sphere
+         */
+        glm::vec4 getBoundingSphere(int objectId, const glm::mat4& M) const;
+        
+        //! A method to draw an object (skipped if it is outside of the culling frustum).
         /*!
          \param objectId the id of the graphical object
          \param lookId the id of the graphical material
          \param M the model matrix
+         \param cull a flag to enable the culling (disable for objects transformed in the shaders)
          */
-        void DrawObject(int objectId, int lookId, const glm::mat4& M);
+        void DrawObject(int objectId, int lookId, const glm::mat4& M, bool cull = true);
 
         //! A method to draw the light source.
         /*!
@@ -256,6 +328,12 @@ namespace sf
          */
         unsigned int BuildObject(Mesh* mesh);
         
+        //! A method to release the buffers of a graphical object (the id is reused by the next built object).
+        /*!
+         \param id the id of the object
+         */
+        void DestroyObject(unsigned int id);
+        
         //! A method to build a cable object.
         /*!
          \param numNodes the number of nodes of the cable
@@ -534,6 +612,8 @@ namespace sf
         static void AABS(Mesh* mesh, GLfloat& bsRadius, glm::vec3& bsCenterOffset);
         
     private:
+        void CreateLookUBO(Look& look);
+
         //Modes
         DrawingMode mode;
         GLfloat maxAnisotropy;
@@ -542,11 +622,12 @@ namespace sf
         std::vector<OpenGLView*> views;
         std::vector<OpenGLLight*> lights;
         std::vector<Object> objects; // Rigid meshes (static)
+        std::vector<unsigned int> freeObjects; // Ids of destroyed objects
         std::vector<Cable> cables;   // Cables (dynamic)
         std::vector<Look> looks;     // OpenGL materials
         NameManager lookNameManager;
-        std::string currentLookName;
-        std::string currentShaderMode;
+        const Look* currentLook;
+        MaterialShaderMode currentShaderMode;
         
         glm::vec3 eyePos;
         glm::vec3 viewDir;
@@ -555,6 +636,9 @@ namespace sf
         glm::mat4 viewProjection; //Current view-projection matrix
         glm::vec2 viewportSize; //Current view-port size
         GLfloat FC; //Current logarithmic depth buffer constant
+        glm::vec4 cullingPlanes[4]; //Side planes of the culling frustum (SoA: x, y, z, w of the 4 planes)
+        glm::vec3 cullingEye; //Eye position used for range culling
+        GLfloat cullingRange; //Maximum range of drawn objects (0 means no limit)
         
         //Standard objects
         GLuint baseVertexArray; //base VAO
@@ -567,7 +651,18 @@ namespace sf
         GLuint viewUBO;
         
         //Shaders
-        std::map<std::string, GLSLShader*> basicShaders;
+        GLSLShader* helperShader;
+        GLSLShader* texSaqShader;
+        GLSLShader* texQuadShader;
+        GLSLShader* texLayerQuadShader;
+        GLSLShader* texLevelQuadShader;
+        GLSLShader* texCubeShader;
+        GLSLShader* flatShader;
+        GLSLShader* shadowShader;
+        GLint helperMVP;
+        GLint flatMVP;
+        GLint flatFC;
+        GLint shadowMVP;
         std::vector<MaterialShader> materialShaders;
         GLSLShader* lightSourceShader[2];
     };
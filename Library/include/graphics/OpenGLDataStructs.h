@@ -73,6 +73,7 @@
 #define UBO_LIGHTS              ((GLuint)2)
 #define UBO_VIEW                ((GLuint)3)
 #define UBO_OCEAN_CURRENTS      ((GLuint)4)
+#define UBO_MATERIAL            ((GLuint)5)
 
 //Standard SSBO bindings
 #define SSBO_HISTOGRAM          ((GLuint)1)
@@ -91,6 +92,7 @@
 #define MAX_SPOT_LIGHTS         ((GLint)32)
 #define MAX_OCEAN_CURRENTS      ((GLint)64)
 #define SPOT_LIGHT_SHADOWMAP_SIZE   ((GLint)2048)
+#define SHADOW_STATIC_FRAMES    ((unsigned int)30) //Number of frames without motion after which an object is cached as a static shadow caster
 
 class btTransform;
 class btVector3;
@@ -338,6 +340,8 @@ namespace sf
         GLuint vboIndex;
         GLsizei faceCount;
         bool texturable;
+        glm::vec3 bsCenter; //Bounding sphere center (local frame)
+        GLfloat bsRadius; //Bounding sphere radius
     };
 
     //! A structure representing a cable.
@@ -351,6 +355,9 @@ namespace sf
     //! An enum representing the rendering mode.
     enum class DrawingMode {RAW, SHADOW, FLAT, FULL, UNDERWATER, TEMPERATURE};
     
+    //! An enum used to select objects by their motion state.
+    enum class ObjectFilter {ALL, STATIC, DYNAMIC};
+    
     //! A structure containing data of a view frustum.
     struct ViewFrustum
     {
@@ -500,6 +507,7 @@ namespace sf
         GLuint normalMap;
         GLuint temperatureMap;
         glm::vec2 temperatureRange;
+        GLuint ubo; //Material parameters packed in a uniform buffer
 
         Look()
         {
@@ -510,6 +518,24 @@ namespace sf
             normalMap = 0;
             temperatureMap = 0;
             temperatureRange = glm::vec2(20.f);
+            ubo = 0;
+        }
+    };
+    
+    //! A structure representing a range of quantized vertices of a helper object, stored in the helper geometry arena.
+    struct HelperRange
+    {
+        GLuint first;
+        GLuint count;
+        glm::vec3 offset; //Minimum corner of the bounding box
+        glm::vec3 scale; //Extent of the bounding box
+        
+        HelperRange()
+        {
+            first = 0;
+            count = 0;
+            offset = glm::vec3(0.f);
+            scale = glm::vec3(0.f);
         }
     };
     
@@ -524,7 +550,7 @@ namespace sf
         glm::vec3 cor;
         glm::vec3 vel;
         glm::vec3 avel;
-        std::variant< std::shared_ptr<std::vector<glm::vec3>>,
+        std::variant< HelperRange,
                       std::shared_ptr<std::vector<CableNode>> > data;
         
         Renderable() 
@@ -539,9 +565,9 @@ namespace sf
             avel = glm::vec3(0.f);
         }
 
-        std::shared_ptr<std::vector<glm::vec3>> getDataAsPoints() const
+        const HelperRange& getDataAsHelperRange() const
         {
-            return std::get<std::shared_ptr<std::vector<glm::vec3>>>(data);
+            return std::get<HelperRange>(data);
         }
 
         std::shared_ptr<std::vector<CableNode>> getDataAsCableNodes() const
@@ -570,6 +596,7 @@ namespace sf
         RenderQuality aa;
         RenderQuality ssr;
         bool verticalSync;
+        bool offscreen;
         
         //! A constructor.
         RenderSettings()
@@ -583,6 +610,7 @@ namespace sf
             aa = RenderQuality::MEDIUM;
             ssr = RenderQuality::MEDIUM;
             verticalSync = false;
+            offscreen = false;
         }
     };
     
@@ -29,6 +29,9 @@
 #include "graphics/OpenGLSonar.h"
 #include <random>
 
+#define FLS_MAX_SINGLE_FOV 20.f
+#define FLS_VRES_FACTOR 0.1f
+
 namespace sf
 {
     class GLSLShader;
@@ -0,0 +1,109 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  OpenGLHelperArena.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_OpenGLHelperArena__
+#define __Stonefish_OpenGLHelperArena__
+
+#include "graphics/OpenGLDataStructs.h"
+
+namespace sf
+{
+    //! A static class implementing a per-frame linear arena for the vertices of helper objects.
+    /*!
+     The vertices are quantized to 16 bits per coordinate, relative to the bounding box of each range, and appended
+     to the arena belonging to the drawing queue being built. When the drawing queue is handed over to the rendering thread
+     the arenas are swapped and the whole frame is uploaded to a single vertex buffer. The memory of both arenas is reused
+     between frames.
+     */
+    class OpenGLHelperArena
+    {
+    public:
+        //! A method that initializes the arena.
+        /*!
+         \param settings a reference to the helper object rendering settings
+         */
+        static void Init(const HelperSettings& settings);
+
+        //! A method that destroys the arena.
+        static void Destroy();
+
+        //! A method informing if helper objects of a specific type are displayed and should be generated.
+        /*!
+         \param type the type of the renderable
+         \return true if the renderable will be drawn
+         */
+        static bool isEnabled(RenderableType type);
+
+        //! A method starting a new range of vertices.
+        /*!
+         Only one range can be built at a time and it has to be finished by calling the Commit method.
+         \return a reference to an empty vector to be filled with the vertices
+         */
+        static std::vector<glm::vec3>& Begin();
+
+        //! A method finishing the range of vertices started with the Begin method.
+        /*!
+         \return a range of vertices in the arena
+         */
+        static HelperRange Commit();
+
+        //! A method storing a range of vertices.
+        /*!
+         \param vertices a vector of vertices
+         \return a range of vertices in the arena
+         */
+        static HelperRange Store(const std::vector<glm::vec3>& vertices);
+
+        //! A method swapping the arena being filled with the one being rendered (has to be called with the drawing queue locked).
+        static void Swap();
+
+        //! A method uploading the vertices of the rendered arena to the vertex buffer.
+        static void Upload();
+
+        //! A method returning a dequantized vertex from the rendered arena.
+        /*!
+         \param range a range of vertices
+         \param index the index of the vertex in the range
+         \return the vertex
+         */
+        static glm::vec3 getVertex(const HelperRange& range, GLuint index);
+
+        //! A method returning the handle to the vertex buffer.
+        static GLuint getVertexBuffer();
+
+    private:
+        OpenGLHelperArena() noexcept;
+
+        static const HelperSettings* settings;
+        static std::vector<glm::vec3> staging;
+        static std::vector<glm::u16vec4> vertices[2];
+        static unsigned int filled;
+        static bool uploaded;
+        static GLuint vbo;
+        static size_t vboSize;
+    };
+}
+
+#endif
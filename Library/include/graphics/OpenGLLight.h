@@ -146,6 +146,7 @@ namespace sf
         int sourceObject;
         
         static GLuint spotShadowArrayTex; //2D array texture for storing shadowmaps of all spot lights (using only one texture unit for all spotlights!)
+        static GLuint spotShadowCacheArrayTex; //2D array texture for storing cached shadowmaps of static objects
         static GLuint spotShadowSampler;
         static GLuint spotDepthSampler;
         static OpenGLCamera* activeView;
@@ -29,6 +29,8 @@
 #include "graphics/OpenGLSonar.h"
 #include <random>
 
+#define MSIS_RES_FACTOR 0.1f
+
 namespace sf
 {
     class GLSLShader;
@@ -198,6 +198,7 @@ namespace sf
 
         //! A method to set if the particles should be rendered.
         /*!
+         Particles are never rendered when the ocean rendering quality is set to low or disabled.
          \param enabled a flag specifying if the particles should be rendered
          */
         void setParticles(bool enabled);
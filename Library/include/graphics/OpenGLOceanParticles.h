@@ -89,6 +89,7 @@ namespace sf
 
 		static GLuint flakeTexture;
 		static GLuint noiseTexture; 
+		static GLuint materialUBO;
 		static GLSLShader* updateShader;
 		static GLSLShader* renderShader;
 		static GLSLShader* renderIdShader;
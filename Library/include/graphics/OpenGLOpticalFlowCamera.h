@@ -161,6 +161,8 @@ namespace sf
         GLfloat focalLength;
         bool _needsUpdate;
         bool newData;
+        bool outputRead;
+        bool displayRead;
         glm::vec2 range;
         glm::vec2 noiseVel;
         GLfloat maxVel;
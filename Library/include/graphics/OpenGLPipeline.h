@@ -28,6 +28,7 @@
 
 #include <SDL2/SDL_thread.h>
 #include <deque>
+#include <unordered_map>
 #include "StonefishCommon.h"
 #include "graphics/OpenGLDataStructs.h"
 
@@ -75,8 +76,11 @@ namespace sf
 		 */
         void AddToSelectedDrawingQueue(const std::vector<Renderable>& r);
 		
-        //! A method that draws all normal objects.
-        void DrawObjects();
+        //! A method that draws normal objects.
+        /*!
+         \param filter a filter selecting objects based on their motion state
+         */
+        void DrawObjects(ObjectFilter filter = ObjectFilter::ALL);
 		
 		//! A method that draws all lights.
 		void DrawLights();
@@ -108,8 +112,35 @@ namespace sf
         //! A method returning a pointer to the OpenGL content manager.
         OpenGLContent* getContent();
         
+        //! A method returning the number of rendered frames.
+        unsigned int getFrameCount() const;
+        
+        //! A method checking if a shadow map of static objects, rendered in the previous frame, is still valid.
+        /*!
+         \param VP the view-projection matrix of the shadow map
+         \return true if no static object changed inside the frustum
+         */
+        bool isShadowCacheValid(const glm::mat4& VP) const;
+        
+        //! A method checking if any dynamic (moving) object is inside a frustum.
+        /*!
+         \param VP the view-projection matrix
+         \return true if at least one dynamic object is inside the frustum
+         */
+        bool hasDynamicObjects(const glm::mat4& VP) const;
+        
     private:
+        //! A structure used to track motion of objects between frames.
+        struct ObjectMotion
+        {
+            glm::mat4 model;
+            glm::vec4 sphere;
+            unsigned int staticFrames;
+            unsigned int lastFrame;
+        };
+        
         void PerformDrawingQueueCopy(SimulationManager* sim);
+        void UpdateObjectMotion();
         void DrawHelpers();
         
         RenderSettings rSettings;
@@ -124,6 +155,12 @@ namespace sf
         GLuint screenTex;
         OpenGLContent* content;
         Scalar lastSimTime;
+        unsigned int frameCount;
+        std::unordered_map<uint64_t, ObjectMotion> objectMotion; //Keyed by object id and the index of its draw in the frame
+        std::unordered_map<int, unsigned int> objectDraws; //Number of draws of each object in the current frame
+        std::vector<glm::vec4> objectSpheres; //Bounding spheres of objects in the drawing queue copy
+        std::vector<GLubyte> objectDynamic; //Flags marking moving objects in the drawing queue copy
+        std::vector<glm::vec4> dirtySpheres; //Regions where static objects changed in the current frame
     };
 }
 
@@ -29,6 +29,9 @@
 #include "graphics/OpenGLSonar.h"
 #include <random>
 
+#define SSS_VRES_FACTOR 0.2f
+#define SSS_HRES_FACTOR 100.f
+
 namespace sf
 {
     class GLSLShader;
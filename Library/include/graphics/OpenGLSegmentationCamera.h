@@ -151,6 +151,8 @@ namespace sf
         GLfloat focalLength;
         bool _needsUpdate;
         bool newData;
+        bool outputRead;
+        bool displayRead;
         glm::vec2 range;
         GLuint renderDepthTex;
         GLuint renderSegTex[2];
@@ -147,6 +147,8 @@ namespace sf
         bool settingsUpdated_;
         bool needsUpdate_;
         bool newData_;
+        bool outputRead_;
+        bool displayRead_;
         
         //OpenGL
         SonarOutputFormat outputFormat_;
@@ -72,6 +72,8 @@ namespace sf
         
         //! A method implementing rendering of shadowmaps.
         /*!
+         Static objects are rendered to a cached layer, which is only updated when the light moves or a static object changes inside its frustum.
+         The shadowmap is composed of the cached layer and the dynamic objects rendered every frame.
          \param pipe a pointer to the OpenGL pipeline
          */
         void BakeShadowmap(OpenGLPipeline* pipe);
@@ -120,6 +122,11 @@ namespace sf
         GLfloat zFar;
         glm::mat4 clipSpace;
         GLuint shadowFBO;
+        GLuint shadowCacheFBO;
+        GLint shadowLayer;
+        glm::mat4 shadowVP; //View-projection of the cached shadowmap
+        unsigned int shadowFrame; //Frame in which the shadowmap was baked (0 means never)
+        bool shadowDynamic; //Were dynamic objects drawn in the shadowmap?
     };
 }
 
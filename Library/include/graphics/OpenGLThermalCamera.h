@@ -164,6 +164,8 @@ namespace sf
         glm::vec2 fov;
         bool _needsUpdate;
         bool newData;
+        bool outputRead;
+        bool displayRead;
         glm::vec2 depthRange;
         glm::vec2 temperatureRange;
         GLfloat temperatureNoise;
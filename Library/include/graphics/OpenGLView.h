@@ -137,6 +137,14 @@ namespace sf
          */
         static void ExtractFrustumFromVP(glm::vec4 frustum[6], const glm::mat4& VP);
         
+        //! A method checking if a sphere intersects a frustum.
+        /*!
+         \param frustum a pointer to the 6 frustum planes (the plane equations may have any positive scale)
+         \param sphere the center (xyz) and radius (w) of the sphere
+         \return true if the sphere is at least partially inside the frustum
+         */
+        static bool SphereInFrustum(const glm::vec4 frustum[6], const glm::vec4& sphere);
+        
     protected:
         GLint originX;
         GLint originY;
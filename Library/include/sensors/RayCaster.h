@@ -0,0 +1,105 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RayCaster.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_RayCaster__
+#define __Stonefish_RayCaster__
+
+#include <functional>
+#include "StonefishCommon.h"
+
+#define RAYCASTER_TILE_SIZE 8 //Edge of a square tile of rays sharing culling [rays]
+
+namespace sf
+{
+    //! A structure representing the result of casting a single ray.
+    struct RayHit
+    {
+        Scalar fraction;                    //!< Fraction of the ray length at which the hit occured (1 if no hit)
+        Vector3 normal;                     //!< Normal of the hit surface in the world frame
+        const btCollisionObject* object;    //!< Pointer to the hit collision object (nullptr if no hit)
+    };
+    
+    //! A class implementing CPU ray casting against the collision geometry of the simulated world.
+    /*!
+     The world is represented by a two-level bounding volume hierarchy: a top-level tree over the world-space bounding boxes
+     of the collision objects, rebuilt on every update to follow moving bodies, and the acceleration structures of the collision
+     shapes (mesh trees, compound trees). Rays are processed in square tiles. Each tile is culled against the top-level tree once,
+     using the bounding box of all its rays, and the tiles are distributed over the physics thread pool.
+     */
+    class RayCaster
+    {
+    public:
+        //! A type of function generating a ray for a specified element of the output grid.
+        typedef std::function<void(unsigned int x, unsigned int y, Vector3& from, Vector3& to)> RayGenerator;
+        
+        //! A constructor.
+        RayCaster();
+        
+        //! A method collecting the geometry of the world that can be hit by rays.
+        /*!
+         \param center the center of the region of interest in the world frame [m]
+         \param radius the radius of the region of interest [m]
+         */
+        void Update(const Vector3& center, Scalar radius);
+        
+        //! A method casting a grid of rays.
+        /*!
+         \param width the number of columns of the grid
+         \param height the number of rows of the grid
+         \param generator a function generating the rays (called concurrently)
+         \param hits a vector filled with the results, stored row by row
+         */
+        void CastRays(unsigned int width, unsigned int height, const RayGenerator& generator, std::vector<RayHit>& hits) const;
+        
+    private:
+        struct Leaf
+        {
+            Vector3 aabbMin;
+            Vector3 aabbMax;
+            btCollisionObject* object;
+        };
+        
+        struct Node
+        {
+            Vector3 aabbMin;
+            Vector3 aabbMax;
+            int left;  //Index of the left child node (-1 for leaf nodes)
+            int right; //Index of the right child node (-1 for leaf nodes)
+            int first; //Index of the first leaf
+            int count; //Number of leaves
+        };
+        
+        int Build(int first, int count);
+        void Query(const Vector3& aabbMin, const Vector3& aabbMax, std::vector<int>& leafIds) const;
+        void CastTile(unsigned int x0, unsigned int y0, unsigned int width, unsigned int height, 
+                      const RayGenerator& generator, std::vector<RayHit>& hits) const;
+        
+        std::vector<Leaf> leaves;
+        std::vector<Node> nodes;
+        std::vector<int> unbounded;
+    };
+}
+
+#endif
@@ -126,6 +126,9 @@ namespace sf
         //! A method returning the last sample.
         Sample getLastSample() const;
         
+        //! A method returning the number of samples taken since the sensor was created.
+        uint64_t getNumOfSamples() const;
+        
         //! A method returing a pointer to a copy of the history of sensor measurements.
         const std::vector<Sample>* getHistory();
         
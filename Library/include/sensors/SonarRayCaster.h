@@ -0,0 +1,83 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SonarRayCaster.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_SonarRayCaster__
+#define __Stonefish_SonarRayCaster__
+
+#include "sensors/RayCaster.h"
+#include "graphics/OpenGLSonar.h"
+
+namespace sf
+{
+    //! A structure representing an acoustic echo received along a single ray.
+    struct SonarEcho
+    {
+        GLfloat range;      //!< Distance to the reflecting surface [m] (negative if nothing was hit)
+        GLfloat intensity;  //!< Intensity of the echo, based on the incidence angle and the material restitution
+    };
+    
+    //! A class implementing CPU ray casting of sonar beams.
+    /*!
+     The echo model follows the one used by the OpenGL sonars: the intensity is the cosine of the incidence angle,
+     scaled by the restitution of the material of the hit body.
+     */
+    class SonarRayCaster : public RayCaster
+    {
+    public:
+        //! A constructor.
+        SonarRayCaster();
+        
+        //! A method casting a grid of rays and computing the echoes.
+        /*!
+         \param origin the position of the transducer in the world frame [m]
+         \param width the number of columns of the grid
+         \param height the number of rows of the grid
+         \param generator a function generating the rays (called concurrently)
+         \param echoes a vector filled with the echoes, stored row by row
+         */
+        void CastEchoes(const Vector3& origin, unsigned int width, unsigned int height, const RayGenerator& generator, std::vector<SonarEcho>& echoes);
+        
+        //! A static method returning the size of a single sample of sonar data.
+        /*!
+         \param format the format of the sonar data
+         \return size of the sample [B]
+         */
+        static size_t getSampleSize(SonarOutputFormat format);
+        
+        //! A static method storing a normalized sample in the sonar data buffer (same conversion as the OpenGL textures).
+        /*!
+         \param data a pointer to the sonar data buffer
+         \param index the index of the sample
+         \param value the value of the sample in range [0,1]
+         \param format the format of the sonar data
+         */
+        static void StoreSample(void* data, size_t index, GLfloat value, SonarOutputFormat format);
+        
+    private:
+        std::vector<RayHit> hits;
+    };
+}
+
+#endif
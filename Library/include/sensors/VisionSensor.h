@@ -26,6 +26,7 @@
 #ifndef __Stonefish_VisionSensor__
 #define __Stonefish_VisionSensor__
 
+#include <atomic>
 #include "sensors/Sensor.h"
 
 namespace sf
@@ -34,6 +35,9 @@ namespace sf
     enum class VisionSensorType {COLOR_CAMERA, DEPTH_CAMERA, THERMAL_CAMERA, EVENT_BASED_CAMERA, 
                                     OPTICAL_FLOW_CAMERA, SEGMENTATION_CAMERA, MULTIBEAM2, FLS, SSS, MSIS};
     
+    //! An enum defining output channels of vision sensors (raw measurement and colour-mapped display image).
+    enum class VisionOutput {RAW, DISPLAY};
+    
     class Entity;
     class StaticEntity;
     class MovingEntity;
@@ -87,6 +91,32 @@ namespace sf
          \param origin a tranformation from the body frame to the sensor frame
          */
         void setRelativeSensorFrame(const Transform& origin);
+        
+        //! A method registering a consumer of one of the sensor outputs.
+        /*!
+         \param output the output channel to subscribe to
+         */
+        void SubscribeOutput(VisionOutput output);
+        
+        //! A method unregistering a consumer of one of the sensor outputs.
+        /*!
+         \param output the output channel to unsubscribe from
+         */
+        void UnsubscribeOutput(VisionOutput output);
+        
+        //! A method informing if an output channel has any consumers.
+        /*!
+         \param output the output channel
+         \return true if at least one consumer subscribed to the output
+         */
+        bool isOutputSubscribed(VisionOutput output) const;
+        
+        //! A method informing if an output channel has to be generated by the rendering pipeline.
+        /*!
+         \param output the output channel
+         \return true if the output is needed by a consumer or for display
+         */
+        virtual bool isOutputRequired(VisionOutput output) const;
 
         //! A method returning the type of the sensor.
         SensorType getType() const override;
@@ -110,9 +140,26 @@ namespace sf
     protected:
         virtual void InitGraphics(bool& seesParticles) = 0;
         
+        //! A method used to initialize a sensor in a console simulation.
+        /*!
+         \return true if the sensor supports running without graphics
+         */
+        virtual bool InitHeadless();
+        
+        //! A method updating the output subscriptions held by the new data callback.
+        /*!
+         \param installed a flag informing if a callback is installed
+         \param display a flag informing if the callback also consumes the display image
+         */
+        void SubscribeCallbackOutputs(bool installed, bool display);
+        
     private:
+        bool Init();
+        
         Entity* attach;
         Transform o2s;
+        std::atomic<unsigned int> subscribers[2];
+        bool callbackOutputs[2];
     };
 }
 
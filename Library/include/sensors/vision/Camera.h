@@ -86,6 +86,13 @@ namespace sf
          */
         bool getDisplayOnScreen(unsigned int& x, unsigned int& y, float& scale) const;
         
+        //! A method informing if an output channel has to be generated by the rendering pipeline.
+        /*!
+         \param output the output channel
+         \return true if the output is subscribed or the display image is shown on screen
+         */
+        bool isOutputRequired(VisionOutput output) const override;
+        
         //! A method returning the horizontal field of view of the camera [deg].
         Scalar getHorizontalFOV() const;
         
@@ -28,6 +28,7 @@
 
 #include <functional>
 #include "sensors/vision/Camera.h"
+#include "sensors/RayCaster.h"
 #include "graphics/OpenGLDataStructs.h"
 
 namespace sf
@@ -35,6 +36,9 @@ namespace sf
     class OpenGLDepthCamera;
     
     //! A class representing a depth camera.
+    /*!
+     In console simulations the depth image is computed on the CPU, by casting rays against the collision geometry of the world.
+     */
     class DepthCamera : public Camera
     {
     public:
@@ -104,8 +108,13 @@ namespace sf
         
     private:
         void InitGraphics(bool& seesParticles);
+        bool InitHeadless();
+        void RayTrace();
         
         OpenGLDepthCamera* glCamera;
+        RayCaster* rayCaster;
+        std::vector<RayHit> rayHits;
+        std::vector<GLfloat> rayDepth;
         GLfloat* imageData;
         glm::vec2 depthRange;
         GLfloat noiseStdDev;
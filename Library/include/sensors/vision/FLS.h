@@ -28,6 +28,7 @@
 
 #include <functional>
 #include "sensors/vision/Camera.h"
+#include "sensors/SonarRayCaster.h"
 #include "graphics/OpenGLSonar.h"
 
 namespace sf
@@ -35,6 +36,10 @@ namespace sf
     class OpenGLFLS;
     
     //! A class representing a forward looking sonar.
+    /*!
+     In console simulations the sonar data is computed on the CPU, by casting the beams against the collision geometry of the world.
+     The display image is not generated in this case.
+     */
     class FLS : public Camera
     {
     public:
@@ -80,8 +85,9 @@ namespace sf
         //! A method used to set a callback function called when new data is available.
         /*!
          \param callback a function to be called
+         \param display a flag deciding if the display image is also generated and downloaded for the callback
          */
-        void InstallNewDataHandler(std::function<void(FLS*)> callback);
+        void InstallNewDataHandler(std::function<void(FLS*)> callback, bool display = true);
         
         //! A method implementing the rendering of the sonar dummy.
         std::vector<Renderable> Render();
@@ -137,7 +143,7 @@ namespace sf
          */
         void getDisplayResolution(unsigned int& x, unsigned int& y) const;
         
-        //! A method returning a pointer to the visualisation image data.
+        //! A method returning a pointer to the visualisation image data (updated only when the display output is subscribed, by default together with the new data callback).
         GLubyte* getDisplayDataPointer();
         
         //! A method returning the type of the vision sensor.
@@ -148,8 +154,14 @@ namespace sf
         
     private:
         void InitGraphics(bool& seesParticles);
+        bool InitHeadless();
+        void RayTrace();
         
         OpenGLFLS* glFLS;
+        SonarRayCaster* rayCaster;
+        std::vector<SonarEcho> echoes;
+        std::vector<GLfloat> beamData;
+        std::vector<GLubyte> outputData;
         void* sonarData;
         GLubyte* displayData;
         glm::vec2 range;
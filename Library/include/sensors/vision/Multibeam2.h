@@ -28,6 +28,7 @@
 
 #include <functional>
 #include "sensors/vision/Camera.h"
+#include "sensors/RayCaster.h"
 #include "graphics/OpenGLDataStructs.h"
 
 #define MULTIBEAM_MAX_SINGLE_FOV 30.0
@@ -46,6 +47,9 @@ namespace sf
     };
     
     //! A class representing a multibeam sonar (simulated with a number of depth cameras).
+    /*!
+     In console simulations the ranges are computed on the CPU, by casting rays against the collision geometry of the world.
+     */
     class Multibeam2 : public Camera
     {
     public:
@@ -131,8 +135,14 @@ namespace sf
         
     private:
         void InitGraphics(bool& seesParticles);
+        bool InitHeadless();
+        void SetupCameras();
+        void RayTrace();
         
         std::vector<CamData> cameras;
+        RayCaster* rayCaster;
+        std::vector<RayHit> rayHits;
+        std::vector<GLfloat> rayRange;
         GLfloat* imageData;
         GLfloat* rangeData;
         Scalar fovV;
@@ -77,8 +77,9 @@ namespace sf
         //! A method used to set a callback function called when new data is available.
         /*!
          \param callback a function to be called
+         \param display a flag deciding if the display image is also generated and downloaded for the callback
          */
-        void InstallNewDataHandler(std::function<void(SegmentationCamera*)> callback);
+        void InstallNewDataHandler(std::function<void(SegmentationCamera*)> callback, bool display = true);
 
         //! A method returning the pointer to the image data.
         /*!
@@ -87,7 +88,7 @@ namespace sf
          */
         void* getImageDataPointer(unsigned int index = 0);
 
-        //! A method returning a pointer to the visualisation image data.
+        //! A method returning a pointer to the visualisation image data (updated only when the display output is subscribed, by default together with the new data callback).
         GLubyte* getDisplayDataPointer();
         
         //! A method returning the type of the vision sensor.
@@ -0,0 +1,76 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  ConvexHullUtil.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_ConvexHullUtil__
+#define __Stonefish_ConvexHullUtil__
+
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    struct Mesh;
+
+    //! A structure holding the settings of the approximate convex decomposition.
+    struct ConvexDecompositionSettings
+    {
+        unsigned int resolution; //Number of voxels along the longest side of the mesh bounding box
+        Scalar concavity; //Maximum concavity of a part, as a fraction of the mesh volume
+        unsigned int maxParts; //Maximum number of convex parts
+        Scalar hullTolerance; //Tolerance used to reduce the vertices of the parts (zero keeps all vertices of the hulls) [m]
+
+        ConvexDecompositionSettings() : resolution(48), concavity(Scalar(0.01)), maxParts(32), hullTolerance(Scalar(0)) {}
+    };
+
+    //! A function computing the vertices of a convex hull, reduced with a bounded error.
+    /*!
+     The vertices are added greedily, starting from a tetrahedron spanned by extreme points, always choosing the point furthest
+     from the current hull, until every point lies within the tolerance from the hull. The reduced hull is contained in the full one.
+     \param points a set of points
+     \param tolerance the maximum distance of any point from the reduced hull (zero keeps all vertices of the hull) [m]
+     \param maxVertices the maximum number of vertices of the reduced hull (zero means no limit)
+     \return the vertices of the reduced hull
+     */
+    std::vector<Vector3> ReduceConvexHull(const std::vector<Vector3>& points, Scalar tolerance, unsigned int maxVertices = 0);
+
+    //! A function computing the volume of the convex hull of a set of points.
+    /*!
+     \param points a set of points
+     \return the volume of the convex hull [m^3]
+     */
+    Scalar ConvexHullVolume(const std::vector<Vector3>& points);
+
+    //! A function computing an approximate convex decomposition of a closed triangle mesh.
+    /*!
+     The mesh is voxelized and the voxels are recursively split with axis-aligned planes, minimising the volume of the convex hulls
+     of the parts, until the concavity of each part is below the threshold or the maximum number of parts is reached. The hulls of the parts
+     are built from the mesh triangles clipped to the part bounds. The result is cached on disk, keyed by the mesh geometry and the settings.
+     \param mesh a pointer to the mesh
+     \param settings the settings of the decomposition
+     \return a list of the vertices of the convex parts
+     */
+    std::vector<std::vector<Vector3>> DecomposeConvex(const Mesh* mesh, const ConvexDecompositionSettings& settings);
+}
+
+#endif
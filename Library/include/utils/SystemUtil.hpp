@@ -144,6 +144,23 @@ inline std::string GetDataPath()
     return SimulationApp::getApp()->getDataPath();
 }
 
+inline std::string GetCachePath()
+{
+#if defined(_WIN32)
+    const char* base = getenv("LOCALAPPDATA");
+    return base != NULL ? std::string(base) + "\\stonefish\\" : "";
+#elif defined(__APPLE__)
+    const char* home = getenv("HOME");
+    return home != NULL ? std::string(home) + "/Library/Caches/stonefish/" : "";
+#else
+    const char* xdg = getenv("XDG_CACHE_HOME");
+    if(xdg != NULL && xdg[0] != '\0')
+        return std::string(xdg) + "/stonefish/";
+    const char* home = getenv("HOME");
+    return home != NULL ? std::string(home) + "/.cache/stonefish/" : "";
+#endif
+}
+
 inline const char* GetDataPathPrefix(const char* directory)
 {
     static char dataPathPrefix[PATH_MAX];
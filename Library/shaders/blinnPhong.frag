@@ -20,14 +20,13 @@
 #version 330
 
 //Blinn-Phong model
-uniform float shininess;
-uniform float specularStrength;
+#inject "materialDef.glsl"
 
 vec3 ShadingModel(vec3 N, vec3 V, vec3 L, vec3 Lcolor, vec3 albedo)
 {
 	vec3 H = normalize(V+L);
 	float diffuse = max(dot(N, L), 0.0);
-	float specular = pow(max(dot(N, H), 0.0), shininess) * specularStrength;
+	float specular = pow(max(dot(N, H), 0.0), shadingParams.y) * shadingParams.x;
     
 	return Lcolor * (diffuse * albedo + specular);
 }
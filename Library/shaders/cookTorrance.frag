@@ -20,8 +20,7 @@
 #version 330
 
 //Cook-Torrance model
-uniform float metallic;
-uniform float roughness;
+#inject "materialDef.glsl"
 const float PI = 3.14159265359;
 
 //Schlick's approximation to Fresnel function (assuming wavelength dependent IOR)
@@ -69,6 +68,8 @@ float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness)
 vec3 ShadingModel(vec3 N, vec3 V, vec3 L, vec3 Lcolor, vec3 albedo)
 {
     vec3 H = normalize(V+L); //Half-way vector (bisection vector)
+	float roughness = shadingParams.x;
+	float metallic = shadingParams.y;
 	vec3 F0 = vec3(0.04); 
     F0 = mix(F0, albedo, metallic);
 	
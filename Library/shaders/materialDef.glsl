@@ -0,0 +1,10 @@
+layout (std140) uniform Material
+{
+    vec4 color;
+    vec2 shadingParams; //Blinn-Phong: specular strength, shininess; Cook-Torrance: roughness, metallic
+    vec2 temperatureRange;
+    float reflectivity;
+    bool enableAlbedoTex;
+    bool enableNormalTex;
+    bool enableTemperatureTex;
+};
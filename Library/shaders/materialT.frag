@@ -29,10 +29,8 @@ layout(location = 0) out float fragColor;
 uniform vec3 eyePos;
 uniform vec3 viewDir;
 uniform float FC;
-uniform vec4 color;
-uniform float reflectivity;
-uniform float temperature;
 
+#inject "materialDef.glsl"
 #inject "lightingDef.glsl"
 
 //---------------Functions-------------------
@@ -58,7 +56,7 @@ void main()
 	vec3 posSky = vec3(P.xy/atmLengthUnitInMeters, clamp(P.z/atmLengthUnitInMeters, -100000.0/atmLengthUnitInMeters, -0.5/atmLengthUnitInMeters));
 	vec3 skyIlluminance;
     vec3 sunIlluminance = GetSunAndSkyIlluminance(posSky - center, N, sunDirection, skyIlluminance);
-    fragColor = temperature + length(absorption.rgb * skyIlluminance / whitePoint) * 0.0001;
+    fragColor = temperatureRange.x + length(absorption.rgb * skyIlluminance / whitePoint) * 0.0001;
 	
 	//Sun
 	fragColor += length(SunContribution(P, N, toEye, absorption.rgb, sunIlluminance) / whitePoint) * 0.0001;
@@ -31,16 +31,11 @@ layout(location = 0) out float fragColor;
 uniform vec3 eyePos;
 uniform vec3 viewDir;
 uniform float FC;
-uniform vec4 color;
-uniform float reflectivity;
 uniform sampler2D texAlbedo;
 uniform sampler2D texNormal;
 uniform sampler2D texTemperature;
-uniform bool enableAlbedoTex;
-uniform bool enableNormalTex;
-uniform bool enableTemperatureTex;
-uniform vec2 temperatureRange;
 
+#inject "materialDef.glsl"
 #inject "lightingDef.glsl"
 
 //---------------Functions-------------------
@@ -32,13 +32,10 @@ layout(location = 1) out vec4 fragNormal;
 uniform vec3 eyePos;
 uniform vec3 viewDir;
 uniform float FC;
-uniform vec4 color;
-uniform float reflectivity;
 uniform sampler2D texAlbedo;
 uniform sampler2D texNormal;
-uniform bool enableAlbedoTex;
-uniform bool enableNormalTex;
 
+#inject "materialDef.glsl"
 #inject "lightingDef.glsl"
 
 const vec3 waterSurfaceN = vec3(0.0, 0.0, -1.0);
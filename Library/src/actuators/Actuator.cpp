@@ -81,6 +81,16 @@ void Actuator::WatchdogTimeout()
 {
 }
 
+void Actuator::getCommandState(std::vector<Scalar>& state) const
+{
+    state.push_back(watchdog);
+}
+
+void Actuator::setCommandState(const Scalar* state)
+{
+    watchdog = state[0];
+}
+
 void Actuator::ResetWatchdog()
 {
     watchdog = Scalar(0);
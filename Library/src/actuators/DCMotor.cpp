@@ -81,6 +81,18 @@ Scalar DCMotor::getVoltage() const
     return V;
 }
 
+void DCMotor::getCommandState(std::vector<Scalar>& state) const
+{
+    Motor::getCommandState(state);
+    state.push_back(V);
+}
+
+void DCMotor::setCommandState(const Scalar* state)
+{
+    Motor::setCommandState(state);
+    V = state[2];
+}
+
 Scalar DCMotor::getTorque() const
 {
     return torque;
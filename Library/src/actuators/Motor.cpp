@@ -42,6 +42,18 @@ ActuatorType Motor::getType() const
     return ActuatorType::MOTOR;
 }
 
+void Motor::getCommandState(std::vector<Scalar>& state) const
+{
+    Actuator::getCommandState(state);
+    state.push_back(torque);
+}
+
+void Motor::setCommandState(const Scalar* state)
+{
+    Actuator::setCommandState(state);
+    torque = state[1];
+}
+
 void Motor::setTorqueLimits(Scalar lower, Scalar upper)
 {
     limits.first = lower;
@@ -27,6 +27,7 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -43,6 +44,18 @@ ActuatorType Push::getType() const
     return ActuatorType::PUSH;
 }
 
+void Push::getCommandState(std::vector<Scalar>& state) const
+{
+    Actuator::getCommandState(state);
+    state.push_back(setpoint);
+}
+
+void Push::setCommandState(const Scalar* state)
+{
+    Actuator::setCommandState(state);
+    setpoint = state[1];
+}
+
 void Push::setForceLimits(Scalar lower, Scalar upper)
 {
     limits.first = lower;
@@ -91,14 +104,17 @@ std::vector<Renderable> Push::Render()
     
     //Add renderable
     std::vector<Renderable> items(0);
-    Renderable item;
-    item.model = glMatrixFromTransform(pushTrans);  
-    item.type = RenderableType::ACTUATOR_LINES;
-    item.data = std::make_shared<std::vector<glm::vec3>>();
-    auto points = item.getDataAsPoints();
-    points->push_back(glm::vec3(0,0,0));
-    points->push_back(glm::vec3(0.1f*(inv ? -setpoint : setpoint),0,0));
-    items.push_back(item);
+    if(OpenGLHelperArena::isEnabled(RenderableType::ACTUATOR_LINES))
+    {
+        Renderable item;
+        item.model = glMatrixFromTransform(pushTrans);  
+        item.type = RenderableType::ACTUATOR_LINES;
+        auto& points = OpenGLHelperArena::Begin();
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(0.1f*(inv ? -setpoint : setpoint),0,0));
+        item.data = OpenGLHelperArena::Commit();
+        items.push_back(item);
+    }
     
     return items;
 }
@@ -29,6 +29,7 @@
 #include "core/SimulationManager.h"
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLHelperArena.h"
 #include "entities/SolidEntity.h"
 
 namespace sf
@@ -62,6 +63,18 @@ ActuatorType Rudder::getType() const
     return ActuatorType::RUDDER;
 }
 
+void Rudder::getCommandState(std::vector<Scalar>& state) const
+{
+    Actuator::getCommandState(state);
+    state.push_back(setpoint);
+}
+
+void Rudder::setCommandState(const Scalar* state)
+{
+    Actuator::setCommandState(state);
+    setpoint = state[1];
+}
+
 void Rudder::setSetpoint(Scalar s)
 {
     if(inv) s *= Scalar(-1);
@@ -193,13 +206,16 @@ std::vector<Renderable> Rudder::Render()
 	item.model = glMatrixFromTransform(rudderTrans);
     items.push_back(item);
     
-    item.type = RenderableType::ACTUATOR_LINES;
-    item.data = std::make_shared<std::vector<glm::vec3>>();
-    auto points = item.getDataAsPoints();
-    points->push_back(glm::vec3(0,0,0));
-    Vector3 VG = .1*(rudder->getO2GTransform().inverse().getBasis()*(liftV + dragV));
-    points->push_back(glm::vec3(VG.getX(),VG.getY(),VG.getZ()));
-    items.push_back(item);
+    if(OpenGLHelperArena::isEnabled(RenderableType::ACTUATOR_LINES))
+    {
+        item.type = RenderableType::ACTUATOR_LINES;
+        auto& points = OpenGLHelperArena::Begin();
+        points.push_back(glm::vec3(0,0,0));
+        Vector3 VG = .1*(rudder->getO2GTransform().inverse().getBasis()*(liftV + dragV));
+        points.push_back(glm::vec3(VG.getX(),VG.getY(),VG.getZ()));
+        item.data = OpenGLHelperArena::Commit();
+        items.push_back(item);
+    }
     
     return items;
 }
@@ -49,6 +49,22 @@ ActuatorType Servo::getType() const
     return ActuatorType::SERVO;
 }    
 
+void Servo::getCommandState(std::vector<Scalar>& state) const
+{
+    Actuator::getCommandState(state);
+    state.push_back(Scalar((int)mode));
+    state.push_back(pSetpoint);
+    state.push_back(vSetpoint);
+}
+
+void Servo::setCommandState(const Scalar* state)
+{
+    Actuator::setCommandState(state);
+    mode = (ServoControlMode)(int)state[1];
+    pSetpoint = state[2];
+    vSetpoint = state[3];
+}
+
 void Servo::setControlMode(ServoControlMode m)
 {
     mode = m;
@@ -29,6 +29,7 @@
 #include "core/SimulationManager.h"
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLHelperArena.h"
 #include "entities/SolidEntity.h"
 
 namespace sf
@@ -52,6 +53,20 @@ ActuatorType SimpleThruster::getType() const
     return ActuatorType::SIMPLE_THRUSTER;
 }
 
+void SimpleThruster::getCommandState(std::vector<Scalar>& state) const
+{
+    Actuator::getCommandState(state);
+    state.push_back(sThrust);
+    state.push_back(sTorque);
+}
+
+void SimpleThruster::setCommandState(const Scalar* state)
+{
+    Actuator::setCommandState(state);
+    sThrust = state[1];
+    sTorque = state[2];
+}
+
 void SimpleThruster::setSetpoint(Scalar _thrust, Scalar _torque)
 {
     if(limits.second > limits.first) // Limitted
@@ -158,12 +173,15 @@ std::vector<Renderable> SimpleThruster::Render()
 	item.model = glMatrixFromTransform(thrustTrans);
     items.push_back(item);
     
-    item.type = RenderableType::ACTUATOR_LINES;
-    item.data = std::make_shared<std::vector<glm::vec3>>();
-    auto points = item.getDataAsPoints();
-    points->push_back(glm::vec3(0,0,0));
-    points->push_back(glm::vec3(0.1f*thrust,0,0));
-    items.push_back(item);
+    if(OpenGLHelperArena::isEnabled(RenderableType::ACTUATOR_LINES))
+    {
+        item.type = RenderableType::ACTUATOR_LINES;
+        auto& points = OpenGLHelperArena::Begin();
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(0.1f*thrust,0,0));
+        item.data = OpenGLHelperArena::Commit();
+        items.push_back(item);
+    }
     
     return items;
 }
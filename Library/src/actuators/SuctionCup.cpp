@@ -50,6 +50,18 @@ ActuatorType SuctionCup::getType() const
     return ActuatorType::SUCTION_CUP;
 }
 
+void SuctionCup::getCommandState(std::vector<Scalar>& state) const
+{
+    Actuator::getCommandState(state);
+    state.push_back(Scalar(pump));
+}
+
+void SuctionCup::setCommandState(const Scalar* state)
+{
+    Actuator::setCommandState(state);
+    pump = state[1] > Scalar(0.5);
+}
+
 void SuctionCup::setPump(bool enabled)
 {
     pump = enabled;
@@ -80,11 +92,10 @@ void SuctionCup::Engage(SimulationManager* sm)
 {
     if(attach != nullptr && joint == nullptr && pump)
     {
-        btDispatcher* dispatcher = sm->getDynamicsWorld()->getDispatcher();
-        int numManifolds = dispatcher->getNumManifolds();
-        for(int i=0; i<numManifolds; ++i)
+        const std::vector<btPersistentManifold*>& manifolds = sm->getContactManifolds(attach);
+        for(size_t i=0; i<manifolds.size(); ++i)
         {
-            btPersistentManifold* contactManifold = dispatcher->getManifoldByIndexInternal(i);
+            btPersistentManifold* contactManifold = manifolds[i];
             if(contactManifold->getNumContacts() == 0)
                 continue;
 
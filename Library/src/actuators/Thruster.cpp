@@ -30,6 +30,7 @@
 #include "core/SimulationManager.h"
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLHelperArena.h"
 #include "entities/SolidEntity.h"
 
 namespace sf
@@ -55,6 +56,18 @@ ActuatorType Thruster::getType() const
     return ActuatorType::THRUSTER;
 }
 
+void Thruster::getCommandState(std::vector<Scalar>& state) const
+{
+    Actuator::getCommandState(state);
+    state.push_back(setpoint);
+}
+
+void Thruster::setCommandState(const Scalar* state)
+{
+    Actuator::setCommandState(state);
+    setpoint = state[1];
+}
+
 void Thruster::setSetpoint(Scalar s)
 {
     if (normalized)
@@ -182,12 +195,15 @@ std::vector<Renderable> Thruster::Render()
     item.model = glMatrixFromTransform(thrustTrans);
     items.push_back(item);
 
-    item.type = RenderableType::ACTUATOR_LINES;
-    item.data = std::make_shared<std::vector<glm::vec3>>();
-    auto points = item.getDataAsPoints();
-    points->push_back(glm::vec3(0, 0, 0));
-    points->push_back(glm::vec3(0.1f * thrust, 0, 0));
-    items.push_back(item);
+    if (OpenGLHelperArena::isEnabled(RenderableType::ACTUATOR_LINES))
+    {
+        item.type = RenderableType::ACTUATOR_LINES;
+        auto& points = OpenGLHelperArena::Begin();
+        points.push_back(glm::vec3(0, 0, 0));
+        points.push_back(glm::vec3(0.1f * thrust, 0, 0));
+        item.data = OpenGLHelperArena::Commit();
+        items.push_back(item);
+    }
 
     return items;
 }
@@ -27,6 +27,7 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "graphics/OpenGLHelperArena.h"
 #include <algorithm>
 
 namespace sf 
@@ -71,6 +72,18 @@ ActuatorType VariableBuoyancy::getType() const
 {
     return ActuatorType::VBS;
 }
+
+void VariableBuoyancy::getCommandState(std::vector<Scalar>& state) const
+{
+    Actuator::getCommandState(state);
+    state.push_back(flowRate);
+}
+
+void VariableBuoyancy::setCommandState(const Scalar* state)
+{
+    Actuator::setCommandState(state);
+    flowRate = state[1];
+}
         
 void VariableBuoyancy::setFlowRate(Scalar rate)
 {
@@ -152,14 +165,17 @@ std::vector<Renderable> VariableBuoyancy::Render()
     
     //Add renderable
     std::vector<Renderable> items(0);
-    Renderable item;
-    item.type = RenderableType::ACTUATOR_LINES;
-    item.model = glMatrixFromTransform(vbsTrans);
-    item.data = std::make_shared<std::vector<glm::vec3>>();
-    auto points = item.getDataAsPoints();
-    points->push_back(glm::vec3(0,0,0));
-    points->push_back(0.1f * glm::vec3((GLfloat)force.x(), (GLfloat)force.y(), (GLfloat)force.z()));
-    items.push_back(item);
+    if(OpenGLHelperArena::isEnabled(RenderableType::ACTUATOR_LINES))
+    {
+        Renderable item;
+        item.type = RenderableType::ACTUATOR_LINES;
+        item.model = glMatrixFromTransform(vbsTrans);
+        auto& points = OpenGLHelperArena::Begin();
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(0.1f * glm::vec3((GLfloat)force.x(), (GLfloat)force.y(), (GLfloat)force.z()));
+        item.data = OpenGLHelperArena::Commit();
+        items.push_back(item);
+    }
     
     return items;
 }
@@ -30,6 +30,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "graphics/OpenGLPipeline.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -124,6 +125,7 @@ AcousticModem::AcousticModem(std::string uniqueName, uint64_t deviceId, Scalar m
     position = V0();
     frame = std::string("");
     occlusion = true;
+    byteErrorRate = Scalar(0);
     addNode(this);
 }
 
@@ -156,6 +158,27 @@ bool AcousticModem::getOcclusionTest() const
     return occlusion;
 }
 
+void AcousticModem::setByteErrorRate(Scalar rate)
+{
+    byteErrorRate = btClamped(rate, Scalar(0), Scalar(1));
+}
+
+Scalar AcousticModem::getByteErrorRate() const
+{
+    return byteErrorRate;
+}
+
+ChannelModel& AcousticModem::getChannelModel()
+{
+    return channel;
+}
+
+void AcousticModem::MessageReceived(std::shared_ptr<CommDataFrame> message)
+{
+    channel.ApplyErrors(message->data, message->source, getDeviceId(), byteErrorRate);
+    Comm::MessageReceived(message);
+}
+
 void AcousticModem::getPosition(Vector3& pos, std::string& referenceFrame)
 {
     pos = position;
@@ -294,13 +317,14 @@ void AcousticModem::UpdatePosition(Vector3 pos, bool absolute, std::string refer
 std::vector<Renderable> AcousticModem::Render()
 {
     std::vector<Renderable> items(0);
+    if(!OpenGLHelperArena::isEnabled(RenderableType::SENSOR_LINES))
+        return items;
     
     //Fov indicator
     Renderable item1;
     item1.model = glMatrixFromTransform(getDeviceFrame());
     item1.type = RenderableType::SENSOR_LINES;
-    item1.data = std::make_shared<std::vector<glm::vec3>>();
-    auto points = item1.getDataAsPoints();
+    auto& points = OpenGLHelperArena::Begin();
 
     GLfloat iconSize = 0.25f;
     int div = 24;
@@ -312,9 +336,9 @@ std::vector<Renderable> AcousticModem::Render()
         for(int i=0; i<=div; ++i)
         {
             GLfloat angle = (GLfloat)i/(GLfloat)div * 2.f * M_PI;
-            points->push_back(glm::vec3(glm::cos(angle)*r, glm::sin(angle)*r, -h));
+            points.push_back(glm::vec3(glm::cos(angle)*r, glm::sin(angle)*r, -h));
             if(i > 0 && i < div)
-                points->push_back(points->back());
+                points.push_back(points.back());
         }
     }
     //Lower circle
@@ -325,9 +349,9 @@ std::vector<Renderable> AcousticModem::Render()
         for(int i=0; i<=div; ++i)
         {
             GLfloat angle = (GLfloat)i/(GLfloat)div * 2.f * M_PI;
-            points->push_back(glm::vec3(glm::cos(angle)*r, glm::sin(angle)*r, -h));
+            points.push_back(glm::vec3(glm::cos(angle)*r, glm::sin(angle)*r, -h));
             if(i > 0 && i < div)
-                points->push_back(points->back());
+                points.push_back(points.back());
         }
     }
     //4 bars
@@ -342,23 +366,24 @@ std::vector<Renderable> AcousticModem::Render()
             for(int h=0; h<=div; ++h)
             {
                 GLfloat angle = (GLfloat)h/(GLfloat)div * (maxFov2-minFov2) + minFov2;
-                points->push_back(glm::vec3(glm::sin(angle)*x, glm::sin(angle)*y, -glm::cos(angle)*iconSize));
+                points.push_back(glm::vec3(glm::sin(angle)*x, glm::sin(angle)*y, -glm::cos(angle)*iconSize));
                 if(h == 0 && minFov2 > Scalar(0))
                 {
-                    glm::vec3 v = points->back();
-                    points->push_back(glm::vec3(0.f,0.f,0.f));
-                    points->push_back(v);
+                    glm::vec3 v = points.back();
+                    points.push_back(glm::vec3(0.f,0.f,0.f));
+                    points.push_back(v);
                 }
                 else if(h == div && maxFov2 < Scalar(M_PI))
                 {
-                    points->push_back(points->back());
-                    points->push_back(glm::vec3(0.f,0.f,0.f));
+                    points.push_back(points.back());
+                    points.push_back(glm::vec3(0.f,0.f,0.f));
                 }
                 else if(h > 0 && h < div)
-                    points->push_back(points->back());
+                    points.push_back(points.back());
             }
         }
     }
+    item1.data = OpenGLHelperArena::Commit();
     items.push_back(item1);
 
     //Axes
@@ -370,8 +395,7 @@ std::vector<Renderable> AcousticModem::Render()
     Renderable item3;
     item3.type = RenderableType::SENSOR_LINES;
     item3.model = glm::mat4(1.f);
-    item3.data = std::make_shared<std::vector<glm::vec3>>();
-    points = item3.getDataAsPoints();
+    auto& lines = OpenGLHelperArena::Begin();
 
     if(getConnectedId() == 0)
     {
@@ -380,8 +404,8 @@ std::vector<Renderable> AcousticModem::Render()
             if(nodeIds[i] != getDeviceId())
             {               
                 Transform Tn = getNode(nodeIds[i])->getDeviceFrame();
-                points->push_back(glVectorFromVector(getDeviceFrame().getOrigin()));
-                points->push_back(glVectorFromVector(Tn.getOrigin()));
+                lines.push_back(glVectorFromVector(getDeviceFrame().getOrigin()));
+                lines.push_back(glVectorFromVector(Tn.getOrigin()));
             }
     }
     else if(getConnectedId() > 0)
@@ -389,25 +413,28 @@ std::vector<Renderable> AcousticModem::Render()
         AcousticModem* cNode = getNode(getConnectedId());
         if(cNode != nullptr)
         {
-            points->push_back(glVectorFromVector(getDeviceFrame().getOrigin()));
-            points->push_back(glVectorFromVector(cNode->getDeviceFrame().getOrigin()));    
+            lines.push_back(glVectorFromVector(getDeviceFrame().getOrigin()));
+            lines.push_back(glVectorFromVector(cNode->getDeviceFrame().getOrigin()));    
         }
     }
-    if(!points->empty())
+    if(!lines.empty())
+    {
+        item3.data = OpenGLHelperArena::Commit();
         items.push_back(item3);
+    }
 
 #ifdef DEBUG
     Renderable item4;
     item4.type = RenderableType::SENSOR_POINTS;
     item4.model = glm::mat4(1.f);
-    item4.data = std::make_shared<std::vector<glm::vec3>>();
-    points = item4.getDataAsPoints();
+    auto& msgs = OpenGLHelperArena::Begin();
 
     for( auto mIt = propagating.begin(); mIt != propagating.end(); ++mIt)
     {
         Vector3 mPos = mIt->second;
-        points->push_back(glm::vec3((GLfloat)mPos.getX(), (GLfloat)mPos.getY(), (GLfloat)mPos.getZ()));
+        msgs.push_back(glm::vec3((GLfloat)mPos.getX(), (GLfloat)mPos.getY(), (GLfloat)mPos.getZ()));
     }
+    item4.data = OpenGLHelperArena::Commit();
     items.push_back(item4);
 #endif
 
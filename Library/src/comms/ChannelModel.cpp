@@ -0,0 +1,149 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  ChannelModel.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "comms/ChannelModel.h"
+
+#include <cmath>
+
+namespace sf
+{
+
+//SplitMix64 finalizer, decorrelates the seeds of the link streams
+static inline uint64_t MixSeed(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+ChannelModel::ChannelModel(uint64_t seed) : seed(seed), model(ChannelErrorModel::INDEPENDENT),
+    goodLength(Scalar(1)), burstLength(Scalar(1)), burstErrorRate(Scalar(0))
+{
+}
+
+void ChannelModel::setSeed(uint64_t s)
+{
+    seed = s;
+    Reset();
+}
+
+void ChannelModel::setIndependentErrors()
+{
+    model = ChannelErrorModel::INDEPENDENT;
+    Reset();
+}
+
+void ChannelModel::setBurstErrors(Scalar good, Scalar burst, Scalar rate)
+{
+    model = ChannelErrorModel::BURST;
+    goodLength = good < Scalar(1) ? Scalar(1) : good;
+    burstLength = burst < Scalar(1) ? Scalar(1) : burst;
+    burstErrorRate = btClamped(rate, Scalar(0), Scalar(1));
+    Reset();
+}
+
+void ChannelModel::Reset()
+{
+    links.clear();
+}
+
+ChannelErrorModel ChannelModel::getErrorModel() const
+{
+    return model;
+}
+
+uint64_t ChannelModel::getSeed() const
+{
+    return seed;
+}
+
+ChannelModel::Link& ChannelModel::getLink(uint64_t source, uint64_t destination)
+{
+    std::pair<uint64_t, uint64_t> key(source, destination);
+    auto it = links.find(key);
+    if(it == links.end())
+    {
+        it = links.emplace(key, Link()).first;
+        it->second.rng.seed(MixSeed(seed ^ MixSeed(source ^ MixSeed(destination))));
+        it->second.burst = true; //Switches to the good state on first use
+        it->second.remaining = 0;
+    }
+    return it->second;
+}
+
+uint64_t ChannelModel::SampleSkip(std::mt19937_64& rng, double p)
+{
+    //Number of correct bytes before the next error (geometric distribution, inversion method)
+    if(p >= 1.0)
+        return 0;
+    if(p <= 0.0)
+        return UINT64_MAX;
+    double u = (double)((rng() >> 11) + 1) * (1.0/9007199254740992.0); //(0,1]
+    double k = std::floor(std::log(u)/std::log1p(-p));
+    return k < 1.8e19 ? (uint64_t)k : UINT64_MAX;
+}
+
+size_t ChannelModel::CorruptRange(std::vector<uint8_t>& data, size_t begin, size_t end, double p, std::mt19937_64& rng)
+{
+    size_t errors = 0;
+    uint64_t skip;
+    while((skip = SampleSkip(rng, p)) < end - begin)
+    {
+        begin += skip;
+        data[begin++] ^= (uint8_t)(1 + rng() % 255); //Never zero -> byte always changes
+        ++errors;
+    }
+    return errors;
+}
+
+size_t ChannelModel::ApplyErrors(std::vector<uint8_t>& data, uint64_t source, uint64_t destination, Scalar errorRate)
+{
+    double p = btClamped((double)errorRate, 0.0, 1.0);
+    if(data.empty() || (model == ChannelErrorModel::INDEPENDENT && p <= 0.0))
+        return 0;
+
+    Link& link = getLink(source, destination);
+    if(model == ChannelErrorModel::INDEPENDENT)
+        return CorruptRange(data, 0, data.size(), p, link.rng);
+
+    size_t errors = 0;
+    size_t i = 0;
+    while(i < data.size())
+    {
+        if(link.remaining == 0) //Switch state and sample its length
+        {
+            link.burst = !link.burst;
+            link.remaining = 1 + SampleSkip(link.rng, 1.0/(double)(link.burst ? burstLength : goodLength));
+        }
+        size_t run = (size_t)std::min<uint64_t>(link.remaining, data.size() - i);
+        errors += CorruptRange(data, i, i + run, link.burst ? (double)burstErrorRate : p, link.rng);
+        i += run;
+        link.remaining -= run;
+    }
+    return errors;
+}
+
+}
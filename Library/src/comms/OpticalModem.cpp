@@ -25,12 +25,11 @@
 
 #include "comms/OpticalModem.h"
 
-#include <random>
-#include <chrono>   
 #include "BulletCollision/NarrowPhaseCollision/btRaycastCallback.h"
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "graphics/OpenGLPipeline.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -93,69 +92,6 @@ std::vector<uint64_t> OpticalModem::getNodeIds()
     return ids;
 }
 
-// Function to introduce random errors in a byte stream
-// based on a link_quality_factor (0.0 to 1.0).
-// A link_quality_factor of 1.0 means no errors (perfect quality).
-// A link_quality_factor of 0.0 means maximum errors (every byte potentially changed).
-std::vector<uint8_t> OpticalModem::introduceErrors(
-    const std::vector<uint8_t>& data, Scalar linkQuality) 
-{
-    if (data.empty()) 
-    {
-        return {};
-    }
-
-    btClamp(linkQuality, Scalar(0), Scalar(1));
-
-    if (linkQuality == Scalar(1))
-    {
-        return data;
-    }
-
-    // Calculate the actual probability of an error occurring for each byte
-    double errorProbability = Scalar(1) - linkQuality;
-    
-    std::vector<uint8_t> erroredData {data};
-    
-    // Modern C++ random number generation
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    std::mt19937 generator(seed); // Mersenne Twister engine
-
-    // Distribution for deciding IF an error occurs at a position
-    std::uniform_real_distribution<Scalar> errorProbabilityDistribution(Scalar(0), Scalar(1));
-
-    // Distribution for picking a random byte value (0-255)
-    std::uniform_int_distribution<uint8_t> byteDistribution(0, 255);
-
-    for (size_t i = 0; i < erroredData.size(); ++i) 
-    {
-        // Check if an error should be introduced at this position
-        if (errorProbabilityDistribution(generator) < errorProbability) 
-        {
-            uint8_t originalByte = erroredData[i];
-            uint8_t newByte;
-
-            // If error probability is 1.0 we ideally want to ensure the byte actually changes.
-            if (errorProbability == Scalar(1)) 
-            {
-                do 
-                {
-                    newByte = static_cast<unsigned char>(byteDistribution(generator));
-                } 
-                while (newByte == originalByte); // Keep trying until it's different
-            } 
-            else 
-            {
-                // For other probabilities, a single random selection is usually fine.
-                // The chance of picking the same byte is 1/256.
-                newByte = static_cast<unsigned char>(byteDistribution(generator));
-            }
-            erroredData[i] = newByte;
-        }
-    }
-    return erroredData;
-}
-
 //Member 
 OpticalModem::OpticalModem(std::string uniqueName, uint64_t deviceId, Scalar fovDeg, Scalar operatingRange, Scalar ambientLightSensitivity)
                                 : Comm(uniqueName, deviceId)
@@ -201,6 +137,11 @@ Scalar OpticalModem::getReceptionQuality() const
     return receptionQuality;
 }
 
+ChannelModel& OpticalModem::getChannelModel()
+{
+    return channel;
+}
+
 CommType OpticalModem::getType() const
 {
     return CommType::OPTICAL;
@@ -210,7 +151,7 @@ void OpticalModem::MessageReceived(std::shared_ptr<CommDataFrame> message)
 {
     if(receptionQuality > Scalar(0))
     {
-        message->data = introduceErrors(message->data, receptionQuality);
+        channel.ApplyErrors(message->data, message->source, getDeviceId(), Scalar(1) - receptionQuality);
         Comm::MessageReceived(message);
     }
 }
@@ -348,13 +289,14 @@ void OpticalModem::InternalUpdate(Scalar dt)
 std::vector<Renderable> OpticalModem::Render()
 {
     std::vector<Renderable> items(0);
+    if(!OpenGLHelperArena::isEnabled(RenderableType::SENSOR_LINES))
+        return items;
     
     //Fov indicator
     Renderable item1;
     item1.model = glMatrixFromTransform(getDeviceFrame());
     item1.type = RenderableType::SENSOR_LINES;
-    item1.data = std::make_shared<std::vector<glm::vec3>>();
-    auto points = item1.getDataAsPoints();
+    auto& points = OpenGLHelperArena::Begin();
 
     GLfloat iconSize = 0.25f;
     unsigned int div = 24;
@@ -364,18 +306,19 @@ std::vector<Renderable> OpticalModem::Render()
     {
         GLfloat angle1 = (GLfloat)i/(GLfloat)div * 2.f * M_PI;
         GLfloat angle2 = (GLfloat)(i+1)/(GLfloat)div * 2.f * M_PI;
-        points->push_back(glm::vec3(r * cosf(angle1), r * sinf(angle1), iconSize));
-        points->push_back(glm::vec3(r * cosf(angle2), r * sinf(angle2), iconSize));
+        points.push_back(glm::vec3(r * cosf(angle1), r * sinf(angle1), iconSize));
+        points.push_back(glm::vec3(r * cosf(angle2), r * sinf(angle2), iconSize));
     }
         
-    points->push_back(glm::vec3(0,0,0));
-    points->push_back(glm::vec3(r, 0, iconSize));
-    points->push_back(glm::vec3(0,0,0));
-    points->push_back(glm::vec3(-r, 0, iconSize));
-    points->push_back(glm::vec3(0,0,0));
-    points->push_back(glm::vec3(0, r, iconSize));
-    points->push_back(glm::vec3(0,0,0));
-    points->push_back(glm::vec3(0, -r, iconSize));
+    points.push_back(glm::vec3(0,0,0));
+    points.push_back(glm::vec3(r, 0, iconSize));
+    points.push_back(glm::vec3(0,0,0));
+    points.push_back(glm::vec3(-r, 0, iconSize));
+    points.push_back(glm::vec3(0,0,0));
+    points.push_back(glm::vec3(0, r, iconSize));
+    points.push_back(glm::vec3(0,0,0));
+    points.push_back(glm::vec3(0, -r, iconSize));
+    item1.data = OpenGLHelperArena::Commit();
     items.push_back(item1);
 
     //Axes
@@ -387,20 +330,22 @@ std::vector<Renderable> OpticalModem::Render()
     Renderable item3;
     item3.type = RenderableType::SENSOR_LINES;
     item3.model = glm::mat4(1.f);
-    item3.data = std::make_shared<std::vector<glm::vec3>>();
-    points = item3.getDataAsPoints();
+    auto& lines = OpenGLHelperArena::Begin();
 
     if(getConnectedId() > 0)
     {
         OpticalModem* cNode = getNode(getConnectedId());
         if(cNode != nullptr)
         {
-            points->push_back(glVectorFromVector(getDeviceFrame().getOrigin()));
-            points->push_back(glVectorFromVector(cNode->getDeviceFrame().getOrigin()));    
+            lines.push_back(glVectorFromVector(getDeviceFrame().getOrigin()));
+            lines.push_back(glVectorFromVector(cNode->getDeviceFrame().getOrigin()));    
         }
     }
-    if(!points->empty())
+    if(!lines.empty())
+    {
+        item3.data = OpenGLHelperArena::Commit();
         items.push_back(item3);
+    }
 
     return items;
 }
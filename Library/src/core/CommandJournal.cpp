@@ -0,0 +1,597 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  CommandJournal.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/CommandJournal.h"
+
+#include <cstring>
+#include <algorithm>
+#include "BulletSoftBody/btSoftBody.h"
+#include "BulletDynamics/Featherstone/btMultiBodyLinkCollider.h"
+#include "core/SimulationApp.h"
+#include "core/SimulationManager.h"
+#include "actuators/Actuator.h"
+#include "entities/SolidEntity.h"
+#include "entities/FeatherstoneEntity.h"
+
+namespace sf
+{
+
+#define FNV_OFFSET  0xcbf29ce484222325ULL
+#define FNV_PRIME   0x100000001b3ULL
+
+static inline void HashBytes(uint64_t& h, const void* data, size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    for(size_t i=0; i<size; ++i)
+    {
+        h ^= bytes[i];
+        h *= FNV_PRIME;
+    }
+}
+
+static inline void HashScalar(uint64_t& h, Scalar s)
+{
+    double d = (double)s;
+    HashBytes(h, &d, sizeof(d));
+}
+
+static inline void HashVector(uint64_t& h, const Vector3& v)
+{
+    //Only three components, the fourth one is padding
+    HashScalar(h, v.getX());
+    HashScalar(h, v.getY());
+    HashScalar(h, v.getZ());
+}
+
+static inline void HashTransform(uint64_t& h, const Transform& T)
+{
+    HashVector(h, T.getBasis().getRow(0));
+    HashVector(h, T.getBasis().getRow(1));
+    HashVector(h, T.getBasis().getRow(2));
+    HashVector(h, T.getOrigin());
+}
+
+CommandJournal::CommandJournal(SimulationManager* sm, const std::string& path, JournalMode mode)
+    : sm(sm), path(path), mode(mode), tick(0), recordedHash(0), divergedTick(-1), open(false), finished(false)
+{
+    //Collect actuators and solids (indexed in the order of creation)
+    Actuator* act;
+    for(unsigned int i=0; (act = sm->getActuator(i)) != nullptr; ++i)
+        actuators.push_back(act);
+
+    Entity* ent;
+    for(unsigned int i=0; (ent = sm->getEntity(i)) != nullptr; ++i)
+    {
+        if(ent->getType() == EntityType::SOLID)
+            solids.push_back((SolidEntity*)ent);
+        else if(ent->getType() == EntityType::FEATHERSTONE)
+        {
+            FeatherstoneEntity* fe = (FeatherstoneEntity*)ent;
+            for(unsigned int h=0; h<fe->getNumOfLinks(); ++h)
+                solids.push_back(fe->getLink(h).solid);
+            multibodies.push_back(fe);
+        }
+    }
+
+    expected.resize(getNumOfSources());
+    for(size_t i=0; i<expected.size(); ++i)
+        CaptureCommandState(i, expected[i]);
+
+    if(mode == JournalMode::RECORD)
+    {
+        out.open(path, std::ios::binary | std::ios::trunc);
+        if(!out.is_open())
+        {
+            cError("Failed to create command journal: %s", path.c_str());
+            return;
+        }
+        WriteHeader();
+        open = true;
+        cInfo("Recording commands to journal: %s", path.c_str());
+    }
+    else
+    {
+        in.open(path, std::ios::binary);
+        if(!in.is_open())
+        {
+            cError("Failed to open command journal: %s", path.c_str());
+            return;
+        }
+        if(!ReadHeader())
+            return;
+        open = true;
+        cInfo("Replaying commands from journal: %s", path.c_str());
+    }
+}
+
+CommandJournal::~CommandJournal()
+{
+    if(out.is_open())
+        out.close();
+    if(in.is_open())
+        in.close();
+}
+
+void CommandJournal::WriteHeader()
+{
+    uint32_t u32 = SF_JOURNAL_MAGIC;
+    out.write((const char*)&u32, sizeof(u32));
+    u32 = SF_JOURNAL_VERSION;
+    out.write((const char*)&u32, sizeof(u32));
+    double sps = (double)sm->getStepsPerSecond();
+    out.write((const char*)&sps, sizeof(sps));
+
+    u32 = (uint32_t)actuators.size();
+    out.write((const char*)&u32, sizeof(u32));
+    for(size_t i=0; i<actuators.size(); ++i)
+        WriteName(actuators[i]->getName());
+
+    u32 = (uint32_t)solids.size();
+    out.write((const char*)&u32, sizeof(u32));
+    for(size_t i=0; i<solids.size(); ++i)
+        WriteName(solids[i]->getName());
+
+    u32 = (uint32_t)multibodies.size();
+    out.write((const char*)&u32, sizeof(u32));
+    for(size_t i=0; i<multibodies.size(); ++i)
+        WriteName(multibodies[i]->getName());
+
+    for(size_t i=0; i<expected.size(); ++i)
+    {
+        WriteVarint(expected[i].size());
+        WriteScalars(expected[i].data(), (unsigned int)expected[i].size());
+    }
+}
+
+bool CommandJournal::ReadHeader()
+{
+    uint32_t magic = 0, version = 0, n = 0;
+    double sps = 0.0;
+    in.read((char*)&magic, sizeof(magic));
+    in.read((char*)&version, sizeof(version));
+    in.read((char*)&sps, sizeof(sps));
+    if(!in || magic != SF_JOURNAL_MAGIC || version != SF_JOURNAL_VERSION)
+    {
+        cError("Incompatible command journal: %s", path.c_str());
+        return false;
+    }
+    if(sps != (double)sm->getStepsPerSecond())
+    {
+        cError("Command journal recorded with %1.1lf steps per second, simulation running with %1.1lf!", sps, (double)sm->getStepsPerSecond());
+        return false;
+    }
+
+    std::string name;
+    in.read((char*)&n, sizeof(n));
+    if(!in || n != actuators.size())
+    {
+        cError("Command journal recorded with %u actuators, scenario has %u!", n, (unsigned int)actuators.size());
+        return false;
+    }
+    for(size_t i=0; i<actuators.size(); ++i)
+        if(!ReadName(name) || name != actuators[i]->getName())
+        {
+            cError("Command journal does not match the scenario (actuator '%s')!", actuators[i]->getName().c_str());
+            return false;
+        }
+
+    in.read((char*)&n, sizeof(n));
+    if(!in || n != solids.size())
+    {
+        cError("Command journal recorded with %u bodies, scenario has %u!", n, (unsigned int)solids.size());
+        return false;
+    }
+    for(size_t i=0; i<solids.size(); ++i)
+        if(!ReadName(name) || name != solids[i]->getName())
+        {
+            cError("Command journal does not match the scenario (body '%s')!", solids[i]->getName().c_str());
+            return false;
+        }
+
+    in.read((char*)&n, sizeof(n));
+    if(!in || n != multibodies.size())
+    {
+        cError("Command journal recorded with %u multibodies, scenario has %u!", n, (unsigned int)multibodies.size());
+        return false;
+    }
+    for(size_t i=0; i<multibodies.size(); ++i)
+        if(!ReadName(name) || name != multibodies[i]->getName())
+        {
+            cError("Command journal does not match the scenario (multibody '%s')!", multibodies[i]->getName().c_str());
+            return false;
+        }
+
+    //Initial command state
+    for(size_t i=0; i<expected.size(); ++i)
+    {
+        uint64_t count = 0;
+        if(!ReadVarint(count) || count != expected[i].size() || !ReadScalars(expected[i].data(), (unsigned int)count))
+        {
+            cError("Corrupted command journal: %s", path.c_str());
+            return false;
+        }
+        RestoreCommandState(i, expected[i]);
+    }
+    return true;
+}
+
+void CommandJournal::BeginTick(std::vector<ExternalOverride>& overrides)
+{
+    if(!open)
+        return;
+
+    if(mode == JournalMode::RECORD)
+    {
+        //Record commands received since the last tick
+        for(size_t i=0; i<expected.size(); ++i)
+        {
+            current.clear();
+            CaptureCommandState(i, current);
+            if(current.size() != expected[i].size()
+               || memcmp(current.data(), expected[i].data(), current.size() * sizeof(Scalar)) != 0)
+            {
+                uint8_t type = i < actuators.size() ? SF_JOURNAL_ACTUATOR : SF_JOURNAL_MULTIBODY;
+                out.write((const char*)&type, 1);
+                WriteVarint(i < actuators.size() ? i : i - actuators.size());
+                WriteVarint(current.size());
+                WriteScalars(current.data(), (unsigned int)current.size());
+            }
+        }
+
+        //Record external overrides
+        for(size_t i=0; i<overrides.size(); ++i)
+        {
+            uint64_t index = std::find(solids.begin(), solids.end(), overrides[i].solid) - solids.begin();
+            if(index == solids.size())
+                continue; //Not journaled (e.g. a body created after the recording started)
+            uint8_t type = overrides[i].type == OverrideType::WRENCH ? SF_JOURNAL_WRENCH : SF_JOURNAL_POSE;
+            out.write((const char*)&type, 1);
+            WriteVarint(index);
+            if(overrides[i].type == OverrideType::WRENCH)
+            {
+                Scalar w[6] = {overrides[i].force.getX(), overrides[i].force.getY(), overrides[i].force.getZ(),
+                               overrides[i].torque.getX(), overrides[i].torque.getY(), overrides[i].torque.getZ()};
+                WriteScalars(w, 6);
+            }
+            else
+            {
+                const Matrix3& R = overrides[i].pose.getBasis();
+                const Vector3& O = overrides[i].pose.getOrigin();
+                Scalar p[12] = {R[0][0], R[0][1], R[0][2], R[1][0], R[1][1], R[1][2], R[2][0], R[2][1], R[2][2],
+                                O.getX(), O.getY(), O.getZ()};
+                WriteScalars(p, 12);
+            }
+        }
+        return;
+    }
+
+    //Replay: discard commands coming from controllers
+    overrides.clear();
+    if(finished)
+        return;
+
+    for(size_t i=0; i<expected.size(); ++i)
+        RestoreCommandState(i, expected[i]);
+
+    while(true)
+    {
+        uint8_t type = 0;
+        uint64_t index = 0;
+        in.read((char*)&type, 1);
+        if(!in)
+        {
+            finished = true;
+            cInfo("Command journal replay finished after %llu ticks.", (unsigned long long)tick);
+            return;
+        }
+
+        bool ok = true;
+        switch(type)
+        {
+            case SF_JOURNAL_ACTUATOR:
+            case SF_JOURNAL_MULTIBODY:
+            {
+                uint64_t count = 0;
+                ok = ReadVarint(index) && index < (type == SF_JOURNAL_ACTUATOR ? actuators.size() : multibodies.size());
+                if(ok)
+                {
+                    size_t source = type == SF_JOURNAL_ACTUATOR ? index : actuators.size() + index;
+                    ok = ReadVarint(count) && count == expected[source].size()
+                         && ReadScalars(expected[source].data(), (unsigned int)count);
+                    if(ok)
+                        RestoreCommandState(source, expected[source]);
+                }
+            }
+                break;
+
+            case SF_JOURNAL_WRENCH:
+            {
+                Scalar w[6];
+                ok = ReadVarint(index) && index < solids.size() && ReadScalars(w, 6);
+                if(ok)
+                {
+                    ExternalOverride o;
+                    o.solid = solids[index];
+                    o.type = OverrideType::WRENCH;
+                    o.force = Vector3(w[0], w[1], w[2]);
+                    o.torque = Vector3(w[3], w[4], w[5]);
+                    overrides.push_back(o);
+                }
+            }
+                break;
+
+            case SF_JOURNAL_POSE:
+            {
+                Scalar p[12];
+                ok = ReadVarint(index) && index < solids.size() && ReadScalars(p, 12);
+                if(ok)
+                {
+                    ExternalOverride o;
+                    o.solid = solids[index];
+                    o.type = OverrideType::POSE;
+                    o.pose = Transform(Matrix3(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8]), Vector3(p[9], p[10], p[11]));
+                    overrides.push_back(o);
+                }
+            }
+                break;
+
+            case SF_JOURNAL_TICK:
+            {
+                uint64_t recordedTick = 0;
+                ok = ReadVarint(recordedTick) && in.read((char*)&recordedHash, sizeof(recordedHash)) && recordedTick == tick;
+                if(ok)
+                    return;
+            }
+                break;
+
+            default:
+                ok = false;
+                break;
+        }
+
+        if(!ok)
+        {
+            finished = true;
+            cError("Corrupted command journal at tick %llu!", (unsigned long long)tick);
+            return;
+        }
+    }
+}
+
+void CommandJournal::ActuatorsUpdated()
+{
+    if(!open || (mode != JournalMode::RECORD && finished))
+        return;
+
+    for(size_t i=0; i<expected.size(); ++i)
+    {
+        expected[i].clear();
+        CaptureCommandState(i, expected[i]);
+    }
+}
+
+void CommandJournal::EndTick()
+{
+    if(!open)
+        return;
+
+    if(mode == JournalMode::RECORD)
+    {
+        uint8_t type = SF_JOURNAL_TICK;
+        uint64_t hash = ComputeStateHash();
+        out.write((const char*)&type, 1);
+        WriteVarint(tick);
+        out.write((const char*)&hash, sizeof(hash));
+    }
+    else if(mode == JournalMode::VERIFY && !finished && divergedTick < 0)
+    {
+        if(ComputeStateHash() != recordedHash)
+        {
+            divergedTick = (int64_t)tick;
+            cWarning("Replay diverged from the recorded trajectory at tick %lld!", (long long)divergedTick);
+        }
+    }
+    ++tick;
+}
+
+uint64_t CommandJournal::ComputeStateHash() const
+{
+    uint64_t h = FNV_OFFSET;
+    btSoftMultiBodyDynamicsWorld* world = sm->getDynamicsWorld();
+
+    const btCollisionObjectArray& objects = world->getCollisionObjectArray();
+    for(int i=0; i<objects.size(); ++i)
+    {
+        const btCollisionObject* co = objects[i];
+        if(co->isStaticObject())
+            continue;
+
+        const btRigidBody* rb = btRigidBody::upcast(co);
+        const btSoftBody* sb = btSoftBody::upcast(co);
+        if(rb != nullptr)
+        {
+            HashTransform(h, rb->getWorldTransform());
+            HashVector(h, rb->getLinearVelocity());
+            HashVector(h, rb->getAngularVelocity());
+        }
+        else if(sb != nullptr)
+        {
+            for(int k=0; k<sb->m_nodes.size(); ++k)
+            {
+                HashVector(h, sb->m_nodes[k].m_x);
+                HashVector(h, sb->m_nodes[k].m_v);
+            }
+        }
+        else
+            HashTransform(h, co->getWorldTransform());
+    }
+
+    for(int i=0; i<world->getNumMultibodies(); ++i)
+    {
+        const btMultiBody* mb = world->getMultiBody(i);
+        HashVector(h, mb->getBasePos());
+        const Quaternion& q = mb->getWorldToBaseRot();
+        HashScalar(h, q.getX());
+        HashScalar(h, q.getY());
+        HashScalar(h, q.getZ());
+        HashScalar(h, q.getW());
+        const Scalar* vel = mb->getVelocityVector();
+        for(int k=0; k<6 + mb->getNumDofs(); ++k)
+            HashScalar(h, vel[k]);
+        for(int l=0; l<mb->getNumLinks(); ++l)
+        {
+            const Scalar* pos = mb->getJointPosMultiDof(l);
+            for(int k=0; k<mb->getLink(l).m_posVarCount; ++k)
+                HashScalar(h, pos[k]);
+        }
+    }
+    return h;
+}
+
+size_t CommandJournal::getNumOfSources() const
+{
+    return actuators.size() + multibodies.size();
+}
+
+void CommandJournal::CaptureCommandState(size_t source, std::vector<Scalar>& state) const
+{
+    if(source < actuators.size())
+        actuators[source]->getCommandState(state);
+    else
+        multibodies[source - actuators.size()]->getCommandState(state);
+}
+
+void CommandJournal::RestoreCommandState(size_t source, const std::vector<Scalar>& state)
+{
+    if(source < actuators.size())
+        actuators[source]->setCommandState(state.data());
+    else
+        multibodies[source - actuators.size()]->setCommandState(state.data());
+}
+
+void CommandJournal::WriteVarint(uint64_t v)
+{
+    uint8_t buf[10];
+    unsigned int n = 0;
+    do
+    {
+        buf[n] = (uint8_t)(v & 0x7F);
+        v >>= 7;
+        if(v != 0)
+            buf[n] |= 0x80;
+        ++n;
+    }
+    while(v != 0);
+    out.write((const char*)buf, n);
+}
+
+void CommandJournal::WriteScalars(const Scalar* values, unsigned int count)
+{
+    for(unsigned int i=0; i<count; ++i)
+    {
+        double d = (double)values[i];
+        out.write((const char*)&d, sizeof(d));
+    }
+}
+
+void CommandJournal::WriteName(const std::string& name)
+{
+    uint16_t length = (uint16_t)name.size();
+    out.write((const char*)&length, sizeof(length));
+    out.write(name.data(), length);
+}
+
+bool CommandJournal::ReadVarint(uint64_t& v)
+{
+    v = 0;
+    for(unsigned int shift = 0; shift < 64; shift += 7)
+    {
+        uint8_t b;
+        if(!in.read((char*)&b, 1))
+            return false;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if((b & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+bool CommandJournal::ReadScalars(Scalar* values, unsigned int count)
+{
+    for(unsigned int i=0; i<count; ++i)
+    {
+        double d;
+        if(!in.read((char*)&d, sizeof(d)))
+            return false;
+        values[i] = (Scalar)d;
+    }
+    return true;
+}
+
+bool CommandJournal::ReadName(std::string& name)
+{
+    uint16_t length = 0;
+    if(!in.read((char*)&length, sizeof(length)))
+        return false;
+    name.resize(length);
+    return length == 0 || (bool)in.read(&name[0], length);
+}
+
+int64_t CommandJournal::getFirstDivergingTick() const
+{
+    return divergedTick;
+}
+
+uint64_t CommandJournal::getNumOfTicks() const
+{
+    return tick;
+}
+
+JournalMode CommandJournal::getMode() const
+{
+    return mode;
+}
+
+std::string CommandJournal::getPath() const
+{
+    return path;
+}
+
+bool CommandJournal::isReplaying() const
+{
+    return open && mode != JournalMode::RECORD;
+}
+
+bool CommandJournal::isFinished() const
+{
+    return finished;
+}
+
+bool CommandJournal::isOpen() const
+{
+    return open;
+}
+
+}
@@ -20,25 +20,61 @@
 //  Stonefish
 //
 //  Created by Patryk Cieslak on 24/05/2014.
-//  Copyright (c) 2014-2021 Patryk Cieslak. All rights reserved.
+//  Copyright (c) 2014-2026 Patryk Cieslak. All rights reserved.
 //
 
 #include "core/Console.h"
 #include <iostream>
 #include <fstream>
+#include <chrono>
 
 namespace sf
 {
     
-Console::Console(bool useStdout)
+Console::Console(bool useStdout, bool asynchronous, size_t historyLength)
 {
     stdoutEnabled = useStdout;
-    lines = std::vector<ConsoleMessage>(0);
     linesMutex = SDL_CreateMutex();
+    maxLines = historyLength;
+    minSeverity = MessageType::INFO;
+    repeatLimit = 0;
+    repeatCount = 0;
+    suppressedCount = 0;
+    async = asynchronous;
+    enqueuePos = 0;
+    dequeuePos = 0;
+    droppedCount = 0;
+    stop = false;
+    
+    if(async)
+    {
+        queue = std::unique_ptr<QueueSlot[]>(new QueueSlot[CONSOLE_QUEUE_LENGTH]);
+        for(size_t i=0; i<CONSOLE_QUEUE_LENGTH; ++i)
+            queue[i].sequence.store(i, std::memory_order_relaxed);
+        flushThread = std::thread(FlushThread, this);
+    }
 }
 
 Console::~Console()
 {
+    if(async)
+    {
+        stop = true;
+        flushThread.join();
+    }
+    
+    outputMutex.lock();
+    if(async)
+        Drain();
+    if(suppressedCount > 0)
+    {
+        ConsoleMessage msg;
+        msg.type = lastMsg.type;
+        msg.text = "Last message repeated " + std::to_string(suppressedCount) + " more times.";
+        Write(msg);
+    }
+    outputMutex.unlock();
+    
     lines.clear();
     SDL_DestroyMutex(linesMutex);
 }
@@ -50,79 +86,90 @@ SDL_mutex* Console::getLinesMutex()
 
 std::vector<ConsoleMessage> Console::getLines()
 {
-    return lines;
+    Flush();
+    SDL_LockMutex(linesMutex);
+    std::vector<ConsoleMessage> copy(lines.begin(), lines.end());
+    SDL_UnlockMutex(linesMutex);
+    return copy;
+}
+
+void Console::setMinimumSeverity(MessageType t)
+{
+    minSeverity = t;
+}
+
+MessageType Console::getMinimumSeverity() const
+{
+    return minSeverity;
+}
+
+void Console::setRepeatLimit(unsigned int n)
+{
+    repeatLimit = n;
+}
+
+unsigned int Console::getRepeatLimit() const
+{
+    return repeatLimit;
+}
+
+bool Console::isAsynchronous() const
+{
+    return async;
 }
 
 void Console::Print(MessageType t, std::string format, ...)
 {
+    if(t < minSeverity.load(std::memory_order_relaxed))
+        return;
+    
     va_list args;
     char buffer[4096];
     va_start(args, format);
     vsnprintf(buffer, sizeof(buffer), format.c_str(), args);
     va_end(args);
     
-    if(stdoutEnabled)
-    {
-#ifdef COLOR_CONSOLE
-        switch(t)
-        {
-            default:
-            case MessageType::INFO:
-                printf("[INFO] %s\n", buffer);
-                break;
-                
-            case MessageType::WARNING:
-                printf("\033[33m[WARN] %s\033[0m\n", buffer);
-                break;
-                
-            case MessageType::ERROR:
-                printf("\033[31m[ERROR] %s\033[0m\n", buffer);
-                break;
-                
-            case MessageType::CRITICAL:
-                printf("\033[1;31m[CRITICAL] %s\033[0m\n", buffer);
-                break;
-        }
-#else
-        switch(t)
-        {
-            default:
-            case MessageType::INFO:
-                printf("[INFO] %s\n", buffer);
-                break;
-                
-            case MessageType::WARNING:
-                printf("[WARN] %s\n", buffer);
-                break;
-                
-            case MessageType::ERROR:
-                printf("[ERROR] %s\n", buffer);
-                break;
-                
-            case MessageType::CRITICAL:
-                printf("[CRITICAL] %s\n", buffer);
-                break;
-        }
-#endif
-    }
-
     ConsoleMessage msg;
     msg.type = t;
     msg.text = std::string(buffer);
-    SDL_LockMutex(linesMutex);
-    lines.push_back(msg);
-    SDL_UnlockMutex(linesMutex);
+    
+    if(async && t != MessageType::CRITICAL)
+    {
+        if(!Enqueue(msg))
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    else //Critical messages are followed by abort() so they have to reach the output before returning
+    {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        if(async)
+            Drain();
+        Output(msg);
+        if(stdoutEnabled)
+            fflush(stdout);
+    }
 }
 
 void Console::AppendMessage(const ConsoleMessage& msg)
 {
     SDL_LockMutex(linesMutex);
     lines.push_back(msg);
+    if(maxLines > 0 && lines.size() > maxLines)
+        lines.pop_front();
     SDL_UnlockMutex(linesMutex);
 }
+
+void Console::Flush()
+{
+    if(!async)
+        return;
+    
+    std::lock_guard<std::mutex> lock(outputMutex);
+    Drain();
+}
     
 void Console::Clear()
 {
+    Flush();
     SDL_LockMutex(linesMutex);
     lines.clear();
     SDL_UnlockMutex(linesMutex);
@@ -130,6 +177,7 @@ void Console::Clear()
 
 bool Console::SaveToFile(std::string filename)
 {
+    Flush();
     std::ofstream outFile(filename);
     if(outFile.is_open())
     {
@@ -160,4 +208,153 @@ bool Console::SaveToFile(std::string filename)
         return false;
 }
 
+bool Console::Enqueue(ConsoleMessage& msg)
+{
+    //Bounded multi-producer queue (D. Vyukov)
+    QueueSlot* slot;
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for(;;)
+    {
+        slot = &queue[pos & (CONSOLE_QUEUE_LENGTH-1)];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if(diff == 0)
+        {
+            if(enqueuePos.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed))
+                break;
+        }
+        else if(diff < 0) //Queue full
+            return false;
+        else
+            pos = enqueuePos.load(std::memory_order_relaxed);
+    }
+    slot->msg = std::move(msg);
+    slot->sequence.store(pos+1, std::memory_order_release);
+    return true;
+}
+
+bool Console::Drain()
+{
+    //Has to be called with outputMutex locked (single consumer)
+    bool written = false;
+    for(;;)
+    {
+        QueueSlot& slot = queue[dequeuePos & (CONSOLE_QUEUE_LENGTH-1)];
+        size_t seq = slot.sequence.load(std::memory_order_acquire);
+        if((intptr_t)seq - (intptr_t)(dequeuePos+1) < 0) //Queue empty
+            break;
+        ConsoleMessage msg = std::move(slot.msg);
+        slot.sequence.store(dequeuePos + CONSOLE_QUEUE_LENGTH, std::memory_order_release);
+        ++dequeuePos;
+        Output(msg);
+        written = true;
+    }
+    
+    size_t dropped = droppedCount.exchange(0, std::memory_order_relaxed);
+    if(dropped > 0)
+    {
+        ConsoleMessage msg;
+        msg.type = MessageType::WARNING;
+        msg.text = "Console queue overflow! " + std::to_string(dropped) + " messages dropped.";
+        Output(msg);
+        written = true;
+    }
+    
+    if(written && stdoutEnabled)
+        fflush(stdout);
+    return written;
+}
+
+void Console::Output(const ConsoleMessage& msg)
+{
+    unsigned int limit = repeatLimit.load(std::memory_order_relaxed);
+    if(limit > 0 && msg.type == lastMsg.type && msg.text == lastMsg.text)
+    {
+        if(++repeatCount > limit)
+        {
+            ++suppressedCount;
+            return;
+        }
+    }
+    else
+    {
+        if(suppressedCount > 0)
+        {
+            ConsoleMessage rep;
+            rep.type = lastMsg.type;
+            rep.text = "Last message repeated " + std::to_string(suppressedCount) + " more times.";
+            Write(rep);
+        }
+        if(limit > 0)
+            lastMsg = msg;
+        repeatCount = 1;
+        suppressedCount = 0;
+    }
+    Write(msg);
+}
+
+void Console::Write(const ConsoleMessage& msg)
+{
+    if(stdoutEnabled)
+    {
+        const char* text = msg.text.c_str();
+#ifdef COLOR_CONSOLE
+        switch(msg.type)
+        {
+            default:
+            case MessageType::INFO:
+                printf("[INFO] %s\n", text);
+                break;
+                
+            case MessageType::WARNING:
+                printf("\033[33m[WARN] %s\033[0m\n", text);
+                break;
+                
+            case MessageType::ERROR:
+                printf("\033[31m[ERROR] %s\033[0m\n", text);
+                break;
+                
+            case MessageType::CRITICAL:
+                printf("\033[1;31m[CRITICAL] %s\033[0m\n", text);
+                break;
+        }
+#else
+        switch(msg.type)
+        {
+            default:
+            case MessageType::INFO:
+                printf("[INFO] %s\n", text);
+                break;
+                
+            case MessageType::WARNING:
+                printf("[WARN] %s\n", text);
+                break;
+                
+            case MessageType::ERROR:
+                printf("[ERROR] %s\n", text);
+                break;
+                
+            case MessageType::CRITICAL:
+                printf("[CRITICAL] %s\n", text);
+                break;
+        }
+#endif
+    }
+    AppendMessage(msg);
+}
+
+void Console::FlushThread(Console* console)
+{
+    while(!console->stop.load())
+    {
+        bool written;
+        {
+            std::lock_guard<std::mutex> lock(console->outputMutex);
+            written = console->Drain();
+        }
+        if(!written)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
 }
@@ -28,6 +28,7 @@
 #include <chrono>
 #include <thread>
 #include "core/SimulationManager.h"
+#include "core/SharedMemoryBridge.h"
 #include "utils/SystemUtil.hpp"
 
 namespace sf
@@ -100,6 +101,33 @@ void ConsoleSimulationApp::StopSimulation()
     physicsThreadPool_.reset();
 }
 
+void ConsoleSimulationApp::StartLockstep()
+{
+    autostep_ = false;
+    timeStep_ = Scalar(1)/getSimulationManager()->getStepsPerSecond();
+    Init();
+    StartSimulation();
+}
+
+void ConsoleSimulationApp::Step(unsigned int n, bool callStepCompleted, const std::function<void(unsigned int, Scalar)>& callback)
+{
+    if(state_ != SimulationState::RUNNING)
+        return;
+    getSimulationManager()->Step(n, callStepCompleted, callback);
+}
+
+void ConsoleSimulationApp::StopLockstep()
+{
+    StopSimulation();
+    Quit();
+    CleanUp();
+}
+
+void ConsoleSimulationApp::EnableSharedMemoryBridge(const SharedMemoryBridgeSettings& settings)
+{
+    getSimulationManager()->EnableSharedMemoryBridge(settings);
+}
+
 //Static
 int ConsoleSimulationApp::RunSimulation(void* data)
 {
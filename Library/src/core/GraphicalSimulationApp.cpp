@@ -188,9 +188,12 @@ void GraphicalSimulationApp::Init()
 
     //Continue initialization with console visible
     cInfo("Initializing rendering pipeline:");
-    cInfo("Loading GUI...");
-    gui = new IMGUI(windowW, windowH);
-    InitializeGUI(); //Initialize non-standard graphical elements
+    if(!rSettings.offscreen)
+    {
+        cInfo("Loading GUI...");
+        gui = new IMGUI(windowW, windowH);
+        InitializeGUI(); //Initialize non-standard graphical elements
+    }
     glPipeline = new OpenGLPipeline(rSettings, hSettings);
     ShowHUD();
     
@@ -198,12 +201,16 @@ void GraphicalSimulationApp::Init()
     InitializeSimulation();
     
     cInfo("Ready for running...");
-    SDL_Delay(1000);
     
     //Close loading console - exit loading thread
     loading = false;
-    int status = 0;
-    SDL_WaitThread(loadingThread, &status);
+    if(loadingThread != nullptr)
+    {
+        SDL_Delay(1000);
+        int status = 0;
+        SDL_WaitThread(loadingThread, &status);
+        loadingThread = nullptr;
+    }
     SDL_GL_MakeCurrent(window, glMainContext);
 
     //Create performance counters
@@ -214,7 +221,13 @@ void GraphicalSimulationApp::Init()
 
 void GraphicalSimulationApp::InitializeSDL()
 {
-    SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_JOYSTICK);
+    //Offscreen rendering uses a headless EGL context (software rasterizer when no GPU is available),
+    //unless another video driver was explicitly chosen by the user
+    if(rSettings.offscreen)
+        SDL_setenv("SDL_VIDEODRIVER", "offscreen", 0);
+    
+    if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | (rSettings.offscreen ? 0 : SDL_INIT_JOYSTICK)) < 0)
+        cCritical("SDL2: %s", SDL_GetError());
     
     //Create OpenGL contexts
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
@@ -234,8 +247,29 @@ void GraphicalSimulationApp::InitializeSDL()
                               SDL_WINDOWPOS_CENTERED,
                               windowW,
                               windowH,
-                              SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN// | SDL_WINDOW_ALLOW_HIGHDPI
+                              SDL_WINDOW_OPENGL | (rSettings.offscreen ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN)// | SDL_WINDOW_ALLOW_HIGHDPI
                               );
+    if(window == nullptr)
+        cCritical("SDL2: %s", SDL_GetError());
+    
+    if(rSettings.offscreen)
+    {
+        glMainContext = SDL_GL_CreateContext(window);
+        if(glMainContext == nullptr)
+            cCritical("SDL2: %s", SDL_GetError());
+        
+        int version = gladLoadGL((GLADloadfunc) SDL_GL_GetProcAddress);
+        int vmajor = GLAD_VERSION_MAJOR(version);
+        int vminor = GLAD_VERSION_MINOR(version);
+        if(vmajor < 4 || (vmajor == 4 && vminor < 3))
+            cCritical("This program requires support for OpenGL 4.3, however OpenGL %d.%d was detected! Exiting...", vmajor, vminor);
+        
+        //No loading screen, no console window, no joysticks
+        cInfo("Offscreen OpenGL %d.%d context created (%s).", vmajor, vminor, (const char*)glGetString(GL_RENDERER));
+        OpenGLState::Init();
+        GLSLShader::Init();
+        return;
+    }
                               
     //Set window icon
     uint32_t rmask, gmask, bmask, amask;
@@ -288,8 +322,12 @@ void GraphicalSimulationApp::InitializeSDL()
     
     //Initialize console output
     std::vector<ConsoleMessage> textLines = console_->getLines();
+    MessageType minSeverity = console_->getMinimumSeverity();
+    unsigned int repeatLimit = console_->getRepeatLimit();
     delete console_;
     console_ = new OpenGLConsole();
+    console_->setMinimumSeverity(minSeverity);
+    console_->setRepeatLimit(repeatLimit);
     for(size_t i=0; i<textLines.size(); ++i)
         console_->AppendMessage(textLines[i]);
     ((OpenGLConsole*)console_)->Init(windowW, windowH);
@@ -622,27 +660,33 @@ void GraphicalSimulationApp::RenderLoop()
     //Rendering
     glBeginQuery(GL_TIME_ELAPSED, timeQuery[timeQueryPingpong]);
     glPipeline->Render(getSimulationManager());
-    glPipeline->DrawDisplay();
     
-    //GUI & Console
-    if(displayConsole)
-    {
-        gui->GenerateBackground();
-        ((OpenGLConsole*)console_)->Render(true);
-    }
-    else
+    if(!rSettings.offscreen) //Only vision sensors are rendered offscreen
     {
-        if(displayHUD) //Draw immediate mode GUI
+        glPipeline->DrawDisplay();
+        
+        //GUI & Console
+        if(displayConsole)
         {
             gui->GenerateBackground();
-            gui->Begin();
-            DoHUD();
-            gui->End();
+            SDL_LockMutex(console_->getLinesMutex());
+            ((OpenGLConsole*)console_)->Render(true);
+            SDL_UnlockMutex(console_->getLinesMutex());
         }
-        else //Just draw logo in the corner
+        else
         {
-            gui->Begin();
-            gui->End();
+            if(displayHUD) //Draw immediate mode GUI
+            {
+                gui->GenerateBackground();
+                gui->Begin();
+                DoHUD();
+                gui->End();
+            }
+            else //Just draw logo in the corner
+            {
+                gui->Begin();
+                gui->End();
+            }
         }
     }
     glEndQuery(GL_TIME_ELAPSED);
@@ -668,7 +712,10 @@ void GraphicalSimulationApp::RenderLoop()
     }
 
     //glFinish(); //Ensure that the frame was fully rendered
-    SDL_GL_SwapWindow(window);
+    if(rSettings.offscreen)
+        glFlush(); //Nothing to present
+    else
+        SDL_GL_SwapWindow(window);
 }
 
 void GraphicalSimulationApp::DoHUD()
@@ -31,6 +31,7 @@
 #include "entities/statics/Obstacle.h"
 #include "entities/statics/Plane.h"
 #include "entities/statics/Terrain.h"
+#include "entities/statics/TiledTerrain.h"
 #include "entities/AnimatedEntity.h"
 #include "entities/animation/ManualTrajectory.h"
 #include "entities/animation/PWLTrajectory.h"
@@ -45,6 +46,7 @@
 #include "entities/solids/Compound.h"
 #include "entities/forcefields/Uniform.h"
 #include "entities/forcefields/Jet.h"
+#include "entities/forcefields/GriddedField.h"
 #include "entities/FeatherstoneEntity.h"
 #include "entities/CableEntity.h"
 #include "sensors/scalar/Accelerometer.h"
@@ -676,6 +678,19 @@ bool ScenarioParser::ParseEnvironment(XMLElement* element)
             item->QueryAttribute("enabled", &particles);
         }
         sm->getOcean()->setParticles(particles);
+        
+        //Hydrodynamic quiescence
+        if((item = ocean->FirstChildElement("quiescence")) != nullptr)
+        {
+            Scalar linear, angular, position, orientation;
+            if(item->QueryAttribute("linear", &linear) != XML_SUCCESS
+               || item->QueryAttribute("angular", &angular) != XML_SUCCESS
+               || item->QueryAttribute("position", &position) != XML_SUCCESS
+               || item->QueryAttribute("orientation", &orientation) != XML_SUCCESS)
+                log.Print(MessageType::WARNING, "Hydrodynamic quiescence definition incorrect - detection disabled.");
+            else
+                sm->getOcean()->setHydrodynamicsQuiescence(linear, angular, position, orientation);
+        }
 
         //Currents
         if((item = ocean->FirstChildElement("current")) != nullptr)
@@ -938,6 +953,23 @@ VelocityField* ScenarioParser::ParseVelocityField(XMLElement* element)
         Vector3 dir = v.normalized();
         return new Jet(c, dir, radius, v.norm());
     }
+    else if(vfTypeStr == "gridded")
+    {
+        XMLElement* item;
+        const char* file;
+        bool loop = false;
+        Scalar timeOffset(0);
+
+        if((item = element->FirstChildElement("data")) == nullptr
+            || item->QueryStringAttribute("file", &file) != XML_SUCCESS)
+        {
+            log.Print(MessageType::WARNING, "Data file of gridded velocity field missing - skipping.");
+            return nullptr;
+        }
+        item->QueryAttribute("loop", &loop); //Optional
+        item->QueryAttribute("time_offset", &timeOffset); //Optional
+        return new GriddedField(GetFullPath(std::string(file)), loop, timeOffset);
+    }
     else
     {
         log.Print(MessageType::WARNING, "Velocity field type not supported - skipping.");
@@ -1121,6 +1153,27 @@ bool ScenarioParser::ParseStatic(XMLElement* element)
         }   
         object = new Terrain(objectName, GetFullPath(std::string(heightmap)), scaleX, scaleY, height, std::string(mat), std::string(look), uvScale);
     }
+    else if(typestr == "tiled_terrain")
+    {
+        const char* terrainData = nullptr;
+        Scalar pagingRadius(100);
+        Scalar lodDistance(50);
+        Scalar drawRange(2000);
+        
+        if((item = element->FirstChildElement("terrain_data")) == nullptr
+           || item->QueryStringAttribute("filename", &terrainData) != XML_SUCCESS)
+        {
+            log.Print(MessageType::ERROR, "Data of terrain '%s' not properly defined!", objectName.c_str());
+            return false;
+        }
+        if((item = element->FirstChildElement("paging")) != nullptr)
+        {
+            item->QueryAttribute("radius", &pagingRadius);
+            item->QueryAttribute("lod_distance", &lodDistance);
+            item->QueryAttribute("draw_range", &drawRange);
+        }
+        object = new TiledTerrain(objectName, GetFullPath(std::string(terrainData)), std::string(mat), std::string(look), uvScale, pagingRadius, lodDistance, drawRange);
+    }
     else
     {
         log.Print(MessageType::ERROR, "Unknown type of static body '%s'!", objectName.c_str());
@@ -1828,6 +1881,7 @@ bool ScenarioParser::ParseSolid(XMLElement* element, SolidEntity*& solid, std::s
     }
     element->QueryAttribute("buoyant", &phy.buoyancy);
     element->QueryAttribute("collisions", &phy.collisions);
+    element->QueryAttribute("reduced_drag", &phy.reducedDrag);
     
     std::string typeStr(type);
     
@@ -2103,6 +2157,25 @@ bool ScenarioParser::ParseSolid(XMLElement* element, SolidEntity*& solid, std::s
             {
                 solid = new Polyhedron(solidName, phy, GetFullPath(std::string(phyMesh)), phyScale, phyOrigin, std::string(mat), std::string(look), thickness); 
             }
+            
+            //Collision geometry
+            if((item = element->FirstChildElement("physical")->FirstChildElement("collision")) != nullptr)
+            {
+                Polyhedron* poly = (Polyhedron*)solid;
+                Scalar tolerance;
+                bool decompose = false;
+                if(item->QueryAttribute("hull_tolerance", &tolerance) == XML_SUCCESS)
+                    poly->setHullReduction(tolerance);
+                if(item->QueryAttribute("decomposition", &decompose) == XML_SUCCESS && decompose)
+                {
+                    ConvexDecompositionSettings settings;
+                    item->QueryAttribute("concavity", &settings.concavity);
+                    item->QueryAttribute("max_parts", &settings.maxParts);
+                    item->QueryAttribute("resolution", &settings.resolution);
+                    item->QueryAttribute("part_tolerance", &settings.hullTolerance);
+                    poly->setConvexDecomposition(settings);
+                }
+            }
         }
         else
         {
@@ -4027,12 +4100,6 @@ Sensor* ScenarioParser::ParseSensor(XMLElement* element, const std::string& name
     }
     else if(typeStr == "depthcamera")
     {
-        if(!isGraphicalSim())
-        {
-            log.Print(MessageType::ERROR, "Depth cameras not supported in console mode!");
-            return nullptr;
-        }
-
         int resX, resY;
         Scalar hFov;
         Scalar depthMin, depthMax;
@@ -4309,12 +4376,6 @@ Sensor* ScenarioParser::ParseSensor(XMLElement* element, const std::string& name
     }
     else if(typeStr == "multibeam2d")
     {
-        if(!isGraphicalSim())
-        {
-            log.Print(MessageType::ERROR, "Multibeam 2D not supported in console mode!");
-            return nullptr;
-        }
-
         int resX, resY;
         Scalar hFov, vFov;
         Scalar rangeMin, rangeMax;
@@ -4335,12 +4396,6 @@ Sensor* ScenarioParser::ParseSensor(XMLElement* element, const std::string& name
     }
     else if(typeStr == "fls")
     {
-        if(!isGraphicalSim())
-        {
-            log.Print(MessageType::ERROR, "FLS not supported in console mode!");
-            return nullptr;
-        }
-
         Scalar hFov, vFov;
         int nBeams, nBins;
         Scalar rangeMin(0.5);
@@ -4418,12 +4473,6 @@ Sensor* ScenarioParser::ParseSensor(XMLElement* element, const std::string& name
     }
     else if(typeStr == "sss")
     {
-        if(!isGraphicalSim())
-        {
-            log.Print(MessageType::ERROR, "SSS not supported in console mode!");
-            return nullptr;
-        }
-
         Scalar hFov, vFov;
         int nLines, nBins;
         Scalar tilt;
@@ -4503,12 +4552,6 @@ Sensor* ScenarioParser::ParseSensor(XMLElement* element, const std::string& name
     }
     else if(typeStr == "msis")
     {
-        if(!isGraphicalSim())
-        {
-            log.Print(MessageType::ERROR, "MSIS not supported in console mode!");
-            return nullptr;
-        }
-
         Scalar stepAngle;
         int nBins;
         Scalar hFov, vFov;
@@ -4731,6 +4774,14 @@ Comm* ScenarioParser::ParseComm(XMLElement* element, const std::string& namePref
         comm = new AcousticModem(commName, devId, minFovDeg, maxFovDeg, range);
         comm->Connect(cId);
         ((AcousticModem*)comm)->setOcclusionTest(occlusion);
+        
+        //Optional channel errors definition
+        if((item = element->FirstChildElement("errors")) != nullptr)
+        {
+            Scalar byteErrorRate(0);
+            ParseChannelErrors(item, commName, ((AcousticModem*)comm)->getChannelModel(), &byteErrorRate);
+            ((AcousticModem*)comm)->setByteErrorRate(byteErrorRate);
+        }
         return comm;
     }
     else if(typeStr == "usbl")
@@ -4799,6 +4850,13 @@ Comm* ScenarioParser::ParseComm(XMLElement* element, const std::string& namePref
             else
                 ((USBLSimple*)comm)->setResolution(rangeRes, angleResDeg);
         }
+        //Optional channel errors definition
+        if((item = element->FirstChildElement("errors")) != nullptr)
+        {
+            Scalar byteErrorRate(0);
+            ParseChannelErrors(item, commName, ((AcousticModem*)comm)->getChannelModel(), &byteErrorRate);
+            ((AcousticModem*)comm)->setByteErrorRate(byteErrorRate);
+        }
         return comm;
     }
     else if(typeStr == "usbl2")
@@ -4862,6 +4920,13 @@ Comm* ScenarioParser::ParseComm(XMLElement* element, const std::string& namePref
             else
                 ((USBLReal*)comm)->setNoise(timeDev, svDev, phaseDev, blError, depthDev);
         }
+        //Optional channel errors definition
+        if((item = element->FirstChildElement("errors")) != nullptr)
+        {
+            Scalar byteErrorRate(0);
+            ParseChannelErrors(item, commName, ((AcousticModem*)comm)->getChannelModel(), &byteErrorRate);
+            ((AcousticModem*)comm)->setByteErrorRate(byteErrorRate);
+        }
         return comm;
     }
     else if(typeStr == "optical_modem" || typeStr == "vlc")
@@ -4889,6 +4954,10 @@ Comm* ScenarioParser::ParseComm(XMLElement* element, const std::string& namePref
         
         comm = new OpticalModem(commName, devId, fovDeg, range, ambientLightSensitivity);
         comm->Connect(cId);
+        
+        //Optional channel errors definition (byte error rate follows the reception quality)
+        if((item = element->FirstChildElement("errors")) != nullptr)
+            ParseChannelErrors(item, commName, ((OpticalModem*)comm)->getChannelModel(), nullptr);
         return comm;
     }
     else 
@@ -5195,6 +5264,30 @@ bool ScenarioParser::ParseTransform(XMLElement* element, Transform& T)
     return true;
 }
 
+void ScenarioParser::ParseChannelErrors(XMLElement* element, const std::string& commName, ChannelModel& channel, Scalar* byteErrorRate)
+{
+    int64_t seed;
+    if(element->QueryAttribute("seed", &seed) == XML_SUCCESS)
+        channel.setSeed((uint64_t)seed);
+    if(byteErrorRate != nullptr)
+        element->QueryAttribute("byte_error_rate", byteErrorRate);
+    
+    Scalar goodLength;
+    Scalar burstLength;
+    Scalar burstErrorRate;
+    int c = 0;
+    if(element->QueryAttribute("good_length", &goodLength) == XML_SUCCESS)
+        ++c;
+    if(element->QueryAttribute("burst_length", &burstLength) == XML_SUCCESS)
+        ++c;
+    if(element->QueryAttribute("burst_error_rate", &burstErrorRate) == XML_SUCCESS)
+        ++c;
+    if(c == 3)
+        channel.setBurstErrors(goodLength, burstLength, burstErrorRate);
+    else if(c > 0)
+        log.Print(MessageType::WARNING, "Burst errors of communication device '%s' not properly defined - using independent errors.", commName.c_str());
+}
+
 bool ScenarioParser::ParseColor(XMLElement* element, Color& c)
 {
     const char* components = nullptr;
@@ -0,0 +1,399 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SharedMemoryBridge.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/SharedMemoryBridge.h"
+
+#include <cstring>
+#include <thread>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "core/SimulationApp.h"
+#include "core/SimulationManager.h"
+#include "core/Robot.h"
+#include "sensors/ScalarSensor.h"
+#include "actuators/Motor.h"
+#include "actuators/Servo.h"
+#include "actuators/Propeller.h"
+#include "actuators/Thruster.h"
+#include "actuators/Rudder.h"
+#include "actuators/VariableBuoyancy.h"
+#include "actuators/Light.h"
+#include "actuators/SuctionCup.h"
+#include "actuators/Push.h"
+#include "actuators/SimpleThruster.h"
+#include "utils/SystemUtil.hpp"
+
+namespace sf
+{
+
+static inline uint64_t AlignOffset(uint64_t offset, uint64_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+SharedMemoryBridge::SharedMemoryBridge(SimulationManager* sm, const SharedMemoryBridgeSettings& settings)
+    : name(settings.name), capacity(btMax(settings.ringCapacity, 2u)), synchronous(settings.synchronous),
+      timeout((int64_t)(settings.timeout * Scalar(1e9))), mapping(nullptr), mappingSize(0), header(nullptr),
+      tick(0), roundTrips(0), latencySum(0), latencyMax(0)
+{
+#ifdef _WIN32
+    mappingHandle = nullptr;
+#endif
+    //Collect robots, their scalar sensors and actuators
+    Robot* robot;
+    for(unsigned int i=0; (robot = sm->getRobot(i)) != nullptr; ++i)
+    {
+        RobotChannel rc;
+        memset(&rc.layout, 0, sizeof(ShmRobotDescriptor));
+        rc.sensorRing = nullptr;
+        rc.commandRing = nullptr;
+        rc.publishTime = 0;
+        rc.connected = false;
+
+        Sensor* sens;
+        for(size_t h=0; (sens = robot->getSensor(h)) != nullptr; ++h)
+            if(sens->getType() != SensorType::VISION)
+                rc.sensors.push_back((ScalarSensor*)sens);
+
+        Actuator* act;
+        for(size_t h=0; (act = robot->getActuator(h)) != nullptr; ++h)
+            rc.actuators.push_back(act);
+
+        channels.push_back(rc);
+    }
+
+    //Compute layout
+    std::vector<ShmRobotDescriptor> descs(channels.size());
+    uint64_t offset = sizeof(ShmHeader) + channels.size() * sizeof(ShmRobotDescriptor);
+    for(size_t i=0; i<channels.size(); ++i)
+    {
+        ShmRobotDescriptor& d = descs[i];
+        memset(&d, 0, sizeof(ShmRobotDescriptor));
+        d.numSensors = (uint32_t)channels[i].sensors.size();
+        d.numActuators = (uint32_t)channels[i].actuators.size();
+        for(size_t h=0; h<channels[i].sensors.size(); ++h)
+            d.numChannels += channels[i].sensors[h]->getNumOfChannels();
+
+        d.sensorDescOffset = AlignOffset(offset, 8);
+        d.actuatorDescOffset = d.sensorDescOffset + d.numSensors * sizeof(ShmSensorDescriptor);
+        offset = d.actuatorDescOffset + d.numActuators * sizeof(ShmActuatorDescriptor);
+        d.sensorFrameSize = AlignOffset(sizeof(ShmSensorFrameHeader) + d.numSensors * sizeof(uint64_t) + d.numChannels * sizeof(double), 64);
+        d.commandFrameSize = AlignOffset(sizeof(ShmCommandFrameHeader) + d.numActuators * sizeof(ShmActuatorCommand), 64);
+        d.sensorRingOffset = AlignOffset(offset, 64);
+        d.commandRingOffset = d.sensorRingOffset + sizeof(ShmRingHeader) + capacity * d.sensorFrameSize;
+        offset = d.commandRingOffset + sizeof(ShmRingHeader) + capacity * d.commandFrameSize;
+    }
+    mappingSize = (size_t)offset;
+
+    //Create shared memory segment
+#ifdef _WIN32
+    std::string shmName = "Local\\" + name;
+    mappingHandle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, (DWORD)((uint64_t)mappingSize >> 32), (DWORD)(mappingSize & 0xFFFFFFFF), shmName.c_str());
+    if(mappingHandle != NULL)
+        mapping = (uint8_t*)MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, mappingSize);
+#else
+    std::string shmName = "/" + name;
+    shm_unlink(shmName.c_str()); //Remove stale segment
+    int fd = shm_open(shmName.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+    if(fd >= 0)
+    {
+        if(ftruncate(fd, (off_t)mappingSize) == 0)
+        {
+            void* ptr = mmap(NULL, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            mapping = ptr == MAP_FAILED ? nullptr : (uint8_t*)ptr;
+        }
+        close(fd);
+    }
+#endif
+    if(mapping == nullptr)
+    {
+        cError("Failed to create shared memory segment '%s'!", name.c_str());
+        return;
+    }
+    memset(mapping, 0, mappingSize);
+
+    //Fill descriptors
+    header = (ShmHeader*)mapping;
+    header->magic = SF_SHM_MAGIC;
+    header->version = SF_SHM_VERSION;
+    header->size = mappingSize;
+    header->numRobots = (uint32_t)channels.size();
+    header->ringCapacity = capacity;
+    header->synchronous = synchronous ? 1 : 0;
+    header->tick.store(0);
+
+    for(size_t i=0; i<channels.size(); ++i)
+    {
+        RobotChannel& rc = channels[i];
+        rc.layout = descs[i];
+        strncpy(rc.layout.name, sm->getRobot((unsigned int)i)->getName().c_str(), SF_SHM_NAME_LENGTH-1);
+        ((ShmRobotDescriptor*)(mapping + sizeof(ShmHeader)))[i] = rc.layout;
+
+        ShmSensorDescriptor* sd = (ShmSensorDescriptor*)(mapping + rc.layout.sensorDescOffset);
+        uint32_t firstChannel = 0;
+        for(size_t h=0; h<rc.sensors.size(); ++h)
+        {
+            strncpy(sd[h].name, rc.sensors[h]->getName().c_str(), SF_SHM_NAME_LENGTH-1);
+            sd[h].type = (uint32_t)rc.sensors[h]->getScalarSensorType();
+            sd[h].numChannels = rc.sensors[h]->getNumOfChannels();
+            sd[h].firstChannel = firstChannel;
+            sd[h].frequency = rc.sensors[h]->getUpdateFrequency();
+            firstChannel += sd[h].numChannels;
+        }
+
+        ShmActuatorDescriptor* ad = (ShmActuatorDescriptor*)(mapping + rc.layout.actuatorDescOffset);
+        for(size_t h=0; h<rc.actuators.size(); ++h)
+        {
+            strncpy(ad[h].name, rc.actuators[h]->getName().c_str(), SF_SHM_NAME_LENGTH-1);
+            ad[h].type = (uint32_t)rc.actuators[h]->getType();
+        }
+
+        rc.sensorRing = (ShmRingHeader*)(mapping + rc.layout.sensorRingOffset);
+        rc.commandRing = (ShmRingHeader*)(mapping + rc.layout.commandRingOffset);
+    }
+
+    header->open.store(1, std::memory_order_release); //Layout complete
+    cInfo("Shared memory bridge '%s' created (%lu robots, %lu bytes).", name.c_str(), (unsigned long)channels.size(), (unsigned long)mappingSize);
+}
+
+SharedMemoryBridge::~SharedMemoryBridge()
+{
+    if(header != nullptr)
+        header->open.store(0, std::memory_order_release);
+
+#ifdef _WIN32
+    if(mapping != nullptr)
+        UnmapViewOfFile(mapping);
+    if(mappingHandle != NULL)
+        CloseHandle(mappingHandle);
+#else
+    if(mapping != nullptr)
+    {
+        munmap(mapping, mappingSize);
+        shm_unlink(("/" + name).c_str());
+    }
+#endif
+}
+
+std::string SharedMemoryBridge::getName() const
+{
+    return name;
+}
+
+bool SharedMemoryBridge::isOpen() const
+{
+    return header != nullptr;
+}
+
+uint64_t SharedMemoryBridge::getNumOfDroppedFrames() const
+{
+    uint64_t dropped = 0;
+    for(size_t i=0; i<channels.size(); ++i)
+        if(channels[i].sensorRing != nullptr)
+            dropped += channels[i].sensorRing->dropped.load(std::memory_order_relaxed);
+    return dropped;
+}
+
+uint64_t SharedMemoryBridge::getRoundTripLatency(Scalar& mean, Scalar& max) const
+{
+    mean = roundTrips > 0 ? Scalar(latencySum)/Scalar(roundTrips) * Scalar(1e-9) : Scalar(0);
+    max = Scalar(latencyMax) * Scalar(1e-9);
+    return roundTrips;
+}
+
+void SharedMemoryBridge::PublishSensors(Scalar simulationTime)
+{
+    if(header == nullptr)
+        return;
+
+    ++tick;
+    for(size_t i=0; i<channels.size(); ++i)
+    {
+        RobotChannel& rc = channels[i];
+        uint64_t head = rc.sensorRing->head.load(std::memory_order_relaxed);
+        if(head - rc.sensorRing->tail.load(std::memory_order_acquire) >= capacity)
+        {
+            rc.sensorRing->dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        uint8_t* slot = (uint8_t*)rc.sensorRing + sizeof(ShmRingHeader) + (head % capacity) * rc.layout.sensorFrameSize;
+        ShmSensorFrameHeader* frame = (ShmSensorFrameHeader*)slot;
+        uint64_t* sampleCounts = (uint64_t*)(slot + sizeof(ShmSensorFrameHeader));
+        double* values = (double*)(sampleCounts + rc.sensors.size());
+
+        for(size_t h=0; h<rc.sensors.size(); ++h)
+        {
+            ScalarSensor* sens = rc.sensors[h];
+            sampleCounts[h] = sens->getNumOfSamples();
+            for(unsigned short c=0; c<sens->getNumOfChannels(); ++c)
+                *(values++) = (double)sens->getLastValue(c);
+        }
+
+        rc.publishTime = GetTimeInNanoseconds();
+        frame->tick = tick;
+        frame->simulationTime = (double)simulationTime;
+        frame->publishTime = rc.publishTime;
+        rc.sensorRing->head.store(head + 1, std::memory_order_release);
+    }
+    header->tick.store(tick, std::memory_order_release);
+}
+
+void SharedMemoryBridge::ReceiveCommands()
+{
+    if(header == nullptr)
+        return;
+
+    for(size_t i=0; i<channels.size(); ++i)
+    {
+        RobotChannel& rc = channels[i];
+        uint64_t tail = rc.commandRing->tail.load(std::memory_order_relaxed);
+        uint64_t head = rc.commandRing->head.load(std::memory_order_acquire);
+
+        //Wait for the controller to respond to the last published frame
+        if(synchronous && rc.connected && tick > 0)
+        {
+            int64_t waitStart = GetTimeInNanoseconds();
+            while(true)
+            {
+                if(head > tail)
+                {
+                    const ShmCommandFrameHeader* last = (const ShmCommandFrameHeader*)((uint8_t*)rc.commandRing + sizeof(ShmRingHeader)
+                                                                                       + ((head - 1) % capacity) * rc.layout.commandFrameSize);
+                    if(last->tick >= tick)
+                        break;
+                }
+                if(GetTimeInNanoseconds() - waitStart > timeout)
+                {
+                    cWarning("Shared memory bridge '%s': no commands for robot '%s' received in time!", name.c_str(), rc.layout.name);
+                    rc.connected = false; //Stop waiting until the controller responds again
+                    break;
+                }
+                std::this_thread::yield();
+                head = rc.commandRing->head.load(std::memory_order_acquire);
+            }
+        }
+
+        //The head is written by the controller and cannot be trusted
+        if(head < tail) //Controller restarted its ring
+            tail = head;
+        else if(head - tail > capacity) //Older frames were overwritten
+        {
+            rc.commandRing->dropped.fetch_add(head - tail - capacity, std::memory_order_relaxed);
+            tail = head - capacity;
+        }
+
+        //Apply all pending frames in order
+        for(; tail < head; ++tail)
+        {
+            const uint8_t* slot = (const uint8_t*)rc.commandRing + sizeof(ShmRingHeader) + (tail % capacity) * rc.layout.commandFrameSize;
+            const ShmCommandFrameHeader* frame = (const ShmCommandFrameHeader*)slot;
+            const ShmActuatorCommand* cmds = (const ShmActuatorCommand*)(slot + sizeof(ShmCommandFrameHeader));
+
+            for(size_t h=0; h<rc.actuators.size(); ++h)
+                if(cmds[h].flags & SF_SHM_COMMAND_VALID)
+                    ApplyCommand(rc.actuators[h], cmds[h]);
+
+            if(frame->tick == tick && tick > 0)
+            {
+                int64_t latency = GetTimeInNanoseconds() - rc.publishTime;
+                latencySum += latency;
+                latencyMax = btMax(latencyMax, latency);
+                ++roundTrips;
+            }
+            rc.connected = true;
+        }
+        rc.commandRing->tail.store(tail, std::memory_order_release);
+    }
+}
+
+void SharedMemoryBridge::ApplyCommand(Actuator* act, const ShmActuatorCommand& cmd)
+{
+    Scalar v0 = (Scalar)cmd.value[0];
+    Scalar v1 = (Scalar)cmd.value[1];
+
+    switch(act->getType())
+    {
+        case ActuatorType::MOTOR:
+            ((Motor*)act)->setCommand(v0);
+            break;
+
+        case ActuatorType::SERVO:
+        {
+            Servo* srv = (Servo*)act;
+            if(cmd.mode == 1)
+            {
+                srv->setControlMode(ServoControlMode::VELOCITY);
+                srv->setDesiredVelocity(v0);
+            }
+            else
+            {
+                srv->setControlMode(ServoControlMode::POSITION);
+                srv->setDesiredPosition(v0);
+            }
+        }
+            break;
+
+        case ActuatorType::PROPELLER:
+            ((Propeller*)act)->setSetpoint(v0);
+            break;
+
+        case ActuatorType::THRUSTER:
+            ((Thruster*)act)->setSetpoint(v0);
+            break;
+
+        case ActuatorType::RUDDER:
+            ((Rudder*)act)->setSetpoint(v0);
+            break;
+
+        case ActuatorType::VBS:
+            ((VariableBuoyancy*)act)->setFlowRate(v0);
+            break;
+
+        case ActuatorType::LIGHT:
+            ((Light*)act)->Switch(v0 > Scalar(0.5));
+            break;
+
+        case ActuatorType::SUCTION_CUP:
+            ((SuctionCup*)act)->setPump(v0 > Scalar(0.5));
+            break;
+
+        case ActuatorType::PUSH:
+            ((Push*)act)->setForce(v0);
+            break;
+
+        case ActuatorType::SIMPLE_THRUSTER:
+            ((SimpleThruster*)act)->setSetpoint(v0, v1);
+            break;
+    }
+}
+
+}
@@ -0,0 +1,262 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SharedMemoryClient.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/SharedMemoryClient.h"
+
+#include <cstring>
+#include <chrono>
+#include <thread>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "utils/SystemUtil.hpp"
+
+namespace sf
+{
+
+SharedMemoryClient::SharedMemoryClient() : mapping(nullptr), mappingSize(0), header(nullptr)
+{
+#ifdef _WIN32
+    mappingHandle = nullptr;
+#endif
+}
+
+SharedMemoryClient::~SharedMemoryClient()
+{
+    Disconnect();
+}
+
+bool SharedMemoryClient::Connect(const std::string& name, Scalar timeout)
+{
+    Disconnect();
+    int64_t start = GetTimeInNanoseconds();
+
+    while(true)
+    {
+#ifdef _WIN32
+        std::string shmName = "Local\\" + name;
+        mappingHandle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, shmName.c_str());
+        if(mappingHandle != NULL)
+        {
+            mapping = (uint8_t*)MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+            if(mapping != nullptr)
+            {
+                MEMORY_BASIC_INFORMATION info;
+                VirtualQuery(mapping, &info, sizeof(info));
+                mappingSize = (size_t)info.RegionSize;
+            }
+        }
+#else
+        std::string shmName = "/" + name;
+        int fd = shm_open(shmName.c_str(), O_RDWR, 0600);
+        if(fd >= 0)
+        {
+            struct stat st;
+            if(fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(ShmHeader))
+            {
+                void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if(ptr != MAP_FAILED)
+                {
+                    mapping = (uint8_t*)ptr;
+                    mappingSize = (size_t)st.st_size;
+                }
+            }
+            close(fd);
+        }
+#endif
+        if(mapping != nullptr)
+        {
+            ShmHeader* hdr = (ShmHeader*)mapping;
+            if(hdr->open.load(std::memory_order_acquire) == 1 && hdr->magic == SF_SHM_MAGIC
+               && hdr->version == SF_SHM_VERSION && hdr->size <= mappingSize)
+            {
+                header = hdr;
+                return true;
+            }
+            Disconnect(); //Not ready yet or incompatible
+        }
+
+        if(GetTimeInNanoseconds() - start >= (int64_t)(timeout * Scalar(1e9)))
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+void SharedMemoryClient::Disconnect()
+{
+#ifdef _WIN32
+    if(mapping != nullptr)
+        UnmapViewOfFile(mapping);
+    if(mappingHandle != NULL)
+        CloseHandle(mappingHandle);
+    mappingHandle = nullptr;
+#else
+    if(mapping != nullptr)
+        munmap(mapping, mappingSize);
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+    header = nullptr;
+}
+
+bool SharedMemoryClient::isConnected() const
+{
+    return header != nullptr && header->open.load(std::memory_order_acquire) == 1;
+}
+
+unsigned int SharedMemoryClient::getNumOfRobots() const
+{
+    return header != nullptr ? header->numRobots : 0;
+}
+
+const ShmRobotDescriptor* SharedMemoryClient::getRobot(unsigned int robot) const
+{
+    if(header == nullptr || robot >= header->numRobots)
+        return nullptr;
+    return (const ShmRobotDescriptor*)(mapping + sizeof(ShmHeader)) + robot;
+}
+
+const ShmSensorDescriptor* SharedMemoryClient::getSensor(unsigned int robot, unsigned int sensor) const
+{
+    const ShmRobotDescriptor* r = getRobot(robot);
+    if(r == nullptr || sensor >= r->numSensors)
+        return nullptr;
+    return (const ShmSensorDescriptor*)(mapping + r->sensorDescOffset) + sensor;
+}
+
+const ShmActuatorDescriptor* SharedMemoryClient::getActuator(unsigned int robot, unsigned int actuator) const
+{
+    const ShmRobotDescriptor* r = getRobot(robot);
+    if(r == nullptr || actuator >= r->numActuators)
+        return nullptr;
+    return (const ShmActuatorDescriptor*)(mapping + r->actuatorDescOffset) + actuator;
+}
+
+int SharedMemoryClient::getRobotIndex(const std::string& name) const
+{
+    for(unsigned int i=0; i<getNumOfRobots(); ++i)
+        if(name == getRobot(i)->name)
+            return (int)i;
+    return -1;
+}
+
+int SharedMemoryClient::getSensorIndex(unsigned int robot, const std::string& name) const
+{
+    const ShmRobotDescriptor* r = getRobot(robot);
+    for(unsigned int i=0; r != nullptr && i<r->numSensors; ++i)
+        if(name == getSensor(robot, i)->name)
+            return (int)i;
+    return -1;
+}
+
+int SharedMemoryClient::getActuatorIndex(unsigned int robot, const std::string& name) const
+{
+    const ShmRobotDescriptor* r = getRobot(robot);
+    for(unsigned int i=0; r != nullptr && i<r->numActuators; ++i)
+        if(name == getActuator(robot, i)->name)
+            return (int)i;
+    return -1;
+}
+
+const uint64_t* SharedMemoryClient::getSampleCounts(const ShmSensorFrameHeader* frame)
+{
+    return (const uint64_t*)((const uint8_t*)frame + sizeof(ShmSensorFrameHeader));
+}
+
+const double* SharedMemoryClient::getChannels(const ShmSensorFrameHeader* frame, unsigned int numSensors)
+{
+    return (const double*)(getSampleCounts(frame) + numSensors);
+}
+
+const ShmSensorFrameHeader* SharedMemoryClient::AcquireSensorFrame(unsigned int robot, bool latest)
+{
+    const ShmRobotDescriptor* r = getRobot(robot);
+    if(r == nullptr)
+        return nullptr;
+
+    ShmRingHeader* ring = (ShmRingHeader*)(mapping + r->sensorRingOffset);
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    if(head == tail)
+        return nullptr;
+
+    if(latest && head - tail > 1) //Skip older frames
+    {
+        tail = head - 1;
+        ring->tail.store(tail, std::memory_order_release);
+    }
+    return (const ShmSensorFrameHeader*)(mapping + r->sensorRingOffset + sizeof(ShmRingHeader) + (tail % header->ringCapacity) * r->sensorFrameSize);
+}
+
+void SharedMemoryClient::ReleaseSensorFrame(unsigned int robot)
+{
+    const ShmRobotDescriptor* r = getRobot(robot);
+    if(r == nullptr)
+        return;
+
+    ShmRingHeader* ring = (ShmRingHeader*)(mapping + r->sensorRingOffset);
+    uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    if(tail < ring->head.load(std::memory_order_acquire))
+        ring->tail.store(tail + 1, std::memory_order_release);
+}
+
+ShmActuatorCommand* SharedMemoryClient::AcquireCommandFrame(unsigned int robot, uint64_t tick)
+{
+    const ShmRobotDescriptor* r = getRobot(robot);
+    if(r == nullptr)
+        return nullptr;
+
+    ShmRingHeader* ring = (ShmRingHeader*)(mapping + r->commandRingOffset);
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    if(head - ring->tail.load(std::memory_order_acquire) >= header->ringCapacity)
+        return nullptr;
+
+    uint8_t* slot = mapping + r->commandRingOffset + sizeof(ShmRingHeader) + (head % header->ringCapacity) * r->commandFrameSize;
+    ShmCommandFrameHeader* frame = (ShmCommandFrameHeader*)slot;
+    frame->tick = tick;
+    ShmActuatorCommand* cmds = (ShmActuatorCommand*)(slot + sizeof(ShmCommandFrameHeader));
+    memset(cmds, 0, r->numActuators * sizeof(ShmActuatorCommand));
+    return cmds;
+}
+
+void SharedMemoryClient::CommitCommandFrame(unsigned int robot)
+{
+    const ShmRobotDescriptor* r = getRobot(robot);
+    if(r == nullptr)
+        return;
+
+    ShmRingHeader* ring = (ShmRingHeader*)(mapping + r->commandRingOffset);
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    ShmCommandFrameHeader* frame = (ShmCommandFrameHeader*)(mapping + r->commandRingOffset + sizeof(ShmRingHeader) + (head % header->ringCapacity) * r->commandFrameSize);
+    frame->sendTime = GetTimeInNanoseconds();
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+}
@@ -32,7 +32,7 @@ namespace sf
 {
 
 SimulationApp::SimulationApp(std::string title, std::string dataDirPath, SimulationManager* sim)
-    : console_{new Console()}, startTime_{0}, autostep_{true}, timeStep_{Scalar(0)}, state_{SimulationState::NOT_READY},
+    : console_{new Console(true, true, CONSOLE_HISTORY_LENGTH)}, startTime_{0}, autostep_{true}, timeStep_{Scalar(0)}, state_{SimulationState::NOT_READY},
       simManager_{sim}, title_{title}, dataPath_{dataDirPath}, physicsTime_{0.0}
 {
     SimulationApp::handle = this;
@@ -39,6 +39,9 @@
 #include <typeinfo>
 #include <algorithm>
 #include "core/FilteredCollisionDispatcher.h"
+#include "core/TorusCollisionAlgorithm.h"
+#include "core/SharedMemoryBridge.h"
+#include "core/CommandJournal.h"
 #include "core/GraphicalSimulationApp.h"
 #include "core/NameManager.h"
 #include "core/MaterialManager.h"
@@ -61,6 +64,7 @@
 #include "entities/ForcefieldEntity.h"
 #include "entities/forcefields/Trigger.h"
 #include "entities/statics/Plane.h"
+#include "entities/statics/TiledTerrain.h"
 #include "joints/Joint.h"
 #include "actuators/Actuator.h"
 #include "actuators/Light.h"
@@ -103,9 +107,15 @@ SimulationManager::SimulationManager(Scalar stepsPerSecond, Solver st, Collision
     dwDispatcher = nullptr;
     ocean = nullptr;
     atmosphere = nullptr;
+    shmSettings = nullptr;
+    shmBridge = nullptr;
+    journalMode = JournalMode::RECORD;
+    journal = nullptr;
     trackball = nullptr;
+    contactIndexValid = false;
     sdm = DisplayMode::GRAPHICAL;
     simHydroMutex = SDL_CreateMutex();
+    simOverrideMutex = SDL_CreateMutex();
     simSettingsMutex = SDL_CreateMutex();
     simInfoMutex = SDL_CreateMutex();
     setStepsPerSecond(stepsPerSecond);
@@ -125,9 +135,11 @@ SimulationManager::~SimulationManager()
 {
     DestroyScenario();
     if(atmosphere != nullptr) delete atmosphere;
+    if(shmSettings != nullptr) delete shmSettings;
     SDL_DestroyMutex(simSettingsMutex);
     SDL_DestroyMutex(simInfoMutex);
     SDL_DestroyMutex(simHydroMutex);
+    SDL_DestroyMutex(simOverrideMutex);
     delete materialManager;
     delete nameManager;
     delete ned;
@@ -227,6 +239,15 @@ void SimulationManager::EnableOcean(Scalar waves, Fluid f)
     }
     
     bool hasGraphics = SimulationApp::getApp()->hasGraphics();
+    if(hasGraphics && waves > Scalar(0))
+    {
+        RenderSettings s = ((GraphicalSimulationApp*)SimulationApp::getApp())->getRenderSettings();
+        if(s.offscreen && s.ocean == RenderQuality::DISABLED)
+        {
+            cWarning("Offscreen ocean rendering disabled - waves will not be simulated!");
+            waves = Scalar(0);
+        }
+    }
 
     ocean = new Ocean("Ocean", hasGraphics ? waves : 0.0, f);
     ocean->AddToSimulation(this);
@@ -256,6 +277,77 @@ void SimulationManager::EnableAtmosphere()
     }
 }
 
+void SimulationManager::EnableSharedMemoryBridge(const SharedMemoryBridgeSettings& settings)
+{
+    if(shmSettings != nullptr)
+        delete shmSettings;
+    shmSettings = new SharedMemoryBridgeSettings(settings);
+}
+
+void SimulationManager::EnableCommandJournal(const std::string& path, JournalMode mode)
+{
+    journalPath = path;
+    journalMode = mode;
+}
+
+void SimulationManager::ApplyExternalWrench(SolidEntity* solid, const Vector3& force, const Vector3& torque)
+{
+    ExternalOverride o;
+    o.solid = solid;
+    o.type = OverrideType::WRENCH;
+    o.force = force;
+    o.torque = torque;
+    SDL_LockMutex(simOverrideMutex);
+    overrides.push_back(o);
+    SDL_UnlockMutex(simOverrideMutex);
+}
+
+void SimulationManager::OverridePose(SolidEntity* solid, const Transform& pose)
+{
+    if(solid->getRigidBody() == nullptr)
+    {
+        cError("Pose override is not supported for multibody links (%s)!", solid->getName().c_str());
+        return;
+    }
+    
+    ExternalOverride o;
+    o.solid = solid;
+    o.type = OverrideType::POSE;
+    o.pose = pose;
+    SDL_LockMutex(simOverrideMutex);
+    overrides.push_back(o);
+    SDL_UnlockMutex(simOverrideMutex);
+}
+
+void SimulationManager::ApplyExternalOverrides()
+{
+    std::vector<ExternalOverride> tickOverrides;
+    SDL_LockMutex(simOverrideMutex);
+    tickOverrides.swap(overrides);
+    SDL_UnlockMutex(simOverrideMutex);
+    
+    //Record or replace with the recorded ones
+    if(journal != nullptr)
+        journal->BeginTick(tickOverrides);
+    
+    for(size_t i = 0; i < tickOverrides.size(); ++i)
+    {
+        const ExternalOverride& o = tickOverrides[i];
+        if(o.type == OverrideType::WRENCH)
+        {
+            o.solid->ApplyCentralForce(o.force);
+            o.solid->ApplyTorque(o.torque);
+        }
+        else
+        {
+            btRigidBody* rb = o.solid->getRigidBody();
+            rb->setCenterOfMassTransform(o.pose);
+            rb->getMotionState()->setWorldTransform(o.pose);
+            rb->activate(true);
+        }
+    }
+}
+
 void SimulationManager::AddSensor(Sensor* sens)
 {
     if(sens != nullptr)
@@ -372,6 +464,41 @@ Contact* SimulationManager::getContact(Entity* entA, Entity* entB)
     return nullptr;
 }
 
+const std::vector<btPersistentManifold*>& SimulationManager::getContactManifolds(const Entity* ent)
+{
+    static const std::vector<btPersistentManifold*> none;
+    
+    if(!contactIndexValid)
+        BuildContactIndex();
+    
+    auto it = contactIndex.find(ent);
+    return it != contactIndex.end() ? it->second : none;
+}
+
+void SimulationManager::BuildContactIndex()
+{
+    //Keep the lists of known entities to reuse their memory
+    for(auto it = contactIndex.begin(); it != contactIndex.end(); ++it)
+        it->second.clear();
+    
+    btDispatcher* dispatcher = dynamicsWorld->getDispatcher();
+    int numManifolds = dispatcher->getNumManifolds();
+    for(int i=0; i<numManifolds; ++i)
+    {
+        btPersistentManifold* contactManifold = dispatcher->getManifoldByIndexInternal(i);
+        if(contactManifold->getNumContacts() == 0)
+            continue;
+        
+        const Entity* entA = (const Entity*)contactManifold->getBody0()->getUserPointer();
+        const Entity* entB = (const Entity*)contactManifold->getBody1()->getUserPointer();
+        if(entA != nullptr)
+            contactIndex[entA].push_back(contactManifold);
+        if(entB != nullptr && entB != entA)
+            contactIndex[entB].push_back(contactManifold);
+    }
+    contactIndexValid = true;
+}
+
 Contact* SimulationManager::getContact(unsigned int index)
 {
     if(index < contacts.size())
@@ -516,6 +643,16 @@ Atmosphere* SimulationManager::getAtmosphere()
     return atmosphere;
 }
 
+SharedMemoryBridge* SimulationManager::getSharedMemoryBridge()
+{
+    return shmBridge;
+}
+
+CommandJournal* SimulationManager::getCommandJournal()
+{
+    return journal;
+}
+
 btSoftMultiBodyDynamicsWorld* SimulationManager::getDynamicsWorld()
 {
     return dynamicsWorld;
@@ -751,6 +888,7 @@ void SimulationManager::InitializeSolver()
             dwDispatcher = new FilteredCollisionDispatcher(dwCollisionConfig, false);
             break;
     }
+    TorusCollisionAlgorithm::Register(dwDispatcher);
     
     //Choose constraint solver
     if(solver == Solver::SI)
@@ -864,6 +1002,8 @@ void SimulationManager::InitializeScenario()
             GraphicalSimulationApp* gApp = (GraphicalSimulationApp*)SimulationApp::getApp();
             trackball = new OpenGLTrackball(glm::vec3(0.f,0.f,-1.f), 5.0, glm::vec3(0.f,0.f,-1.f), 0, 0, gApp->getWindowWidth(), gApp->getWindowHeight(), 90.f, glm::vec2(STD_NEAR_PLANE_DISTANCE, STD_FAR_PLANE_DISTANCE));
             trackball->Rotate(glm::quat(glm::eulerAngleYXZ(0.0, 0.0, 0.25)));
+            if(gApp->getRenderSettings().offscreen) //Nobody is looking
+                trackball->setEnabled(false);
             ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->AddView(trackball);
         }
     }
@@ -921,6 +1061,19 @@ void SimulationManager::DestroyScenario()
     }
     
     //remove sim manager objects
+    if(shmBridge != nullptr)
+    {
+        delete shmBridge;
+        shmBridge = nullptr;
+    }
+    
+    if(journal != nullptr)
+    {
+        delete journal;
+        journal = nullptr;
+    }
+    overrides.clear();
+    
     for(size_t i=0; i<robots.size(); ++i)
         delete robots[i];
     robots.clear();
@@ -948,6 +1101,8 @@ void SimulationManager::DestroyScenario()
     for(size_t i=0; i<contacts.size(); ++i)
         delete contacts[i];
     contacts.clear();
+    contactIndex.clear();
+    contactIndexValid = false;
     
     for(size_t i=0; i<sensors.size(); ++i)
         delete sensors[i];
@@ -993,6 +1148,13 @@ bool SimulationManager::StartSimulation()
     //Reset sensors
     for(unsigned int i = 0; i < sensors.size(); i++)
         sensors[i]->Reset();
+    
+    //Open command journal and shared memory bridge (kept until the scenario is destroyed)
+    if(!journalPath.empty() && journal == nullptr)
+        journal = new CommandJournal(this, journalPath, journalMode);
+    
+    if(shmSettings != nullptr && shmBridge == nullptr && (journal == nullptr || !journal->isReplaying()))
+        shmBridge = new SharedMemoryBridge(this, *shmSettings);
 
     perfMon.SimulationStarted();
     
@@ -1132,6 +1294,31 @@ void SimulationManager::StepSimulation(Scalar timeStep)
     }
 }
 
+void SimulationManager::Step(unsigned int n, bool callStepCompleted, const std::function<void(unsigned int, Scalar)>& callback)
+{
+    //Check if initial conditions solved
+    if(!icProblemSolved)
+        return;
+
+    //Each call to StepSimulation performs exactly one tick (sensors and comms updated in the post-tick)
+    Scalar dt = (Scalar)ssus/Scalar(1000000.0);
+    bool callInTick = getCallSimulationStepCompleted();
+    if(callInTick)
+        setCallSimulationStepCompleted(false);
+
+    for(unsigned int i=0; i<n; ++i)
+    {
+        StepSimulation(dt);
+        if(callStepCompleted)
+            SimulationStepCompleted(dt);
+        if(callback)
+            callback(i, dt);
+    }
+
+    if(callInTick)
+        setCallSimulationStepCompleted(true);
+}
+
 void SimulationManager::SimulationStepCompleted(Scalar timeStep)
 {
 #ifdef DEBUG
@@ -1521,11 +1708,21 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
         
     //Clear all forces to ensure that no summing occurs
     dynamicsWorld->clearForces(); //Includes clearing of multibody forces!
+    
+    //Apply commands of external controllers
+    if(simManager->shmBridge != nullptr)
+        simManager->shmBridge->ReceiveCommands();
+    
+    //Apply external forces and pose overrides (journal records or replays commands here)
+    simManager->ApplyExternalOverrides();
         
     //loop through all actuators -> apply forces to bodies (free and connected by joints)
     for(size_t i = 0; i < simManager->actuators.size(); ++i)
         simManager->actuators[i]->Update(timeStep);
     
+    if(simManager->journal != nullptr)
+        simManager->journal->ActuatorsUpdated();
+    
     //loop through all joints -> apply damping forces to bodies connected by joints
     for(size_t i = 0; i < simManager->joints.size(); ++i)
         simManager->joints[i]->ApplyDamping();
@@ -1551,33 +1748,6 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
             CableEntity* cable = (CableEntity*)ent;
             cable->ApplyGravity(dynamicsWorld->getGravity());
         }
-        else if(ent->getType() == EntityType::FORCEFIELD)
-        {
-            ForcefieldEntity* ff = (ForcefieldEntity*)ent;
-            if(ff->getForcefieldType() == ForcefieldType::TRIGGER)
-            {				
-                Trigger* trigger = (Trigger*)ff;
-                trigger->Clear();
-                btBroadphasePairArray& pairArray = trigger->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
-                int numPairs = pairArray.size();
-                    
-                for(int h = 0; h < numPairs; ++h)
-                {
-                    const btBroadphasePair& pair = pairArray[h];
-                    btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
-                    if(!colPair)
-                        continue;
-                    
-                    btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
-                    btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
-                
-                    if(co1 == trigger->getGhost())
-                        trigger->Activate(co2);
-                    else if(co2 == trigger->getGhost())
-                        trigger->Activate(co1);
-                }
-            }
-        }
     }
 
     //Geometry-based forces
@@ -1587,21 +1757,15 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
     //Aerodynamic forces
     if(simManager->atmosphere != nullptr)
     {
-        btBroadphasePairArray& pairArray = simManager->atmosphere->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
-        int numPairs = pairArray.size();
+        //Bodies overlapping the atmosphere are tracked by the broadphase
+        btGhostObject* ghost = simManager->atmosphere->getGhost();
+        int numBodies = ghost->getNumOverlappingObjects();
         
-        if(numPairs > 0)
+        if(numBodies > 0)
         {
-            for(int h=0; h<numPairs; ++h)
+            for(int h=0; h<numBodies; ++h)
             {
-                const btBroadphasePair& pair = pairArray[h];
-                btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
-                if (!colPair)
-                    continue;
-                    
-                btCollisionObject* candidate1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
-                btCollisionObject* candidate2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
-                btCollisionObject* co = candidate1 == simManager->atmosphere->getGhost() ? candidate2 : candidate1;
+                btCollisionObject* co = ghost->getOverlappingObject(h);
                 
                 if (threads != nullptr)
                     threads->enqueue([](SimulationManager* sim, btDynamicsWorld* world, btCollisionObject* co, bool recompute){
@@ -1622,21 +1786,19 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
         if(recompute) SDL_LockMutex(simManager->simHydroMutex);
         simManager->perfMon.HydrodynamicsStarted();
         
-        btBroadphasePairArray& pairArray = simManager->ocean->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
-        int numPairs = pairArray.size();
+        //Contacts are needed to detect hydrodynamic quiescence (the index has to be built before threads start)
+        if(recompute && simManager->ocean->isHydrodynamicsQuiescenceEnabled() && !simManager->contactIndexValid)
+            simManager->BuildContactIndex();
+        
+        //Bodies overlapping the ocean are tracked by the broadphase
+        btGhostObject* ghost = simManager->ocean->getGhost();
+        int numBodies = ghost->getNumOverlappingObjects();
         
-        if(numPairs > 0)
+        if(numBodies > 0)
         {
-            for(int h=0; h<numPairs; ++h)
+            for(int h=0; h<numBodies; ++h)
             {
-                const btBroadphasePair& pair = pairArray[h];
-                btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
-                if (!colPair)
-                    continue;
-                    
-                btCollisionObject* candidate1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
-                btCollisionObject* candidate2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
-                btCollisionObject* co = candidate1 == simManager->ocean->getGhost() ? candidate2 : candidate1;
+                btCollisionObject* co = ghost->getOverlappingObject(h);
                 
                 if (threads != nullptr)
                     threads->enqueue([](SimulationManager* sim, btDynamicsWorld* world, btCollisionObject* co, bool recompute){
@@ -1659,6 +1821,7 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
 void SimulationManager::SimulationPostTickCallback(btDynamicsWorld *world, Scalar timeStep)
 {
     SimulationManager* simManager = (SimulationManager*)world->getWorldUserInfo();
+    simManager->contactIndexValid = false; //Manifolds changed during the step
     
     //Update motion data
     for(size_t i = 0; i < simManager->entities.size(); ++i)
@@ -1680,6 +1843,11 @@ void SimulationManager::SimulationPostTickCallback(btDynamicsWorld *world, Scala
             AnimatedEntity* anim = (AnimatedEntity*)ent;
             anim->Update(timeStep);
         }
+        else if(ent->getType() == EntityType::STATIC && ((StaticEntity*)ent)->getStaticType() == StaticEntityType::TILED_TERRAIN)
+        {
+            TiledTerrain* terrain = (TiledTerrain*)ent;
+            terrain->UpdateTiles(simManager);
+        }
     }
 
     //Special treatment of suction cup actuator
@@ -1699,26 +1867,35 @@ void SimulationManager::SimulationPostTickCallback(btDynamicsWorld *world, Scala
     for(size_t i = 0; i < simManager->comms.size(); ++i)
         simManager->comms[i]->ProcessMessages();
     
-    //Loop through contact manifolds -> update contacts
-    if(simManager->getContact(0) != nullptr) // If at least one contact is defined
+    //Loop through contacts -> add points from the manifolds of the first entity
+    for(size_t i = 0; i < simManager->contacts.size(); ++i)
     {
-        int numManifolds = world->getDispatcher()->getNumManifolds();
-        for(int i=0; i<numManifolds; ++i)
+        Contact* contact = simManager->contacts[i];
+        const std::vector<btPersistentManifold*>& manifolds = simManager->getContactManifolds(contact->getEntityA());
+        for(size_t h = 0; h < manifolds.size(); ++h)
         {
-            btPersistentManifold* contactManifold = world->getDispatcher()->getManifoldByIndexInternal(i);
-            btCollisionObject* coA = (btCollisionObject*)contactManifold->getBody0();
-            btCollisionObject* coB = (btCollisionObject*)contactManifold->getBody1();
-            Entity* entA = (Entity*)coA->getUserPointer();
-            Entity* entB = (Entity*)coB->getUserPointer();
-            Contact* contact = simManager->getContact(entA, entB);
-            if(contact != nullptr && contactManifold->getNumContacts() > 0)
-                contact->AddContactPoint(contactManifold, contact->getEntityA() != entA, timeStep);        
+            if(manifolds[h]->getNumContacts() == 0) //Could have been cleared by a suction cup
+                continue;
+            const Entity* entA = (const Entity*)manifolds[h]->getBody0()->getUserPointer();
+            const Entity* entB = (const Entity*)manifolds[h]->getBody1()->getUserPointer();
+            if(entA == contact->getEntityA() && entB == contact->getEntityB())
+                contact->AddContactPoint(manifolds[h], false, timeStep);
+            else if(entB == contact->getEntityA() && entA == contact->getEntityB())
+                contact->AddContactPoint(manifolds[h], true, timeStep);
         }
     }
 
     //Update simulation time
     simManager->simulationTime += timeStep;
     
+    //Publish measurements to external controllers
+    if(simManager->shmBridge != nullptr)
+        simManager->shmBridge->PublishSensors(simManager->simulationTime);
+    
+    //Close the tick in the command journal
+    if(simManager->journal != nullptr)
+        simManager->journal->EndTick();
+    
     //Optional method to update some post simulation data (like ROS messages...)
     if (simManager->getCallSimulationStepCompleted())
     {
@@ -0,0 +1,341 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  TorusCollisionAlgorithm.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/TorusCollisionAlgorithm.h"
+
+#include "BulletCollision/CollisionDispatch/btCollisionObjectWrapper.h"
+#include "BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h"
+#include "BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h"
+#include "BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h"
+#include "core/TorusShape.h"
+
+namespace sf
+{
+
+//The other shape expressed in the frame of the torus (centre at origin, axis Y)
+struct TorusPartner
+{
+    enum class Type {PLANE, POINT, SEGMENT, BOX} type;
+    Transform T; //Frame of the shape
+    Vector3 a; //Segment start or plane normal
+    Vector3 b; //Segment end or box half extents
+    Scalar offset; //Plane constant
+    Scalar radius; //Radius of the sphere swept over the core
+
+    bool Init(const btCollisionShape* shape, const Transform& trans)
+    {
+        T = trans;
+        switch(shape->getShapeType())
+        {
+            case SPHERE_SHAPE_PROXYTYPE:
+                type = Type::POINT;
+                radius = ((const btSphereShape*)shape)->getRadius();
+                return true;
+
+            case CAPSULE_SHAPE_PROXYTYPE:
+            {
+                const btCapsuleShape* capsule = (const btCapsuleShape*)shape;
+                Vector3 h(0,0,0);
+                h[capsule->getUpAxis()] = capsule->getHalfHeight();
+                type = Type::SEGMENT;
+                a = T(-h);
+                b = T(h);
+                radius = capsule->getRadius();
+            }
+                return true;
+
+            case BOX_SHAPE_PROXYTYPE:
+                type = Type::BOX;
+                b = ((const btBoxShape*)shape)->getHalfExtentsWithoutMargin();
+                radius = shape->getMargin();
+                return true;
+
+            case STATIC_PLANE_PROXYTYPE:
+            {
+                const btStaticPlaneShape* plane = (const btStaticPlaneShape*)shape;
+                type = Type::PLANE;
+                a = T.getBasis() * plane->getPlaneNormal();
+                offset = a.dot(T(plane->getPlaneNormal() * plane->getPlaneConstant()));
+                radius = Scalar(0);
+            }
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    Vector3 Center() const
+    {
+        return type == Type::SEGMENT ? (a + b)/Scalar(2) : T.getOrigin();
+    }
+
+    //Closest point of the core
+    Vector3 Project(const Vector3& p) const
+    {
+        switch(type)
+        {
+            case Type::SEGMENT:
+            {
+                Vector3 ab = b - a;
+                Scalar len2 = ab.length2();
+                Scalar t = len2 > SIMD_EPSILON ? btClamped((p - a).dot(ab)/len2, Scalar(0), Scalar(1)) : Scalar(0);
+                return a + ab * t;
+            }
+
+            case Type::BOX:
+            {
+                Vector3 local = T.invXform(p);
+                local.setMax(-b);
+                local.setMin(b);
+                return T(local);
+            }
+
+            case Type::PLANE:
+                return p - a * (a.dot(p) - offset);
+
+            default:
+                return T.getOrigin();
+        }
+    }
+};
+
+static Vector3 ClosestPointOnDisk(const Vector3& p, Scalar R)
+{
+    Scalar s = btSqrt(p.x()*p.x() + p.z()*p.z());
+    if(s > R)
+        return Vector3(p.x() * R/s, Scalar(0), p.z() * R/s);
+    return Vector3(p.x(), Scalar(0), p.z());
+}
+
+//Contact between the torus surface around a point of the core disk and the other shape (local frame of the torus)
+static bool ContactAtDiskPoint(const TorusPartner& partner, Scalar r, const Vector3& q, TorusContact& contact)
+{
+    if(partner.type == TorusPartner::Type::PLANE)
+    {
+        Scalar d = partner.a.dot(q) - partner.offset;
+        contact.normal = -partner.a;
+        contact.point = q - partner.a * d;
+        contact.distance = d - r;
+        return true;
+    }
+
+    Vector3 p = partner.Project(q);
+    Vector3 diff = p - q;
+    Scalar d = diff.length();
+    if(d > r * Scalar(1e-4))
+        contact.normal = diff/d;
+    else if(partner.type == TorusPartner::Type::POINT) //Sphere centred on the disk
+        contact.normal = Vector3(Scalar(0), p.y() < Scalar(0) ? Scalar(-1) : Scalar(1), Scalar(0));
+    else //Intersecting cores
+        return false;
+
+    contact.point = p - contact.normal * partner.radius;
+    contact.distance = d - r - partner.radius;
+    return true;
+}
+
+//Closest point of the core disk to the other shape (local frame of the torus)
+static Vector3 ClosestDiskPoint(const TorusPartner& partner, Scalar R)
+{
+    if(partner.type == TorusPartner::Type::PLANE) //Support point in the direction opposite to the plane normal
+    {
+        Vector3 u(-partner.a.x(), Scalar(0), -partner.a.z());
+        Scalar s = u.length();
+        return s > SIMD_EPSILON ? u * (R/s) : Vector3(R, Scalar(0), Scalar(0));
+    }
+
+    //Alternating projections converge to the closest points of two convex sets, but they zigzag slowly when the sets are almost parallel,
+    //so each step is extrapolated (alternately along the last step and the last two steps) as long as the distance keeps decreasing
+    Scalar tol2 = R * R * Scalar(1e-12);
+    Vector3 q = ClosestPointOnDisk(partner.Center(), R);
+    Vector3 qp = q;
+    for(unsigned int i=0; i<32; ++i)
+    {
+        Vector3 qn = ClosestPointOnDisk(partner.Project(q), R);
+        if(qn.distance2(q) < tol2)
+            break;
+        
+        Vector3 step = qn - (i % 2 == 1 ? qp : q);
+        Scalar d2 = partner.Project(qn).distance2(qn);
+        for(Scalar k = Scalar(1); k < Scalar(1000); k *= Scalar(2))
+        {
+            Vector3 qe = ClosestPointOnDisk(qn + step * k, R);
+            Scalar de2 = partner.Project(qe).distance2(qe);
+            if(de2 >= d2)
+                break;
+            qn = qe;
+            d2 = de2;
+        }
+        qp = q;
+        q = qn;
+    }
+    return q;
+}
+
+static void ToWorld(const Transform& torusTrans, TorusContact& contact)
+{
+    contact.normal = torusTrans.getBasis() * contact.normal;
+    contact.point = torusTrans(contact.point);
+}
+
+TorusCollisionAlgorithm::CreateFunc::CreateFunc(bool isSwapped)
+{
+    m_swapped = isSwapped;
+}
+
+btCollisionAlgorithm* TorusCollisionAlgorithm::CreateFunc::CreateCollisionAlgorithm(btCollisionAlgorithmConstructionInfo& ci,
+                                                                                   const btCollisionObjectWrapper* body0Wrap, const btCollisionObjectWrapper* body1Wrap)
+{
+    void* mem = ci.m_dispatcher1->allocateCollisionAlgorithm(sizeof(TorusCollisionAlgorithm));
+    return new(mem) TorusCollisionAlgorithm(nullptr, ci, body0Wrap, body1Wrap, m_swapped);
+}
+
+TorusCollisionAlgorithm::TorusCollisionAlgorithm(btPersistentManifold* mf, const btCollisionAlgorithmConstructionInfo& ci,
+                                                 const btCollisionObjectWrapper* body0Wrap, const btCollisionObjectWrapper* body1Wrap, bool isSwapped)
+    : btActivatingCollisionAlgorithm(ci, body0Wrap, body1Wrap), ownManifold(false), manifold(mf), swapped(isSwapped)
+{
+    if(manifold == nullptr)
+    {
+        manifold = m_dispatcher->getNewManifold(body0Wrap->getCollisionObject(), body1Wrap->getCollisionObject());
+        ownManifold = true;
+    }
+}
+
+TorusCollisionAlgorithm::~TorusCollisionAlgorithm()
+{
+    if(ownManifold && manifold != nullptr)
+        m_dispatcher->releaseManifold(manifold);
+}
+
+void TorusCollisionAlgorithm::getAllContactManifolds(btManifoldArray& manifoldArray)
+{
+    if(manifold != nullptr && ownManifold)
+        manifoldArray.push_back(manifold);
+}
+
+Scalar TorusCollisionAlgorithm::calculateTimeOfImpact(btCollisionObject* body0, btCollisionObject* body1,
+                                                      const btDispatcherInfo& dispatchInfo, btManifoldResult* resultOut)
+{
+    return Scalar(1);
+}
+
+void TorusCollisionAlgorithm::AddContact(const TorusContact& contact, btManifoldResult* resultOut)
+{
+    //The normal has to point from the second object to the first one and the point has to lie on the second object
+    if(swapped)
+        resultOut->addContactPoint(contact.normal, contact.point - contact.normal * contact.distance, contact.distance);
+    else
+        resultOut->addContactPoint(-contact.normal, contact.point, contact.distance);
+}
+
+void TorusCollisionAlgorithm::processCollision(const btCollisionObjectWrapper* body0Wrap, const btCollisionObjectWrapper* body1Wrap,
+                                               const btDispatcherInfo& dispatchInfo, btManifoldResult* resultOut)
+{
+    if(manifold == nullptr)
+        return;
+    resultOut->setPersistentManifold(manifold);
+
+    const btCollisionObjectWrapper* torusWrap = swapped ? body1Wrap : body0Wrap;
+    const btCollisionObjectWrapper* otherWrap = swapped ? body0Wrap : body1Wrap;
+    const TorusShape* torus = (const TorusShape*)torusWrap->getCollisionShape();
+    const Transform& torusTrans = torusWrap->getWorldTransform();
+    Scalar R = torus->getMajorRadius();
+    Scalar r = torus->getMinorRadius();
+    Scalar threshold = manifold->getContactBreakingThreshold();
+
+    TorusPartner partner;
+    TorusContact contact;
+    Vector3 q;
+    if(partner.Init(otherWrap->getCollisionShape(), torusTrans.inverseTimes(otherWrap->getWorldTransform()))
+       && ContactAtDiskPoint(partner, r, q = ClosestDiskPoint(partner, R), contact))
+    {
+        if(contact.distance < threshold)
+        {
+            Vector3 normal = contact.normal;
+            ToWorld(torusTrans, contact);
+            AddContact(contact, resultOut);
+
+            //Probe the rim of the disk at quarter turns, so that resting contacts are supported by multiple points
+            if(partner.type != TorusPartner::Type::POINT)
+            {
+                Scalar angle = btAtan2(q.z(), q.x());
+                bool onRim = q.x()*q.x() + q.z()*q.z() > R * R * Scalar(0.99);
+                for(unsigned int i=onRim ? 1 : 0; i<4; ++i)
+                {
+                    Scalar probeAngle = angle + i * SIMD_HALF_PI;
+                    TorusContact probe;
+                    if(ContactAtDiskPoint(partner, r, Vector3(btCos(probeAngle) * R, Scalar(0), btSin(probeAngle) * R), probe)
+                       && probe.distance < threshold && probe.normal.dot(normal) > Scalar(0.9))
+                    {
+                        ToWorld(torusTrans, probe);
+                        AddContact(probe, resultOut);
+                    }
+                }
+            }
+        }
+    }
+    else //Deep penetration (or unsupported shape)
+    {
+        btVoronoiSimplexSolver simplexSolver;
+        btGjkEpaPenetrationDepthSolver epaSolver;
+        btGjkPairDetector gjk((const btConvexShape*)body0Wrap->getCollisionShape(), (const btConvexShape*)body1Wrap->getCollisionShape(),
+                              &simplexSolver, &epaSolver);
+        btGjkPairDetector::ClosestPointInput input;
+        input.m_transformA = body0Wrap->getWorldTransform();
+        input.m_transformB = body1Wrap->getWorldTransform();
+        input.m_maximumDistanceSquared = BT_LARGE_FLOAT;
+        gjk.getClosestPoints(input, *resultOut, dispatchInfo.m_debugDraw);
+    }
+
+    if(ownManifold)
+        resultOut->refreshContactPoints();
+}
+
+bool TorusCollisionAlgorithm::ComputeContact(const TorusShape* torus, const Transform& torusTrans,
+                                             const btCollisionShape* shape, const Transform& shapeTrans, TorusContact& contact)
+{
+    TorusPartner partner;
+    if(!partner.Init(shape, torusTrans.inverseTimes(shapeTrans)))
+        return false;
+    Vector3 q = ClosestDiskPoint(partner, torus->getMajorRadius());
+    if(!ContactAtDiskPoint(partner, torus->getMinorRadius(), q, contact))
+        return false;
+    ToWorld(torusTrans, contact);
+    return true;
+}
+
+void TorusCollisionAlgorithm::Register(btCollisionDispatcher* dispatcher)
+{
+    static CreateFunc createFunc(false);
+    static CreateFunc swappedCreateFunc(true);
+    for(int type : {SPHERE_SHAPE_PROXYTYPE, BOX_SHAPE_PROXYTYPE, CAPSULE_SHAPE_PROXYTYPE, STATIC_PLANE_PROXYTYPE})
+    {
+        dispatcher->registerCollisionCreateFunc(CUSTOM_CONVEX_SHAPE_TYPE, type, &createFunc);
+        dispatcher->registerCollisionCreateFunc(type, CUSTOM_CONVEX_SHAPE_TYPE, &swappedCreateFunc);
+    }
+}
+
+}
@@ -75,9 +75,11 @@ void TorusShape::setLocalScaling(const Vector3& scaling)
     btConvexInternalShape::setLocalScaling(scaling);
 }
 
-Vector3 TorusShape::localGetSupportingVertex(const Vector3& vec)const
+Vector3 TorusShape::localGetSupportingVertex(const Vector3& vec0)const
 {
-    //Torus with Y principal axis
+    //Torus with Y principal axis (GJK passes directions which are not normalized)
+    Scalar len = vec0.length();
+    Vector3 vec = len > SIMD_EPSILON ? vec0/len : Vector3(1,0,0);
     Scalar s = btSqrt(vec[0]*vec[0] + vec[2]*vec[2]);
     Vector3 res;
     
@@ -98,9 +100,11 @@ Vector3 TorusShape::localGetSupportingVertex(const Vector3& vec)const
     return res;
 }
 
-Vector3 TorusShape::localGetSupportingVertexWithoutMargin(const Vector3& vec)const
+Vector3 TorusShape::localGetSupportingVertexWithoutMargin(const Vector3& vec0)const
 {
-    //Torus with Y principal axis
+    //Torus with Y principal axis (GJK passes directions which are not normalized)
+    Scalar len = vec0.length();
+    Vector3 vec = len > SIMD_EPSILON ? vec0/len : Vector3(1,0,0);
     Scalar s = btSqrt(vec[0]*vec[0] + vec[2]*vec[2]);
     Vector3 res;
     
@@ -123,10 +127,21 @@ Vector3 TorusShape::localGetSupportingVertexWithoutMargin(const Vector3& vec)con
 
 void TorusShape::batchedUnitVectorGetSupportingVertexWithoutMargin(const Vector3* vectors, Vector3* supportVerticesOut, int numVectors) const
 {
-    for (int i=0;i<numVectors;i++)
+    //Branch-free version of localGetSupportingVertexWithoutMargin, without virtual calls, which can be vectorised by the compiler
+    const Scalar R = m_majorRadius;
+    const Scalar r = m_minorRadius - getMargin();
+    const Scalar eps2 = SIMD_EPSILON * SIMD_EPSILON;
+    for(int i=0; i<numVectors; ++i)
     {
-        Vector3 support = localGetSupportingVertexWithoutMargin(vectors[i]);
-        supportVerticesOut[i].setValue(support.x(), support.y(), support.z());
+        const Scalar x = vectors[i].x();
+        const Scalar y = vectors[i].y();
+        const Scalar z = vectors[i].z();
+        const Scalar s2 = x*x + z*z;
+        const bool axial = s2 < eps2;
+        const Scalar radial = R/btSqrt(btMax(s2, eps2)) + r; //(R + r*s)/s
+        supportVerticesOut[i].setValue(axial ? R : x * radial,
+                                       axial ? (y < Scalar(0) ? -r : r) : r * y,
+                                       axial ? Scalar(0) : z * radial);
     }
 }
 
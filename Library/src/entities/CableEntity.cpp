@@ -28,6 +28,7 @@
 #include "core/SimulationManager.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLHelperArena.h"
 #include "entities/SolidEntity.h"
 #include "BulletSoftBody/btSoftBodyHelpers.h"
 #include "tinysplinecxx.h"
@@ -464,38 +465,38 @@ std::vector<Renderable> CableEntity::Render()
         items.push_back(item);
 
         // Hydrodynamic forces
-        if(phy_.mode == PhysicsMode::FLOATING || phy_.mode == PhysicsMode::SUBMERGED)
+        if((phy_.mode == PhysicsMode::FLOATING || phy_.mode == PhysicsMode::SUBMERGED)
+           && OpenGLHelperArena::isEnabled(RenderableType::FORCE_BUOYANCY))
         {
-
             Renderable itemFb;
             itemFb.type = RenderableType::FORCE_BUOYANCY;
             itemFb.model = glm::mat4(1.f);
-            itemFb.data = std::make_shared<std::vector<glm::vec3>>();
-            auto pointsFb = itemFb.getDataAsPoints();
+            std::vector<glm::vec3> pointsFb;
 
             Renderable itemFdq;
             itemFdq.type = RenderableType::FORCE_QUADRATIC_DRAG;
             itemFdq.model = glm::mat4(1.f);
-            itemFdq.data = std::make_shared<std::vector<glm::vec3>>();
-            auto pointsFdq = itemFdq.getDataAsPoints();
+            std::vector<glm::vec3> pointsFdq;
 
             Renderable itemFdf;
             itemFdf.type = RenderableType::FORCE_LINEAR_DRAG;
             itemFdf.model = glm::mat4(1.f);
-            itemFdf.data = std::make_shared<std::vector<glm::vec3>>();
-            auto pointsFdf = itemFdf.getDataAsPoints();
+            std::vector<glm::vec3> pointsFdf;
 
             for (size_t i = 0; i < cableBody_->m_nodes.size(); ++i)
             {
                 glm::vec3 p = glVectorFromVector(cableBody_->m_nodes[i].m_x);
-                pointsFb->push_back(p);
-                pointsFb->push_back(p + glVectorFromVector(nodalForces_[i].Fb));
-                pointsFdq->push_back(p);
-                pointsFdq->push_back(p + glVectorFromVector(nodalForces_[i].Fdq));
-                pointsFdf->push_back(p);
-                pointsFdf->push_back(p + glVectorFromVector(nodalForces_[i].Fdf));
+                pointsFb.push_back(p);
+                pointsFb.push_back(p + glVectorFromVector(nodalForces_[i].Fb));
+                pointsFdq.push_back(p);
+                pointsFdq.push_back(p + glVectorFromVector(nodalForces_[i].Fdq));
+                pointsFdf.push_back(p);
+                pointsFdf.push_back(p + glVectorFromVector(nodalForces_[i].Fdf));
             }
 
+            itemFb.data = OpenGLHelperArena::Store(pointsFb);
+            itemFdq.data = OpenGLHelperArena::Store(pointsFdq);
+            itemFdf.data = OpenGLHelperArena::Store(pointsFdf);
             items.push_back(itemFb);
             items.push_back(itemFdq);
             items.push_back(itemFdf);
@@ -25,9 +25,11 @@
 
 #include "entities/FeatherstoneEntity.h"
 
+#include <algorithm>
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "entities/StaticEntity.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -51,6 +53,7 @@ FeatherstoneEntity::FeatherstoneEntity(std::string uniqueName, unsigned int tota
     AddLink(baseSolid, Transform::getIdentity());
     
     baseRenderable = true;
+    jointTableValid = false;
 }
 
 FeatherstoneEntity::~FeatherstoneEntity()
@@ -233,6 +236,7 @@ void FeatherstoneEntity::setJointDamping(unsigned int index, Scalar constantFact
     }
     
     joints[index].velDamping = viscousFactor > Scalar(0) ? viscousFactor : Scalar(0);
+    jointTableValid = false;
 }
 
 FeatherstoneJoint FeatherstoneEntity::getJoint(unsigned int index)
@@ -310,6 +314,95 @@ Scalar FeatherstoneEntity::getJointTorque(unsigned int index)
         return multiBody->getJointTorque(joints[index].child - 1);
 }
 
+void FeatherstoneEntity::UpdateJointTable()
+{
+    //Offsets of the links in the velocity vector (1 DOF per moving joint)
+    std::vector<int> dofOffsets(multiBody->getNumLinks());
+    int dofs = 0;
+    for(int i=0; i<multiBody->getNumLinks(); ++i)
+    {
+        dofOffsets[i] = dofs;
+        dofs += multiBody->getLink(i).m_dofCount;
+    }
+    
+    movingJoints.clear();
+    movingLinks.clear();
+    movingDofs.clear();
+    movingSigDamping.clear();
+    movingVelDamping.clear();
+    for(unsigned int i=0; i<joints.size(); ++i)
+    {
+        if(joints[i].type != btMultibodyLink::eRevolute && joints[i].type != btMultibodyLink::ePrismatic)
+            continue;
+        
+        bool damped = joints[i].sigDamping >= SIMD_EPSILON || joints[i].velDamping >= SIMD_EPSILON;
+        movingJoints.push_back(i);
+        movingLinks.push_back((int)joints[i].child - 1);
+        movingDofs.push_back(dofOffsets[joints[i].child - 1]);
+        movingSigDamping.push_back(damped ? joints[i].sigDamping : Scalar(0));
+        movingVelDamping.push_back(damped ? joints[i].velDamping : Scalar(0));
+    }
+    efforts.resize(movingJoints.size(), Scalar(0));
+    jointTableValid = true;
+}
+
+void FeatherstoneEntity::getJointPositions(Scalar* positions)
+{
+    if(!jointTableValid)
+        UpdateJointTable();
+    
+    for(size_t i=0; i<movingLinks.size(); ++i)
+        positions[i] = multiBody->getJointPos(movingLinks[i]);
+}
+
+void FeatherstoneEntity::getJointVelocities(Scalar* velocities)
+{
+    if(!jointTableValid)
+        UpdateJointTable();
+    
+    const Scalar* vel = multiBody->getVelocityVector() + 6; //Skip base velocity
+    for(size_t i=0; i<movingDofs.size(); ++i)
+        velocities[i] = vel[movingDofs[i]];
+}
+
+void FeatherstoneEntity::getJointTorques(Scalar* torques)
+{
+    if(!jointTableValid)
+        UpdateJointTable();
+    
+    for(size_t i=0; i<movingLinks.size(); ++i)
+        torques[i] = multiBody->getJointTorque(movingLinks[i]);
+}
+
+void FeatherstoneEntity::getMotorForceTorques(Scalar* forceTorques)
+{
+    if(!jointTableValid)
+        UpdateJointTable();
+    
+    Scalar sps = SimulationApp::getApp()->getSimulationManager()->getStepsPerSecond();
+    for(size_t i=0; i<movingJoints.size(); ++i)
+    {
+        btMultiBodyJointMotor* motor = joints[movingJoints[i]].motor;
+        forceTorques[i] = motor != nullptr ? motor->getAppliedImpulse(0) * sps : Scalar(0);
+    }
+}
+
+void FeatherstoneEntity::setJointEfforts(const Scalar* e)
+{
+    if(!jointTableValid)
+        UpdateJointTable();
+    
+    std::copy(e, e + efforts.size(), efforts.begin());
+}
+
+void FeatherstoneEntity::getJointEfforts(Scalar* e)
+{
+    if(!jointTableValid)
+        UpdateJointTable();
+    
+    std::copy(efforts.begin(), efforts.end(), e);
+}
+
 void FeatherstoneEntity::setMaxMotorForceTorque(unsigned int index, Scalar maxT)
 {
     if(index >= joints.size())
@@ -329,6 +422,46 @@ Scalar FeatherstoneEntity::getMotorForceTorque(unsigned int index)
         return joints[index].motor->getAppliedImpulse(0) * SimulationApp::getApp()->getSimulationManager()->getStepsPerSecond();
 }
 
+void FeatherstoneEntity::getCommandState(std::vector<Scalar>& state)
+{
+    if(!jointTableValid)
+        UpdateJointTable();
+    
+    for(size_t i=0; i<joints.size(); ++i)
+    {
+        const FeatherstoneJoint& joint = joints[i];
+        if(joint.motor == nullptr)
+            continue;
+        
+        state.push_back(joint.motorPosition);
+        state.push_back(joint.motorKp);
+        state.push_back(joint.motorVelocity);
+        state.push_back(joint.motorKd);
+        state.push_back(joint.motor->getMaxAppliedImpulse());
+    }
+    state.insert(state.end(), efforts.begin(), efforts.end());
+}
+
+void FeatherstoneEntity::setCommandState(const Scalar* state)
+{
+    for(size_t i=0; i<joints.size(); ++i)
+    {
+        FeatherstoneJoint& joint = joints[i];
+        if(joint.motor == nullptr)
+            continue;
+        
+        joint.motorPosition = state[0];
+        joint.motorKp = state[1];
+        joint.motorVelocity = state[2];
+        joint.motorKd = state[3];
+        joint.motor->setPositionTarget(joint.motorPosition, joint.motorKp);
+        joint.motor->setVelocityTarget(joint.motorVelocity, joint.motorKd);
+        joint.motor->setMaxAppliedImpulse(state[4]);
+        state += 5;
+    }
+    setJointEfforts(state);
+}
+
 unsigned int FeatherstoneEntity::getJointFeedback(unsigned int index, Vector3& force, Vector3& torque)
 {
     if(index >= joints.size())
@@ -479,6 +612,7 @@ int FeatherstoneEntity::AddRevoluteJoint(std::string name, unsigned int parent,
     joint.feedback = new btMultiBodyJointFeedback();
     multiBody->getLink((int)child - 1).m_jointFeedback = joint.feedback;
     joints.push_back(joint);
+    jointTableValid = false;
     
     return ((int)joints.size() - 1);
 }
@@ -515,6 +649,7 @@ int FeatherstoneEntity::AddPrismaticJoint(std::string name, unsigned int parent,
     joint.feedback = new btMultiBodyJointFeedback();
     multiBody->getLink((int)child - 1).m_jointFeedback = joint.feedback;
     joints.push_back(joint);
+    jointTableValid = false;
     
     return ((int)joints.size() - 1);
 }
@@ -550,6 +685,7 @@ int FeatherstoneEntity::AddFixedJoint(std::string name, unsigned int parent, uns
     joint.feedback = new btMultiBodyJointFeedback();
     multiBody->getLink((int)child - 1).m_jointFeedback = joint.feedback;
     joints.push_back(joint);
+    jointTableValid = false;
     
     return ((int)joints.size() - 1);
 }
@@ -595,6 +731,8 @@ void FeatherstoneEntity::MotorPositionSetpoint(unsigned int index, Scalar pos, S
         pos = pos < joints[index].lowerLimit ? joints[index].lowerLimit : (pos > joints[index].upperLimit ? joints[index].upperLimit : pos);
     
     joints[index].motor->setPositionTarget(pos, kp);
+    joints[index].motorPosition = pos;
+    joints[index].motorKp = kp;
 }
 
 void FeatherstoneEntity::MotorVelocitySetpoint(unsigned int index, Scalar vel, Scalar kd)
@@ -606,6 +744,45 @@ void FeatherstoneEntity::MotorVelocitySetpoint(unsigned int index, Scalar vel, S
         return;
         
     joints[index].motor->setVelocityTarget(vel, kd);
+    joints[index].motorVelocity = vel;
+    joints[index].motorKd = kd;
+}
+
+void FeatherstoneEntity::MotorPositionSetpoints(const Scalar* positions, const Scalar* kp)
+{
+    if(!jointTableValid)
+        UpdateJointTable();
+    
+    for(size_t i=0; i<movingJoints.size(); ++i)
+    {
+        FeatherstoneJoint& joint = joints[movingJoints[i]];
+        if(joint.motor == nullptr)
+            continue;
+        
+        Scalar pos = positions[i];
+        if(joint.lowerLimit < joint.upperLimit) //Restrict to the joint limits
+            pos = pos < joint.lowerLimit ? joint.lowerLimit : (pos > joint.upperLimit ? joint.upperLimit : pos);
+        joint.motor->setPositionTarget(pos, kp[i]);
+        joint.motorPosition = pos;
+        joint.motorKp = kp[i];
+    }
+}
+
+void FeatherstoneEntity::MotorVelocitySetpoints(const Scalar* velocities, const Scalar* kd)
+{
+    if(!jointTableValid)
+        UpdateJointTable();
+    
+    for(size_t i=0; i<movingJoints.size(); ++i)
+    {
+        FeatherstoneJoint& joint = joints[movingJoints[i]];
+        if(joint.motor == nullptr)
+            continue;
+        
+        joint.motor->setVelocityTarget(velocities[i], kd[i]);
+        joint.motorVelocity = velocities[i];
+        joint.motorKd = kd[i];
+    }
 }
 
 void FeatherstoneEntity::DriveJoint(unsigned int index, Scalar forceTorque)
@@ -657,18 +834,20 @@ void FeatherstoneEntity::ApplyGravity(const Vector3& g)
 
 void FeatherstoneEntity::ApplyDamping()
 {
-    for(unsigned int i=0; i<joints.size(); ++i)
+    if(!jointTableValid)
+        UpdateJointTable();
+    
+    const Scalar* vel = multiBody->getVelocityVector() + 6; //Skip base velocity
+    for(size_t i=0; i<movingLinks.size(); ++i)
     {
-        if(joints[i].sigDamping >= SIMD_EPSILON || joints[i].velDamping >= SIMD_EPSILON) //If damping factors not equal zero
-        {
-            Scalar velocity = multiBody->getJointVel(joints[i].child - 1);
-            
-            if(btFabs(velocity) >= SIMD_EPSILON) //If velocity higher than zero
-            {
-                Scalar damping = - velocity/btFabs(velocity) * joints[i].sigDamping - velocity * joints[i].velDamping;
-                multiBody->addJointTorque(joints[i].child - 1, damping);
-            }
-        }
+        Scalar tau = efforts[i];
+        Scalar velocity = vel[movingDofs[i]];
+        
+        if(btFabs(velocity) >= SIMD_EPSILON) //If velocity higher than zero
+            tau += - velocity/btFabs(velocity) * movingSigDamping[i] - velocity * movingVelDamping[i];
+        
+        if(tau != Scalar(0))
+            multiBody->addJointTorque(movingLinks[i], tau);
     }
 }
 
@@ -719,11 +898,13 @@ std::vector<Renderable> FeatherstoneEntity::Render()
     }
     
     //Draw link axes
+    if(!OpenGLHelperArena::isEnabled(RenderableType::MULTIBODY_AXIS))
+        return items;
+    
     Renderable item;
     item.type = RenderableType::MULTIBODY_AXIS;
     item.model = glm::mat4(1.f);
-    item.data = std::make_shared<std::vector<glm::vec3>>();
-    auto points = item.getDataAsPoints();
+    auto& points = OpenGLHelperArena::Begin();
     
     for(size_t i = 1; i < links.size(); ++i)
     {
@@ -742,10 +923,11 @@ std::vector<Renderable> FeatherstoneEntity::Render()
             axisEnd += axisInWorld * Scalar(0.3);
         }
         
-        points->push_back(glm::vec3((GLfloat)pivot.x(), (GLfloat)pivot.y(), (GLfloat)pivot.z()));
-        points->push_back(glm::vec3((GLfloat)axisEnd.x(), (GLfloat)axisEnd.y(), (GLfloat)axisEnd.z()));
+        points.push_back(glm::vec3((GLfloat)pivot.x(), (GLfloat)pivot.y(), (GLfloat)pivot.z()));
+        points.push_back(glm::vec3((GLfloat)axisEnd.x(), (GLfloat)axisEnd.y(), (GLfloat)axisEnd.z()));
     }
     
+    item.data = OpenGLHelperArena::Commit();
     items.push_back(item);
     
     return items;
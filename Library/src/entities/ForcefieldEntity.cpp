@@ -31,9 +31,43 @@
 namespace sf
 {
 
+ForcefieldGhost::ForcefieldGhost(ForcefieldEntity* owner) : owner(owner)
+{
+}
+
+void ForcefieldGhost::addOverlappingObjectInternal(btBroadphaseProxy* otherProxy, btBroadphaseProxy* thisProxy)
+{
+    btCollisionObject* co = (btCollisionObject*)otherProxy->m_clientObject;
+    if(!indices.emplace(co, m_overlappingObjects.size()).second)
+        return;
+    
+    m_overlappingObjects.push_back(co);
+    owner->BodyEntered(co);
+}
+
+void ForcefieldGhost::removeOverlappingObjectInternal(btBroadphaseProxy* otherProxy, btDispatcher* dispatcher, btBroadphaseProxy* thisProxy)
+{
+    btCollisionObject* co = (btCollisionObject*)otherProxy->m_clientObject;
+    auto it = indices.find(co);
+    if(it == indices.end())
+        return;
+    
+    //Move the last body in place of the removed one
+    int index = it->second;
+    indices.erase(it);
+    btCollisionObject* last = m_overlappingObjects[m_overlappingObjects.size()-1];
+    m_overlappingObjects.pop_back();
+    if(last != co)
+    {
+        m_overlappingObjects[index] = last;
+        indices[last] = index;
+    }
+    owner->BodyLeft(co);
+}
+
 ForcefieldEntity::ForcefieldEntity(std::string uniqueName) : Entity(uniqueName)
 {
-    ghost = new btPairCachingGhostObject();
+    ghost = new ForcefieldGhost(this);
     ghost->setCollisionFlags(btCollisionObject::CF_NO_CONTACT_RESPONSE);
 }
 
@@ -46,7 +80,7 @@ EntityType ForcefieldEntity::getType() const
     return EntityType::FORCEFIELD;
 }
 
-btPairCachingGhostObject* ForcefieldEntity::getGhost()
+btGhostObject* ForcefieldEntity::getGhost()
 {
     return ghost;
 }
@@ -56,6 +90,14 @@ void ForcefieldEntity::AddToSimulation(SimulationManager* sm)
     sm->getDynamicsWorld()->addCollisionObject(ghost, MASK_GHOST, MASK_DYNAMIC);
 }
 
+void ForcefieldEntity::BodyEntered(btCollisionObject* co)
+{
+}
+
+void ForcefieldEntity::BodyLeft(btCollisionObject* co)
+{
+}
+
 std::vector<Renderable> ForcefieldEntity::Render()
 {
     return std::vector<Renderable>(0);
@@ -29,6 +29,7 @@
 #include "core/SimulationManager.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLHelperArena.h"
 #include "utils/SystemUtil.hpp"
 #include "entities/forcefields/Ocean.h"
 #include "entities/forcefields/Atmosphere.h"
@@ -89,6 +90,12 @@ SolidEntity::SolidEntity(std::string uniqueName, PhysicsSettings phy, std::strin
     Tda.setZero();
     Swet = Scalar(0);
     Vsub = Scalar(0);
+    hydroStateValid = false;
+    hydroT = Transform::getIdentity();
+    hydroV.setZero();
+    hydroAppF.setZero();
+    hydroAppT.setZero();
+    hydroContacts = 0;
     lastV.setZero();
     lastOmega.setZero();
     linearAcc.setZero();
@@ -100,9 +107,6 @@ SolidEntity::SolidEntity(std::string uniqueName, PhysicsSettings phy, std::strin
     graObjectId = -1;
     phyObjectId = -1;
     dm = DisplayMode::GRAPHICAL;
-    submerged.type = RenderableType::HYDRO_LINES;
-    submerged.model = glm::mat4(1.f);
-    submerged.data = std::make_shared<std::vector<glm::vec3>>();
 }
 
 SolidEntity::~SolidEntity()
@@ -271,117 +275,117 @@ std::vector<Renderable> SolidEntity::Render()
         items.push_back(item3);
 
         //Forces
-        Vector3 cg = getCGTransform().getOrigin();
-        glm::vec3 cgv((GLfloat)cg.x(), (GLfloat)cg.y(), (GLfloat)cg.z());
-
-        //---Buoyancy
-        Renderable item4;
-        item4.type = RenderableType::FORCE_BUOYANCY;
-        item4.model = glm::mat4(1.f);
-        item4.data = std::make_shared<std::vector<glm::vec3>>();
-        auto points = item4.getDataAsPoints();
-        points->push_back(cgv);
-        points->push_back(cgv + glm::vec3((GLfloat)Fb.x(), (GLfloat)Fb.y(), (GLfloat)Fb.z())/1000.f);
-        items.push_back(item4);
+        if(OpenGLHelperArena::isEnabled(RenderableType::FORCE_BUOYANCY))
+        {
+            Vector3 cg = getCGTransform().getOrigin();
+            glm::vec3 cgv((GLfloat)cg.x(), (GLfloat)cg.y(), (GLfloat)cg.z());
+
+            //---Buoyancy
+            Renderable item4;
+            item4.type = RenderableType::FORCE_BUOYANCY;
+            item4.model = glm::mat4(1.f);
+            item4.data = OpenGLHelperArena::Store({cgv, cgv + glm::vec3((GLfloat)Fb.x(), (GLfloat)Fb.y(), (GLfloat)Fb.z())/1000.f});
+            items.push_back(item4);
         
-        //---Linear drag
-        Renderable item5;
-        item5.type = RenderableType::FORCE_LINEAR_DRAG;
-        item5.model = glm::mat4(1.f);
-        item5.data = std::make_shared<std::vector<glm::vec3>>();
-        points = item5.getDataAsPoints();
-        points->push_back(cgv);
-        points->push_back(cgv + glm::vec3((GLfloat)Fdf.x(), (GLfloat)Fdf.y(), (GLfloat)Fdf.z()));
-        items.push_back(item5);
-
-        //---Quadratic drag
-        Renderable item6;
-        item6.type = RenderableType::FORCE_QUADRATIC_DRAG;
-        item6.model = glm::mat4(1.f);
-        item6.data = std::make_shared<std::vector<glm::vec3>>();
-        points = item6.getDataAsPoints();
-        points->push_back(cgv);
-        points->push_back(cgv + glm::vec3((GLfloat)Fdq.x(), (GLfloat)Fdq.y(), (GLfloat)Fdq.z()));
-        items.push_back(item6);
+            //---Linear drag
+            Renderable item5;
+            item5.type = RenderableType::FORCE_LINEAR_DRAG;
+            item5.model = glm::mat4(1.f);
+            item5.data = OpenGLHelperArena::Store({cgv, cgv + glm::vec3((GLfloat)Fdf.x(), (GLfloat)Fdf.y(), (GLfloat)Fdf.z())});
+            items.push_back(item5);
+
+            //---Quadratic drag
+            Renderable item6;
+            item6.type = RenderableType::FORCE_QUADRATIC_DRAG;
+            item6.model = glm::mat4(1.f);
+            item6.data = OpenGLHelperArena::Store({cgv, cgv + glm::vec3((GLfloat)Fdq.x(), (GLfloat)Fdq.y(), (GLfloat)Fdq.z())});
+            items.push_back(item6);
+        }
 
         //Surface crossing debug
+        if(OpenGLHelperArena::isEnabled(RenderableType::HYDRO_LINES))
+        {
 #ifdef DEBUG_HYDRO
-        items.push_back(submerged);
+            Renderable submergedItem;
+            submergedItem.type = RenderableType::HYDRO_LINES;
+            submergedItem.model = glm::mat4(1.f);
+            submergedItem.data = OpenGLHelperArena::Store(submerged);
+            items.push_back(submergedItem);
 
-        //points = submerged.getDataAsPoints();
-        Renderable debugItem;
-        debugItem.type = RenderableType::HYDRO_LINES;
-        debugItem.model = glm::mat4(1.f);
-        debugItem.data = std::make_shared<std::vector<glm::vec3>>();
-        points = debugItem.getDataAsPoints();
+            Renderable debugItem;
+            debugItem.type = RenderableType::HYDRO_LINES;
+            debugItem.model = glm::mat4(1.f);
+            auto& points = OpenGLHelperArena::Begin();
 
-        Vector3 min, max;
-        getAABB(min, max);
+            Vector3 min, max;
+            getAABB(min, max);
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)min.z()));
+            points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)min.z()));
+            points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)min.z()));
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)min.z()));
+            points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)min.z()));
+            points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)min.z()));
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)max.z()));
+            points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)min.z()));
+            points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)max.z()));
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)max.z()));
+            points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)min.z()));
+            points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)max.z()));
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)max.z()));
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)max.z()));
+            points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)max.z()));
+            points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)max.z()));
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)max.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)max.z()));
+            points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)max.z()));
+            points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)max.z()));
 
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)max.z()));
+            points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)min.z()));
+            points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)max.z()));
 
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)min.z()));
+            points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)min.z()));
+            points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)min.z()));
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)min.z()));
+            points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)min.z()));
+            points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)min.z()));
 
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)max.z()));
+            points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)min.z()));
+            points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)max.z()));
 
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)max.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)max.z()));
+            points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)max.z()));
+            points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)max.z()));
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)max.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)max.z()));
+            points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)max.z()));
+            points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)max.z()));
 
-        items.push_back(debugItem);
+            debugItem.data = OpenGLHelperArena::Commit();
+            items.push_back(debugItem);
 #else
-        //Geometry approximation
-        Renderable item7;
-        item7.model = glMatrixFromTransform(getHTransform());
-        item7.data = std::make_shared<std::vector<glm::vec3>>();
-        points = item7.getDataAsPoints();
-
-        switch(fdApproxType)
-        {    
-            case GeometryApproxType::SPHERE:
-                item7.type = RenderableType::HYDRO_ELLIPSOID;
-                points->push_back(glm::vec3((GLfloat)fdApproxParams[0], (GLfloat)fdApproxParams[0], (GLfloat)fdApproxParams[0]));
-                break;
+            //Geometry approximation
+            Renderable item7;
+            item7.model = glMatrixFromTransform(getHTransform());
+            auto& points = OpenGLHelperArena::Begin();
+
+            switch(fdApproxType)
+            {    
+                case GeometryApproxType::SPHERE:
+                    item7.type = RenderableType::HYDRO_ELLIPSOID;
+                    points.push_back(glm::vec3((GLfloat)fdApproxParams[0], (GLfloat)fdApproxParams[0], (GLfloat)fdApproxParams[0]));
+                    break;
                 
-            case GeometryApproxType::CYLINDER:
-                item7.type = RenderableType::HYDRO_CYLINDER;
-                points->push_back(glm::vec3((GLfloat)fdApproxParams[0], (GLfloat)fdApproxParams[0], (GLfloat)fdApproxParams[1]));
-                break;
-
-            case GeometryApproxType::AUTO:       
-            case GeometryApproxType::ELLIPSOID:
-                item7.type = RenderableType::HYDRO_ELLIPSOID;
-                points->push_back(glm::vec3((GLfloat)fdApproxParams[0], (GLfloat)fdApproxParams[1], (GLfloat)fdApproxParams[2]));
-                break;
-        }
-        items.push_back(item7);
+                case GeometryApproxType::CYLINDER:
+                    item7.type = RenderableType::HYDRO_CYLINDER;
+                    points.push_back(glm::vec3((GLfloat)fdApproxParams[0], (GLfloat)fdApproxParams[0], (GLfloat)fdApproxParams[1]));
+                    break;
+
+                case GeometryApproxType::AUTO:       
+                case GeometryApproxType::ELLIPSOID:
+                    item7.type = RenderableType::HYDRO_ELLIPSOID;
+                    points.push_back(glm::vec3((GLfloat)fdApproxParams[0], (GLfloat)fdApproxParams[1], (GLfloat)fdApproxParams[2]));
+                    break;
+            }
+            item7.data = OpenGLHelperArena::Commit();
+            items.push_back(item7);
 #endif
+        }
     }
     
     return items;
@@ -588,6 +592,26 @@ Vector3 SolidEntity::getAppliedForce()
         return V0();
 }
 
+Vector3 SolidEntity::getAppliedTorque()
+{
+    if(rigidBody != nullptr)
+    {
+        return rigidBody->getTotalTorque();
+    }
+    else if(multibodyCollider != nullptr)
+    {
+        btMultiBody* multiBody = multibodyCollider->m_multiBody;
+        int index = multibodyCollider->m_link;
+
+        if(index >= 0)
+            return multiBody->getLinkTorque(index);
+        else
+            return multiBody->getBaseTorque();
+    }
+    else
+        return V0();
+}
+
 void SolidEntity::getHydrodynamicForces(Vector3& Fb, Vector3& Tb, Vector3& Fd, Vector3& Td, Vector3& Ff, Vector3& Tf)
 {
     Fb = this->Fb;
@@ -1094,6 +1118,9 @@ void SolidEntity::BuildRigidBody(btDynamicsWorld* world)
             rigidBody->setContactStiffnessAndDamping(contactK, contactD);
 
         cInfo("Built rigid body %s [mass: %1.3lf; inertia: %1.3lf, %1.3lf, %1.3lf; volume: %1.1lf]", getName().c_str(), mass, Ipri.x(), Ipri.y(), Ipri.z(), volume*1e6);
+        
+        if(phy.reducedDrag)
+            BuildReducedDragModels();
     }
 }
 
@@ -1147,6 +1174,9 @@ void SolidEntity::BuildMultibodyLinkCollider(btMultiBody *mb, unsigned int child
         BuildGraphicalObject();
         
         cInfo("Built multibody link %s (mass[kg]: %1.3lf; inertia[kgm2]: %1.3lf, %1.3lf, %1.3lf; volume[cm3]: %1.1lf)", getName().c_str(), mass, Ipri.x(), Ipri.y(), Ipri.z(), volume*1e6);
+        
+        if(phy.reducedDrag)
+            BuildReducedDragModels();
     }
 }
 
@@ -1288,7 +1318,7 @@ void SolidEntity::CorrectHydrodynamicForces(Ocean* ocn, Vector3& _Fdq, Vector3&
 
 void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings& settings, const Mesh* mesh, Ocean* ocn, const Transform& T_CG, const Transform& T_C,
                                             const Vector3& _v, const Vector3& _omega, Vector3& _Fb, Vector3& _Tb, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf, 
-                                            Scalar& _Swet, Scalar& _Vsub, Renderable& debug)
+                                            Scalar& _Swet, Scalar& _Vsub, std::vector<glm::vec3>& debug, HydrodynamicsBuffers* buffers)
 {
     if(mesh == nullptr)
     {
@@ -1311,8 +1341,6 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
         return;
     }
 
-    auto debugPoints = debug.getDataAsPoints();
-
     //Computation with floats (geometry has float precision)
     glm::vec3 Fb(0.f);
     glm::vec3 Tb(0.f);
@@ -1333,6 +1361,17 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
     glm::vec3 p0 = p; //Point used as a center of mesh for volume calculation.
     p0.z = 0.f;       //When the robot is far from the world origin numerical erros would explode without translating the mesh data!
     
+    //Submerged faces used to compute damping forces
+    HydrodynamicsBuffers temp;
+    HydrodynamicsBuffers& buf = buffers != nullptr ? *buffers : temp;
+    std::vector<glm::vec3>& faceC = buf.faceC;
+    std::vector<glm::vec3>& faceN = buf.faceN;
+    std::vector<GLfloat>& faceA = buf.faceA;
+    std::vector<glm::vec3>& faceV = buf.faceV;
+    faceC.clear();
+    faceN.clear();
+    faceA.clear();
+    
     //Loop through all faces...
     for(size_t i=0; i<mesh->faces.size(); ++i)
     {
@@ -1388,12 +1427,12 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
                 fn1 = fn/len; //Normalised normal (length = 1)
                 A = len/2.f; //Area of the face (triangle)         
 #ifdef DEBUG_HYDRO
-                debugPoints->push_back(p1);
-                debugPoints->push_back(p2);
-                debugPoints->push_back(p2);
-                debugPoints->push_back(p3);
-                debugPoints->push_back(p3);
-                debugPoints->push_back(p1);
+                debug.push_back(p1);
+                debug.push_back(p2);
+                debug.push_back(p2);
+                debug.push_back(p3);
+                debug.push_back(p3);
+                debug.push_back(p1);
 #endif
             }
             else if(depth[2] < 0.f) //Two vertices above water (triangle)
@@ -1423,12 +1462,12 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
                 fn1 = fn/len; //Normalised normal (length = 1)
                 A = len/2.f; //Area of the face (triangle)         
 #ifdef DEBUG_HYDRO
-                debugPoints->push_back(p1);
-                debugPoints->push_back(p2);
-                debugPoints->push_back(p2);
-                debugPoints->push_back(p3);
-                debugPoints->push_back(p3);
-                debugPoints->push_back(p1);
+                debug.push_back(p1);
+                debug.push_back(p2);
+                debug.push_back(p2);
+                debug.push_back(p3);
+                debug.push_back(p3);
+                debug.push_back(p1);
 #endif
             }
             else //depth[1] >= 0 && depth[2] >= 0 --> Two vertices under water (quad = two triangles)
@@ -1470,14 +1509,14 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
                 A = (len + glm::length(glm::cross(fv3, fv4)))/2.f; //Quad
                 fn = fn1 * A;
 #ifdef DEBUG_HYDRO
-                debugPoints->push_back(p1);
-                debugPoints->push_back(p2);
-                debugPoints->push_back(p2);
-                debugPoints->push_back(p3);
-                debugPoints->push_back(p3);
-                debugPoints->push_back(p4);
-                debugPoints->push_back(p4);
-                debugPoints->push_back(p1);
+                debug.push_back(p1);
+                debug.push_back(p2);
+                debug.push_back(p2);
+                debug.push_back(p3);
+                debug.push_back(p3);
+                debug.push_back(p4);
+                debug.push_back(p4);
+                debug.push_back(p1);
 #endif  
             }
         }
@@ -1510,12 +1549,12 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
                 fn1 = fn/len; //Normalised normal (length = 1)
                 A = len/2.f; //Area of the face (triangle)
 #ifdef DEBUG_HYDRO
-                debugPoints->push_back(p1);
-                debugPoints->push_back(p2);
-                debugPoints->push_back(p2);
-                debugPoints->push_back(p3);
-                debugPoints->push_back(p3);
-                debugPoints->push_back(p1);
+                debug.push_back(p1);
+                debug.push_back(p2);
+                debug.push_back(p2);
+                debug.push_back(p3);
+                debug.push_back(p3);
+                debug.push_back(p1);
 #endif                
             }
             else
@@ -1556,14 +1595,14 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
                 A = (len + glm::length(glm::cross(fv3, fv4)))/2.f; //Quad
                 fn = fn1 * A;
 #ifdef DEBUG_HYDRO
-                debugPoints->push_back(p1);
-                debugPoints->push_back(p2);
-                debugPoints->push_back(p2);
-                debugPoints->push_back(p4);
-                debugPoints->push_back(p4);
-                debugPoints->push_back(p3);
-                debugPoints->push_back(p3);
-                debugPoints->push_back(p1);
+                debug.push_back(p1);
+                debug.push_back(p2);
+                debug.push_back(p2);
+                debug.push_back(p4);
+                debug.push_back(p4);
+                debug.push_back(p3);
+                debug.push_back(p3);
+                debug.push_back(p1);
 #endif                 
             }
         }
@@ -1605,14 +1644,14 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
             A = (len + glm::length(glm::cross(fv3, fv4)))/2.f; //Quad
             fn = fn1 * A;
 #ifdef DEBUG_HYDRO
-            debugPoints->push_back(p1);
-            debugPoints->push_back(p2);
-            debugPoints->push_back(p2);
-            debugPoints->push_back(p3);
-            debugPoints->push_back(p3);
-            debugPoints->push_back(p4);
-            debugPoints->push_back(p4);
-            debugPoints->push_back(p1);
+            debug.push_back(p1);
+            debug.push_back(p2);
+            debug.push_back(p2);
+            debug.push_back(p3);
+            debug.push_back(p3);
+            debug.push_back(p4);
+            debug.push_back(p4);
+            debug.push_back(p1);
 #endif             
         }
         else //All underwater
@@ -1637,12 +1676,12 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
             A = len/2.f; //Area of the face (triangle)
             fc = (p1+p2+p3)/3.f; //Face centroid
 #ifdef DEBUG_HYDRO
-            debugPoints->push_back(p1);
-            debugPoints->push_back(p2);
-            debugPoints->push_back(p2);
-            debugPoints->push_back(p3);
-            debugPoints->push_back(p3);
-            debugPoints->push_back(p1);
+            debug.push_back(p1);
+            debug.push_back(p2);
+            debug.push_back(p2);
+            debug.push_back(p3);
+            debug.push_back(p3);
+            debug.push_back(p1);
 #endif             
         }
 
@@ -1657,10 +1696,30 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
             Tb += glm::cross(fc-p, Fbi);
         }
         
-        //Damping force
+        //Damping force (computed after fluid velocity is known for all faces)
         if(settings.dampingForces)
         {
-            glm::vec3 vc = ocn->GetFluidVelocity(fc) - (v + glm::cross(omega, fc-p));
+            faceC.push_back(fc);
+            faceN.push_back(fn1);
+            faceA.push_back(A);
+        }
+
+        //Wetted surface area
+        Swet += A;
+    }
+
+    //Damping forces
+    if(settings.dampingForces)
+    {
+        ocn->GetFluidVelocity(faceC, faceV);
+
+        for(size_t i=0; i<faceC.size(); ++i)
+        {
+            const glm::vec3& fc = faceC[i];
+            const glm::vec3& fn1 = faceN[i];
+            GLfloat A = faceA[i];
+
+            glm::vec3 vc = faceV[i] - (v + glm::cross(omega, fc-p));
             GLfloat vc_n = glm::dot(vc, fn1);
             glm::vec3 vn = vc_n  * fn1; //Normal velocity
             glm::vec3 vt = vc - vn; //Tangent velocity
@@ -1681,9 +1740,6 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
                 Tdf += glm::cross(fc - p, skin);
             }
         }
-
-        //Wetted surface area
-        Swet += A;
     }
 
     //Buoyancy
@@ -1721,7 +1777,8 @@ void SolidEntity::ComputeHydrodynamicForcesSurface(const HydrodynamicsSettings&
 }
 
 void SolidEntity::ComputeHydrodynamicForcesSubmerged(const Mesh* mesh, Ocean* ocn, const Transform& T_CG, const Transform& T_C,
-                                              const Vector3& _v, const Vector3& _omega, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf)
+                                              const Vector3& _v, const Vector3& _omega, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf,
+                                              HydrodynamicsBuffers* buffers)
 {
     if(mesh == nullptr)
     {
@@ -1746,6 +1803,19 @@ void SolidEntity::ComputeHydrodynamicForcesSubmerged(const Mesh* mesh, Ocean* oc
     glm::vec3 p = glm::vec3(TCG[3]);
 
     //Loop through all faces...
+    HydrodynamicsBuffers temp;
+    HydrodynamicsBuffers& buf = buffers != nullptr ? *buffers : temp;
+    std::vector<glm::vec3>& faceC = buf.faceC;
+    std::vector<glm::vec3>& faceN = buf.faceN;
+    std::vector<GLfloat>& faceA = buf.faceA;
+    std::vector<glm::vec3>& faceV = buf.faceV;
+    faceC.clear();
+    faceN.clear();
+    faceA.clear();
+    faceC.reserve(mesh->faces.size());
+    faceN.reserve(mesh->faces.size());
+    faceA.reserve(mesh->faces.size());
+
     for(size_t i=0; i<mesh->faces.size(); ++i)
     {
         //Global coordinates
@@ -1763,12 +1833,22 @@ void SolidEntity::ComputeHydrodynamicForcesSubmerged(const Mesh* mesh, Ocean* oc
         GLfloat len = glm::length2(fn);
         if(len < 1e-12f) continue;
         len = glm::sqrt(len);
-        glm::vec3 fn1 = fn/len; //Normalised normal (length = 1)
-        GLfloat A = len/2.f; //Area of the face (triangle)
-        glm::vec3 fc = (p1+p2+p3)/3.f; //Face centroid
+        faceN.push_back(fn/len); //Normalised normal (length = 1)
+        faceA.push_back(len/2.f); //Area of the face (triangle)
+        faceC.push_back((p1+p2+p3)/3.f); //Face centroid
+    }
+
+    //Fluid velocity at all face centroids at once
+    ocn->GetFluidVelocity(faceC, faceV);
+
+    for(size_t i=0; i<faceC.size(); ++i)
+    {
+        const glm::vec3& fc = faceC[i];
+        const glm::vec3& fn1 = faceN[i];
+        GLfloat A = faceA[i];
      
         //Forces
-        glm::vec3 vc = ocn->GetFluidVelocity(fc) - (v + glm::cross(omega, fc-p));
+        glm::vec3 vc = faceV[i] - (v + glm::cross(omega, fc-p));
         GLfloat vc_n = glm::dot(vc, fn1);
         glm::vec3 vn = vc_n  * fn1; //Normal velocity
         glm::vec3 vt = vc - vn; //Tangent velocity
@@ -1796,13 +1876,240 @@ void SolidEntity::ComputeHydrodynamicForcesSubmerged(const Mesh* mesh, Ocean* oc
     _Tdf = Vector3(Tdf.x, Tdf.y, Tdf.z);
 }
 
+//Form drag of a single face, exposed to a relative flow of velocity vc
+static void AccumulateFormDrag(const glm::vec3& vc, const glm::vec3& n, GLfloat A, const glm::vec3& r, glm::vec3& F, glm::vec3& T)
+{
+    GLfloat vc_n = glm::dot(vc, n);
+    if(vc_n < -1e-12f) //If liquid is approaching the surface
+    {
+        glm::vec3 quadratic = vc * glm::length(vc) * -vc_n * A;
+        F += quadratic;
+        T += glm::cross(r, quadratic);
+    }
+}
+
+//Bilinear interpolation of a quantity tabulated over a latitude-longitude grid of directions
+template<typename T>
+static T SampleDirection(const std::vector<T>& table, unsigned int nLat, unsigned int nLon, const glm::vec3& d)
+{
+    GLfloat u = glm::acos(glm::clamp(d.z, -1.f, 1.f))/glm::pi<GLfloat>() * (GLfloat)nLat;
+    GLfloat v = glm::atan(d.y, d.x)/glm::two_pi<GLfloat>() * (GLfloat)nLon;
+    if(v < 0.f) 
+        v += (GLfloat)nLon;
+    unsigned int i0 = glm::min((unsigned int)u, nLat-1);
+    unsigned int j0 = glm::min((unsigned int)v, nLon-1);
+    unsigned int j1 = (j0 + 1) % nLon;
+    GLfloat fu = glm::clamp(u - (GLfloat)i0, 0.f, 1.f);
+    GLfloat fv = glm::clamp(v - (GLfloat)j0, 0.f, 1.f);
+    T a = glm::mix(table[i0*nLon + j0], table[i0*nLon + j1], fv);
+    T b = glm::mix(table[(i0+1)*nLon + j0], table[(i0+1)*nLon + j1], fv);
+    return glm::mix(a, b, fu);
+}
+
+//Ratio of the velocities below which the coupling of translation and rotation in the form drag is neglected
+#define REDUCED_DRAG_COUPLING_RATIO 0.01f
+
+//Forces and torques predicted by the reduced-order model (physics frame)
+static void EvaluateReducedDragModel(const ReducedDragModel& model, const glm::vec3& w, const glm::vec3& omega,
+                                     glm::vec3& Fdq, glm::vec3& Tdq, glm::vec3& Fdf, glm::vec3& Tdf)
+{
+    Fdq = glm::vec3(0.f);
+    Tdq = glm::vec3(0.f);
+    
+    GLfloat s = glm::length(w);
+    GLfloat W = glm::length(omega);
+    GLfloat sRot = W * model.length; //Highest velocity of a face due to rotation
+    
+    if(s <= 1e-6f && W <= 1e-6f)
+    {
+        //No form drag
+    }
+    else if(sRot <= REDUCED_DRAG_COUPLING_RATIO * s)
+    {
+        //Form drag due to the relative flow
+        glm::vec3 d = w/s;
+        glm::vec4 f = SampleDirection(model.flow, model.nLat, model.nLon, d);
+        GLfloat s3 = s*s*s;
+        Fdq += s3 * f.x * d;
+        Tdq += s3 * glm::cross(glm::vec3(f.y, f.z, f.w), d);
+    }
+    else if(s > REDUCED_DRAG_COUPLING_RATIO * sRot)
+    {
+        //Translation combined with rotation (coupled by the quadratic law): integration over faces
+        for(size_t h=0; h<model.faceR.size(); ++h)
+            AccumulateFormDrag(w - glm::cross(omega, model.faceR[h]), model.faceN[h], model.faceA[h], model.faceR[h], Fdq, Tdq);
+    }
+    else
+    {
+        //Form drag due to rotation
+        glm::vec3 e = omega/W;
+        GLfloat W3 = W*W*W;
+        Fdq += W3 * SampleDirection(model.rotF, model.nLat, model.nLon, e);
+        Tdq += W3 * SampleDirection(model.rotT, model.nLat, model.nLon, e);
+    }
+    
+    //Skin friction
+    Fdf = model.skinFv * w + model.skinFw * omega;
+    Tdf = model.skinTv * w + model.skinTw * omega;
+}
+
+void SolidEntity::BuildReducedDragModel(const Mesh* mesh, const Vector3& cg, ReducedDragModel& model)
+{
+    model = ReducedDragModel();
+    if(mesh == nullptr)
+        return;
+    
+    //Face properties in the physics frame, relative to CG (kept for the coupled translation and rotation)
+    glm::vec3 c = glVectorFromVector(cg);
+    std::vector<glm::vec3>& faceR = model.faceR;
+    std::vector<glm::vec3>& faceN = model.faceN;
+    std::vector<GLfloat>& faceA = model.faceA;
+    faceR.reserve(mesh->faces.size());
+    faceN.reserve(mesh->faces.size());
+    faceA.reserve(mesh->faces.size());
+    GLfloat& Lc = model.length;
+    
+    for(size_t i=0; i<mesh->faces.size(); ++i)
+    {
+        glm::vec3 p1 = mesh->getVertexPos(i, 0);
+        glm::vec3 p2 = mesh->getVertexPos(i, 1);
+        glm::vec3 p3 = mesh->getVertexPos(i, 2);
+        glm::vec3 fn = glm::cross(p2-p1, p3-p1);
+        GLfloat len = glm::length2(fn);
+        if(len < 1e-12f) continue;
+        len = glm::sqrt(len);
+        faceN.push_back(fn/len);
+        faceA.push_back(len/2.f);
+        faceR.push_back((p1+p2+p3)/3.f - c);
+        Lc = glm::max(Lc, glm::length(faceR.back()));
+    }
+    
+    //Skin friction (exact for a uniform flow): v_face = w + [r]x * omega
+    for(size_t i=0; i<faceR.size(); ++i)
+    {
+        const glm::vec3& r = faceR[i];
+        glm::mat3 P = glm::mat3(1.f) - glm::outerProduct(faceN[i], faceN[i]); //Tangent projection
+        glm::mat3 X(0.f, r.z, -r.y, -r.z, 0.f, r.x, r.y, -r.x, 0.f); //Cross product matrix (column major)
+        model.skinFv += faceA[i] * P;
+        model.skinFw += faceA[i] * P * X;
+        model.skinTv += faceA[i] * X * P;
+        model.skinTw += faceA[i] * X * P * X;
+    }
+    
+    //Form drag tabulated over directions
+    model.nLat = 24;
+    model.nLon = 48;
+    size_t nDir = (model.nLat + 1) * model.nLon;
+    model.flow.resize(nDir);
+    model.rotF.resize(nDir);
+    model.rotT.resize(nDir);
+    
+    for(unsigned int i=0; i<=model.nLat; ++i)
+    {
+        GLfloat theta = (GLfloat)i/(GLfloat)model.nLat * glm::pi<GLfloat>();
+        for(unsigned int j=0; j<model.nLon; ++j)
+        {
+            GLfloat phi = (GLfloat)j/(GLfloat)model.nLon * glm::two_pi<GLfloat>();
+            glm::vec3 d(glm::sin(theta) * glm::cos(phi), glm::sin(theta) * glm::sin(phi), glm::cos(theta));
+            
+            GLfloat area(0.f);
+            glm::vec3 moment(0.f);
+            glm::vec3 F(0.f);
+            glm::vec3 T(0.f);
+            for(size_t h=0; h<faceR.size(); ++h)
+            {
+                //Relative flow along d: quadratic = d * s^3 * max(0, -d.n) * A
+                GLfloat dn = glm::dot(d, faceN[h]);
+                if(dn < 0.f)
+                {
+                    area += -dn * faceA[h];
+                    moment += -dn * faceA[h] * faceR[h];
+                }
+                //Unit rotation about d: v_face = -d x r
+                AccumulateFormDrag(-glm::cross(d, faceR[h]), faceN[h], faceA[h], faceR[h], F, T);
+            }
+            model.flow[i*model.nLon + j] = glm::vec4(area, moment);
+            model.rotF[i*model.nLon + j] = F;
+            model.rotT[i*model.nLon + j] = T;
+        }
+    }
+    
+    //Validation against the integration over faces: pure translation, translation combined with rotation, pure rotation
+    //and both motions at the limit of the coupling ratio, where the tables are still used
+    if(Lc <= 0.f)
+        return;
+    
+    const unsigned int nTest = 64;
+    const GLfloat rotScale[5] = {0.f, 0.5f, 0.9f * REDUCED_DRAG_COUPLING_RATIO, 1.f, 1.f};
+    const GLfloat transScale[5] = {1.f, 1.f, 1.f, 0.f, 0.9f * REDUCED_DRAG_COUPLING_RATIO};
+    GLfloat errF(0.f), errT(0.f), maxF(0.f), maxT(0.f);
+    for(unsigned int k=0; k<nTest; ++k)
+    {
+        for(unsigned int m=0; m<5; ++m)
+        {
+            //Fibonacci sphere directions, not aligned with the grid
+            unsigned int k2 = m == 0 ? k : (k * 37 + 11) % nTest;
+            GLfloat z = 1.f - (2.f * k2 + 1.f)/(GLfloat)nTest;
+            GLfloat rxy = glm::sqrt(1.f - z*z);
+            GLfloat phi = (GLfloat)k2 * glm::pi<GLfloat>() * (3.f - glm::sqrt(5.f));
+            glm::vec3 d(rxy * glm::cos(phi), rxy * glm::sin(phi), z);
+            glm::vec3 w = d * transScale[m];
+            glm::vec3 omega = glm::vec3(d.y, d.z, d.x) * (rotScale[m]/Lc);
+            
+            glm::vec3 Fex(0.f), Tex(0.f);
+            for(size_t h=0; h<faceR.size(); ++h)
+                AccumulateFormDrag(w - glm::cross(omega, faceR[h]), faceN[h], faceA[h], faceR[h], Fex, Tex);
+            
+            glm::vec3 Fdq, Tdq, Fdf, Tdf;
+            EvaluateReducedDragModel(model, w, omega, Fdq, Tdq, Fdf, Tdf);
+            errF = glm::max(errF, glm::length(Fdq - Fex));
+            errT = glm::max(errT, glm::length(Tdq - Tex));
+            maxF = glm::max(maxF, glm::length(Fex));
+            maxT = glm::max(maxT, glm::length(Tex));
+        }
+    }
+    model.forceError = maxF > 0.f ? errF/maxF : 0.f;
+    model.torqueError = maxT > 0.f ? errT/maxT : 0.f;
+}
+
+void SolidEntity::ComputeHydrodynamicForcesSubmerged(const ReducedDragModel& model, Ocean* ocn, const Transform& T_CG, const Transform& T_C,
+                                              const Vector3& _v, const Vector3& _omega, Vector3& _Fdq, Vector3& _Tdq, Vector3& _Fdf, Vector3& _Tdf)
+{
+    //Relative flow at CG and angular velocity in the physics frame
+    glm::mat3 R = glm::mat3(glMatrixFromTransform(T_C));
+    glm::mat3 Rt = glm::transpose(R);
+    glm::vec3 p = glVectorFromVector(T_CG.getOrigin());
+    glm::vec3 w = Rt * (ocn->GetFluidVelocity(p) - glVectorFromVector(_v));
+    glm::vec3 omega = Rt * glVectorFromVector(_omega);
+    
+    glm::vec3 Fdq, Tdq, Fdf, Tdf;
+    EvaluateReducedDragModel(model, w, omega, Fdq, Tdq, Fdf, Tdf);
+    Fdq = R * Fdq;
+    Tdq = R * Tdq;
+    Fdf = R * Fdf;
+    Tdf = R * Tdf;
+    
+    _Fdq = Vector3(Fdq.x, Fdq.y, Fdq.z);
+    _Tdq = Vector3(Tdq.x, Tdq.y, Tdq.z);
+    _Fdf = Vector3(Fdf.x, Fdf.y, Fdf.z);
+    _Tdf = Vector3(Tdf.x, Tdf.y, Tdf.z);
+}
+
+void SolidEntity::BuildReducedDragModels()
+{
+    if(phy.mode != PhysicsMode::FLOATING && phy.mode != PhysicsMode::SUBMERGED)
+        return;
+    
+    BuildReducedDragModel(phyMesh, T_CG2C.inverse().getOrigin(), dragModel);
+    cInfo("Built reduced drag model of %s [max. error of form drag: force %1.1lf%%, torque %1.1lf%%]", 
+          getName().c_str(), dragModel.forceError * 100.0, dragModel.torqueError * 100.0);
+}
+
 void SolidEntity::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean* ocn)
 {
     if(phy.mode != PhysicsMode::FLOATING && phy.mode != PhysicsMode::SUBMERGED) return;
     
-    auto points = submerged.getDataAsPoints();
-    if (points != nullptr)
-        points->clear();
+    submerged.clear();
 
     BodyFluidPosition bf = CheckBodyFluidPosition(ocn);
     
@@ -1835,14 +2142,19 @@ void SolidEntity::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocea
         }
         
         if(settings.dampingForces)
-            ComputeHydrodynamicForcesSubmerged(getPhysicsMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fdq, Tdq, Fdf, Tdf);
+        {
+            if(!dragModel.flow.empty())
+                ComputeHydrodynamicForcesSubmerged(dragModel, ocn, getCGTransform(), getCTransform(), v, omega, Fdq, Tdq, Fdf, Tdf);
+            else
+                ComputeHydrodynamicForcesSubmerged(getPhysicsMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fdq, Tdq, Fdf, Tdf, &hydroBuffers);
+        }
 
         Swet = surface;
     }
     else //CROSSING_FLUID_SURFACE
     {
         if(!isBuoyant()) settings.reallisticBuoyancy = false;
-        ComputeHydrodynamicForcesSurface(settings, getPhysicsMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fb, Tb, Fdq, Tdq, Fdf, Tdf, Swet, Vsub, submerged);
+        ComputeHydrodynamicForcesSurface(settings, getPhysicsMesh(), ocn, getCGTransform(), getCTransform(), v, omega, Fb, Tb, Fdq, Tdq, Fdf, Tdf, Swet, Vsub, submerged, &hydroBuffers);
     }
     
     if(settings.dampingForces)
@@ -1961,6 +2273,62 @@ void SolidEntity::ApplyHydrodynamicForces()
     ApplyTorque(Tb + Tdq + Tdf);
 }
 
+//Order-independent signature of the bodies in contact with the solid
+static size_t ContactSignature(const SolidEntity* solid)
+{
+    const std::vector<btPersistentManifold*>& manifolds = SimulationApp::getApp()->getSimulationManager()->getContactManifolds(solid);
+    size_t signature = manifolds.size();
+    for(size_t i=0; i<manifolds.size(); ++i)
+    {
+        const btCollisionObject* other = manifolds[i]->getBody0()->getUserPointer() == solid ? manifolds[i]->getBody1() : manifolds[i]->getBody0();
+        signature += std::hash<const void*>()(other) * 0x9e3779b97f4a7c15ull;
+    }
+    return signature;
+}
+
+bool SolidEntity::isHydrodynamicallyQuiescent(Ocean* ocn, const HydrodynamicsQuiescence& q)
+{
+    if(!hydroStateValid)
+        return false;
+    
+    //Motion relative to the water and drift since the last computation
+    Transform T = getCGTransform();
+    Vector3 v = ocn->GetFluidVelocity(T.getOrigin());
+    if((getLinearVelocity() - v).length() > q.linearVelocity
+       || getAngularVelocity().length() > q.angularVelocity
+       || (T.getOrigin() - hydroT.getOrigin()).length() > q.position
+       || T.getRotation().angleShortestPath(hydroT.getRotation()) > q.orientation)
+        return false;
+    
+    //Change of the currents around the body
+    if((v - hydroV).length() > q.linearVelocity)
+        return false;
+    
+    //Waves passing through the body
+    if(ocn->hasWaves() && CheckBodyFluidPosition(ocn) != BodyFluidPosition::INSIDE)
+        return false;
+    
+    //Actuator input (gravity and other constant loads cancel out)
+    Vector3 F = getAppliedForce();
+    Vector3 Tq = getAppliedTorque();
+    if((F - hydroAppF).length() > Scalar(1e-3) * (hydroAppF.length() + Scalar(1))
+       || (Tq - hydroAppT).length() > Scalar(1e-3) * (hydroAppT.length() + Scalar(1)))
+        return false;
+    
+    //New or broken contacts
+    return ContactSignature(this) == hydroContacts;
+}
+
+void SolidEntity::StoreHydrodynamicState(Ocean* ocn)
+{
+    hydroT = getCGTransform();
+    hydroV = ocn->GetFluidVelocity(hydroT.getOrigin());
+    hydroAppF = getAppliedForce();
+    hydroAppT = getAppliedTorque();
+    hydroContacts = ContactSignature(this);
+    hydroStateValid = true;
+}
+
 void SolidEntity::ApplyAerodynamicForces()
 {
     ApplyCentralForce(Fda);
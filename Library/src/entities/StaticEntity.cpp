@@ -129,6 +129,12 @@ void StaticEntity::BuildGraphicalObject()
 }
 
 void StaticEntity::BuildRigidBody(btCollisionShape* shape)
+{
+    rigidBody = CreateRigidBody(shape);
+    BuildGraphicalObject();
+}
+
+btRigidBody* StaticEntity::CreateRigidBody(btCollisionShape* shape)
 {
     btDefaultMotionState* motionState = new btDefaultMotionState();
     
@@ -138,11 +144,10 @@ void StaticEntity::BuildRigidBody(btCollisionShape* shape)
     rigidBodyCI.m_linearSleepingThreshold = rigidBodyCI.m_angularSleepingThreshold = Scalar(0); //not used
     rigidBodyCI.m_additionalDamping = false;
     
-    rigidBody = new btRigidBody(rigidBodyCI);
-    rigidBody->setUserPointer(this);
-    rigidBody->setCollisionFlags(rigidBody->getCollisionFlags() | btCollisionObject::CF_STATIC_OBJECT | btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK);
-    
-    BuildGraphicalObject();
+    btRigidBody* body = new btRigidBody(rigidBodyCI);
+    body->setUserPointer(this);
+    body->setCollisionFlags(body->getCollisionFlags() | btCollisionObject::CF_STATIC_OBJECT | btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK);
+    return body;
 }
 
 void StaticEntity::AddToSimulation(SimulationManager* sm)
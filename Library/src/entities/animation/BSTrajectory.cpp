@@ -153,10 +153,10 @@ void BSTrajectory::BuildGraphicalPath()
 
     if(points.size() >= 3)
     {
-        vis[1].getDataAsPoints()->clear();
+        vis[1].clear();
         std::vector<Scalar> p = spline.sample((size_t)ceil(points.back().t * 10));
         for(size_t i = 0; i<p.size(); i+=4)
-            vis[1].getDataAsPoints()->push_back(glm::vec3((GLfloat)p[i+1], (GLfloat)p[i+2], (GLfloat)p[i+3]));
+            vis[1].push_back(glm::vec3((GLfloat)p[i+1], (GLfloat)p[i+2], (GLfloat)p[i+3]));
     }
 }
 
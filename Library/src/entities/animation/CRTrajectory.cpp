@@ -114,7 +114,7 @@ void CRTrajectory::BuildGraphicalPath()
 
     if(points.size() >= 3)
     {
-        vis[1].getDataAsPoints()->clear();
+        vis[1].clear();
         for(size_t i=0; i<points.size()-1; ++i)
         {
             Vector3 P1 = points[i].T.getOrigin();
@@ -152,9 +152,9 @@ void CRTrajectory::BuildGraphicalPath()
 
             Scalar dt = (t2-t1)/Scalar(100.0);
             for(Scalar t=t1; t<t2; t+=dt)
-                vis[1].getDataAsPoints()->push_back(glVectorFromVector(catmullRom(P0, P1, P2, P3, t0, t1, t2, t3, t)));    
+                vis[1].push_back(glVectorFromVector(catmullRom(P0, P1, P2, P3, t0, t1, t2, t3, t)));    
         }
-        vis[1].getDataAsPoints()->push_back(glVectorFromVector(points.back().T.getOrigin()));
+        vis[1].push_back(glVectorFromVector(points.back().T.getOrigin()));
     }
 }
 
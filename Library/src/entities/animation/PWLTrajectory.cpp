@@ -25,25 +25,13 @@
 
 #include "entities/animation/PWLTrajectory.h"
 #include <algorithm>
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
 
 PWLTrajectory::PWLTrajectory(PlaybackMode playback) : Trajectory(playback)
 {
-    Renderable pathPoints;
-    pathPoints.type = RenderableType::PATH_POINTS;
-    pathPoints.model = glm::mat4(1.f);
-    pathPoints.data = std::make_shared<std::vector<glm::vec3>>();
-
-    Renderable pathLine;
-    pathLine.type = RenderableType::PATH_LINE_STRIP;
-    pathLine.model = glm::mat4(1.f);
-    pathLine.data = std::make_shared<std::vector<glm::vec3>>();
-
-    vis.push_back(pathPoints);
-    vis.push_back(pathLine);
-    
     interpAcc = V0();
     AddKeyPoint(Scalar(0), I4());
 }
@@ -115,16 +103,30 @@ void PWLTrajectory::Interpolate()
 
 void PWLTrajectory::BuildGraphicalPath()
 {
-    vis[0].getDataAsPoints()->clear();
-    vis[1].getDataAsPoints()->clear();
+    vis[0].clear();
     for(size_t i=0; i<points.size(); ++i)
-        vis[0].getDataAsPoints()->push_back(glVectorFromVector(points[i].T.getOrigin()));
-    *vis[1].getDataAsPoints() = *vis[0].getDataAsPoints();
+        vis[0].push_back(glVectorFromVector(points[i].T.getOrigin()));
+    vis[1] = vis[0];
 }
 
 std::vector<Renderable> PWLTrajectory::Render()
 {
-    return vis;
+    std::vector<Renderable> items(0);
+    if(!OpenGLHelperArena::isEnabled(RenderableType::PATH_POINTS))
+        return items;
+
+    Renderable pathPoints;
+    pathPoints.type = RenderableType::PATH_POINTS;
+    pathPoints.model = glm::mat4(1.f);
+    pathPoints.data = OpenGLHelperArena::Store(vis[0]);
+    items.push_back(pathPoints);
+
+    Renderable pathLine;
+    pathLine.type = RenderableType::PATH_LINE_STRIP;
+    pathLine.model = glm::mat4(1.f);
+    pathLine.data = OpenGLHelperArena::Store(vis[1]);
+    items.push_back(pathLine);
+    return items;
 }
 
 }
\ No newline at end of file
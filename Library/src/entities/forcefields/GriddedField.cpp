@@ -0,0 +1,286 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  GriddedField.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "entities/forcefields/GriddedField.h"
+
+#include <cstring>
+#include <algorithm>
+#include <cmath>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "core/SimulationApp.h"
+#include "core/SimulationManager.h"
+#include "graphics/OpenGLHelperArena.h"
+
+namespace sf
+{
+
+GriddedField::GriddedField(const std::string& filename, bool loop, Scalar timeOffset) 
+    : tileMaxSpeed(nullptr), data(nullptr), loopTime(loop), tOffset(timeOffset), mapping(nullptr), mappingSize(0)
+{
+    //Map data file
+#ifdef _WIN32
+    fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+    if(fileHandle == INVALID_HANDLE_VALUE)
+        cCritical("Failed to open velocity field data file '%s'!", filename.c_str());
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(fileHandle, &fileSize);
+    mappingSize = (size_t)fileSize.QuadPart;
+    mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if(mappingHandle != NULL)
+        mapping = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if(mapping == nullptr)
+        cCritical("Failed to map velocity field data file '%s'!", filename.c_str());
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if(fd < 0)
+        cCritical("Failed to open velocity field data file '%s'!", filename.c_str());
+    struct stat st;
+    if(fstat(fd, &st) == 0)
+        mappingSize = (size_t)st.st_size;
+    mapping = mappingSize > 0 ? mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if(mapping == MAP_FAILED)
+        cCritical("Failed to map velocity field data file '%s'!", filename.c_str());
+    madvise(mapping, mappingSize, MADV_RANDOM); //Only the queried tiles should be paged in
+#endif
+
+    //Check header
+    if(mappingSize < sizeof(GriddedFieldHeader))
+        cCritical("Velocity field data file '%s' is corrupted!", filename.c_str());
+    std::memcpy(&header, mapping, sizeof(GriddedFieldHeader));
+    if(std::strncmp(header.magic, "SFVF", 4) != 0 || header.version != 1)
+        cCritical("Velocity field data file '%s' has wrong format!", filename.c_str());
+    if(header.size[0] == 0 || header.size[1] == 0 || header.size[2] == 0 || header.slices == 0 || header.tile == 0
+       || header.spacing[0] <= 0.0 || header.spacing[1] <= 0.0 || header.spacing[2] <= 0.0
+       || (header.slices > 1 && header.dt <= 0.0))
+        cCritical("Velocity field data file '%s' has invalid dimensions!", filename.c_str());
+    
+    //Compute data layout
+    tileCount = 1;
+    for(int h=0; h<3; ++h)
+    {
+        tiles[h] = (header.size[h] + header.tile - 1)/header.tile;
+        tileCount *= tiles[h];
+    }
+    tileNodes = (size_t)header.tile * header.tile * header.tile;
+    size_t requiredSize = sizeof(GriddedFieldHeader) + tileCount * sizeof(float) 
+                          + (size_t)header.slices * tileCount * tileNodes * 3 * sizeof(float);
+    if(mappingSize < requiredSize)
+        cCritical("Velocity field data file '%s' is truncated!", filename.c_str());
+    
+    tileMaxSpeed = (const float*)((const char*)mapping + sizeof(GriddedFieldHeader));
+    data = tileMaxSpeed + tileCount;
+    
+    gridMin = glm::vec3((GLfloat)header.origin[0], (GLfloat)header.origin[1], (GLfloat)header.origin[2]);
+    gridMax = gridMin + glm::vec3((GLfloat)((header.size[0]-1) * header.spacing[0]),
+                                  (GLfloat)((header.size[1]-1) * header.spacing[1]),
+                                  (GLfloat)((header.size[2]-1) * header.spacing[2]));
+    invSpacing = glm::vec3((GLfloat)(1.0/header.spacing[0]), (GLfloat)(1.0/header.spacing[1]), (GLfloat)(1.0/header.spacing[2]));
+}
+
+GriddedField::~GriddedField()
+{
+#ifdef _WIN32
+    if(mapping != nullptr)
+        UnmapViewOfFile(mapping);
+    if(mappingHandle != NULL)
+        CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+#else
+    if(mapping != nullptr && mapping != MAP_FAILED)
+        munmap(mapping, mappingSize);
+#endif
+}
+
+VelocityFieldType GriddedField::getType() const
+{
+    return VelocityFieldType::GRIDDED;
+}
+
+bool GriddedField::getBoundingBox(Vector3& aabbMin, Vector3& aabbMax) const
+{
+    aabbMin = Vector3(gridMin.x, gridMin.y, gridMin.z);
+    aabbMax = Vector3(gridMax.x, gridMax.y, gridMax.z);
+    return true;
+}
+
+bool GriddedField::Overlaps(const Vector3& aabbMin, const Vector3& aabbMax) const
+{
+    Vector3 gMin, gMax;
+    getBoundingBox(gMin, gMax);
+    if(!TestAabbAgainstAabb2(aabbMin, aabbMax, gMin, gMax))
+        return false;
+    
+    //Check if any of the overlapped tiles contains flow
+    uint32_t lo[3], hi[3];
+    for(int h=0; h<3; ++h)
+    {
+        Scalar l = std::floor((btMax(aabbMin[h], gMin[h]) - gMin[h])/Scalar(header.spacing[h]));
+        Scalar u = std::ceil((btMin(aabbMax[h], gMax[h]) - gMin[h])/Scalar(header.spacing[h]));
+        lo[h] = (uint32_t)btMax(l, Scalar(0))/header.tile;
+        hi[h] = (uint32_t)btMin(u, Scalar(header.size[h]-1))/header.tile;
+    }
+    
+    for(uint32_t tz=lo[2]; tz<=hi[2]; ++tz)
+        for(uint32_t ty=lo[1]; ty<=hi[1]; ++ty)
+            for(uint32_t tx=lo[0]; tx<=hi[0]; ++tx)
+                if(tileMaxSpeed[((size_t)tz * tiles[1] + ty) * tiles[0] + tx] > 0.f)
+                    return true;
+    return false;
+}
+
+void GriddedField::GetSlices(size_t& s0, size_t& s1, float& ws) const
+{
+    s0 = s1 = 0;
+    ws = 0.f;
+    if(header.slices < 2)
+        return;
+    
+    Scalar t = SimulationApp::getApp()->getSimulationManager()->getSimulationTime() + tOffset;
+    Scalar s = (t - Scalar(header.t0))/Scalar(header.dt);
+    Scalar n = Scalar(header.slices);
+    
+    if(loopTime) //Period equal to slices * dt (last slice blends into the first one)
+    {
+        s = btFmod(s, n);
+        if(s < Scalar(0)) s += n;
+        s0 = btMin((size_t)s, (size_t)header.slices-1);
+        s1 = (s0 + 1) % header.slices;
+    }
+    else
+    {
+        if(s <= Scalar(0))
+            return;
+        if(s >= n - Scalar(1))
+        {
+            s0 = s1 = header.slices-1;
+            return;
+        }
+        s0 = (size_t)s;
+        s1 = s0 + 1;
+    }
+    ws = (float)(s - Scalar(s0));
+}
+
+glm::vec3 GriddedField::getNode(size_t s, uint32_t i, uint32_t j, uint32_t k) const
+{
+    const uint32_t T = header.tile;
+    size_t tileId = ((size_t)(k/T) * tiles[1] + j/T) * tiles[0] + i/T;
+    size_t local = ((size_t)(k%T) * T + j%T) * T + i%T;
+    const float* n = data + ((s * tileCount + tileId) * tileNodes + local) * 3;
+    return glm::vec3(n[0], n[1], n[2]);
+}
+
+glm::vec3 GriddedField::Interpolate(const glm::vec3& p, size_t s0, size_t s1, float ws) const
+{
+    if(p.x < gridMin.x || p.y < gridMin.y || p.z < gridMin.z
+       || p.x > gridMax.x || p.y > gridMax.y || p.z > gridMax.z)
+        return glm::vec3(0.f);
+    
+    //Cell containing the point
+    glm::vec3 g = (p - gridMin) * invSpacing;
+    uint32_t i0[3], i1[3];
+    glm::vec3 f;
+    for(int h=0; h<3; ++h)
+    {
+        i0[h] = std::min((uint32_t)g[h], header.size[h]-1);
+        i1[h] = std::min(i0[h]+1, header.size[h]-1);
+        f[h] = g[h] - (float)i0[h];
+    }
+    
+    //Trilinear interpolation in space, linear in time
+    glm::vec3 v(0.f);
+    size_t slice[2] = {s0, s1};
+    float wslice[2] = {1.f - ws, ws};
+    for(int s=0; s<(ws > 0.f ? 2 : 1); ++s)
+    {
+        glm::vec3 c00 = glm::mix(getNode(slice[s], i0[0], i0[1], i0[2]), getNode(slice[s], i1[0], i0[1], i0[2]), f.x);
+        glm::vec3 c10 = glm::mix(getNode(slice[s], i0[0], i1[1], i0[2]), getNode(slice[s], i1[0], i1[1], i0[2]), f.x);
+        glm::vec3 c01 = glm::mix(getNode(slice[s], i0[0], i0[1], i1[2]), getNode(slice[s], i1[0], i0[1], i1[2]), f.x);
+        glm::vec3 c11 = glm::mix(getNode(slice[s], i0[0], i1[1], i1[2]), getNode(slice[s], i1[0], i1[1], i1[2]), f.x);
+        v += wslice[s] * glm::mix(glm::mix(c00, c10, f.y), glm::mix(c01, c11, f.y), f.z);
+    }
+    return v;
+}
+
+Vector3 GriddedField::GetVelocityAtPoint(const Vector3& p) const
+{
+    size_t s0, s1;
+    float ws;
+    GetSlices(s0, s1, ws);
+    glm::vec3 v = Interpolate(glm::vec3((GLfloat)p.getX(), (GLfloat)p.getY(), (GLfloat)p.getZ()), s0, s1, ws);
+    return Vector3(v.x, v.y, v.z);
+}
+
+void GriddedField::AddVelocityAtPoints(const std::vector<glm::vec3>& points, std::vector<glm::vec3>& velocities) const
+{
+    size_t s0, s1;
+    float ws;
+    GetSlices(s0, s1, ws);
+    for(size_t i=0; i<points.size(); ++i)
+        velocities[i] += Interpolate(points[i], s0, s1, ws);
+}
+
+std::vector<Renderable> GriddedField::Render(VelocityFieldUBO& ubo)
+{
+    std::vector<Renderable> items(0);
+    ubo.posR = glm::vec4(0.f);
+    ubo.dirV = glm::vec4(0.f);
+    ubo.params = glm::vec3(0.f);
+    ubo.type = 3; //Not evaluated by the shaders
+    
+    if(!OpenGLHelperArena::isEnabled(RenderableType::HYDRO_LINES))
+        return items;
+
+    //Grid extents
+    Renderable box;
+    box.type = RenderableType::HYDRO_LINES;
+    box.model = glm::mat4(1.f);
+    auto& boxPoints = OpenGLHelperArena::Begin();
+    
+    glm::vec3 c[8];
+    for(unsigned int i=0; i<8; ++i)
+        c[i] = glm::vec3(i & 1 ? gridMax.x : gridMin.x, i & 2 ? gridMax.y : gridMin.y, i & 4 ? gridMax.z : gridMin.z);
+    for(unsigned int i=0; i<8; ++i)
+        for(unsigned int h=1; h<8; h <<= 1)
+            if(!(i & h))
+            {
+                boxPoints.push_back(c[i]);
+                boxPoints.push_back(c[i | h]);
+            }
+    
+    box.data = OpenGLHelperArena::Commit();
+    items.push_back(box);
+    return items;
+}
+
+}
@@ -24,6 +24,9 @@
 //
 
 #include "entities/forcefields/Jet.h"
+#include "graphics/OpenGLHelperArena.h"
+
+#define JET_CUTOFF_FRACTION Scalar(0.01) //Fraction of the outlet velocity at which the centreline velocity is truncated
 
 namespace sf
 {
@@ -33,6 +36,7 @@ Jet::Jet(const Vector3& point, const Vector3& direction, Scalar radius, Scalar o
     c = point;
     n = direction.normalized();
     r = radius;
+    l = Scalar(10)*r/JET_CUTOFF_FRACTION - Scalar(5)*r; //Centreline velocity 10*r*vout/(t+5*r) decays to the cutoff fraction
     setOutletVelocity(outletVelocity);
 }
 
@@ -46,20 +50,57 @@ Scalar Jet::getOutletVelocity() const
     return vout;
 }
 
+Scalar Jet::getLength() const
+{
+    return l;
+}
+
+bool Jet::getBoundingBox(Vector3& aabbMin, Vector3& aabbMax) const
+{
+    //Extents of the outlet disc and of the end disc of the truncated cone
+    Vector3 e(btSqrt(btMax(Scalar(1) - n.x()*n.x(), Scalar(0))),
+              btSqrt(btMax(Scalar(1) - n.y()*n.y(), Scalar(0))),
+              btSqrt(btMax(Scalar(1) - n.z()*n.z(), Scalar(0))));
+    Vector3 end = c + l*n;
+    Scalar rEnd = (l + Scalar(5)*r)/Scalar(5);
+    aabbMin = c - r*e;
+    aabbMax = c + r*e;
+    aabbMin.setMin(end - rEnd*e);
+    aabbMax.setMax(end + rEnd*e);
+    return true;
+}
+
 VelocityFieldType Jet::getType() const
 {
     return VelocityFieldType::JET;
 }
 
-Vector3 Jet::GetVelocityAtPoint(const Vector3& p) const
+bool Jet::Overlaps(const Vector3& aabbMin, const Vector3& aabbMax) const
 {
-    //Calculate distance to axis
-    Vector3 cp = p-c;
-    Scalar d = cp.cross(n).norm();
+    //Bounding sphere of the box
+    Vector3 s = (aabbMin + aabbMax)/Scalar(2);
+    Scalar R = (aabbMax - aabbMin).length()/Scalar(2);
     
+    //Behind the outlet or beyond the truncation?
+    Scalar t = (s-c).dot(n);
+    if(t < -R || t > l + R) return false;
+    
+    //Outside of the cone? (apex at 5r behind the outlet, tan(half angle) = 1/5)
+    Vector3 as = s - (c - Scalar(5)*r*n);
+    Scalar axial = as.dot(n);
+    Scalar radial = (as - axial*n).length();
+    return (Scalar(5)*radial - axial)/btSqrt(Scalar(26)) <= R;
+}
+
+Vector3 Jet::GetVelocityAtPoint(const Vector3& p) const
+{
     //Calculate distance from outlet
+    Vector3 cp = p-c;
     Scalar t = cp.dot(n);
-    if(t < 0.0) return Vector3(0,0,0);
+    if(t < 0.0 || t > l) return Vector3(0,0,0);
+    
+    //Calculate distance to axis
+    Scalar d = cp.cross(n).norm();
     
     //Calculate radius at point
     Scalar r_ = Scalar(1)/Scalar(5)*(t + Scalar(5)*r); //Jet angle is around 24 deg independent of conditions!
@@ -88,28 +129,30 @@ std::vector<Renderable> Jet::Render(VelocityFieldUBO& ubo)
     glm::vec3 y_ = glm::cross(z_,x_);
     glm::mat4 model(glm::vec4(x_, 0.f), glm::vec4(y_, 0.f), glm::vec4(z_, 0.f), glm::vec4(c.x(), c.y(), c.z(), 1));    
     
+    if(!OpenGLHelperArena::isEnabled(RenderableType::HYDRO_LINES))
+        return items;
+    
     //Orifice
     Renderable orifice;
     orifice.type = RenderableType::HYDRO_LINE_STRIP;
     orifice.model = model;
-    orifice.data = std::make_shared<std::vector<glm::vec3>>();
-    auto orificePoints = orifice.getDataAsPoints();
+    auto& orificePoints = OpenGLHelperArena::Begin();
     
     for(unsigned int i=0; i<=12; ++i)
     {
         Scalar alpha = Scalar(i)/Scalar(12) * M_PI * Scalar(2);
         Vector3 v(btCos(alpha)*r, btSin(alpha)*r, 0);
-        orificePoints->push_back(glm::vec3(v.x(), v.y(), v.z()));
+        orificePoints.push_back(glm::vec3(v.x(), v.y(), v.z()));
     }
+    orifice.data = OpenGLHelperArena::Commit();
     
     //Cone
     Renderable cone;
     cone.type = RenderableType::HYDRO_LINES;
     cone.model = orifice.model;
-    cone.data = std::make_shared<std::vector<glm::vec3>>();
-    auto conePoints = cone.getDataAsPoints();
-    conePoints->push_back(glm::vec3(0, 0, 0));
-    conePoints->push_back(glm::vec3(0, 0, vout));
+    auto& conePoints = OpenGLHelperArena::Begin();
+    conePoints.push_back(glm::vec3(0, 0, 0));
+    conePoints.push_back(glm::vec3(0, 0, vout));
     
     Scalar r_ = Scalar(1)/Scalar(5)*(Scalar(10)*r + Scalar(5)*r);
     
@@ -118,9 +161,10 @@ std::vector<Renderable> Jet::Render(VelocityFieldUBO& ubo)
         Scalar alpha = Scalar(i)/Scalar(12) * M_PI * Scalar(2);
         Vector3 v1(btCos(alpha)*r, btSin(alpha)*r, 0);
         Vector3 v2(v1.x()*r_/r, v1.y()*r_/r, Scalar(10)*r);
-        conePoints->push_back(glm::vec3(v1.x(), v1.y(), v1.z()));
-        conePoints->push_back(glm::vec3(v2.x(), v2.y(), v2.z()));
+        conePoints.push_back(glm::vec3(v1.x(), v1.y(), v1.z()));
+        conePoints.push_back(glm::vec3(v2.x(), v2.y(), v2.z()));
     }
+    cone.data = OpenGLHelperArena::Commit();
     
     //Build
     items.push_back(orifice);
@@ -26,12 +26,14 @@
 #include "entities/forcefields/Ocean.h"
 
 #include <algorithm>
+#include <cmath>
 #include "utils/SystemUtil.hpp"
 #include "entities/forcefields/VelocityField.h"
 #include "entities/SolidEntity.h"
 #include "entities/CableEntity.h"
 #include "graphics/OpenGLFlatOcean.h"
 #include "graphics/OpenGLRealOcean.h"
+#include "graphics/OpenGLHelperArena.h"
 #include "actuators/Thruster.h"
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
@@ -52,11 +54,13 @@ Ocean::Ocean(std::string uniqueName, Scalar waves, Fluid l) : ForcefieldEntity(u
     
     currents = std::vector<VelocityField*>(0);
     currentsEnabled = false;
+    currentsGridCell = Scalar(1);
+    quiescence.linearVelocity = Scalar(0);
+    quiescence.angularVelocity = Scalar(0);
+    quiescence.position = Scalar(0);
+    quiescence.orientation = Scalar(0);
     
     liquid = l;
-    wavesDebug.type = RenderableType::HYDRO_POINTS;
-    wavesDebug.model = glm::mat4(1.f);
-    wavesDebug.data = std::make_shared<std::vector<glm::vec3>>();
     waterType = Scalar(0.0);
     glOcean = nullptr;
 }
@@ -79,6 +83,17 @@ bool Ocean::hasWaves() const
     return oceanState > Scalar(0);
 }
 
+bool Ocean::isHydrodynamicsQuiescenceEnabled() const
+{
+    return quiescence.linearVelocity > Scalar(0) && quiescence.angularVelocity > Scalar(0)
+           && quiescence.position > Scalar(0) && quiescence.orientation > Scalar(0);
+}
+
+HydrodynamicsQuiescence Ocean::getHydrodynamicsQuiescence() const
+{
+    return quiescence;
+}
+
 bool Ocean::hasParticles() const
 {
     if(glOcean != nullptr)
@@ -136,9 +151,77 @@ void Ocean::SetConditions(Scalar waterTemp)
         glOcean->setWaterTemperature((float)waterTemp);
 }
 
+void Ocean::setHydrodynamicsQuiescence(Scalar linearVelocity, Scalar angularVelocity, Scalar position, Scalar orientation)
+{
+    quiescence.linearVelocity = btMax(linearVelocity, Scalar(0));
+    quiescence.angularVelocity = btMax(angularVelocity, Scalar(0));
+    quiescence.position = btMax(position, Scalar(0));
+    quiescence.orientation = btMax(orientation, Scalar(0));
+}
+
 void Ocean::AddVelocityField(VelocityField* field)
 {
     currents.push_back(field);
+    RebuildCurrentsIndex();
+}
+
+static inline uint64_t CurrentsCellKey(int64_t i, int64_t j, int64_t k)
+{
+    return ((uint64_t)i * 73856093ULL) ^ ((uint64_t)j * 19349663ULL) ^ ((uint64_t)k * 83492791ULL);
+}
+
+void Ocean::RebuildCurrentsIndex()
+{
+    currentsBounds.resize(currents.size());
+    unboundedCurrents.clear();
+    currentsGrid.clear();
+    
+    //Cell size equal to the average extent of the bounded fields
+    Scalar extent(0);
+    size_t nBounded = 0;
+    for(size_t i=0; i<currents.size(); ++i)
+    {
+        CurrentBounds& b = currentsBounds[i];
+        b.bounded = currents[i]->getBoundingBox(b.aabbMin, b.aabbMax);
+        if(b.bounded)
+        {
+            Vector3 size = b.aabbMax - b.aabbMin;
+            extent += size[size.maxAxis()];
+            ++nBounded;
+        }
+    }
+    currentsGridCell = nBounded > 0 ? btMax(extent/Scalar(nBounded), Scalar(0.1)) : Scalar(1);
+    
+    //Register fields in the cells overlapped by their bounding boxes
+    for(size_t i=0; i<currents.size(); ++i)
+    {
+        const CurrentBounds& b = currentsBounds[i];
+        if(!b.bounded)
+        {
+            unboundedCurrents.push_back(i);
+            continue;
+        }
+        
+        int64_t lo[3], hi[3];
+        uint64_t nCells = 1;
+        for(int h=0; h<3; ++h)
+        {
+            lo[h] = (int64_t)std::floor(b.aabbMin[h]/currentsGridCell);
+            hi[h] = (int64_t)std::floor(b.aabbMax[h]/currentsGridCell);
+            nCells *= (uint64_t)(hi[h] - lo[h] + 1);
+        }
+        
+        if(nCells > CURRENTS_GRID_MAX_CELLS)
+        {
+            unboundedCurrents.push_back(i);
+            continue;
+        }
+        
+        for(int64_t x=lo[0]; x<=hi[0]; ++x)
+            for(int64_t y=lo[1]; y<=hi[1]; ++y)
+                for(int64_t z=lo[2]; z<=hi[2]; ++z)
+                    currentsGrid[CurrentsCellKey(x, y, z)].push_back(i);
+    }
 }
 
 bool Ocean::IsInsideFluid(const Vector3& point)
@@ -153,7 +236,7 @@ float Ocean::GetDepth(const glm::vec3& point)
         GLfloat waveHeight = glOcean->ComputeWaveHeight(point.x, point.y);
         glm::vec3 wavePoint(point.x, point.y, waveHeight);
 #ifdef DEBUG_WAVES
-        wavesDebug.getDataAsPoints()->push_back(wavePoint);
+        wavesDebug.push_back(wavePoint);
 #endif
         return point.z - waveHeight;
     }
@@ -161,7 +244,7 @@ float Ocean::GetDepth(const glm::vec3& point)
     {
         glm::vec3 wavePoint(point.x, point.y, 0.f);
 #ifdef DEBUG_WAVES  
-        wavesDebug.getDataAsPoints()->push_back(wavePoint);
+        wavesDebug.push_back(wavePoint);
 #endif
         return point.z;
     }
@@ -185,10 +268,32 @@ Vector3 Ocean::GetFluidVelocity(const Vector3& point) const
     if(currentsEnabled)
     {
         Vector3 fv = V0();
-        for(size_t i=0; i<currents.size(); ++i)
+        for(size_t i=0; i<unboundedCurrents.size(); ++i)
         {
-            if(currents[i]->isEnabled())
-                fv += currents[i]->GetVelocityAtPoint(point);
+            const VelocityField* vf = currents[unboundedCurrents[i]];
+            if(vf->isEnabled())
+                fv += vf->GetVelocityAtPoint(point);
+        }
+        
+        if(!currentsGrid.empty())
+        {
+            auto cell = currentsGrid.find(CurrentsCellKey((int64_t)std::floor(point.getX()/currentsGridCell),
+                                                          (int64_t)std::floor(point.getY()/currentsGridCell),
+                                                          (int64_t)std::floor(point.getZ()/currentsGridCell)));
+            if(cell != currentsGrid.end())
+            {
+                for(size_t i=0; i<cell->second.size(); ++i)
+                {
+                    size_t id = cell->second[i];
+                    const CurrentBounds& b = currentsBounds[id];
+                    if(point.getX() < b.aabbMin.getX() || point.getX() > b.aabbMax.getX()
+                       || point.getY() < b.aabbMin.getY() || point.getY() > b.aabbMax.getY()
+                       || point.getZ() < b.aabbMin.getZ() || point.getZ() > b.aabbMax.getZ())
+                        continue;
+                    if(currents[id]->isEnabled())
+                        fv += currents[id]->GetVelocityAtPoint(point);
+                }
+            }
         }
         return fv;
     }
@@ -200,6 +305,32 @@ glm::vec3 Ocean::GetFluidVelocity(const glm::vec3& point) const
     return glVectorFromVector(GetFluidVelocity(Vector3(point.x, point.y, point.z)));
 }
 
+void Ocean::GetFluidVelocity(const std::vector<glm::vec3>& points, std::vector<glm::vec3>& velocities) const
+{
+    velocities.assign(points.size(), glm::vec3(0.f));
+    if(!currentsEnabled || points.empty())
+        return;
+    
+    //Cull fields using the bounding box of all points
+    glm::vec3 pMin = points[0];
+    glm::vec3 pMax = points[0];
+    for(size_t i=1; i<points.size(); ++i)
+    {
+        pMin = glm::min(pMin, points[i]);
+        pMax = glm::max(pMax, points[i]);
+    }
+    Vector3 aabbMin(pMin.x, pMin.y, pMin.z);
+    Vector3 aabbMax(pMax.x, pMax.y, pMax.z);
+    
+    std::vector<const VelocityField*> active;
+    for(size_t i=0; i<currents.size(); ++i)
+        if(currents[i]->isEnabled() && currents[i]->Overlaps(aabbMin, aabbMax))
+            active.push_back(currents[i]);
+    
+    for(size_t i=0; i<active.size(); ++i)
+        active[i]->AddVelocityAtPoints(points, velocities);
+}
+
 void Ocean::EnableCurrents()
 {
     currentsEnabled = true;
@@ -245,14 +376,20 @@ void Ocean::ApplyFluidForces(btDynamicsWorld* world, btCollisionObject* co, bool
     
     if (ent->getType() == EntityType::SOLID)
     {
-        if(recompute)
+        SolidEntity* solid = (SolidEntity*)ent;
+        bool detectQuiescence = isHydrodynamicsQuiescenceEnabled();
+        
+        //Forces computed last time are reused for quiescent bodies
+        if(recompute && !(detectQuiescence && solid->isHydrodynamicallyQuiescent(this, quiescence)))
         {
             settings.dampingForces = true;
             settings.reallisticBuoyancy = true;
-            ((SolidEntity*)ent)->ComputeHydrodynamicForces(settings, this);
+            solid->ComputeHydrodynamicForces(settings, this);
+            if(detectQuiescence)
+                solid->StoreHydrodynamicState(this);
         }
         
-        ((SolidEntity*)ent)->ApplyHydrodynamicForces();
+        solid->ApplyHydrodynamicForces();
     }
     else if (ent->getType() == EntityType::CABLE)
     {
@@ -322,10 +459,17 @@ std::vector<Renderable> Ocean::Render(const std::vector<Actuator*>& act)
             ++glOceanCurrentsUBOData.numCurrents;
         }
 
-    if(wavesDebug.getDataAsPoints()->size() > 0)
+    if(wavesDebug.size() > 0)
     {
-        items.push_back(wavesDebug);
-        wavesDebug.getDataAsPoints()->clear();
+        if(OpenGLHelperArena::isEnabled(RenderableType::HYDRO_POINTS))
+        {
+            Renderable item;
+            item.type = RenderableType::HYDRO_POINTS;
+            item.model = glm::mat4(1.f);
+            item.data = OpenGLHelperArena::Store(wavesDebug);
+            items.push_back(item);
+        }
+        wavesDebug.clear();
     }
 
     return items;
@@ -24,6 +24,7 @@
 //
 
 #include "entities/forcefields/Pipe.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -54,6 +55,17 @@ Scalar Pipe::getInletVelocity() const
     return vin;
 }
 
+bool Pipe::getBoundingBox(Vector3& aabbMin, Vector3& aabbMax) const
+{
+    //Spheres enclosing the end discs
+    Vector3 p2 = p1 + n * l;
+    aabbMin = p1 - Vector3(r1, r1, r1);
+    aabbMax = p1 + Vector3(r1, r1, r1);
+    aabbMin.setMin(p2 - Vector3(r2, r2, r2));
+    aabbMax.setMax(p2 + Vector3(r2, r2, r2));
+    return true;
+}
+
 Vector3 Pipe::GetVelocityAtPoint(const Vector3& p) const
 {
     //Calculate distance to line
@@ -91,43 +103,46 @@ std::vector<Renderable> Pipe::Render(VelocityFieldUBO& ubo)
     glm::vec3 y_ = glm::cross(z_,x_);
     glm::mat4 model(glm::vec4(x_, 0.f), glm::vec4(y_, 0.f), glm::vec4(z_, 0.f), glm::vec4(p1.x(), p1.y(), p1.z(), 1));    
     
+    if(!OpenGLHelperArena::isEnabled(RenderableType::HYDRO_LINES))
+        return items;
+    
     //Inlet and outlet
     Renderable inlet;
     inlet.type = RenderableType::HYDRO_LINE_STRIP;
     inlet.model = model;
-    inlet.data = std::make_shared<std::vector<glm::vec3>>();
-    auto inletPoints = inlet.getDataAsPoints();
+    std::vector<glm::vec3> inletPoints;
     
     Renderable outlet;
     outlet.type = RenderableType::HYDRO_LINE_STRIP;
     outlet.model = model;
-    outlet.data = std::make_shared<std::vector<glm::vec3>>();
-    auto outletPoints = outlet.getDataAsPoints();
+    std::vector<glm::vec3> outletPoints;
     
     //Pipe
     Renderable pipe;
     pipe.type = RenderableType::HYDRO_LINES;
     pipe.model = model;
-    pipe.data = std::make_shared<std::vector<glm::vec3>>();
-    auto pipePoints = pipe.getDataAsPoints();
+    std::vector<glm::vec3> pipePoints;
     
-    pipePoints->push_back(glm::vec3(0, 0, 0));
-    pipePoints->push_back(glm::vec3(0, 0, l));
+    pipePoints.push_back(glm::vec3(0, 0, 0));
+    pipePoints.push_back(glm::vec3(0, 0, l));
     
     for(unsigned int i=0; i<12; ++i)
     {
         Scalar alpha = Scalar(i)/Scalar(12) * M_PI * Scalar(2);
         Vector3 v1(btCos(alpha)*r1, btSin(alpha)*r1, 0);
         Vector3 v2(v1.x()*r2/r1, v1.y()*r2/r1, l);
-        pipePoints->push_back(glm::vec3(v1.x(), v1.y(), v1.z()));
-        inletPoints->push_back(pipePoints->back());
-        pipePoints->push_back(glm::vec3(v2.x(), v2.y(), v2.z()));
-        outletPoints->push_back(pipePoints->back());
+        pipePoints.push_back(glm::vec3(v1.x(), v1.y(), v1.z()));
+        inletPoints.push_back(pipePoints.back());
+        pipePoints.push_back(glm::vec3(v2.x(), v2.y(), v2.z()));
+        outletPoints.push_back(pipePoints.back());
     }
     
-    inletPoints->push_back(inletPoints->front());
-    outletPoints->push_back(outletPoints->front());
+    inletPoints.push_back(inletPoints.front());
+    outletPoints.push_back(outletPoints.front());
     
+    inlet.data = OpenGLHelperArena::Store(inletPoints);
+    outlet.data = OpenGLHelperArena::Store(outletPoints);
+    pipe.data = OpenGLHelperArena::Store(pipePoints);
     items.push_back(inlet);
     items.push_back(outlet);
     items.push_back(pipe);
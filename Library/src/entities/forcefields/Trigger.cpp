@@ -25,6 +25,7 @@
 
 #include "entities/forcefields/Trigger.h"
 
+#include <algorithm>
 #include "core/GraphicalSimulationApp.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
@@ -37,7 +38,7 @@ Trigger::Trigger(std::string uniqueName, Scalar radius, const Transform& worldTr
     ghost->setCollisionFlags(ghost->getCollisionFlags() | btCollisionObject::CF_STATIC_OBJECT);
     ghost->setWorldTransform(worldTransform);
     ghost->setCollisionShape(new btSphereShape(radius));
-    active = false;
+    active = 0;
     
     Mesh* mesh = OpenGLContent::BuildSphere((GLfloat)radius);
     
@@ -58,7 +59,7 @@ Trigger::Trigger(std::string uniqueName, Scalar radius, Scalar length, const Tra
     ghost->setCollisionFlags(ghost->getCollisionFlags() | btCollisionObject::CF_STATIC_OBJECT);
     ghost->setWorldTransform(worldTransform);
     ghost->setCollisionShape(new btCylinderShape(Vector3(radius, length/Scalar(2), radius)));
-    active = false;
+    active = 0;
     
     Mesh* mesh = OpenGLContent::BuildCylinder((GLfloat)radius, (GLfloat)length);
     
@@ -79,7 +80,7 @@ Trigger::Trigger(std::string uniqueName, const Vector3& dimensions, const Transf
     ghost->setCollisionFlags(ghost->getCollisionFlags() | btCollisionObject::CF_STATIC_OBJECT);
     ghost->setWorldTransform(worldTransform);
     ghost->setCollisionShape(new btBoxShape(dimensions/Scalar(2)));
-    active = false;
+    active = 0;
     
     glm::vec3 halfExt((GLfloat)(dimensions.x()/Scalar(2)), (GLfloat)(dimensions.y()/Scalar(2)), (GLfloat)(dimensions.z()/Scalar(2)));
     Mesh* mesh = OpenGLContent::BuildBox(halfExt);
@@ -103,13 +104,35 @@ ForcefieldType Trigger::getForcefieldType()
 
 void Trigger::AddActiveSolid(SolidEntity* solid)
 {
+    if(std::find(solids.begin(), solids.end(), solid) != solids.end())
+        return;
     solids.push_back(solid);
+    
+    //The solid may already overlap the trigger
+    for(int i=0; i<ghost->getNumOverlappingObjects(); ++i)
+    {
+        btCollisionObject* co = ghost->getOverlappingObject(i);
+        if(co->getUserPointer() == solid && isActiveSolid(co))
+            ++active;
+    }
 }
 
-void Trigger::Activate(btCollisionObject* co)
+void Trigger::BodyEntered(btCollisionObject* co)
+{
+    if(isActiveSolid(co))
+        ++active;
+}
+
+void Trigger::BodyLeft(btCollisionObject* co)
+{
+    if(active > 0 && isActiveSolid(co))
+        --active;
+}
+
+bool Trigger::isActiveSolid(btCollisionObject* co) const
 {
     if(solids.size() == 0)
-        return;
+        return false;
     
     Entity* ent;
     btRigidBody* rb = btRigidBody::upcast(co);
@@ -118,40 +141,33 @@ void Trigger::Activate(btCollisionObject* co)
     if(rb != 0)
     {
         if(rb->isStaticOrKinematicObject())
-            return;
+            return false;
         else
             ent = (Entity*)rb->getUserPointer();
     }
     else if(mbl != 0)
     {
         if(mbl->isStaticOrKinematicObject())
-            return;
+            return false;
         else
             ent = (Entity*)mbl->getUserPointer();
     }
     else
-        return;
+        return false;
     
     if(ent->getType() == EntityType::SOLID)
     {
         SolidEntity* solid = (SolidEntity*)ent;
         for(unsigned int i=0; i<solids.size(); ++i)
             if(solids[i] == solid)
-            {
-                active = true;
-                return;
-            }
+                return true;
     }
-}
-
-void Trigger::Clear()
-{
-    active = false;
+    return false;
 }
 
 bool Trigger::isActive()
 {
-    return active;
+    return active > 0;
 }
 
 std::vector<Renderable> Trigger::Render()
@@ -46,4 +46,23 @@ bool VelocityField::isEnabled() const
     return enabled;
 }
 
+void VelocityField::AddVelocityAtPoints(const std::vector<glm::vec3>& points, std::vector<glm::vec3>& velocities) const
+{
+    for(size_t i=0; i<points.size(); ++i)
+        velocities[i] += glVectorFromVector(GetVelocityAtPoint(Vector3(points[i].x, points[i].y, points[i].z)));
+}
+
+bool VelocityField::getBoundingBox(Vector3& aabbMin, Vector3& aabbMax) const
+{
+    return false;
+}
+
+bool VelocityField::Overlaps(const Vector3& aabbMin, const Vector3& aabbMax) const
+{
+    Vector3 fMin, fMax;
+    if(!getBoundingBox(fMin, fMax))
+        return true;
+    return TestAabbAgainstAabb2(aabbMin, aabbMax, fMin, fMax);
+}
+
 }
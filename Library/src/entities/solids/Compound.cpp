@@ -28,6 +28,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "utils/GeometryFileUtil.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -281,8 +282,21 @@ btCollisionShape* Compound::BuildCollisionShape()
         {
             Transform childTrans = parts[i].origin * parts[i].solid->getCG2OTransform().inverse() * parts[i].solid->getCG2CTransform();
             btCollisionShape* partColShape = parts[i].solid->BuildCollisionShape();
-            colShape->addChildShape(childTrans, partColShape);
-            collisionPartId.push_back(i);
+            if(partColShape->getShapeType() == COMPOUND_SHAPE_PROXYTYPE) //Flatten decomposed parts, so that the child index identifies the part
+            {
+                btCompoundShape* partCompound = (btCompoundShape*)partColShape;
+                for(int h=0; h<partCompound->getNumChildShapes(); ++h)
+                {
+                    colShape->addChildShape(childTrans * partCompound->getChildTransform(h), partCompound->getChildShape(h));
+                    collisionPartId.push_back(i);
+                }
+                delete partCompound;
+            }
+            else
+            {
+                colShape->addChildShape(childTrans, partColShape);
+                collisionPartId.push_back(i);
+            }
         }
     }
     return colShape;
@@ -292,9 +306,7 @@ void Compound::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean*
 {
     if(phy.mode != PhysicsMode::FLOATING && phy.mode != PhysicsMode::SUBMERGED) return;
     
-    auto points = submerged.getDataAsPoints();
-    if (points != nullptr)
-        points->clear();
+    submerged.clear();
 
     BodyFluidPosition bf = CheckBodyFluidPosition(ocn);
      
@@ -347,7 +359,10 @@ void Compound::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean*
                     Transform T_C_part = getOTransform() * parts[i].origin * parts[i].solid->getO2CTransform();
                     Transform T_O_part = getOTransform() * parts[i].origin;
 
-                    ComputeHydrodynamicForcesSubmerged(parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fdqp, Tdqp, Fdfp, Tdfp);
+                    if(i < partDragModels.size() && !partDragModels[i].flow.empty())
+                        ComputeHydrodynamicForcesSubmerged(partDragModels[i], ocn, getCGTransform(), T_C_part, v, omega, Fdqp, Tdqp, Fdfp, Tdfp);
+                    else
+                        ComputeHydrodynamicForcesSubmerged(parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fdqp, Tdqp, Fdfp, Tdfp, &hydroBuffers);
                     Vector3 Cd, Cf;
                     parts[i].solid->getHydrodynamicCoefficients(Cd, Cf);
                     CorrectHydrodynamicForces(ocn, Fdqp, Tdqp, Fdfp, Tdfp, Cd, Cf, T_O_part);
@@ -410,7 +425,7 @@ void Compound::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean*
 
                 if(parts[i].isExternal) //Compute buoyancy and drag
                 {
-                    ComputeHydrodynamicForcesSurface(pSettings, parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fbp, Tbp, Fdqp, Tdqp, Fdfp, Tdfp, Swetp, Vsubp, submerged);
+                    ComputeHydrodynamicForcesSurface(pSettings, parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fbp, Tbp, Fdqp, Tdqp, Fdfp, Tdfp, Swetp, Vsubp, submerged, &hydroBuffers);
                     Vector3 Cd, Cf;
                     parts[i].solid->getHydrodynamicCoefficients(Cd, Cf);
                     CorrectHydrodynamicForces(ocn, Fdqp, Tdqp, Fdfp, Tdfp, Cd, Cf, T_O_part);
@@ -426,7 +441,7 @@ void Compound::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean*
                 else if(pSettings.reallisticBuoyancy) //Compute only buoyancy
                 {
                     pSettings.dampingForces = false;
-                    ComputeHydrodynamicForcesSurface(pSettings, parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fbp, Tbp, Fdqp, Tdqp, Fdfp, Tdfp, Swetp, Vsubp, submerged);
+                    ComputeHydrodynamicForcesSurface(pSettings, parts[i].solid->getPhysicsMesh(), ocn, getCGTransform(), T_C_part, v, omega, Fbp, Tbp, Fdqp, Tdqp, Fdfp, Tdfp, Swetp, Vsubp, submerged, &hydroBuffers);
                     Fb += Fbp;
                     Tb += Tbp;
                     Vsub += Vsubp;
@@ -436,6 +451,24 @@ void Compound::ComputeHydrodynamicForces(HydrodynamicsSettings settings, Ocean*
     }
 }
 
+void Compound::BuildReducedDragModels()
+{
+    if(phy.mode != PhysicsMode::FLOATING && phy.mode != PhysicsMode::SUBMERGED)
+        return;
+
+    partDragModels.assign(parts.size(), ReducedDragModel());
+    for(size_t i=0; i<parts.size(); ++i)
+        if(parts[i].isExternal 
+            && (parts[i].solid->getPhysicsMode() == PhysicsMode::SUBMERGED
+            || parts[i].solid->getPhysicsMode() == PhysicsMode::FLOATING))
+        {
+            Transform T_CG2C_part = T_CG2O * parts[i].origin * parts[i].solid->getO2CTransform();
+            BuildReducedDragModel(parts[i].solid->getPhysicsMesh(), T_CG2C_part.inverse().getOrigin(), partDragModels[i]);
+            cInfo("Built reduced drag model of %s/%s [max. error of form drag: force %1.1lf%%, torque %1.1lf%%]", getName().c_str(),
+                  parts[i].solid->getName().c_str(), partDragModels[i].forceError * 100.0, partDragModels[i].torqueError * 100.0);
+        }
+}
+
 void Compound::ComputeAerodynamicForces(Atmosphere* atm)
 {
     if(phy.mode != PhysicsMode::AERODYNAMIC) return;
@@ -510,13 +543,15 @@ std::vector<Renderable> Compound::Render(size_t partId)
         }
 
 #ifndef DEBUG_HYDRO
+        if(!OpenGLHelperArena::isEnabled(RenderableType::HYDRO_ELLIPSOID))
+            return items;
+
         GeometryApproxType atype;
         std::vector<Scalar> aparams;
         parts.at(partId).solid->getGeometryApprox(atype, aparams);
 
         Renderable item2;
         item2.model = glMatrixFromTransform(oCompoundTrans * parts.at(partId).origin * parts.at(partId).solid->getO2HTransform());
-        item2.data = std::make_shared<std::vector<glm::vec3>>();
 
         switch(atype)
         {
@@ -525,19 +560,19 @@ std::vector<Renderable> Compound::Render(size_t partId)
             
             case  GeometryApproxType::SPHERE:
                 item2.type = RenderableType::HYDRO_ELLIPSOID;
-                item2.getDataAsPoints()->push_back(glm::vec3((GLfloat)aparams[0], (GLfloat)aparams[0], (GLfloat)aparams[0]));
+                item2.data = OpenGLHelperArena::Store({glm::vec3((GLfloat)aparams[0], (GLfloat)aparams[0], (GLfloat)aparams[0])});
                 items.push_back(item2);
                 break;
             
             case  GeometryApproxType::CYLINDER:
                 item2.type = RenderableType::HYDRO_CYLINDER;
-                item2.getDataAsPoints()->push_back(glm::vec3((GLfloat)aparams[0], (GLfloat)aparams[0], (GLfloat)aparams[1]));
+                item2.data = OpenGLHelperArena::Store({glm::vec3((GLfloat)aparams[0], (GLfloat)aparams[0], (GLfloat)aparams[1])});
                 items.push_back(item2);
                 break;
             
             case  GeometryApproxType::ELLIPSOID:
                 item2.type = RenderableType::HYDRO_ELLIPSOID;
-                item2.getDataAsPoints()->push_back(glm::vec3((GLfloat)aparams[0], (GLfloat)aparams[1], (GLfloat)aparams[2]));
+                item2.data = OpenGLHelperArena::Store({glm::vec3((GLfloat)aparams[0], (GLfloat)aparams[1], (GLfloat)aparams[2])});
                 items.push_back(item2);
                 break;
         }   
@@ -566,8 +601,6 @@ std::vector<Renderable> Compound::Render()
         Renderable item2;
         item2.type = RenderableType::HYDRO_CS;
         item2.model = glMatrixFromTransform(Transform(Quaternion::getIdentity(), cbWorld));
-        item2.data = std::make_shared<std::vector<glm::vec3>>();
-        item2.getDataAsPoints()->push_back(glm::vec3(volume, volume, volume));
         items.push_back(item2);
         
         //Parts
@@ -578,84 +611,85 @@ std::vector<Renderable> Compound::Render()
         }
 
         //Forces
-        Vector3 cg = getCGTransform().getOrigin();
-        glm::vec3 cgv((GLfloat)cg.x(), (GLfloat)cg.y(), (GLfloat)cg.z());
-
-        //--- Buoyancy
-        Renderable item3;
-        item3.type = RenderableType::FORCE_BUOYANCY;
-        item3.model = glm::mat4(1.f);
-        item3.data = std::make_shared<std::vector<glm::vec3>>();
-        item3.getDataAsPoints()->push_back(cgv);
-        item3.getDataAsPoints()->push_back(cgv + glm::vec3((GLfloat)Fb.x(), (GLfloat)Fb.y(), (GLfloat)Fb.z())/1000.f);
-        items.push_back(item3);
+        if(OpenGLHelperArena::isEnabled(RenderableType::FORCE_BUOYANCY))
+        {
+            Vector3 cg = getCGTransform().getOrigin();
+            glm::vec3 cgv((GLfloat)cg.x(), (GLfloat)cg.y(), (GLfloat)cg.z());
+
+            //--- Buoyancy
+            Renderable item3;
+            item3.type = RenderableType::FORCE_BUOYANCY;
+            item3.model = glm::mat4(1.f);
+            item3.data = OpenGLHelperArena::Store({cgv, cgv + glm::vec3((GLfloat)Fb.x(), (GLfloat)Fb.y(), (GLfloat)Fb.z())/1000.f});
+            items.push_back(item3);
         
-        //--- Linear drag
-        Renderable item4;
-        item4.type = RenderableType::FORCE_LINEAR_DRAG;
-        item4.model = glm::mat4(1.f);
-        item4.data = std::make_shared<std::vector<glm::vec3>>();
-        item4.getDataAsPoints()->push_back(cgv);
-        item4.getDataAsPoints()->push_back(cgv + glm::vec3((GLfloat)Fdf.x(), (GLfloat)Fdf.y(), (GLfloat)Fdf.z()));
-        items.push_back(item4);
+            //--- Linear drag
+            Renderable item4;
+            item4.type = RenderableType::FORCE_LINEAR_DRAG;
+            item4.model = glm::mat4(1.f);
+            item4.data = OpenGLHelperArena::Store({cgv, cgv + glm::vec3((GLfloat)Fdf.x(), (GLfloat)Fdf.y(), (GLfloat)Fdf.z())});
+            items.push_back(item4);
         
-        //--- Quadratic drag
-        Renderable item5;
-        item5.type = RenderableType::FORCE_QUADRATIC_DRAG;
-        item5.model = glm::mat4(1.f);
-        item5.data = std::make_shared<std::vector<glm::vec3>>();
-        item5.getDataAsPoints()->push_back(cgv);
-        item5.getDataAsPoints()->push_back(cgv + glm::vec3((GLfloat)Fdq.x(), (GLfloat)Fdq.y(), (GLfloat)Fdq.z()));
-        items.push_back(item5);
+            //--- Quadratic drag
+            Renderable item5;
+            item5.type = RenderableType::FORCE_QUADRATIC_DRAG;
+            item5.model = glm::mat4(1.f);
+            item5.data = OpenGLHelperArena::Store({cgv, cgv + glm::vec3((GLfloat)Fdq.x(), (GLfloat)Fdq.y(), (GLfloat)Fdq.z())});
+            items.push_back(item5);
+        }
 
 #ifdef DEBUG_HYDRO
-        items.push_back(submerged);
+        Renderable submergedItem;
+        submergedItem.type = RenderableType::HYDRO_LINES;
+        submergedItem.model = glm::mat4(1.f);
+        submergedItem.data = OpenGLHelperArena::Store(submerged);
+        items.push_back(submergedItem);
 
         Renderable debugItem;
         debugItem.type = RenderableType::HYDRO_LINES;
         debugItem.model = glm::mat4(1.f);
-        debugItem.data = std::make_shared<std::vector<glm::vec3>>();
-        auto points = debugItem.getDataAsPoints();
+        auto& points = OpenGLHelperArena::Begin();
         
         Vector3 min, max;
         getAABB(min, max);
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)min.z()));
+        points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)min.z()));
+        points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)min.z()));
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)min.z()));
+        points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)min.z()));
+        points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)min.z()));
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)max.z()));
+        points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)min.z()));
+        points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)max.z()));
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)max.z()));
+        points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)min.z()));
+        points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)max.z()));
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)max.z()));
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)max.z()));
+        points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)max.z()));
+        points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)max.z()));
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)max.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)max.z()));
+        points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)min.y(), (GLfloat)max.z()));
+        points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)max.z()));
 
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)max.z()));
+        points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)min.z()));
+        points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)max.z()));
 
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)min.z()));
+        points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)min.z()));
+        points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)min.z()));
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)min.z()));
+        points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)min.z()));
+        points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)min.z()));
 
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)min.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)max.z()));
+        points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)min.z()));
+        points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)max.z()));
 
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)max.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)max.z()));
+        points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)min.y(), (GLfloat)max.z()));
+        points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)max.z()));
 
-        points->push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)max.z()));
-        points->push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)max.z()));
+        points.push_back(glm::vec3((GLfloat)min.x(), (GLfloat)max.y(), (GLfloat)max.z()));
+        points.push_back(glm::vec3((GLfloat)max.x(), (GLfloat)max.y(), (GLfloat)max.z()));
 
+        debugItem.data = OpenGLHelperArena::Commit();
         items.push_back(debugItem);
 #endif
     }
@@ -69,6 +69,10 @@ Polyhedron::Polyhedron(std::string uniqueName, PhysicsSettings phy,
     ComputeFluidDynamicsApprox(approx);
     T_O2H = T_CG2O.inverse() * T_CG2H;
     P_CB = Vector3(0,0,0);
+    
+    //4. Collision geometry
+    hullTolerance = Scalar(0);
+    decompose = false;
 }
     
 Polyhedron::Polyhedron(std::string uniqueName, PhysicsSettings phy, 
@@ -89,16 +93,56 @@ SolidType Polyhedron::getSolidType()
     return SolidType::POLYHEDRON;
 }
 
+void Polyhedron::setHullReduction(Scalar tolerance)
+{
+    hullTolerance = tolerance;
+}
+
+void Polyhedron::setConvexDecomposition(const ConvexDecompositionSettings& settings)
+{
+    decomposition = settings;
+    decompose = true;
+}
+
+Scalar Polyhedron::getHullReduction() const
+{
+    return hullTolerance;
+}
+
+bool Polyhedron::isConvexDecompositionEnabled() const
+{
+    return decompose;
+}
+
 btCollisionShape* Polyhedron::BuildCollisionShape()
 {
-    btConvexHullShape* convex = new btConvexHullShape();
-    for(size_t i=0; i<phyMesh->getNumOfVertices(); ++i)
+    if(decompose)
+    {
+        std::vector<std::vector<Vector3>> parts = DecomposeConvex(phyMesh, decomposition);
+        
+        if(parts.size() > 1)
+        {
+            btCompoundShape* compound = new btCompoundShape(true, (int)parts.size());
+            for(size_t i=0; i<parts.size(); ++i)
+            {
+                btConvexHullShape* convex = new btConvexHullShape(&parts[i][0].x(), (int)parts[i].size(), sizeof(Vector3));
+                convex->setMargin(0);
+                compound->addChildShape(I4(), convex);
+            }
+            return compound;
+        }
+    }
+
+    std::vector<Vector3> points(phyMesh->getNumOfVertices());
+    for(size_t i=0; i<points.size(); ++i)
     {
         glm::vec3 pos = phyMesh->getVertexPos(i);
-        Vector3 v(pos.x, pos.y, pos.z);
-        convex->addPoint(v);
+        points[i] = Vector3(pos.x, pos.y, pos.z);
     }
-    //convex->optimizeConvexHull();
+    if(hullTolerance >= Scalar(0))
+        points = ReduceConvexHull(points, hullTolerance);
+    
+    btConvexHullShape* convex = new btConvexHullShape(&points[0].x(), (int)points.size(), sizeof(Vector3));
     convex->setMargin(0);
     return convex;
 }
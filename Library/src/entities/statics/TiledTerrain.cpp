@@ -0,0 +1,721 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  TiledTerrain.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "entities/statics/TiledTerrain.h"
+
+#include <cstring>
+#include <cmath>
+#include <cfloat>
+#include <fstream>
+#include <algorithm>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "core/SimulationApp.h"
+#include "core/SimulationManager.h"
+#include "entities/SolidEntity.h"
+#include "entities/FeatherstoneEntity.h"
+#include "entities/AnimatedEntity.h"
+#include "sensors/VisionSensor.h"
+#include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLView.h"
+#include "stb_image.h"
+
+namespace sf
+{
+
+#define TILED_TERRAIN_KEEP_FACTOR   Scalar(1.5) //Tiles are unloaded only beyond this multiple of the paging radius
+#define TILED_TERRAIN_BUILD_BUDGET  8           //Maximum number of tile meshes built per frame
+
+TiledTerrain::TiledTerrain(std::string uniqueName, std::string pathToData, std::string material, std::string look, float uvScale,
+                           Scalar pagingRadius, Scalar lodDistance, Scalar drawRange)
+    : StaticEntity(uniqueName, material, look), tileRange(nullptr), data(nullptr), pageCount(0), maxTileRadius(0), sim(nullptr), T(Transform::getIdentity()),
+      pRadius(pagingRadius), lodDist(lodDistance), range(drawRange), uvs(uvScale), renderCount(0), graphicsCount(0), mapping(nullptr), mappingSize(0)
+{
+    //Map data file
+#ifdef _WIN32
+    fileHandle = CreateFileA(pathToData.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+    if(fileHandle == INVALID_HANDLE_VALUE)
+        cCritical("Failed to open terrain data file '%s'!", pathToData.c_str());
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(fileHandle, &fileSize);
+    mappingSize = (size_t)fileSize.QuadPart;
+    mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if(mappingHandle != NULL)
+        mapping = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if(mapping == nullptr)
+        cCritical("Failed to map terrain data file '%s'!", pathToData.c_str());
+#else
+    int fd = open(pathToData.c_str(), O_RDONLY);
+    if(fd < 0)
+        cCritical("Failed to open terrain data file '%s'!", pathToData.c_str());
+    struct stat st;
+    if(fstat(fd, &st) == 0)
+        mappingSize = (size_t)st.st_size;
+    mapping = mappingSize > 0 ? mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if(mapping == MAP_FAILED)
+        cCritical("Failed to map terrain data file '%s'!", pathToData.c_str());
+    madvise(mapping, mappingSize, MADV_RANDOM); //Only the tiles around the vehicles should be paged in
+#endif
+
+    //Check header
+    if(mappingSize < sizeof(TiledTerrainHeader))
+        cCritical("Terrain data file '%s' is corrupted!", pathToData.c_str());
+    std::memcpy(&header, mapping, sizeof(TiledTerrainHeader));
+    if(std::strncmp(header.magic, "SFTT", 4) != 0 || header.version != 1
+       || (header.format != TiledTerrainFormat::FLOAT32 && header.format != TiledTerrainFormat::INT16))
+        cCritical("Terrain data file '%s' has wrong format!", pathToData.c_str());
+    if(header.size[0] < 2 || header.size[1] < 2 || header.tile < 4 || (header.tile & (header.tile - 1)) != 0
+       || header.spacing[0] <= 0.0 || header.spacing[1] <= 0.0)
+        cCritical("Terrain data file '%s' has invalid dimensions!", pathToData.c_str());
+
+    //Compute data layout
+    tiles[0] = (header.size[0] - 1 + header.tile - 1)/header.tile;
+    tiles[1] = (header.size[1] - 1 + header.tile - 1)/header.tile;
+    size_t tileCount = (size_t)tiles[0] * tiles[1];
+    tileNodes = (size_t)(header.tile + 1) * (header.tile + 1);
+    size_t valueSize = header.format == TiledTerrainFormat::INT16 ? sizeof(int16_t) : sizeof(float);
+    size_t requiredSize = sizeof(TiledTerrainHeader) + tileCount * 2 * sizeof(float) + tileCount * tileNodes * valueSize;
+    if(mappingSize < requiredSize)
+        cCritical("Terrain data file '%s' is truncated!", pathToData.c_str());
+
+    tileRange = (const float*)((const char*)mapping + sizeof(TiledTerrainHeader));
+    data = tileRange + 2 * tileCount;
+
+    //Levels of detail (coarsest has 4 cells along the tile edge)
+    maxLod = 0;
+    while((header.tile >> (maxLod + 1)) >= 4)
+        ++maxLod;
+
+    //Tile descriptors
+    Scalar spx = Scalar(header.spacing[0]);
+    Scalar spy = Scalar(header.spacing[1]);
+    tileInfo.resize(tileCount);
+    for(uint32_t ty=0; ty<tiles[1]; ++ty)
+        for(uint32_t tx=0; tx<tiles[0]; ++tx)
+        {
+            size_t id = (size_t)ty * tiles[0] + tx;
+            Tile& t = tileInfo[id];
+            t.nodes[0] = std::min(header.tile, header.size[0] - 1 - tx * header.tile) + 1;
+            t.nodes[1] = std::min(header.tile, header.size[1] - 1 - ty * header.tile) + 1;
+            t.minHeight = tileRange[2*id];
+            t.maxHeight = tileRange[2*id+1];
+            Scalar ex = (t.nodes[0] - 1) * spx;
+            Scalar ey = (t.nodes[1] - 1) * spy;
+            Scalar ez = Scalar(t.maxHeight - t.minHeight);
+            t.center = Vector3(tx * header.tile * spx + ex/Scalar(2), ty * header.tile * spy + ey/Scalar(2), Scalar(t.minHeight + t.maxHeight)/Scalar(2));
+            t.radius = btSqrt(ex*ex + ey*ey + ez*ez)/Scalar(2);
+            maxTileRadius = btMax(maxTileRadius, t.radius);
+            t.heights = nullptr;
+            t.shape = nullptr;
+            t.body = nullptr;
+            t.objectId = -1;
+            t.objectLod = -1;
+            t.model = glm::mat4(1.f);
+            t.stamp = 0;
+            t.graphicsStamp = 0;
+        }
+
+    graphicsMutex = SDL_CreateMutex();
+}
+
+TiledTerrain::~TiledTerrain()
+{
+    //Rigid bodies are deleted together with the dynamics world
+    for(size_t i=0; i<loaded.size(); ++i)
+    {
+        Tile& t = tileInfo[loaded[i]];
+        delete t.shape;
+        delete [] t.heights;
+    }
+    SDL_DestroyMutex(graphicsMutex);
+
+#ifdef _WIN32
+    if(mapping != nullptr)
+        UnmapViewOfFile(mapping);
+    if(mappingHandle != NULL)
+        CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+#else
+    if(mapping != nullptr && mapping != MAP_FAILED)
+        munmap(mapping, mappingSize);
+#endif
+}
+
+StaticEntityType TiledTerrain::getStaticType()
+{
+    return StaticEntityType::TILED_TERRAIN;
+}
+
+void TiledTerrain::getAABB(Vector3& min, Vector3& max)
+{
+    //Terrain shouldn't affect shadow calculation
+    min.setValue(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+    max.setValue(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+}
+
+Transform TiledTerrain::getTransform()
+{
+    return T;
+}
+
+unsigned int TiledTerrain::getNumOfLoadedTiles() const
+{
+    return (unsigned int)loaded.size();
+}
+
+unsigned int TiledTerrain::getNumOfDrawnTiles() const
+{
+    SDL_LockMutex(graphicsMutex);
+    unsigned int n = (unsigned int)drawn.size();
+    SDL_UnlockMutex(graphicsMutex);
+    return n;
+}
+
+int TiledTerrain::getLevelOfDetail(Scalar distance) const
+{
+    if(distance > range)
+        return -1;
+    if(distance <= lodDist)
+        return 0;
+    return std::min(maxLod, (int)std::floor(btLog(distance/lodDist)/btLog(Scalar(2))) + 1);
+}
+
+Scalar TiledTerrain::getNode(uint32_t gx, uint32_t gy) const
+{
+    gx = std::min(gx, header.size[0] - 1);
+    gy = std::min(gy, header.size[1] - 1);
+    uint32_t tx = std::min(gx / header.tile, tiles[0] - 1);
+    uint32_t ty = std::min(gy / header.tile, tiles[1] - 1);
+    size_t index = ((size_t)ty * tiles[0] + tx) * tileNodes + (size_t)(gy - ty * header.tile) * (header.tile + 1) + (gx - tx * header.tile);
+    Scalar value = header.format == TiledTerrainFormat::INT16 ? Scalar(((const int16_t*)data)[index]) : Scalar(((const float*)data)[index]);
+    return value * Scalar(header.scale) + Scalar(header.offset);
+}
+
+Scalar TiledTerrain::getHeight(Scalar x, Scalar y) const
+{
+    Scalar u = btClamped(x / Scalar(header.spacing[0]), Scalar(0), Scalar(header.size[0] - 1));
+    Scalar v = btClamped(y / Scalar(header.spacing[1]), Scalar(0), Scalar(header.size[1] - 1));
+    uint32_t i = std::min((uint32_t)u, header.size[0] - 2);
+    uint32_t j = std::min((uint32_t)v, header.size[1] - 2);
+    Scalar wu = u - Scalar(i);
+    Scalar wv = v - Scalar(j);
+    Scalar h0 = getNode(i, j) * (Scalar(1) - wu) + getNode(i + 1, j) * wu;
+    Scalar h1 = getNode(i, j + 1) * (Scalar(1) - wu) + getNode(i + 1, j + 1) * wu;
+    return h0 * (Scalar(1) - wv) + h1 * wv;
+}
+
+void TiledTerrain::AddToSimulation(SimulationManager* sm, const Transform& origin)
+{
+    sim = sm;
+    T = origin;
+    for(size_t i=0; i<tileInfo.size(); ++i)
+        tileInfo[i].model = glMatrixFromTransform(T * Transform(IQ(), tileInfo[i].center));
+    UpdateTiles(sm);
+}
+
+void TiledTerrain::LoadTile(size_t id)
+{
+    Tile& t = tileInfo[id];
+    uint32_t gx0 = (uint32_t)(id % tiles[0]) * header.tile;
+    uint32_t gy0 = (uint32_t)(id / tiles[0]) * header.tile;
+
+    //Decode heights
+    t.heights = new Scalar[t.nodes[0] * t.nodes[1]];
+    Scalar minHeight = BT_LARGE_FLOAT;
+    Scalar maxHeight = -BT_LARGE_FLOAT;
+    for(uint32_t j=0; j<t.nodes[1]; ++j)
+        for(uint32_t i=0; i<t.nodes[0]; ++i)
+        {
+            Scalar h = getNode(gx0 + i, gy0 + j);
+            t.heights[j * t.nodes[0] + i] = h;
+            minHeight = btMin(minHeight, h);
+            maxHeight = btMax(maxHeight, h);
+        }
+
+    //Collision shape (heightfield is centered in its bounding box)
+    t.shape = new btHeightfieldTerrainShape(t.nodes[0], t.nodes[1], t.heights, Scalar(1), minHeight, maxHeight, 2, PHY_FLOAT, false);
+    t.shape->setLocalScaling(Vector3(Scalar(header.spacing[0]), Scalar(header.spacing[1]), Scalar(1)));
+    t.shape->setUseDiamondSubdivision(true);
+    t.shape->setMargin(0);
+
+    Transform tileTrans = T * Transform(IQ(), Vector3(t.center.x(), t.center.y(), (minHeight + maxHeight)/Scalar(2)));
+    t.body = CreateRigidBody(t.shape);
+    t.body->getMotionState()->setWorldTransform(tileTrans);
+    t.body->setCenterOfMassTransform(tileTrans);
+    sim->getDynamicsWorld()->addRigidBody(t.body, MASK_STATIC, MASK_DYNAMIC);
+    t.stamp = pageCount;
+    loaded.push_back(id);
+}
+
+void TiledTerrain::UnloadTile(size_t id)
+{
+    Tile& t = tileInfo[id];
+    sim->getDynamicsWorld()->removeRigidBody(t.body);
+    delete t.body->getMotionState();
+    delete t.body;
+    delete t.shape;
+    delete [] t.heights;
+    t.body = nullptr;
+    t.shape = nullptr;
+    t.heights = nullptr;
+}
+
+void TiledTerrain::UpdateTiles(SimulationManager* sm)
+{
+    if(sim == nullptr)
+        return;
+
+    //Collect paging centres (bodies which can collide or sense the terrain)
+    centres.clear();
+    Entity* ent;
+    for(unsigned int i=0; (ent = sm->getEntity(i)) != nullptr; ++i)
+    {
+        switch(ent->getType())
+        {
+            case EntityType::SOLID:
+                centres.push_back(((SolidEntity*)ent)->getCGTransform().getOrigin());
+                break;
+
+            case EntityType::FEATHERSTONE:
+                centres.push_back(((FeatherstoneEntity*)ent)->getLinkTransform(0).getOrigin());
+                break;
+
+            case EntityType::ANIMATED:
+                centres.push_back(((AnimatedEntity*)ent)->getOTransform().getOrigin());
+                break;
+
+            default:
+                break;
+        }
+    }
+    Sensor* sens;
+    for(unsigned int i=0; (sens = sm->getSensor(i)) != nullptr; ++i)
+        if(sens->getType() == SensorType::VISION)
+            centres.push_back(sens->getSensorFrame().getOrigin());
+
+    //Mark tiles to keep and load the missing ones
+    ++pageCount;
+    Transform invT = T.inverse();
+    Scalar tileSize[2] = {header.tile * Scalar(header.spacing[0]), header.tile * Scalar(header.spacing[1])};
+    for(size_t h=0; h<centres.size(); ++h)
+    {
+        Vector3 p = invT * centres[h];
+        for(int pass=0; pass<2; ++pass)
+        {
+            Scalar r = pass == 0 ? pRadius * TILED_TERRAIN_KEEP_FACTOR : pRadius;
+            int x0 = (int)std::floor((p.x() - r)/tileSize[0]);
+            int x1 = (int)std::floor((p.x() + r)/tileSize[0]);
+            int y0 = (int)std::floor((p.y() - r)/tileSize[1]);
+            int y1 = (int)std::floor((p.y() + r)/tileSize[1]);
+            if(x1 < 0 || y1 < 0 || x0 >= (int)tiles[0] || y0 >= (int)tiles[1])
+                break;
+            x0 = std::max(x0, 0);
+            y0 = std::max(y0, 0);
+            x1 = std::min(x1, (int)tiles[0] - 1);
+            y1 = std::min(y1, (int)tiles[1] - 1);
+
+            for(int ty=y0; ty<=y1; ++ty)
+                for(int tx=x0; tx<=x1; ++tx)
+                {
+                    size_t id = (size_t)ty * tiles[0] + tx;
+                    if(tileInfo[id].body != nullptr)
+                        tileInfo[id].stamp = pageCount;
+                    else if(pass == 1)
+                        LoadTile(id);
+                }
+        }
+    }
+
+    //Unload tiles far from all centres
+    for(size_t i=0; i<loaded.size();)
+    {
+        if(tileInfo[loaded[i]].stamp != pageCount)
+        {
+            UnloadTile(loaded[i]);
+            loaded[i] = loaded.back();
+            loaded.pop_back();
+        }
+        else
+            ++i;
+    }
+}
+
+Mesh* TiledTerrain::BuildTileMesh(size_t id, int lod) const
+{
+    const Tile& t = tileInfo[id];
+    uint32_t gx0 = (uint32_t)(id % tiles[0]) * header.tile;
+    uint32_t gy0 = (uint32_t)(id / tiles[0]) * header.tile;
+    uint32_t step = 1u << lod;
+    GLfloat spx = (GLfloat)header.spacing[0];
+    GLfloat spy = (GLfloat)header.spacing[1];
+
+    //Sampled nodes (the last node of partial tiles is always included)
+    std::vector<uint32_t> xs, ys;
+    for(uint32_t i=0; i<t.nodes[0]-1; i+=step)
+        xs.push_back(i);
+    xs.push_back(t.nodes[0]-1);
+    for(uint32_t j=0; j<t.nodes[1]-1; j+=step)
+        ys.push_back(j);
+    ys.push_back(t.nodes[1]-1);
+    GLuint nx = (GLuint)xs.size();
+    GLuint ny = (GLuint)ys.size();
+
+    TexturableMesh* mesh = new TexturableMesh;
+    TexturableVertex vt;
+    Face f;
+
+    for(GLuint j=0; j<ny; ++j)
+        for(GLuint i=0; i<nx; ++i)
+        {
+            uint32_t gx = gx0 + xs[i];
+            uint32_t gy = gy0 + ys[j];
+            vt.pos = glm::vec3(gx * spx - (GLfloat)t.center.x(), gy * spy - (GLfloat)t.center.y(), (GLfloat)(getNode(gx, gy) - t.center.z()));
+            //Normal from central differences on the full resolution grid (seamless between tiles)
+            uint32_t xm = gx > 0 ? gx - 1 : gx;
+            uint32_t xp = std::min(gx + 1, header.size[0] - 1);
+            uint32_t ym = gy > 0 ? gy - 1 : gy;
+            uint32_t yp = std::min(gy + 1, header.size[1] - 1);
+            GLfloat dzdx = (GLfloat)(getNode(xp, gy) - getNode(xm, gy)) / ((xp - xm) * spx);
+            GLfloat dzdy = (GLfloat)(getNode(gx, yp) - getNode(gx, ym)) / ((yp - ym) * spy);
+            vt.normal = glm::normalize(glm::vec3(dzdx, dzdy, -1.f));
+            vt.uv = glm::vec2((GLfloat)gx/(GLfloat)(header.size[0]-1), (GLfloat)gy/(GLfloat)(header.size[1]-1)) * uvs;
+            mesh->vertices.push_back(vt);
+        }
+
+    for(GLuint j=0; j<ny-1; ++j)
+        for(GLuint i=0; i<nx-1; ++i)
+        {
+            f.vertexID[0] = j*nx + i;
+            f.vertexID[1] = (j+1)*nx + i;
+            f.vertexID[2] = j*nx + i + 1;
+            mesh->faces.push_back(f);
+            f.vertexID[0] = f.vertexID[1];
+            f.vertexID[1] = (j+1)*nx + i + 1;
+            mesh->faces.push_back(f);
+        }
+
+    //Skirts hiding the cracks between tiles of different level of detail
+    GLfloat skirt = (t.maxHeight - t.minHeight) + step * std::max(spx, spy);
+    auto addSkirt = [&](GLuint a, GLuint b, const glm::vec3& outward)
+    {
+        GLuint a2 = (GLuint)mesh->vertices.size();
+        TexturableVertex va = mesh->vertices[a];
+        TexturableVertex vb = mesh->vertices[b];
+        va.pos.z += skirt;
+        vb.pos.z += skirt;
+        mesh->vertices.push_back(va);
+        mesh->vertices.push_back(vb);
+        glm::vec3 n = glm::cross(mesh->vertices[b].pos - mesh->vertices[a].pos, va.pos - mesh->vertices[a].pos);
+        bool flip = glm::dot(n, outward) < 0.f;
+        f.vertexID[0] = a;
+        f.vertexID[1] = flip ? b : a2;
+        f.vertexID[2] = flip ? a2 : b;
+        mesh->faces.push_back(f);
+        f.vertexID[0] = b;
+        f.vertexID[1] = flip ? a2+1 : a2;
+        f.vertexID[2] = flip ? a2 : a2+1;
+        mesh->faces.push_back(f);
+    };
+    for(GLuint i=0; i<nx-1; ++i)
+    {
+        addSkirt(i, i+1, glm::vec3(0.f,-1.f,0.f));
+        addSkirt((ny-1)*nx + i, (ny-1)*nx + i+1, glm::vec3(0.f,1.f,0.f));
+    }
+    for(GLuint j=0; j<ny-1; ++j)
+    {
+        addSkirt(j*nx, (j+1)*nx, glm::vec3(-1.f,0.f,0.f));
+        addSkirt(j*nx + nx-1, (j+1)*nx + nx-1, glm::vec3(1.f,0.f,0.f));
+    }
+
+    OpenGLContent::ComputeTangents(mesh);
+    return mesh;
+}
+
+void TiledTerrain::UpdateGraphics(OpenGLContent* content)
+{
+    if(sim == nullptr || !isRenderable())
+        return;
+
+    //Destroy meshes which can no longer be referenced by the drawing queue
+    SDL_LockMutex(graphicsMutex);
+    for(size_t i=0; i<retired.size();)
+    {
+        if(renderCount >= retired[i].second + 2)
+        {
+            content->DestroyObject(retired[i].first);
+            retired[i] = retired.back();
+            retired.pop_back();
+        }
+        else
+            ++i;
+    }
+    SDL_UnlockMutex(graphicsMutex);
+
+    //Eyes of the active views in the terrain frame
+    Transform invT = T.inverse();
+    eyes.clear();
+    for(unsigned int i=0; i<content->getViewsCount(); ++i)
+    {
+        OpenGLView* view = content->getView(i);
+        if(!view->isEnabled())
+            continue;
+        glm::vec3 eye = view->GetEyePosition();
+        eyes.push_back(invT * Vector3(eye.x, eye.y, eye.z));
+    }
+
+    //Find tiles with the wrong level of detail, among the tiles within the drawing range and the tiles drawn until now
+    ++graphicsCount;
+    requests.clear();
+    Scalar reach = range + maxTileRadius;
+    Scalar tileSize[2] = {header.tile * Scalar(header.spacing[0]), header.tile * Scalar(header.spacing[1])};
+    for(size_t h=0; h<eyes.size(); ++h)
+    {
+        int x0 = std::max((int)std::floor((eyes[h].x() - reach)/tileSize[0]), 0);
+        int x1 = std::min((int)std::floor((eyes[h].x() + reach)/tileSize[0]), (int)tiles[0] - 1);
+        int y0 = std::max((int)std::floor((eyes[h].y() - reach)/tileSize[1]), 0);
+        int y1 = std::min((int)std::floor((eyes[h].y() + reach)/tileSize[1]), (int)tiles[1] - 1);
+        for(int ty=y0; ty<=y1; ++ty)
+            for(int tx=x0; tx<=x1; ++tx)
+                RequestTileGraphics((size_t)ty * tiles[0] + tx);
+    }
+    for(size_t i=0; i<drawn.size(); ++i) //Only modified by this thread
+        RequestTileGraphics(drawn[i]);
+    if(requests.empty())
+        return;
+    std::sort(requests.begin(), requests.end());
+
+    //Build meshes of the closest tiles first and retire the replaced ones
+    unsigned int built = 0;
+    for(size_t i=0; i<requests.size(); ++i)
+    {
+        size_t id = requests[i].second;
+        int lod = getLevelOfDetail(requests[i].first);
+        int objectId = -1;
+        if(lod >= 0)
+        {
+            if(built >= TILED_TERRAIN_BUILD_BUDGET)
+                continue;
+            Mesh* mesh = BuildTileMesh(id, lod);
+            objectId = (int)content->BuildObject(mesh);
+            delete mesh;
+            ++built;
+        }
+
+        SDL_LockMutex(graphicsMutex);
+        Tile& t = tileInfo[id];
+        if(t.objectId >= 0)
+        {
+            retired.push_back(std::make_pair(t.objectId, renderCount));
+            if(objectId < 0)
+            {
+                auto it = std::find(drawn.begin(), drawn.end(), id);
+                *it = drawn.back();
+                drawn.pop_back();
+            }
+        }
+        else if(objectId >= 0)
+            drawn.push_back(id);
+        t.objectId = objectId;
+        t.objectLod = lod;
+        SDL_UnlockMutex(graphicsMutex);
+    }
+}
+
+void TiledTerrain::RequestTileGraphics(size_t id)
+{
+    Tile& t = tileInfo[id];
+    if(t.graphicsStamp == graphicsCount) //Already checked in this frame
+        return;
+    t.graphicsStamp = graphicsCount;
+
+    Scalar d = BT_LARGE_FLOAT;
+    for(size_t h=0; h<eyes.size(); ++h)
+        d = btMin(d, btMax((eyes[h] - t.center).length() - t.radius, Scalar(0)));
+    if(getLevelOfDetail(d) != t.objectLod)
+        requests.push_back(std::make_pair(d, id));
+}
+
+std::vector<Renderable> TiledTerrain::Render()
+{
+    std::vector<Renderable> items(0);
+    if(!isRenderable())
+        return items;
+
+    SDL_LockMutex(graphicsMutex);
+    ++renderCount;
+    items.reserve(drawn.size());
+    for(size_t i=0; i<drawn.size(); ++i)
+    {
+        const Tile& t = tileInfo[drawn[i]];
+        Renderable item;
+        item.type = RenderableType::SOLID;
+        item.materialName = mat.name;
+        item.objectId = t.objectId;
+        item.lookId = dm == DisplayMode::GRAPHICAL ? lookId : -1;
+        item.model = t.model;
+        items.push_back(item);
+    }
+    SDL_UnlockMutex(graphicsMutex);
+    return items;
+}
+
+bool TiledTerrain::WriteTerrainData(const std::string& path, const float* heights, uint32_t sizeX, uint32_t sizeY, double spacingX, double spacingY,
+                                    uint32_t tile, TiledTerrainFormat format)
+{
+    if(heights == nullptr || sizeX < 2 || sizeY < 2 || tile < 4 || (tile & (tile - 1)) != 0 || spacingX <= 0.0 || spacingY <= 0.0)
+    {
+        cError("Invalid dimensions of the tiled terrain '%s'!", path.c_str());
+        return false;
+    }
+
+    TiledTerrainHeader hdr;
+    std::memset(&hdr, 0, sizeof(hdr));
+    std::memcpy(hdr.magic, "SFTT", 4);
+    hdr.version = 1;
+    hdr.size[0] = sizeX;
+    hdr.size[1] = sizeY;
+    hdr.tile = tile;
+    hdr.format = format;
+    hdr.spacing[0] = spacingX;
+    hdr.spacing[1] = spacingY;
+    hdr.scale = 1.0;
+    hdr.offset = 0.0;
+
+    //Scale and offset mapping the range of heights to the range of int16
+    size_t count = (size_t)sizeX * sizeY;
+    if(format == TiledTerrainFormat::INT16)
+    {
+        float minH = heights[0];
+        float maxH = heights[0];
+        for(size_t i=1; i<count; ++i)
+        {
+            minH = std::min(minH, heights[i]);
+            maxH = std::max(maxH, heights[i]);
+        }
+        hdr.offset = ((double)minH + (double)maxH)/2.0;
+        hdr.scale = maxH > minH ? ((double)maxH - (double)minH)/(2.0 * INT16_MAX) : 1.0;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if(!file.is_open())
+    {
+        cError("Failed to create tiled terrain file '%s'!", path.c_str());
+        return false;
+    }
+
+    uint32_t tilesX = (sizeX - 1 + tile - 1)/tile;
+    uint32_t tilesY = (sizeY - 1 + tile - 1)/tile;
+    std::vector<float> tileValues((size_t)(tile + 1) * (tile + 1));
+    std::vector<int16_t> tileQuantized(tileValues.size());
+    std::vector<float> ranges((size_t)tilesX * tilesY * 2);
+    file.write((const char*)&hdr, sizeof(hdr));
+    file.write((const char*)ranges.data(), ranges.size() * sizeof(float)); //Filled after the tiles are written
+
+    for(uint32_t ty=0; ty<tilesY; ++ty)
+        for(uint32_t tx=0; tx<tilesX; ++tx)
+        {
+            //Nodes of the tile, padded with the last valid node
+            float minH = FLT_MAX;
+            float maxH = -FLT_MAX;
+            for(uint32_t j=0; j<=tile; ++j)
+                for(uint32_t i=0; i<=tile; ++i)
+                {
+                    uint32_t gx = std::min(tx * tile + i, sizeX - 1);
+                    uint32_t gy = std::min(ty * tile + j, sizeY - 1);
+                    float h = heights[(size_t)gy * sizeX + gx];
+                    size_t k = (size_t)j * (tile + 1) + i;
+                    if(format == TiledTerrainFormat::INT16)
+                    {
+                        double q = std::round((h - hdr.offset)/hdr.scale);
+                        tileQuantized[k] = (int16_t)std::min(std::max(q, -(double)INT16_MAX), (double)INT16_MAX);
+                        h = (float)(tileQuantized[k] * hdr.scale + hdr.offset); //Range of decoded heights
+                    }
+                    else
+                        tileValues[k] = h;
+                    minH = std::min(minH, h);
+                    maxH = std::max(maxH, h);
+                }
+
+            size_t id = (size_t)ty * tilesX + tx;
+            ranges[2*id] = minH;
+            ranges[2*id+1] = maxH;
+            if(format == TiledTerrainFormat::INT16)
+                file.write((const char*)tileQuantized.data(), tileQuantized.size() * sizeof(int16_t));
+            else
+                file.write((const char*)tileValues.data(), tileValues.size() * sizeof(float));
+        }
+
+    file.seekp(sizeof(hdr));
+    file.write((const char*)ranges.data(), ranges.size() * sizeof(float));
+    if(!file)
+    {
+        cError("Failed to write tiled terrain file '%s'!", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool TiledTerrain::ConvertHeightmap(const std::string& pathToHeightmap, const std::string& path, double spacingX, double spacingY, double height,
+                                    uint32_t tile, TiledTerrainFormat format)
+{
+    int w, h, ch;
+    std::vector<float> heights;
+    if(stbi_is_16_bit(pathToHeightmap.c_str())) //16 bit image
+    {
+        stbi_us* pixels = stbi_load_16(pathToHeightmap.c_str(), &w, &h, &ch, 1);
+        if(pixels == NULL)
+        {
+            cError("Failed to load heightmap from file '%s'!", pathToHeightmap.c_str());
+            return false;
+        }
+        heights.resize((size_t)w * h);
+        for(size_t i=0; i<heights.size(); ++i)
+            heights[i] = (float)((1.0 - pixels[i]/(double)(__UINT16_MAX__)) * height);
+        stbi_image_free(pixels);
+    }
+    else //8 bit image
+    {
+        stbi_uc* pixels = stbi_load(pathToHeightmap.c_str(), &w, &h, &ch, 1);
+        if(pixels == NULL)
+        {
+            cError("Failed to load heightmap from file '%s'!", pathToHeightmap.c_str());
+            return false;
+        }
+        heights.resize((size_t)w * h);
+        for(size_t i=0; i<heights.size(); ++i)
+            heights[i] = (float)((1.0 - pixels[i]/(double)(__UINT8_MAX__)) * height);
+        stbi_image_free(pixels);
+    }
+    return WriteTerrainData(path, heights.data(), (uint32_t)w, (uint32_t)h, spacingX, spacingY, tile, format);
+}
+
+}
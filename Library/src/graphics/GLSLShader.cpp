@@ -26,11 +26,13 @@
 #include "graphics/GLSLShader.h"
 
 #include <fstream>
+#include <filesystem>
+#include <sstream>
+#include <iomanip>
 #include "core/SimulationApp.h"
 #include "graphics/OpenGLState.h"
 #include "utils/SystemUtil.hpp"
 #ifdef EMBEDDED_RESOURCES
-#include <sstream>
 #include "ResourceHandle.h"
 #endif
 
@@ -39,64 +41,87 @@ namespace sf
 
 GLuint GLSLShader::saqVertexShader = 0;
 bool GLSLShader::verbose = true;
+std::string GLSLShader::cachePath = "";
+uint64_t GLSLShader::driverHash = 0;
+std::unordered_map<GLuint, uint64_t> GLSLShader::shaderHashes;
 
 GLSLShader::GLSLShader(const std::vector<GLSLSource>& sources, const std::vector<GLuint>& precompiled)
 {
-    valid = false;
-    program = 0;
-
-    if(sources.size() > 0)
-    {
-        valid = true;
-        
-        std::vector<GLuint> shaders = precompiled;
-        GLint compiled = 0;
-
-        for(size_t i=0; i<sources.size(); ++i)
-        {
-            GLuint shader = LoadShader(sources[i].type, sources[i].filename, sources[i].header, &compiled);
-            if(compiled == 0)
-            {
-                valid = false;
-                break;
-            }
-            shaders.push_back(shader);
-        }
-
-        if(valid)
-        {
-            program = CreateProgram(shaders, precompiled.size());
-            if(program == 0)
-                valid = false;
-        }
-    }
+    Build(sources, precompiled);
 }
 
 GLSLShader::GLSLShader(const std::vector<GLuint>& precompiled)
 {
-    program = CreateProgram(precompiled, precompiled.size());
+    uint64_t key = 0;
+    bool cacheable = ProgramKey(precompiled, {}, key);
+    
+    program = cacheable ? LoadProgramBinary(key) : 0;
     if(program == 0)
-        valid = false;
-    else 
-        valid = true;
+    {
+        program = CreateProgram(precompiled, precompiled.size());
+        if(program != 0 && cacheable)
+            SaveProgramBinary(program, key);
+    }
+    valid = program != 0;
 }
 
 GLSLShader::GLSLShader(std::string fragment, std::string vertex)
 {
-    valid = false;
-    GLint compiled = 0;
-    GLuint vs;
-    GLuint fs;
-    std::string emptyHeader = "";
-    
+    std::vector<GLSLSource> sources;
+    std::vector<GLuint> precompiled;
     if(vertex == "")
-        vs = saqVertexShader;
+        precompiled.push_back(saqVertexShader);
     else
-        vs = LoadShader(GL_VERTEX_SHADER, vertex, emptyHeader, &compiled);
+        sources.push_back(GLSLSource(GL_VERTEX_SHADER, vertex));
+    sources.push_back(GLSLSource(GL_FRAGMENT_SHADER, fragment));
+    Build(sources, precompiled);
+}
+
+void GLSLShader::Build(const std::vector<GLSLSource>& sources, const std::vector<GLuint>& precompiled)
+{
+    valid = false;
+    program = 0;
+
+    if(sources.size() == 0)
+        return;
+
+    //Preprocess sources
+    std::vector<std::string> code(sources.size());
+    std::vector<uint64_t> hashes(sources.size());
+    for(size_t i=0; i<sources.size(); ++i)
+    {
+        if(!ReadShaderSource(sources[i].filename, sources[i].header, code[i]))
+            return;
+        hashes[i] = HashSource(sources[i].type, code[i]);
+    }
+
+    //Try to skip compilation and linking
+    uint64_t key = 0;
+    bool cacheable = ProgramKey(precompiled, hashes, key);
+    if(cacheable && (program = LoadProgramBinary(key)) != 0)
+    {
+        valid = true;
+        return;
+    }
+
+    //Compile and link
+    std::vector<GLuint> shaders = precompiled;
+    GLint compiled = 0;
+    for(size_t i=0; i<sources.size(); ++i)
+    {
+        GLuint shader = CompileShader(sources[i].type, code[i], sources[i].filename, &compiled);
+        if(compiled == 0)
+            return;
+        shaders.push_back(shader);
+    }
+
+    program = CreateProgram(shaders, precompiled.size());
+    if(program == 0)
+        return;
     
-    fs = LoadShader(GL_FRAGMENT_SHADER, fragment, emptyHeader, &compiled);
-    program = CreateProgram({vs, fs}, vs == saqVertexShader ? 1 : 0);
     valid = true;
+    if(cacheable)
+        SaveProgramBinary(program, key);
 }
     
 GLSLShader::~GLSLShader()
@@ -125,7 +150,7 @@ void GLSLShader::Use()
 #endif
 }
 
-bool GLSLShader::AddAttribute(std::string name, ParameterType type)
+bool GLSLShader::AddAttribute(const std::string& name, ParameterType type)
 {
     GLSLAttribute att;
     att.name = name;
@@ -142,7 +167,7 @@ bool GLSLShader::AddAttribute(std::string name, ParameterType type)
     return true;
 }
 
-bool GLSLShader::AddUniform(std::string name, ParameterType type)
+bool GLSLShader::AddUniform(const std::string& name, ParameterType type)
 {
     GLSLUniform uni;
     uni.name = name;
@@ -160,11 +185,11 @@ bool GLSLShader::AddUniform(std::string name, ParameterType type)
         return false;
     }
     
-    uniforms.push_back(uni);
+    uniforms[name] = uni;
     return true;
 }
 
-bool GLSLShader::SetAttribute(std::string name, GLfloat x)
+bool GLSLShader::SetAttribute(const std::string& name, GLfloat x)
 {
     GLint index = 0;
     bool success = GetAttribute(name, FLOAT, index);
@@ -175,7 +200,7 @@ bool GLSLShader::SetAttribute(std::string name, GLfloat x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, bool x)
+bool GLSLShader::SetUniform(const std::string& name, bool x)
 {
     GLint location = 0;
     bool success = GetUniform(name, BOOLEAN, location);
@@ -186,7 +211,7 @@ bool GLSLShader::SetUniform(std::string name, bool x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, GLfloat x)
+bool GLSLShader::SetUniform(const std::string& name, GLfloat x)
 {
     GLint location = 0;
     bool success = GetUniform(name, FLOAT, location);
@@ -197,7 +222,7 @@ bool GLSLShader::SetUniform(std::string name, GLfloat x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, glm::vec2 x)
+bool GLSLShader::SetUniform(const std::string& name, glm::vec2 x)
 {
     GLint location = 0;
     bool success = GetUniform(name, VEC2, location);
@@ -208,7 +233,7 @@ bool GLSLShader::SetUniform(std::string name, glm::vec2 x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, glm::vec3 x)
+bool GLSLShader::SetUniform(const std::string& name, glm::vec3 x)
 {
     GLint location = 0;
     bool success = GetUniform(name, VEC3, location);
@@ -219,7 +244,7 @@ bool GLSLShader::SetUniform(std::string name, glm::vec3 x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, glm::vec4 x)
+bool GLSLShader::SetUniform(const std::string& name, glm::vec4 x)
 {
     GLint location = 0;
     bool success = GetUniform(name, VEC4, location);
@@ -230,7 +255,7 @@ bool GLSLShader::SetUniform(std::string name, glm::vec4 x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, GLuint x)
+bool GLSLShader::SetUniform(const std::string& name, GLuint x)
 {
     GLint location = 0;
     bool success = GetUniform(name, UINT, location);
@@ -241,7 +266,7 @@ bool GLSLShader::SetUniform(std::string name, GLuint x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, GLint x)
+bool GLSLShader::SetUniform(const std::string& name, GLint x)
 {
     GLint location = 0;
     bool success = GetUniform(name, INT, location);
@@ -252,7 +277,7 @@ bool GLSLShader::SetUniform(std::string name, GLint x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, glm::ivec2 x)
+bool GLSLShader::SetUniform(const std::string& name, glm::ivec2 x)
 {
     GLint location = 0;
     bool success = GetUniform(name, IVEC2, location);
@@ -263,7 +288,7 @@ bool GLSLShader::SetUniform(std::string name, glm::ivec2 x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, glm::ivec3 x)
+bool GLSLShader::SetUniform(const std::string& name, glm::ivec3 x)
 {
     GLint location = 0;
     bool success = GetUniform(name, IVEC3, location);
@@ -274,7 +299,7 @@ bool GLSLShader::SetUniform(std::string name, glm::ivec3 x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, glm::ivec4 x)
+bool GLSLShader::SetUniform(const std::string& name, glm::ivec4 x)
 {
     GLint location = 0;
     bool success = GetUniform(name, IVEC4, location);
@@ -285,7 +310,7 @@ bool GLSLShader::SetUniform(std::string name, glm::ivec4 x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, glm::uvec2 x)
+bool GLSLShader::SetUniform(const std::string& name, glm::uvec2 x)
 {
     GLint location = 0;
     bool success = GetUniform(name, UVEC2, location);
@@ -296,7 +321,7 @@ bool GLSLShader::SetUniform(std::string name, glm::uvec2 x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, glm::uvec3 x)
+bool GLSLShader::SetUniform(const std::string& name, glm::uvec3 x)
 {
     GLint location = 0;
     bool success = GetUniform(name, UVEC3, location);
@@ -307,7 +332,7 @@ bool GLSLShader::SetUniform(std::string name, glm::uvec3 x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, glm::uvec4 x)
+bool GLSLShader::SetUniform(const std::string& name, glm::uvec4 x)
 {
     GLint location = 0;
     bool success = GetUniform(name, UVEC4, location);
@@ -318,7 +343,7 @@ bool GLSLShader::SetUniform(std::string name, glm::uvec4 x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, glm::mat3 x)
+bool GLSLShader::SetUniform(const std::string& name, glm::mat3 x)
 {
     GLint location = 0;
     bool success = GetUniform(name, MAT3, location);
@@ -329,7 +354,7 @@ bool GLSLShader::SetUniform(std::string name, glm::mat3 x)
     return success;
 }
 
-bool GLSLShader::SetUniform(std::string name, glm::mat4 x)
+bool GLSLShader::SetUniform(const std::string& name, glm::mat4 x)
 {
     GLint location = 0;
     bool success = GetUniform(name, MAT4, location);
@@ -340,30 +365,76 @@ bool GLSLShader::SetUniform(std::string name, glm::mat4 x)
     return success;
 }
 
-bool GLSLShader::GetUniform(std::string name, ParameterType type, GLint& location)
+bool GLSLShader::GetUniform(const std::string& name, ParameterType type, GLint& location)
 {
-    for(unsigned int i = 0; i < uniforms.size(); i++)
-        if(uniforms[i].name == name)
-        {
-            if(uniforms[i].type == type)
-            {
-                location = uniforms[i].location;
-                return true;
-            }
-            else
-            {
+    auto it = uniforms.find(name);
+    if(it == uniforms.end())
+    {
+        //cError("Uniform %s doesn't exist!", name.c_str());
+        return false;
+    }
+    
+    if(it->second.type != type)
+    {
 #ifdef DEBUG
-                cError("Uniform %s doesn't exist! Mismatched type!", name.c_str());
+        cError("Uniform %s doesn't exist! Mismatched type!", name.c_str());
 #endif
-                return false;
-            }
-        }
+        return false;
+    }
+    
+    location = it->second.location;
+    return true;
+}
 
-    //cError("Uniform %s doesn't exist!", name.c_str());
-    return false;
+GLint GLSLShader::getUniformLocation(const std::string& name, ParameterType type) const
+{
+    auto it = uniforms.find(name);
+    if(it == uniforms.end() || it->second.type != type)
+        return -1;
+    return it->second.location;
+}
+
+void GLSLShader::SetUniform(GLint location, bool x)
+{
+    glUniform1i(location, (GLint)x);
+}
+
+void GLSLShader::SetUniform(GLint location, GLfloat x)
+{
+    glUniform1f(location, x);
+}
+
+void GLSLShader::SetUniform(GLint location, GLint x)
+{
+    glUniform1i(location, x);
+}
+
+void GLSLShader::SetUniform(GLint location, const glm::vec2& x)
+{
+    glUniform2fv(location, 1, glm::value_ptr(x));
 }
 
-bool GLSLShader::GetAttribute(std::string name, ParameterType type, GLint& index)
+void GLSLShader::SetUniform(GLint location, const glm::vec3& x)
+{
+    glUniform3fv(location, 1, glm::value_ptr(x));
+}
+
+void GLSLShader::SetUniform(GLint location, const glm::vec4& x)
+{
+    glUniform4fv(location, 1, glm::value_ptr(x));
+}
+
+void GLSLShader::SetUniform(GLint location, const glm::mat3& x)
+{
+    glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(x));
+}
+
+void GLSLShader::SetUniform(GLint location, const glm::mat4& x)
+{
+    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(x));
+}
+
+bool GLSLShader::GetAttribute(const std::string& name, ParameterType type, GLint& index)
 {
     for(unsigned int i = 0; i < attributes.size(); i++)
         if(attributes[i].name == name)
@@ -380,7 +451,7 @@ bool GLSLShader::GetAttribute(std::string name, ParameterType type, GLint& index
     return false;
 }
 
-bool GLSLShader::BindUniformBlock(std::string name, GLuint bindingPoint)
+bool GLSLShader::BindUniformBlock(const std::string& name, GLuint bindingPoint)
 {
     GLuint blockIndex = glGetUniformBlockIndex(program, name.c_str());
     if(blockIndex != GL_INVALID_INDEX)
@@ -397,7 +468,7 @@ bool GLSLShader::BindUniformBlock(std::string name, GLuint bindingPoint)
     }
 }
 
-bool GLSLShader::BindShaderStorageBlock(std::string name, GLuint bindingPoint)
+bool GLSLShader::BindShaderStorageBlock(const std::string& name, GLuint bindingPoint)
 {
     GLuint blockIndex = glGetProgramResourceIndex(program, GL_SHADER_STORAGE_BLOCK, name.c_str());
     if(blockIndex != GL_INVALID_INDEX)
@@ -417,6 +488,40 @@ bool GLSLShader::BindShaderStorageBlock(std::string name, GLuint bindingPoint)
 //// Statics
 bool GLSLShader::Init()
 {
+    //Program binary cache
+    cachePath = "";
+    GLint numFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+    if(numFormats > 0)
+    {
+        const char* envPath = getenv("STONEFISH_SHADER_CACHE");
+        std::string path = envPath != NULL ? std::string(envPath) : GetCachePath();
+        if(path != "")
+        {
+            path = (std::filesystem::path(path) / "shaders").string() + "/";
+            std::error_code ec;
+            std::filesystem::create_directories(path, ec);
+            if(!ec)
+                cachePath = path;
+            else
+                cWarning("Shader program cache disabled! Failed to create directory: %s", path.c_str());
+        }
+    }
+    
+    if(cachePath != "")
+    {
+        //Binaries are only valid for the driver that produced them
+        std::string driver;
+        for(GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION})
+        {
+            const GLubyte* str = glGetString(name);
+            if(str != NULL)
+                driver += std::string((const char*)str) + "\n";
+        }
+        driverHash = HashSource(0, driver);
+        cInfo("Using shader program cache: %s", cachePath.c_str());
+    }
+
     GLint compiled;
     std::string emptyHeader = "";
     saqVertexShader = LoadShader(GL_VERTEX_SHADER, "saq.vert", emptyHeader, &compiled);
@@ -427,6 +532,7 @@ void GLSLShader::Destroy()
 {
     if(saqVertexShader != 0)
         glDeleteProgram(saqVertexShader);
+    shaderHashes.clear();
 }
 
 void GLSLShader::Silent()
@@ -441,14 +547,24 @@ void GLSLShader::Verbose()
 
 GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, const std::string& header, GLint *shaderCompiled)
 {
-    GLuint shader = 0;
+    std::string source;
+    if(!ReadShaderSource(filename, header, source))
+    {
+        *shaderCompiled = 0;
+        return 0;
+    }
+    return CompileShader(shaderType, source, filename, shaderCompiled);
+}
+
+bool GLSLShader::ReadShaderSource(const std::string& filename, const std::string& header, std::string& source)
+{
     std::string sourcePath = GetShaderPath() + filename;
 #ifdef EMBEDDED_RESOURCES
     ResourceHandle rh(sourcePath);
     if(!rh.isValid())
     {
         cCritical("Shader resource not found: %s", sourcePath.c_str());
-        return 0;
+        return false;
     }
     std::istringstream sourceString(rh.string());
     std::istream& sourceBuf(sourceString);
@@ -457,7 +573,7 @@ GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, co
     if(!sourceFile.is_open())
     {
         cCritical("Shader file not found: %s", sourcePath.c_str());
-        return 0;
+        return false;
     }
     std::istream& sourceBuf(sourceFile);
 #endif
@@ -465,7 +581,7 @@ GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, co
     if(verbose)
         cInfo("Loading shader from: %s", sourcePath.c_str());
 #endif
-    std::string source = header + "\n";
+    source = header + "\n";
     std::string line;
     while(!sourceBuf.eof())
     {
@@ -486,7 +602,7 @@ GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, co
                 if(!rh2.isValid())
                 {
                     cCritical("Shader include resource not found: %s", injectedPath.c_str());
-                    return 0;
+                    return false;
                 }
                 std::istringstream injectedString(rh2.string());
                 std::istream& injectedBuf(injectedString);
@@ -497,7 +613,7 @@ GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, co
                 {
                     sourceFile.close();
                     cCritical("Shader include file not found: %s", injectedPath.c_str());
-                    return 0;
+                    return false;
                 }
                 std::istream& injectedBuf(injectedFile);
 #endif
@@ -518,40 +634,146 @@ GLuint GLSLShader::LoadShader(GLenum shaderType, const std::string& filename, co
     }
 #ifndef EMBEDDED_RESOURCES
     sourceFile.close();
-#endif    
+#endif
+    return true;
+}
+
+GLuint GLSLShader::CompileShader(GLenum shaderType, const std::string& source, const std::string& filename, GLint* shaderCompiled)
+{
     const char* shaderSource = source.c_str();
-    if(shaderSource != NULL)
+    GLuint shader = glCreateShader(shaderType);
+    glShaderSource(shader, 1, (const GLchar**)&shaderSource, NULL);
+    glCompileShader(shader);
+    glGetShaderiv(shader, GL_COMPILE_STATUS, shaderCompiled);
+    if(*shaderCompiled == 0)
     {
-        shader = glCreateShader(shaderType);
-        glShaderSource(shader, 1, (const GLchar**)&shaderSource, NULL);
-        glCompileShader(shader);
-        glGetShaderiv(shader, GL_COMPILE_STATUS, shaderCompiled);
-        if(*shaderCompiled == 0)
-        {
-            cError("Failed to compile shader: %s", sourcePath.c_str());
+        cError("Failed to compile shader: %s", (GetShaderPath() + filename).c_str());
 #ifdef DEBUG	
-            GLint infoLogLength = 0;	
-            glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
-            if(infoLogLength > 0)
-            {
-                std::vector<char> infoLog(infoLogLength+1);
-                glGetShaderInfoLog(shader, infoLogLength, NULL, &infoLog[0]);
-                cWarning("Shader compile log: %s", &infoLog[0]);
-            }
-#endif
-            shader = 0;
+        GLint infoLogLength = 0;	
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
+        if(infoLogLength > 0)
+        {
+            std::vector<char> infoLog(infoLogLength+1);
+            glGetShaderInfoLog(shader, infoLogLength, NULL, &infoLog[0]);
+            cWarning("Shader compile log: %s", &infoLog[0]);
         }
+#endif
+        return 0;
     }
-    else
-        *shaderCompiled = 0;
     
+    shaderHashes[shader] = HashSource(shaderType, source);
     return shader;
 }
 
+uint64_t GLSLShader::HashSource(GLenum shaderType, const std::string& source, uint64_t seed)
+{
+    //FNV-1a
+    uint64_t hash = seed;
+    const uint8_t* type = (const uint8_t*)&shaderType;
+    for(size_t i=0; i<sizeof(GLenum); ++i)
+        hash = (hash ^ type[i]) * 1099511628211ULL;
+    for(size_t i=0; i<source.size(); ++i)
+        hash = (hash ^ (uint8_t)source[i]) * 1099511628211ULL;
+    return hash;
+}
+
+bool GLSLShader::ProgramKey(const std::vector<GLuint>& precompiled, const std::vector<uint64_t>& sourceHashes, uint64_t& key)
+{
+    if(cachePath == "")
+        return false;
+    
+    key = driverHash;
+    for(size_t i=0; i<precompiled.size(); ++i)
+    {
+        auto it = shaderHashes.find(precompiled[i]);
+        if(it == shaderHashes.end()) //Shader of unknown origin
+            return false;
+        key = (key ^ it->second) * 1099511628211ULL;
+    }
+    for(size_t i=0; i<sourceHashes.size(); ++i)
+        key = (key ^ sourceHashes[i]) * 1099511628211ULL;
+    return true;
+}
+
+std::string GLSLShader::ProgramBinaryPath(uint64_t key)
+{
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+    return cachePath + name.str();
+}
+
+GLuint GLSLShader::LoadProgramBinary(uint64_t key)
+{
+    std::ifstream file(ProgramBinaryPath(key), std::ios::binary);
+    if(!file.is_open())
+        return 0;
+    
+    uint64_t storedKey = 0;
+    GLenum format = 0;
+    GLint length = 0;
+    file.read((char*)&storedKey, sizeof(storedKey));
+    file.read((char*)&format, sizeof(format));
+    file.read((char*)&length, sizeof(length));
+    if(!file || storedKey != key || length <= 0)
+        return 0;
+    
+    std::vector<char> binary(length);
+    file.read(binary.data(), length);
+    if(!file)
+        return 0;
+    
+    GLuint prog = glCreateProgram();
+    glProgramBinary(prog, format, binary.data(), length);
+    GLint linked = 0;
+    glGetProgramiv(prog, GL_LINK_STATUS, &linked);
+    if(linked == 0) //Driver rejected the binary (e.g. after an update)
+    {
+        glDeleteProgram(prog);
+        return 0;
+    }
+    return prog;
+}
+
+void GLSLShader::SaveProgramBinary(GLuint prog, uint64_t key)
+{
+    GLint length = 0;
+    glGetProgramiv(prog, GL_PROGRAM_BINARY_LENGTH, &length);
+    if(length <= 0)
+        return;
+    
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(prog, length, NULL, &format, binary.data());
+    
+    //Write to a temporary file first, so that concurrent instances never read a partial binary
+    std::string path = ProgramBinaryPath(key);
+    std::string tmpPath = path + "." + std::to_string(GetTimeInMicroseconds()) + ".tmp";
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if(!file.is_open())
+        return;
+    file.write((const char*)&key, sizeof(key));
+    file.write((const char*)&format, sizeof(format));
+    file.write((const char*)&length, sizeof(length));
+    file.write(binary.data(), length);
+    file.close();
+    
+    std::error_code ec;
+    if(file.fail())
+        std::filesystem::remove(tmpPath, ec);
+    else
+    {
+        std::filesystem::rename(tmpPath, path, ec);
+        if(ec)
+            std::filesystem::remove(tmpPath, ec);
+    }
+}
+
 GLuint GLSLShader::CreateProgram(const std::vector<GLuint>& compiledShaders, unsigned int doNotDeleteNFirstShaders)
 {
     GLint programLinked = 0;
     GLuint program = glCreateProgram();
+    if(cachePath != "")
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     
     for(unsigned int i=0; i<compiledShaders.size(); ++i)
         if(compiledShaders[i] > 0)
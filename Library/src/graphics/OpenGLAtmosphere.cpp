@@ -59,6 +59,8 @@ OpenGLAtmosphere::OpenGLAtmosphere(const std::string& modelFilename, RenderQuali
     sunShadowmapSplits = 4;
     sunShadowmapSize = 4096;
     sunShadowFBO = 0;
+    sunShadowFrame = 0;
+    sunShadowDynamic = false;
     sunSkyUBO = 0;
     sunDirection = glm::vec3(0,0,1.f);
     sunModelView = glm::mat4x4(0);
@@ -405,18 +407,15 @@ void OpenGLAtmosphere::BakeShadowmaps(OpenGLPipeline* pipe, OpenGLView* view)
     //Compute the z-distances for each split as seen in camera space
     UpdateSplitDist(view->GetNearClip(), view->GetFarClip());
 
-    //Render maps
-    glCullFace(GL_FRONT); //GL_FRONT -> no shadow acne but problems with filtering
-    glDisable(GL_DEPTH_CLAMP);
-
-    OpenGLState::BindFramebuffer(sunShadowFBO);
-    OpenGLState::Viewport(0, 0, sunShadowmapSize, sunShadowmapSize);
-
     glm::vec3 camPos = view->GetEyePosition();
     glm::vec3 camDir = view->GetLookingDirection();
     glm::vec3 camUp = view->GetUpDirection();
 
     // for all shadow splits
+    unsigned int frame = pipe->getFrameCount();
+    bool cacheValid = sunShadowFrame > 0 && sunShadowFrame + 1 >= frame;
+    bool dynamic = false;
+    std::vector<glm::mat4> cps(sunShadowmapSplits);
     for(unsigned int i = 0; i < sunShadowmapSplits; ++i)
     {
         //Compute the camera frustum slice boundary points in world space
@@ -424,10 +423,32 @@ void OpenGLAtmosphere::BakeShadowmaps(OpenGLPipeline* pipe, OpenGLView* view)
 
         //Adjust the view frustum of the light, so that it encloses the camera frustum slice fully.
         //note that this function sets the projection matrix as it sees best fit
-        glm::mat4 cp = BuildCropProjMatrix(sunShadowFrustum[i]);
-        sunShadowCPM[i] =  cp * sunModelView;
+        cps[i] = BuildCropProjMatrix(sunShadowFrustum[i]);
+        glm::mat4 VP = cps[i] * sunModelView;
+        
+        //Check if the map baked before is still valid
+        cacheValid = cacheValid && VP == sunShadowCPM[i] && (sunShadowFrame == frame || pipe->isShadowCacheValid(VP));
+        dynamic = dynamic || pipe->hasDynamicObjects(VP);
+        sunShadowCPM[i] = VP;
+    }
+    
+    //Skip rendering if nothing changed (objects do not move within a frame)
+    bool update = !cacheValid || (sunShadowFrame != frame && (dynamic || sunShadowDynamic));
+    sunShadowFrame = frame;
+    sunShadowDynamic = dynamic;
+    if(!update)
+        return;
+
+    //Render maps
+    glCullFace(GL_FRONT); //GL_FRONT -> no shadow acne but problems with filtering
+    glDisable(GL_DEPTH_CLAMP);
 
-        ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->SetProjectionMatrix(cp);
+    OpenGLState::BindFramebuffer(sunShadowFBO);
+    OpenGLState::Viewport(0, 0, sunShadowmapSize, sunShadowmapSize);
+
+    for(unsigned int i = 0; i < sunShadowmapSplits; ++i)
+    {
+        ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->SetProjectionMatrix(cps[i]);
         ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->SetViewMatrix(sunModelView);
         //Draw current depth map
         glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, sunShadowmapArray, 0, i);
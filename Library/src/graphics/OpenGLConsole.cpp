@@ -35,7 +35,7 @@
 namespace sf
 {
 
-OpenGLConsole::OpenGLConsole()
+OpenGLConsole::OpenGLConsole() : Console(true, true, CONSOLE_HISTORY_LENGTH)
 {
     windowW = 0;
     windowH = 0;
@@ -35,6 +35,7 @@
 #include "graphics/OpenGLView.h"
 #include "graphics/OpenGLLight.h"
 #include "graphics/OpenGLOcean.h"
+#include "graphics/OpenGLHelperArena.h"
 #include "entities/forcefields/Ocean.h"
 #include "entities/forcefields/Atmosphere.h"
 #include "utils/SystemUtil.hpp"
@@ -69,10 +70,11 @@ OpenGLContent::OpenGLContent()
     view = glm::mat4();
     projection = glm::mat4();
     FC = 0.f;
+    ResetCullingFrustum();
     viewportSize = glm::vec2(800.f,600.f);
     mode = DrawingMode::FULL;
-    currentLookName = "";
-    currentShaderMode = "plain";
+    currentLook = nullptr;
+    currentShaderMode = MaterialShaderMode::PLAIN;
 
     //Get OpenGL capabilities
     maxAnisotropy = 0.0f;
@@ -201,38 +203,43 @@ OpenGLContent::OpenGLContent()
     
     //Load shaders
     //-----BASIC-----
-    basicShaders["helper"] = new GLSLShader("helpers.frag","helpers.vert");
-    basicShaders["helper"]->AddUniform("MVP", ParameterType::MAT4);
-    basicShaders["helper"]->AddUniform("scale", ParameterType::VEC3);
+    helperShader = new GLSLShader("helpers.frag","helpers.vert");
+    helperShader->AddUniform("MVP", ParameterType::MAT4);
+    helperShader->AddUniform("scale", ParameterType::VEC3);
     
-    basicShaders["tex_saq"] = new GLSLShader("texQuad.frag");
-    basicShaders["tex_saq"]->AddUniform("tex", ParameterType::INT);
-    basicShaders["tex_saq"]->AddUniform("color", ParameterType::VEC4);
+    texSaqShader = new GLSLShader("texQuad.frag");
+    texSaqShader->AddUniform("tex", ParameterType::INT);
+    texSaqShader->AddUniform("color", ParameterType::VEC4);
     
-    basicShaders["tex_quad"] = new GLSLShader("texQuad.frag","texQuad.vert");
-    basicShaders["tex_quad"]->AddUniform("rect", ParameterType::VEC4);
-    basicShaders["tex_quad"]->AddUniform("tex", ParameterType::INT);
-    basicShaders["tex_quad"]->AddUniform("color", ParameterType::VEC4);
+    texQuadShader = new GLSLShader("texQuad.frag","texQuad.vert");
+    texQuadShader->AddUniform("rect", ParameterType::VEC4);
+    texQuadShader->AddUniform("tex", ParameterType::INT);
+    texQuadShader->AddUniform("color", ParameterType::VEC4);
     
-    basicShaders["tex_layer_quad"] = new GLSLShader("texLayerQuad.frag", "texQuad.vert");
-    basicShaders["tex_layer_quad"]->AddUniform("rect", ParameterType::VEC4);
-    basicShaders["tex_layer_quad"]->AddUniform("tex", ParameterType::INT);
-    basicShaders["tex_layer_quad"]->AddUniform("layer", ParameterType::INT);
+    texLayerQuadShader = new GLSLShader("texLayerQuad.frag", "texQuad.vert");
+    texLayerQuadShader->AddUniform("rect", ParameterType::VEC4);
+    texLayerQuadShader->AddUniform("tex", ParameterType::INT);
+    texLayerQuadShader->AddUniform("layer", ParameterType::INT);
     
-    basicShaders["tex_level_quad"] = new GLSLShader("texLevelQuad.frag", "texQuad.vert");
-    basicShaders["tex_level_quad"]->AddUniform("rect", ParameterType::VEC4);
-    basicShaders["tex_level_quad"]->AddUniform("tex", ParameterType::INT);
-    basicShaders["tex_level_quad"]->AddUniform("level", ParameterType::INT);
+    texLevelQuadShader = new GLSLShader("texLevelQuad.frag", "texQuad.vert");
+    texLevelQuadShader->AddUniform("rect", ParameterType::VEC4);
+    texLevelQuadShader->AddUniform("tex", ParameterType::INT);
+    texLevelQuadShader->AddUniform("level", ParameterType::INT);
     
-    basicShaders["tex_cube"] = new GLSLShader("texCube.frag", "texCube.vert");
-    basicShaders["tex_cube"]->AddUniform("tex", ParameterType::INT);
+    texCubeShader = new GLSLShader("texCube.frag", "texCube.vert");
+    texCubeShader->AddUniform("tex", ParameterType::INT);
     
-    basicShaders["flat"] = new GLSLShader("flat.frag", "flat.vert");
-    basicShaders["flat"]->AddUniform("MVP", ParameterType::MAT4);
-    basicShaders["flat"]->AddUniform("FC", ParameterType::FLOAT);
+    flatShader = new GLSLShader("flat.frag", "flat.vert");
+    flatShader->AddUniform("MVP", ParameterType::MAT4);
+    flatShader->AddUniform("FC", ParameterType::FLOAT);
 
-    basicShaders["shadow"] = new GLSLShader("shadow.frag", "shadow.vert");
-    basicShaders["shadow"]->AddUniform("MVP", ParameterType::MAT4);
+    shadowShader = new GLSLShader("shadow.frag", "shadow.vert");
+    shadowShader->AddUniform("MVP", ParameterType::MAT4);
+
+    helperMVP = helperShader->getUniformLocation("MVP", ParameterType::MAT4);
+    flatMVP = flatShader->getUniformLocation("MVP", ParameterType::MAT4);
+    flatFC = flatShader->getUniformLocation("FC", ParameterType::FLOAT);
+    shadowMVP = shadowShader->getUniformLocation("MVP", ParameterType::MAT4);
     
     //-----MATERIALS-----
     std::vector<std::string> shadingAlgorithms;
@@ -278,7 +285,6 @@ OpenGLContent::OpenGLContent()
         precompiled.pop_back();
         precompiled.push_back(materialTFragment);
         ms.shaders["plain_temperature"] = new GLSLShader(precompiled);
-        ms.shaders["plain_temperature"]->AddUniform("temperature", ParameterType::FLOAT);
         
         precompiled.pop_back();
         precompiled.push_back(materialUFragment);
@@ -305,8 +311,6 @@ OpenGLContent::OpenGLContent()
         ms.shaders["textured"] = new GLSLShader(precompiled);
         ms.shaders["textured"]->AddUniform("texAlbedo", ParameterType::INT);
         ms.shaders["textured"]->AddUniform("texNormal", ParameterType::INT);
-        ms.shaders["textured"]->AddUniform("enableAlbedoTex", ParameterType::BOOLEAN);
-        ms.shaders["textured"]->AddUniform("enableNormalTex", ParameterType::BOOLEAN);
         
         precompiled.pop_back();
         precompiled.push_back(materialTUvFragment);
@@ -314,10 +318,6 @@ OpenGLContent::OpenGLContent()
         ms.shaders["textured_temperature"]->AddUniform("texAlbedo", ParameterType::INT);
         ms.shaders["textured_temperature"]->AddUniform("texNormal", ParameterType::INT);
         ms.shaders["textured_temperature"]->AddUniform("texTemperature", ParameterType::INT);
-        ms.shaders["textured_temperature"]->AddUniform("enableAlbedoTex", ParameterType::BOOLEAN);
-        ms.shaders["textured_temperature"]->AddUniform("enableNormalTex", ParameterType::BOOLEAN);
-        ms.shaders["textured_temperature"]->AddUniform("enableTemperatureTex", ParameterType::BOOLEAN);
-        ms.shaders["textured_temperature"]->AddUniform("temperatureRange", ParameterType::VEC2);
         
         precompiled.pop_back();
         precompiled.push_back(materialUUvFragment);
@@ -326,8 +326,6 @@ OpenGLContent::OpenGLContent()
         ms.shaders["textured_underwater"] = new GLSLShader(precompiled);
         ms.shaders["textured_underwater"]->AddUniform("texAlbedo", ParameterType::INT);
         ms.shaders["textured_underwater"]->AddUniform("texNormal", ParameterType::INT);
-        ms.shaders["textured_underwater"]->AddUniform("enableAlbedoTex", ParameterType::BOOLEAN);
-        ms.shaders["textured_underwater"]->AddUniform("enableNormalTex", ParameterType::BOOLEAN);
         ms.shaders["textured_underwater"]->AddUniform("cWater", ParameterType::VEC3);
         ms.shaders["textured_underwater"]->AddUniform("bWater", ParameterType::VEC3);
         
@@ -336,8 +334,6 @@ OpenGLContent::OpenGLContent()
         ms.shaders["textured_underwater_waves"] = new GLSLShader(precompiled);
         ms.shaders["textured_underwater_waves"]->AddUniform("texAlbedo", ParameterType::INT);
         ms.shaders["textured_underwater_waves"]->AddUniform("texNormal", ParameterType::INT);
-        ms.shaders["textured_underwater_waves"]->AddUniform("enableAlbedoTex", ParameterType::BOOLEAN);
-        ms.shaders["textured_underwater_waves"]->AddUniform("enableNormalTex", ParameterType::BOOLEAN);
         ms.shaders["textured_underwater_waves"]->AddUniform("cWater", ParameterType::VEC3);
         ms.shaders["textured_underwater_waves"]->AddUniform("bWater", ParameterType::VEC3);
         ms.shaders["textured_underwater_waves"]->AddUniform("texWaveFFT", ParameterType::INT);
@@ -353,8 +349,6 @@ OpenGLContent::OpenGLContent()
         ms.shaders["cable_textured"] = new GLSLShader(precompiled);
         ms.shaders["cable_textured"]->AddUniform("texAlbedo", ParameterType::INT);
         ms.shaders["cable_textured"]->AddUniform("texNormal", ParameterType::INT);
-        ms.shaders["cable_textured"]->AddUniform("enableAlbedoTex", ParameterType::BOOLEAN);
-        ms.shaders["cable_textured"]->AddUniform("enableNormalTex", ParameterType::BOOLEAN);
         ms.shaders["cable_textured"]->AddUniform("cableRadius", ParameterType::FLOAT);
 
         precompiled.pop_back();
@@ -364,8 +358,6 @@ OpenGLContent::OpenGLContent()
         ms.shaders["cable_textured_underwater"] = new GLSLShader(precompiled);
         ms.shaders["cable_textured_underwater"]->AddUniform("texAlbedo", ParameterType::INT);
         ms.shaders["cable_textured_underwater"]->AddUniform("texNormal", ParameterType::INT);
-        ms.shaders["cable_textured_underwater"]->AddUniform("enableAlbedoTex", ParameterType::BOOLEAN);
-        ms.shaders["cable_textured_underwater"]->AddUniform("enableNormalTex", ParameterType::BOOLEAN);
         ms.shaders["cable_textured_underwater"]->AddUniform("cWater", ParameterType::VEC3);
         ms.shaders["cable_textured_underwater"]->AddUniform("bWater", ParameterType::VEC3);
         ms.shaders["cable_textured_underwater"]->AddUniform("cableRadius", ParameterType::FLOAT);
@@ -375,8 +367,6 @@ OpenGLContent::OpenGLContent()
         ms.shaders["cable_textured_underwater_waves"] = new GLSLShader(precompiled);
         ms.shaders["cable_textured_underwater_waves"]->AddUniform("texAlbedo", ParameterType::INT);
         ms.shaders["cable_textured_underwater_waves"]->AddUniform("texNormal", ParameterType::INT);
-        ms.shaders["cable_textured_underwater_waves"]->AddUniform("enableAlbedoTex", ParameterType::BOOLEAN);
-        ms.shaders["cable_textured_underwater_waves"]->AddUniform("enableNormalTex", ParameterType::BOOLEAN);
         ms.shaders["cable_textured_underwater_waves"]->AddUniform("cWater", ParameterType::VEC3);
         ms.shaders["cable_textured_underwater_waves"]->AddUniform("bWater", ParameterType::VEC3);
         ms.shaders["cable_textured_underwater_waves"]->AddUniform("texWaveFFT", ParameterType::INT);
@@ -393,7 +383,6 @@ OpenGLContent::OpenGLContent()
             shader->AddUniform("FC", ParameterType::FLOAT);
             shader->AddUniform("eyePos", ParameterType::VEC3);
             shader->AddUniform("viewDir", ParameterType::VEC3);
-            shader->AddUniform("color", ParameterType::VEC4);
             shader->AddUniform("spotLightsDepthMap", ParameterType::INT);
             shader->AddUniform("spotLightsShadowMap", ParameterType::INT);
             shader->AddUniform("sunShadowMap", ParameterType::INT);
@@ -403,6 +392,7 @@ OpenGLContent::OpenGLContent()
             shader->AddUniform("irradiance_texture", ParameterType::INT);
             shader->BindUniformBlock("SunSky", UBO_SUNSKY);
             shader->BindUniformBlock("Lights", UBO_LIGHTS);
+            shader->BindUniformBlock("Material", UBO_MATERIAL);
 
             shader->Use();
             shader->SetUniform("spotLightsShadowMap", TEX_SPOT_SHADOW);
@@ -437,24 +427,41 @@ OpenGLContent::OpenGLContent()
         ms.shaders["textured_temperature"]->SetUniform("texTemperature", TEX_MAT_TEMPERATURE);
         glUseProgram(0);
 
-        materialShaders.push_back(ms);
+        for(auto s : {
+            "plain_underwater_waves",
+            "textured_underwater_waves",
+            "cable_textured_underwater_waves"
+        })
+        {
+            auto& shader = ms.shaders[s];
+            shader->Use();
+            shader->SetUniform("texWaveFFT", TEX_POSTPROCESS1);
+            glUseProgram(0);
+        }
 
-        glDeleteShader(shadingFragment);
-    }
+        //Resolve per-draw uniform locations
+        const char* variantNames[(size_t)MaterialShaderMode::COUNT] = {
+            "plain", "plain_temperature", "plain_underwater", "plain_underwater_waves",
+            "textured", "textured_temperature", "textured_underwater", "textured_underwater_waves",
+            "cable_textured", "cable_textured_underwater", "cable_textured_underwater_waves"
+        };
+        for(size_t h=0; h<(size_t)MaterialShaderMode::COUNT; ++h)
+        {
+            MaterialShaderVariant& v = ms.variants[h];
+            v.shader = ms.shaders[variantNames[h]];
+            v.MVP = v.shader->getUniformLocation("MVP", ParameterType::MAT4);
+            v.M = v.shader->getUniformLocation("M", ParameterType::MAT4);
+            v.N = v.shader->getUniformLocation("N", ParameterType::MAT3);
+            v.MV = v.shader->getUniformLocation("MV", ParameterType::MAT3);
+            v.FC = v.shader->getUniformLocation("FC", ParameterType::FLOAT);
+            v.eyePos = v.shader->getUniformLocation("eyePos", ParameterType::VEC3);
+            v.viewDir = v.shader->getUniformLocation("viewDir", ParameterType::VEC3);
+            v.cableRadius = v.shader->getUniformLocation("cableRadius", ParameterType::FLOAT);
+        }
 
-    //Add material-specific uniforms
-    for (auto& [key, shader] : materialShaders[0].shaders)
-    {
-        shader->AddUniform("shininess", ParameterType::FLOAT);
-        shader->AddUniform("specularStrength", ParameterType::FLOAT);
-        shader->AddUniform("reflectivity", ParameterType::FLOAT);
-    }
+        materialShaders.push_back(ms);
 
-    for (auto& [key, shader] : materialShaders[1].shaders)
-    {
-        shader->AddUniform("roughness", ParameterType::FLOAT);
-        shader->AddUniform("metallic", ParameterType::FLOAT);
-        shader->AddUniform("reflectivity", ParameterType::FLOAT);
+        glDeleteShader(shadingFragment);
     }
 
     glDeleteShader(materialVertex);
@@ -545,14 +552,14 @@ OpenGLContent::~OpenGLContent()
     if(csBuf[0] != 0) glDeleteBuffers(2, csBuf);
     if(lightsUBO != 0) glDeleteBuffers(1, &lightsUBO);
     if(viewUBO != 0) glDeleteBuffers(1, &viewUBO);
-    delete basicShaders["helper"];
-    delete basicShaders["tex_saq"];
-    delete basicShaders["tex_quad"];
-    delete basicShaders["tex_layer_quad"];
-    delete basicShaders["tex_level_quad"];
-    delete basicShaders["tex_cube"];
-    delete basicShaders["flat"];
-    delete basicShaders["shadow"];
+    delete helperShader;
+    delete texSaqShader;
+    delete texQuadShader;
+    delete texLayerQuadShader;
+    delete texLevelQuadShader;
+    delete texCubeShader;
+    delete flatShader;
+    delete shadowShader;
     if(lightSourceShader[0] != NULL) delete lightSourceShader[0];
     if(lightSourceShader[1] != NULL) delete lightSourceShader[1];
     
@@ -586,10 +593,12 @@ void OpenGLContent::DestroyContent()
             glDeleteTextures(1, &looks[i].normalMap);
         if(looks[i].temperatureMap != 0)
             glDeleteTextures(1, &looks[i].temperatureMap);
+        if(looks[i].ubo != 0)
+            glDeleteBuffers(1, &looks[i].ubo);
     }
     looks.clear();
     lookNameManager.ClearNames();
-    currentLookName = "";
+    currentLook = nullptr;
             
     for(size_t i=0; i<objects.size(); ++i)
     {
@@ -598,6 +607,7 @@ void OpenGLContent::DestroyContent()
         glDeleteVertexArrays(1, &objects[i].vao);
     }	
     objects.clear();
+    freeObjects.clear();
 
     for(size_t i=0; i<views.size(); ++i)
 		delete views[i];
@@ -618,12 +628,14 @@ void OpenGLContent::SetProjectionMatrix(glm::mat4 P)
 {
     projection = P;
     viewProjection = projection * view;
+    ResetCullingFrustum();
 }
 
 void OpenGLContent::SetViewMatrix(glm::mat4 V)
 {
     view = V;
     viewProjection = projection * view;
+    ResetCullingFrustum();
 }
 
 glm::mat4 OpenGLContent::GetViewMatrix()
@@ -639,6 +651,7 @@ void OpenGLContent::SetCurrentView(OpenGLView* v)
     projection = v->GetProjectionMatrix();
     viewProjection = projection * view;
     FC = v->GetLogDepthConstant();
+    ResetCullingFrustum();
 
     glBindBuffer(GL_UNIFORM_BUFFER, viewUBO);
     glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(ViewUBO), v->getViewUBOData());
@@ -649,6 +662,7 @@ void OpenGLContent::SetCurrentView(OpenGLView* v)
 void OpenGLContent::SetDrawingMode(DrawingMode m)
 {
     mode = m;
+    currentLook = nullptr; //Other passes may have changed the material bindings
 }
 
 void OpenGLContent::BindBaseVertexArray()
@@ -666,9 +680,9 @@ void OpenGLContent::DrawSAQ()
 void OpenGLContent::DrawTexturedSAQ(GLuint texture, glm::vec4 color)
 {
     OpenGLState::BindTexture(TEX_BASE, GL_TEXTURE_2D, texture);
-    basicShaders["tex_saq"]->Use();
-    basicShaders["tex_saq"]->SetUniform("tex", TEX_BASE);
-    basicShaders["tex_saq"]->SetUniform("color", color);
+    texSaqShader->Use();
+    texSaqShader->SetUniform("tex", TEX_BASE);
+    texSaqShader->SetUniform("color", color);
     
     OpenGLState::BindVertexArray(baseVertexArray);
     glDrawArrays(GL_TRIANGLES, 0, 3);
@@ -682,10 +696,10 @@ void OpenGLContent::DrawTexturedQuad(GLfloat x, GLfloat y, GLfloat width, GLfloa
 {
     y = viewportSize.y-y-height;
     
-    basicShaders["tex_quad"]->Use();
-    basicShaders["tex_quad"]->SetUniform("rect", glm::vec4(x/viewportSize.x, y/viewportSize.y, width/viewportSize.x, height/viewportSize.y));
-    basicShaders["tex_quad"]->SetUniform("tex", TEX_BASE);
-    basicShaders["tex_quad"]->SetUniform("color", color);
+    texQuadShader->Use();
+    texQuadShader->SetUniform("rect", glm::vec4(x/viewportSize.x, y/viewportSize.y, width/viewportSize.x, height/viewportSize.y));
+    texQuadShader->SetUniform("tex", TEX_BASE);
+    texQuadShader->SetUniform("color", color);
     
     OpenGLState::BindTexture(TEX_BASE, GL_TEXTURE_2D, texture);
     OpenGLState::BindVertexArray(baseVertexArray);
@@ -701,17 +715,17 @@ void OpenGLContent::DrawTexturedQuad(GLfloat x, GLfloat y, GLfloat width, GLfloa
     
     if(array)
     {
-        basicShaders["tex_layer_quad"]->Use();
-        basicShaders["tex_layer_quad"]->SetUniform("rect", glm::vec4(x/viewportSize.x, y/viewportSize.y, width/viewportSize.x, height/viewportSize.y));
-        basicShaders["tex_layer_quad"]->SetUniform("tex", TEX_BASE);
-        basicShaders["tex_layer_quad"]->SetUniform("layer", z);
+        texLayerQuadShader->Use();
+        texLayerQuadShader->SetUniform("rect", glm::vec4(x/viewportSize.x, y/viewportSize.y, width/viewportSize.x, height/viewportSize.y));
+        texLayerQuadShader->SetUniform("tex", TEX_BASE);
+        texLayerQuadShader->SetUniform("layer", z);
     }
     else
     {
-        basicShaders["tex_level_quad"]->Use();
-        basicShaders["tex_level_quad"]->SetUniform("rect", glm::vec4(x/viewportSize.x, y/viewportSize.y, width/viewportSize.x, height/viewportSize.y));
-        basicShaders["tex_level_quad"]->SetUniform("tex", TEX_BASE);
-        basicShaders["tex_level_quad"]->SetUniform("level", z);
+        texLevelQuadShader->Use();
+        texLevelQuadShader->SetUniform("rect", glm::vec4(x/viewportSize.x, y/viewportSize.y, width/viewportSize.x, height/viewportSize.y));
+        texLevelQuadShader->SetUniform("tex", TEX_BASE);
+        texLevelQuadShader->SetUniform("level", z);
     }
     
     OpenGLState::BindTexture(TEX_BASE, array ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_3D, texture);
@@ -724,8 +738,8 @@ void OpenGLContent::DrawTexturedQuad(GLfloat x, GLfloat y, GLfloat width, GLfloa
 
 void OpenGLContent::DrawCubemapCross(GLuint texture)
 {
-    basicShaders["tex_cube"]->Use();
-    basicShaders["tex_cube"]->SetUniform("tex", TEX_BASE);
+    texCubeShader->Use();
+    texCubeShader->SetUniform("tex", TEX_BASE);
     
     OpenGLState::BindTexture(TEX_BASE, GL_TEXTURE_CUBE_MAP, texture);
     OpenGLState::BindVertexArray(baseVertexArray);
@@ -750,9 +764,9 @@ void OpenGLContent::DrawCubemapCross(GLuint texture)
 
 void OpenGLContent::DrawCoordSystem(glm::mat4 M, GLfloat size)
 {
-    basicShaders["helper"]->Use();
-    basicShaders["helper"]->SetUniform("MVP", viewProjection*M);
-    basicShaders["helper"]->SetUniform("scale", glm::vec3(size));
+    helperShader->Use();
+    helperShader->SetUniform(helperMVP, viewProjection*M);
+    helperShader->SetUniform("scale", glm::vec3(size));
     
     OpenGLState::BindVertexArray(baseVertexArray);
     glEnableVertexAttribArray(0);
@@ -774,9 +788,9 @@ void OpenGLContent::DrawCoordSystem(glm::mat4 M, GLfloat size)
 
 void OpenGLContent::DrawCylinder(glm::mat4 M, glm::vec3 dims, glm::vec4 color)
 {
-    basicShaders["helper"]->Use();
-    basicShaders["helper"]->SetUniform("MVP", viewProjection*M);
-    basicShaders["helper"]->SetUniform("scale", dims);
+    helperShader->Use();
+    helperShader->SetUniform(helperMVP, viewProjection*M);
+    helperShader->SetUniform("scale", dims);
     
     OpenGLState::BindVertexArray(cylinder.vao);
     glVertexAttrib4fv(1, &color.r);
@@ -787,9 +801,9 @@ void OpenGLContent::DrawCylinder(glm::mat4 M, glm::vec3 dims, glm::vec4 color)
 
 void OpenGLContent::DrawEllipsoid(glm::mat4 M, glm::vec3 radii, glm::vec4 color)
 {
-    basicShaders["helper"]->Use();
-    basicShaders["helper"]->SetUniform("MVP", viewProjection*M);
-    basicShaders["helper"]->SetUniform("scale", radii);
+    helperShader->Use();
+    helperShader->SetUniform(helperMVP, viewProjection*M);
+    helperShader->SetUniform("scale", radii);
     
     OpenGLState::BindVertexArray(ellipsoid.vao);
     glVertexAttrib4fv(1, &color.r);
@@ -806,9 +820,9 @@ void OpenGLContent::DrawPrimitives(PrimitiveType type, std::vector<glm::vec3>* v
     GLuint vbo;
     glGenBuffers(1, &vbo);
     
-    basicShaders["helper"]->Use();
-    basicShaders["helper"]->SetUniform("MVP", viewProjection*M);
-    basicShaders["helper"]->SetUniform("scale", glm::vec3(1.f));
+    helperShader->Use();
+    helperShader->SetUniform(helperMVP, viewProjection*M);
+    helperShader->SetUniform("scale", glm::vec3(1.f));
     
     OpenGLState::BindVertexArray(baseVertexArray);
     glEnableVertexAttribArray(0);
@@ -847,25 +861,123 @@ void OpenGLContent::DrawPrimitives(PrimitiveType type, std::vector<glm::vec3>* v
     glDeleteBuffers(1, &vbo);
 }
 
-void OpenGLContent::DrawObject(int objectId, int lookId, const glm::mat4& M)
+void OpenGLContent::DrawPrimitives(PrimitiveType type, const HelperRange& vertices, glm::vec4 color, glm::mat4 M)
+{
+    if(vertices.count == 0)
+        return;
+    
+    //Dequantization: vertex * scale + offset
+    helperShader->Use();
+    helperShader->SetUniform(helperMVP, viewProjection * M * glm::translate(vertices.offset));
+    helperShader->SetUniform("scale", vertices.scale);
+    
+    OpenGLState::BindVertexArray(baseVertexArray);
+    glEnableVertexAttribArray(0);
+    glDisableVertexAttribArray(1);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, OpenGLHelperArena::getVertexBuffer());
+    glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(glm::u16vec4), (void*)0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    glVertexAttrib4fv(1, &color.r);
+    
+    GLenum mode;
+    switch(type)
+    {
+        case PrimitiveType::LINES:
+            mode = GL_LINES;
+            break;
+        
+        case PrimitiveType::LINE_STRIP:
+            mode = GL_LINE_STRIP;
+            break;
+
+        case PrimitiveType::TRIANGLES:
+            mode = GL_TRIANGLES;
+            break;
+            
+        case PrimitiveType::POINTS:
+        default:
+            mode = GL_POINTS;
+            break;
+    }
+    glDrawArrays(mode, (GLint)vertices.first, (GLsizei)vertices.count);
+    OpenGLState::BindVertexArray(0);
+    glDisableVertexAttribArray(0);
+    OpenGLState::UseProgram(0);
+}
+
+void OpenGLContent::SetCullingFrustum(const glm::mat4& VP, const glm::vec3& eye, GLfloat maxRange)
+{
+    //Only the side planes are used because near and far planes do not clip when depth clamping is enabled
+    glm::vec4 frustum[6];
+    OpenGLView::ExtractFrustumFromVP(frustum, VP);
+    for(int i=0; i<4; ++i)
+    {
+        //Unit normals needed to compare metric distances with the sphere radius
+        glm::vec4 plane = frustum[i] / glm::length(glm::vec3(frustum[i]));
+        cullingPlanes[0][i] = plane.x;
+        cullingPlanes[1][i] = plane.y;
+        cullingPlanes[2][i] = plane.z;
+        cullingPlanes[3][i] = plane.w;
+    }
+    cullingEye = eye;
+    cullingRange = maxRange;
+}
+
+void OpenGLContent::ResetCullingFrustum()
+{
+    SetCullingFrustum(viewProjection, eyePos, 0.f);
+}
+
+bool OpenGLContent::isVisible(int objectId, const glm::mat4& M) const
+{
+    if(objectId < 0 || objectId >= (int)objects.size() || objects[objectId].faceCount == 0)
+        return false;
+    
+    glm::vec4 bs = getBoundingSphere(objectId, M);
+    glm::vec3 c = glm::vec3(bs);
+    GLfloat r = bs.w;
+    
+    //Range test
+    if(cullingRange > 0.f && glm::length(c - cullingEye) - r > cullingRange)
+        return false;
+    
+    //Distances to the 4 side planes computed at once
+    glm::vec4 d = cullingPlanes[0] * c.x + cullingPlanes[1] * c.y + cullingPlanes[2] * c.z + cullingPlanes[3];
+    return glm::all(glm::greaterThanEqual(d, glm::vec4(-r)));
+}
+
+glm::vec4 OpenGLContent::getBoundingSphere(int objectId, const glm::mat4& M) const
 {
     if(objectId < 0 || objectId >= (int)objects.size())
+        return glm::vec4(0.f);
+    
+    const Object& obj = objects[objectId];
+    glm::vec3 c = glm::vec3(M * glm::vec4(obj.bsCenter, 1.f));
+    GLfloat scale = glm::max(glm::length2(glm::vec3(M[0])), glm::max(glm::length2(glm::vec3(M[1])), glm::length2(glm::vec3(M[2]))));
+    return glm::vec4(c, obj.bsRadius * glm::sqrt(scale));
+}
+
+void OpenGLContent::DrawObject(int objectId, int lookId, const glm::mat4& M, bool cull)
+{
+    if(cull ? !isVisible(objectId, M) : (objectId < 0 || objectId >= (int)objects.size() || objects[objectId].faceCount == 0))
         return;
     
     switch(mode)
     {
         case DrawingMode::SHADOW:
         {
-            basicShaders["shadow"]->Use();
-            basicShaders["shadow"]->SetUniform("MVP", viewProjection*M);
+            shadowShader->Use();
+            shadowShader->SetUniform(shadowMVP, viewProjection*M);
         }
         break;
         
         case DrawingMode::FLAT:
         {
-            basicShaders["flat"]->Use();
-            basicShaders["flat"]->SetUniform("MVP", viewProjection*M);
-            basicShaders["flat"]->SetUniform("FC", FC);
+            flatShader->Use();
+            flatShader->SetUniform(flatMVP, viewProjection*M);
+            flatShader->SetUniform(flatFC, FC);
         }
         break;
 
@@ -885,7 +997,7 @@ void OpenGLContent::DrawObject(int objectId, int lookId, const glm::mat4& M)
     }
 
     OpenGLState::BindVertexArray(objects[objectId].vao);
-    glDrawElements(GL_TRIANGLES, sizeof(Face) * objects[objectId].faceCount, GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, 3 * objects[objectId].faceCount, GL_UNSIGNED_INT, 0);
     OpenGLState::BindVertexArray(0);
 }
 
@@ -903,6 +1015,9 @@ void OpenGLContent::DrawLightSource(unsigned int lightId)
         //Render light source (on)
         glm::vec4 colorLi = lights[lightId]->getColorLi();
         glm::mat4 M = lights[lightId]->getTransform();
+        if(!isVisible(objectId, M))
+            return;
+
         GLint type = lights[lightId]->getType() == LightType::POINT ? 0 : 1; 
         GLint id = lights[lightId]->getType() == LightType::POINT ? lightId : lightId - lightsUBOData.numPointLights;
 
@@ -926,7 +1041,7 @@ void OpenGLContent::DrawLightSource(unsigned int lightId)
         }
 
         OpenGLState::BindVertexArray(objects[objectId].vao);
-        glDrawElements(GL_TRIANGLES, sizeof(Face) * objects[objectId].faceCount, GL_UNSIGNED_INT, 0);
+        glDrawElements(GL_TRIANGLES, 3 * objects[objectId].faceCount, GL_UNSIGNED_INT, 0);
         OpenGLState::BindVertexArray(0);
     }
     else
@@ -1011,142 +1126,97 @@ void OpenGLContent::UseLook(const Look& look, bool texturable, const glm::mat4&
     
     texturable = texturable && (look.albedoTexture > 0 || look.normalMap > 0 || look.temperatureMap > 0);
     
-    std::string shaderMode;
+    MaterialShaderMode shaderMode;
     switch (mode)
     {
         case DrawingMode::FULL:
             if (texturable)
-                shaderMode = "textured";
+                shaderMode = MaterialShaderMode::TEXTURED;
             else
-                shaderMode = "plain";
+                shaderMode = MaterialShaderMode::PLAIN;
             break;
     
         case DrawingMode::UNDERWATER:
             if (waves)
             {
                 if (texturable)
-                    shaderMode = "textured_underwater_waves";
+                    shaderMode = MaterialShaderMode::TEXTURED_UNDERWATER_WAVES;
                 else
-                    shaderMode = "plain_underwater_waves";
+                    shaderMode = MaterialShaderMode::PLAIN_UNDERWATER_WAVES;
             }
             else
             {
                 if (texturable)
-                    shaderMode = "textured_underwater";
+                    shaderMode = MaterialShaderMode::TEXTURED_UNDERWATER;
                 else
-                    shaderMode = "plain_underwater";
+                    shaderMode = MaterialShaderMode::PLAIN_UNDERWATER;
             }
             break;
 
         case DrawingMode::TEMPERATURE:
             if (texturable)
-                shaderMode = "textured_temperature";
+                shaderMode = MaterialShaderMode::TEXTURED_TEMPERATURE;
             else
-                shaderMode = "plain_temperature";
+                shaderMode = MaterialShaderMode::PLAIN_TEMPERATURE;
             break;
 
         default:
-            shaderMode = "plain";
+            shaderMode = MaterialShaderMode::PLAIN;
             break;
     }
     
-    bool updateMaterial = (look.name != currentLookName) || (currentShaderMode != shaderMode);
-    currentLookName = look.name;
+    bool updateMaterial = (&look != currentLook) || (currentShaderMode != shaderMode);
+    currentLook = &look;
     currentShaderMode = shaderMode;
     
-    GLSLShader* shader = materialShaders[look.type == LookType::SIMPLE ? 0 : 1].shaders[currentShaderMode];
+    const MaterialShaderVariant& variant = materialShaders[look.type == LookType::SIMPLE ? 0 : 1].variants[(size_t)shaderMode];
+    GLSLShader* shader = variant.shader;
 
     shader->Use();
-    shader->SetUniform("MVP", viewProjection*M);
-    shader->SetUniform("M", M);
-    shader->SetUniform("N", glm::mat3(glm::transpose(glm::inverse(M))));
-    shader->SetUniform("MV", glm::mat3(glm::transpose(glm::inverse(view*M))));
-    shader->SetUniform("FC", FC);
-    shader->SetUniform("eyePos", eyePos);
-    shader->SetUniform("viewDir", viewDir);
+    shader->SetUniform(variant.MVP, viewProjection*M);
+    shader->SetUniform(variant.M, M);
+    shader->SetUniform(variant.N, glm::mat3(glm::transpose(glm::inverse(M))));
+    shader->SetUniform(variant.MV, glm::mat3(glm::transpose(glm::inverse(view*M))));
+    shader->SetUniform(variant.FC, FC);
+    shader->SetUniform(variant.eyePos, eyePos);
+    shader->SetUniform(variant.viewDir, viewDir);
 
     if(updateMaterial)
     {
-        switch(look.type)
-        {		
-            default:
-            case LookType::SIMPLE: //Blinn-Phong
-            {
-                shader->SetUniform("specularStrength", look.params[0]);
-                shader->SetUniform("shininess", look.params[1]);
-                shader->SetUniform("reflectivity", look.reflectivity);
-                shader->SetUniform("color", glm::vec4(look.color.rgb, 1.f));
-            }
-            break;
-            
-            case LookType::PHYSICAL: //Cook-Torrance
-            {
-                shader->SetUniform("roughness", look.params[0]);
-                shader->SetUniform("metallic", look.params[1]);
-                shader->SetUniform("reflectivity", look.reflectivity);
-                shader->SetUniform("color", glm::vec4(look.color.rgb, 1.f));
-            }
-            break;
-        }
+        glBindBufferBase(GL_UNIFORM_BUFFER, UBO_MATERIAL, look.ubo);
 
         if(texturable)
         {
             if(look.albedoTexture > 0)
-            {
-                shader->SetUniform("enableAlbedoTex", true);
                 OpenGLState::BindTexture(TEX_MAT_ALBEDO, GL_TEXTURE_2D, look.albedoTexture);
-            }
             else
-            {
-                shader->SetUniform("enableAlbedoTex", false);
                 OpenGLState::UnbindTexture(TEX_MAT_ALBEDO);
-            }
 
             if(look.normalMap > 0)
-            {
-                shader->SetUniform("enableNormalTex", true);
                 OpenGLState::BindTexture(TEX_MAT_NORMAL, GL_TEXTURE_2D, look.normalMap);
-            }
             else
-            {
-                shader->SetUniform("enableNormalTex", false);
                 OpenGLState::UnbindTexture(TEX_MAT_NORMAL);
-            }
 
-            if(currentShaderMode == "textured_temperature")
+            if(shaderMode == MaterialShaderMode::TEXTURED_TEMPERATURE)
             {
                 if(look.temperatureMap > 0)
-                {
                     OpenGLState::BindTexture(TEX_MAT_TEMPERATURE, GL_TEXTURE_2D, look.temperatureMap);
-                    shader->SetUniform("enableTemperatureTex", true);
-                    shader->SetUniform("texTemperature", TEX_MAT_TEMPERATURE);
-                }
                 else
-                {
-                    shader->SetUniform("enableTemperatureTex", false);
                     OpenGLState::UnbindTexture(TEX_MAT_TEMPERATURE);
-                }
-                shader->SetUniform("temperatureRange", look.temperatureRange);
             }
         }
-        else
-        {
-            if(currentShaderMode == "plain_temperature")
-                shader->SetUniform("temperature", look.temperatureRange.x);
-        }
-    }
 
-    if(mode == DrawingMode::UNDERWATER)
-    {
-        shader->SetUniform("cWater", ocean->getOpenGLOcean()->getLightAttenuation());
-        shader->SetUniform("bWater", ocean->getOpenGLOcean()->getLightScattering());
-        if(waves)
+        if(mode == DrawingMode::UNDERWATER)
         {
-            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D_ARRAY, ocean->getOpenGLOcean()->getWaveTexture());
-            shader->SetUniform("texWaveFFT", TEX_POSTPROCESS1);
-            shader->SetUniform("gridSizes", ocean->getOpenGLOcean()->getWaveGridSizes());
+            shader->SetUniform("cWater", ocean->getOpenGLOcean()->getLightAttenuation());
+            shader->SetUniform("bWater", ocean->getOpenGLOcean()->getLightScattering());
+            if(waves)
+                shader->SetUniform("gridSizes", ocean->getOpenGLOcean()->getWaveGridSizes());
         }
     }
+
+    if(mode == DrawingMode::UNDERWATER && waves)
+        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D_ARRAY, ocean->getOpenGLOcean()->getWaveTexture());
 }
 
 void OpenGLContent::UseCableLook(const Look& look, GLfloat radius)
@@ -1155,124 +1225,63 @@ void OpenGLContent::UseCableLook(const Look& look, GLfloat radius)
     Ocean* ocean = SimulationApp::getApp()->getSimulationManager()->getOcean();
     if(ocean != NULL && ocean->hasWaves()) waves = true;
     
-    std::string shaderMode;
+    MaterialShaderMode shaderMode;
     switch (mode)
     {
-        case DrawingMode::FULL:
-            shaderMode = "cable_textured";
-            break;
-    
         case DrawingMode::UNDERWATER:
             if (waves)
-                shaderMode = "cable_textured_underwater_waves";
+                shaderMode = MaterialShaderMode::CABLE_TEXTURED_UNDERWATER_WAVES;
             else
-                shaderMode = "cable_textured_underwater";
+                shaderMode = MaterialShaderMode::CABLE_TEXTURED_UNDERWATER;
             break;
 
-        case DrawingMode::TEMPERATURE:
-            shaderMode = "cable_textured_temperature";
-            break;
-
-        default:
-            shaderMode = "cable_textured";
+        default: //There is no temperature variant of the cable shader
+            shaderMode = MaterialShaderMode::CABLE_TEXTURED;
             break;
     }
     
-    bool updateMaterial = (look.name != currentLookName) || (currentShaderMode != shaderMode);
-    currentLookName = look.name;
+    bool updateMaterial = (&look != currentLook) || (currentShaderMode != shaderMode);
+    currentLook = &look;
     currentShaderMode = shaderMode;
     
-    GLSLShader* shader = materialShaders[look.type == LookType::SIMPLE ? 0 : 1].shaders[currentShaderMode];
+    const MaterialShaderVariant& variant = materialShaders[look.type == LookType::SIMPLE ? 0 : 1].variants[(size_t)shaderMode];
+    GLSLShader* shader = variant.shader;
 
     shader->Use();
-    shader->SetUniform("MVP", viewProjection);
-    shader->SetUniform("M", glm::mat4(1.f));
-    shader->SetUniform("N", glm::mat3(1.f));
-    shader->SetUniform("MV", glm::mat3(glm::transpose(glm::inverse(view))));
-    shader->SetUniform("FC", FC);
-    shader->SetUniform("cableRadius", radius);
-    shader->SetUniform("eyePos", eyePos);
-    shader->SetUniform("viewDir", viewDir);
+    shader->SetUniform(variant.MVP, viewProjection);
+    shader->SetUniform(variant.M, glm::mat4(1.f));
+    shader->SetUniform(variant.N, glm::mat3(1.f));
+    shader->SetUniform(variant.MV, glm::mat3(glm::transpose(glm::inverse(view))));
+    shader->SetUniform(variant.FC, FC);
+    shader->SetUniform(variant.cableRadius, radius);
+    shader->SetUniform(variant.eyePos, eyePos);
+    shader->SetUniform(variant.viewDir, viewDir);
 
     if(updateMaterial)
     {
-        switch(look.type)
-        {		
-            default:
-            case LookType::SIMPLE: //Blinn-Phong
-            {
-                shader->SetUniform("specularStrength", look.params[0]);
-                shader->SetUniform("shininess", look.params[1]);
-                shader->SetUniform("reflectivity", look.reflectivity);
-                shader->SetUniform("color", glm::vec4(look.color.rgb, 1.f));
-            }
-            break;
-            
-            case LookType::PHYSICAL: //Cook-Torrance
-            {
-                shader->SetUniform("roughness", look.params[0]);
-                shader->SetUniform("metallic", look.params[1]);
-                shader->SetUniform("reflectivity", look.reflectivity);
-                shader->SetUniform("color", glm::vec4(look.color.rgb, 1.f));
-            }
-            break;
-        }
+        glBindBufferBase(GL_UNIFORM_BUFFER, UBO_MATERIAL, look.ubo);
 
         if(look.albedoTexture > 0)
-        {
-            shader->SetUniform("enableAlbedoTex", true);
             OpenGLState::BindTexture(TEX_MAT_ALBEDO, GL_TEXTURE_2D, look.albedoTexture);
-        }
         else
-        {
-            shader->SetUniform("enableAlbedoTex", false);
             OpenGLState::UnbindTexture(TEX_MAT_ALBEDO);
-        }
 
         if(look.normalMap > 0)
-        {
-            shader->SetUniform("enableNormalTex", true);
             OpenGLState::BindTexture(TEX_MAT_NORMAL, GL_TEXTURE_2D, look.normalMap);
-        }
         else
-        {
-            shader->SetUniform("enableNormalTex", false);
             OpenGLState::UnbindTexture(TEX_MAT_NORMAL);
-        }
 
-        //     if(currentShaderMode == "cable_textured_temperature")
-        //     {
-        //         if(look.temperatureMap > 0)
-        //         {
-        //             OpenGLState::BindTexture(TEX_MAT_TEMPERATURE, GL_TEXTURE_2D, look.temperatureMap);
-        //             shader->SetUniform("enableTemperatureTex", true);
-        //             shader->SetUniform("texTemperature", TEX_MAT_TEMPERATURE);
-        //         }
-        //         else
-        //         {
-        //             shader->SetUniform("enableTemperatureTex", false);
-        //             OpenGLState::UnbindTexture(TEX_MAT_TEMPERATURE);
-        //         }
-        //         shader->SetUniform("temperatureRange", look.temperatureRange);
-        //     }
-        // }
-        // else
-        // {
-        //     if(currentShaderMode == "cable_plain_temperature")
-        //         shader->SetUniform("temperature", look.temperatureRange.x);
-    }
-
-    if(mode == DrawingMode::UNDERWATER)
-    {
-        shader->SetUniform("cWater", ocean->getOpenGLOcean()->getLightAttenuation());
-        shader->SetUniform("bWater", ocean->getOpenGLOcean()->getLightScattering());
-        if(waves)
+        if(mode == DrawingMode::UNDERWATER)
         {
-            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D_ARRAY, ocean->getOpenGLOcean()->getWaveTexture());
-            shader->SetUniform("texWaveFFT", TEX_POSTPROCESS1);
-            shader->SetUniform("gridSizes", ocean->getOpenGLOcean()->getWaveGridSizes());
+            shader->SetUniform("cWater", ocean->getOpenGLOcean()->getLightAttenuation());
+            shader->SetUniform("bWater", ocean->getOpenGLOcean()->getLightScattering());
+            if(waves)
+                shader->SetUniform("gridSizes", ocean->getOpenGLOcean()->getWaveGridSizes());
         }
     }
+
+    if(mode == DrawingMode::UNDERWATER && waves)
+        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D_ARRAY, ocean->getOpenGLOcean()->getWaveTexture());
 }
 
 unsigned int OpenGLContent::BuildObject(Mesh* mesh)
@@ -1284,6 +1293,10 @@ unsigned int OpenGLContent::BuildObject(Mesh* mesh)
     glGenBuffers(1, &obj.vboIndex);
     obj.faceCount = (GLsizei)mesh->faces.size();
     obj.texturable = false;
+    obj.bsRadius = 0.f;
+    obj.bsCenter = glm::vec3(0.f);
+    if(mesh->getNumOfVertices() > 0)
+        AABS(mesh, obj.bsRadius, obj.bsCenter);
     
     OpenGLState::BindVertexArray(obj.vao);	
     glEnableVertexAttribArray(0); //Position
@@ -1310,10 +1323,32 @@ unsigned int OpenGLContent::BuildObject(Mesh* mesh)
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(Face) * mesh->faces.size(), &mesh->faces[0].vertexID[0], GL_STATIC_DRAW);
     OpenGLState::BindVertexArray(0);
     
+    if(!freeObjects.empty()) //Reuse the slot of a destroyed object
+    {
+        unsigned int id = freeObjects.back();
+        freeObjects.pop_back();
+        objects[id] = obj;
+        return id;
+    }
     objects.push_back(obj);
     return (unsigned int)objects.size()-1;
 }
 
+void OpenGLContent::DestroyObject(unsigned int id)
+{
+    if(id >= objects.size() || objects[id].vao == 0)
+        return;
+    
+    glDeleteBuffers(1, &objects[id].vboVertex);
+    glDeleteBuffers(1, &objects[id].vboIndex);
+    glDeleteVertexArrays(1, &objects[id].vao);
+    objects[id].vao = 0;
+    objects[id].vboVertex = 0;
+    objects[id].vboIndex = 0;
+    objects[id].faceCount = 0;
+    freeObjects.push_back(id);
+}
+
 size_t OpenGLContent::BuildCable(size_t numNodes)
 {
     Cable cable;
@@ -1348,7 +1383,9 @@ std::string OpenGLContent::CreateSimpleLook(const std::string& name, glm::vec3 r
     look.params.push_back(specular);
     look.params.push_back(shininess);
     if(albedoTexturePath != "") look.albedoTexture = LoadTexture(albedoTexturePath);
+    CreateLookUBO(look);
     looks.push_back(look);
+    currentLook = nullptr; //Looks may have been reallocated
     return look.name;
 }
 
@@ -1367,10 +1404,29 @@ std::string OpenGLContent::CreatePhysicalLook(const std::string& name, glm::vec3
     if(normalMapPath != "") look.normalMap = LoadTexture(normalMapPath, false);
     if(temperatureMapPath != "") look.temperatureMap = LoadTexture(temperatureMapPath, false);
     look.temperatureRange = temperatureRange;
+    CreateLookUBO(look);
     looks.push_back(look);
+    currentLook = nullptr; //Looks may have been reallocated
     return look.name;
 }
 
+void OpenGLContent::CreateLookUBO(Look& look)
+{
+    MaterialUBO data;
+    data.color = glm::vec4(look.color.rgb, 1.f);
+    data.shadingParams = glm::vec2(look.params.size() > 0 ? look.params[0] : 0.f, look.params.size() > 1 ? look.params[1] : 0.f);
+    data.temperatureRange = look.temperatureRange;
+    data.reflectivity = look.reflectivity;
+    data.enableAlbedoTex = look.albedoTexture > 0 ? 1 : 0;
+    data.enableNormalTex = look.normalMap > 0 ? 1 : 0;
+    data.enableTemperatureTex = look.temperatureMap > 0 ? 1 : 0;
+
+    glGenBuffers(1, &look.ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, look.ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(MaterialUBO), &data, GL_STATIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
 void OpenGLContent::AddView(OpenGLView *view)
 {
     views.push_back(view);
@@ -249,6 +249,8 @@ void OpenGLDepthCamera::ComputeOutput(std::vector<Renderable>& objects)
 {
     OpenGLContent* content = ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent();
     content->SetCurrentView(this);
+    if(usesRanges) //Nothing beyond the maximum range is measured
+        content->SetCullingFrustum(GetProjectionMatrix() * GetViewMatrix(), GetEyePosition(), range.y);
     content->SetDrawingMode(DrawingMode::SHADOW);
     OpenGLState::BindFramebuffer(renderFBO);
     OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
@@ -0,0 +1,206 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  OpenGLHelperArena.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "graphics/OpenGLHelperArena.h"
+
+#include <cstring>
+
+namespace sf
+{
+
+const HelperSettings* OpenGLHelperArena::settings = nullptr;
+std::vector<glm::vec3> OpenGLHelperArena::staging;
+std::vector<glm::u16vec4> OpenGLHelperArena::vertices[2];
+unsigned int OpenGLHelperArena::filled = 0;
+bool OpenGLHelperArena::uploaded = true;
+GLuint OpenGLHelperArena::vbo = 0;
+size_t OpenGLHelperArena::vboSize = 0;
+
+void OpenGLHelperArena::Init(const HelperSettings& s)
+{
+    settings = &s;
+    staging.clear();
+    vertices[0].clear();
+    vertices[1].clear();
+    filled = 0;
+    uploaded = true;
+    glGenBuffers(1, &vbo);
+    vboSize = 0;
+}
+
+void OpenGLHelperArena::Destroy()
+{
+    if(vbo != 0)
+    {
+        glDeleteBuffers(1, &vbo);
+        vbo = 0;
+    }
+    vboSize = 0;
+    staging = std::vector<glm::vec3>();
+    vertices[0] = std::vector<glm::u16vec4>();
+    vertices[1] = std::vector<glm::u16vec4>();
+    settings = nullptr;
+}
+
+bool OpenGLHelperArena::isEnabled(RenderableType type)
+{
+    if(settings == nullptr)
+        return false;
+    
+    switch(type)
+    {
+        case RenderableType::SOLID:
+        case RenderableType::CABLE:
+            return true;
+            
+        case RenderableType::SOLID_CS:
+            return settings->showCoordSys;
+            
+        case RenderableType::MULTIBODY_AXIS:
+        case RenderableType::JOINT_LINES:
+        case RenderableType::PATH_POINTS:
+        case RenderableType::PATH_LINE_STRIP:
+            return settings->showJoints;
+            
+        case RenderableType::SENSOR_CS:
+        case RenderableType::SENSOR_LINES:
+        case RenderableType::SENSOR_LINE_STRIP:
+        case RenderableType::SENSOR_POINTS:
+            return settings->showSensors;
+            
+        case RenderableType::ACTUATOR_LINES:
+            return settings->showActuators;
+            
+        case RenderableType::HYDRO_CYLINDER:
+        case RenderableType::HYDRO_ELLIPSOID:
+        case RenderableType::HYDRO_CS:
+        case RenderableType::HYDRO_POINTS:
+        case RenderableType::HYDRO_LINES:
+        case RenderableType::HYDRO_LINE_STRIP:
+        case RenderableType::HYDRO_TRIANGLES:
+            return settings->showFluidDynamics;
+            
+        case RenderableType::FORCE_GRAVITY:
+        case RenderableType::FORCE_BUOYANCY:
+        case RenderableType::FORCE_LINEAR_DRAG:
+        case RenderableType::FORCE_QUADRATIC_DRAG:
+            return settings->showForces;
+            
+        default:
+            return true;
+    }
+}
+
+std::vector<glm::vec3>& OpenGLHelperArena::Begin()
+{
+    staging.clear();
+    return staging;
+}
+
+HelperRange OpenGLHelperArena::Commit()
+{
+    HelperRange range = Store(staging);
+    staging.clear();
+    return range;
+}
+
+HelperRange OpenGLHelperArena::Store(const std::vector<glm::vec3>& points)
+{
+    std::vector<glm::u16vec4>& arena = vertices[filled];
+    HelperRange range;
+    range.first = (GLuint)arena.size();
+    range.count = (GLuint)points.size();
+    if(points.empty())
+        return range;
+
+    //Quantize relative to the bounding box of the range
+    glm::vec3 min = points[0];
+    glm::vec3 max = points[0];
+    for(size_t i=1; i<points.size(); ++i)
+    {
+        min = glm::min(min, points[i]);
+        max = glm::max(max, points[i]);
+    }
+    range.offset = min;
+    range.scale = max - min;
+    glm::vec3 invScale(range.scale.x > 0.f ? 65535.f/range.scale.x : 0.f,
+                       range.scale.y > 0.f ? 65535.f/range.scale.y : 0.f,
+                       range.scale.z > 0.f ? 65535.f/range.scale.z : 0.f);
+    
+    for(size_t i=0; i<points.size(); ++i)
+    {
+        glm::vec3 q = glm::clamp(glm::round((points[i] - min) * invScale), glm::vec3(0.f), glm::vec3(65535.f));
+        arena.push_back(glm::u16vec4((GLushort)q.x, (GLushort)q.y, (GLushort)q.z, 0));
+    }
+    return range;
+}
+
+void OpenGLHelperArena::Swap()
+{
+    filled = 1 - filled;
+    vertices[filled].clear();
+    uploaded = false;
+}
+
+void OpenGLHelperArena::Upload()
+{
+    if(uploaded)
+        return;
+    uploaded = true;
+    
+    const std::vector<glm::u16vec4>& arena = vertices[1 - filled];
+    if(arena.empty())
+        return;
+    
+    size_t size = arena.size() * sizeof(glm::u16vec4);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    if(size > vboSize) //Grow with a margin to avoid reallocation every frame
+    {
+        vboSize = size + size/2;
+        glBufferData(GL_ARRAY_BUFFER, vboSize, NULL, GL_STREAM_DRAW);
+    }
+    void* dst = glMapBufferRange(GL_ARRAY_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if(dst != nullptr)
+    {
+        memcpy(dst, arena.data(), size);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+glm::vec3 OpenGLHelperArena::getVertex(const HelperRange& range, GLuint index)
+{
+    const std::vector<glm::u16vec4>& arena = vertices[1 - filled];
+    if(index >= range.count || range.first + index >= arena.size())
+        return range.offset;
+    return range.offset + glm::vec3(arena[range.first + index]) / 65535.f * range.scale;
+}
+
+GLuint OpenGLHelperArena::getVertexBuffer()
+{
+    return vbo;
+}
+
+}
@@ -38,6 +38,7 @@ namespace sf
 {
 
 GLuint OpenGLLight::spotShadowArrayTex = 0;
+GLuint OpenGLLight::spotShadowCacheArrayTex = 0;
 GLuint OpenGLLight::spotDepthSampler = 0;
 GLuint OpenGLLight::spotShadowSampler = 0;
 OpenGLCamera* OpenGLLight::activeView = nullptr;
@@ -138,6 +139,12 @@ void OpenGLLight::Init(std::vector<OpenGLLight*>& lights)
     glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, SPOT_LIGHT_SHADOWMAP_SIZE, SPOT_LIGHT_SHADOWMAP_SIZE, numOfSpotLights, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
     OpenGLState::UnbindTexture(TEX_BASE);
     
+    //Generate shadowmap cache array (static objects)
+    glGenTextures(1, &spotShadowCacheArrayTex);
+    OpenGLState::BindTexture(TEX_BASE, GL_TEXTURE_2D_ARRAY, spotShadowCacheArrayTex);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, SPOT_LIGHT_SHADOWMAP_SIZE, SPOT_LIGHT_SHADOWMAP_SIZE, numOfSpotLights, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+    OpenGLState::UnbindTexture(TEX_BASE);
+    
     //Generate samplers
     glGenSamplers(1, &spotDepthSampler);
     glSamplerParameteri(spotDepthSampler, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -169,6 +176,7 @@ void OpenGLLight::Init(std::vector<OpenGLLight*>& lights)
 void OpenGLLight::Destroy()
 {
     if(spotShadowArrayTex != 0) glDeleteTextures(1, &spotShadowArrayTex);
+    if(spotShadowCacheArrayTex != 0) glDeleteTextures(1, &spotShadowCacheArrayTex);
     if(spotDepthSampler != 0) glDeleteSamplers(1, &spotDepthSampler);
     if(spotShadowSampler != 0) glDeleteSamplers(1, &spotShadowSampler);
 }
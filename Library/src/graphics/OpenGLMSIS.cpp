@@ -36,8 +36,6 @@
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 
-#define MSIS_RES_FACTOR 0.1f
-
 namespace sf
 {
 
@@ -278,21 +276,27 @@ void OpenGLMSIS::UpdateTransform()
     //Inform sonar to run callback
     if(newData_)
     {
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO_);
-        void* src = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src)
+        if(displayRead_)
         {
-            sonar_->NewDataReady(src, 0);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO_);
+            void* src = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+            if(src)
+            {
+                sonar_->NewDataReady(src, 0);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            }
         }
         
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO_);
-        src = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src)
+        //Sonar head has to advance even if nobody consumes the raw data
+        void* src = nullptr;
+        if(outputRead_)
         {
-            sonar_->NewDataReady(src, 1);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO_);
+            src = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
         }
+        sonar_->NewDataReady(src, 1);
+        if(src)
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
         glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
         newData_ = false;
     }
@@ -355,10 +359,12 @@ void OpenGLMSIS::ComputeOutput(std::vector<Renderable>& objects)
     
     //Calculate view transform
     glm::mat4 VP = GetProjectionMatrix() * beamRotation_ * GetViewMatrix();
+    content->SetCullingFrustum(VP, GetEyePosition(), range_.y);
     //Draw objects
     for(size_t i=0; i<objects.size(); ++i)
     {
-        if(objects[i].type != RenderableType::SOLID)
+        if(objects[i].type != RenderableType::SOLID
+           || !content->isVisible(objects[i].objectId, objects[i].model))
             continue;
         const Object& obj = content->getObject(objects[i].objectId);
         const Look& look = content->getLook(objects[i].lookId);
@@ -375,6 +381,7 @@ void OpenGLMSIS::ComputeOutput(std::vector<Renderable>& objects)
             OpenGLState::BindTexture(TEX_MAT_NORMAL, GL_TEXTURE_2D, look.normalMap);
         content->DrawObject(objects[i].objectId, objects[i].lookId, objects[i].model);
     }
+    content->ResetCullingFrustum();
     glEnable(GL_DEPTH_CLAMP);
     OpenGLState::UnbindTexture(TEX_MAT_NORMAL);
     OpenGLState::BindFramebuffer(0);
@@ -423,18 +430,22 @@ void OpenGLMSIS::ComputeOutput(std::vector<Renderable>& objects)
     glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
     glDispatchCompute((GLuint)ceilf(nBins_/64.f), 1, 1);
     
-    OpenGLState::BindFramebuffer(displayFBO_);
-    OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
-    glClear(GL_COLOR_BUFFER_BIT);
-    OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, outputTex_[1]);
-    glGenerateMipmap(GL_TEXTURE_2D);
-    sonarVisualizeShader_[outputFormat_ == SonarOutputFormat::U32 ? 1 : 0]->Use();
-    sonarVisualizeShader_[outputFormat_ == SonarOutputFormat::U32 ? 1 : 0]->SetUniform("texSonarData", TEX_POSTPROCESS1);
-    sonarVisualizeShader_[outputFormat_ == SonarOutputFormat::U32 ? 1 : 0]->SetUniform("colorMap", static_cast<GLint>(cMap_));
-    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-    OpenGLState::BindVertexArray(displayVAO_);
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, (fanDiv_+1)*2);
-    OpenGLState::BindVertexArray(0);
+    //Color mapped display (skipped when not shown or subscribed)
+    if(sonar_ == nullptr || sonar_->isOutputRequired(VisionOutput::DISPLAY))
+    {
+        OpenGLState::BindFramebuffer(displayFBO_);
+        OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
+        glClear(GL_COLOR_BUFFER_BIT);
+        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, outputTex_[1]);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        sonarVisualizeShader_[outputFormat_ == SonarOutputFormat::U32 ? 1 : 0]->Use();
+        sonarVisualizeShader_[outputFormat_ == SonarOutputFormat::U32 ? 1 : 0]->SetUniform("texSonarData", TEX_POSTPROCESS1);
+        sonarVisualizeShader_[outputFormat_ == SonarOutputFormat::U32 ? 1 : 0]->SetUniform("colorMap", static_cast<GLint>(cMap_));
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        OpenGLState::BindVertexArray(displayVAO_);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, (fanDiv_+1)*2);
+        OpenGLState::BindVertexArray(0);
+    }
     OpenGLState::BindFramebuffer(0);
     OpenGLState::UseProgram(0);
     OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
@@ -467,29 +478,37 @@ void OpenGLMSIS::DrawLDR(GLuint destinationFBO, bool updated)
     //Copy texture to sonar buffer
     if(sonar_ != nullptr && updated)
     {
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, outputTex_[1]);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO_);
-        switch (outputFormat_)
+        outputRead_ = sonar_->isOutputSubscribed(VisionOutput::RAW);
+        displayRead_ = sonar_->isOutputSubscribed(VisionOutput::DISPLAY);
+        if(outputRead_)
         {
-            case SonarOutputFormat::U8:
-                glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_BYTE, NULL);
-                break;
-            case SonarOutputFormat::U16:
-                glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_SHORT, NULL);
-                break;
-            case SonarOutputFormat::U32:
-                glGetTexImage(GL_TEXTURE_2D, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
-                break;
-            case SonarOutputFormat::F32:
-                glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, NULL);
-                break;
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, outputTex_[1]);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO_);
+            switch (outputFormat_)
+            {
+                case SonarOutputFormat::U8:
+                    glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_BYTE, NULL);
+                    break;
+                case SonarOutputFormat::U16:
+                    glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_SHORT, NULL);
+                    break;
+                case SonarOutputFormat::U32:
+                    glGetTexImage(GL_TEXTURE_2D, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+                    break;
+                case SonarOutputFormat::F32:
+                    glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, NULL);
+                    break;
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
         }
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
         
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, displayTex_);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO_);
-        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        if(displayRead_)
+        {
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, displayTex_);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO_);
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
         OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
         newData_ = true;
     }
@@ -51,6 +51,13 @@
 namespace sf
 {
 
+//Suspended particles are dropped only in the low quality tiers of offscreen rendering
+static bool ParticlesAllowed()
+{
+    RenderSettings s = ((GraphicalSimulationApp*)SimulationApp::getApp())->getRenderSettings();
+    return !s.offscreen || s.ocean > RenderQuality::LOW;
+}
+
 OpenGLOcean::OpenGLOcean(GLfloat size)
 {
     cInfo("Generating ocean waves...");
@@ -72,7 +79,7 @@ OpenGLOcean::OpenGLOcean(GLfloat size)
     params.spectrum34 = NULL;
     GLint layers = 4;
     oceanSize = size;
-    particlesEnabled = true;
+    particlesEnabled = ParticlesAllowed();
     waterTemperature = 15.f;
 
     //Create simulation textures
@@ -373,7 +380,7 @@ GLfloat OpenGLOcean::getWaterTemperature()
     
 void OpenGLOcean::setParticles(bool enabled)
 {
-    particlesEnabled = enabled;
+    particlesEnabled = enabled && ParticlesAllowed();
 }
 
 bool OpenGLOcean::getParticlesEnabled()
@@ -563,7 +570,7 @@ void OpenGLOcean::DrawUnderwaterMask(OpenGLView* view)
     oceanShaders["mask_back"]->SetUniform("FC", view->GetLogDepthConstant());
     oceanShaders["mask_back"]->SetUniform("size", oceanSize*0.5f);
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->SetDrawingMode(DrawingMode::RAW);
-    ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->DrawObject(oceanBoxObj, -1, glm::mat4(1.f));
+    ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->DrawObject(oceanBoxObj, -1, glm::mat4(1.f), false); //Scaled in the shader
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->SetDrawingMode(DrawingMode::UNDERWATER);
     OpenGLState::UseProgram(0);
 }
@@ -579,7 +586,7 @@ void OpenGLOcean::DrawBackground(OpenGLView* view)
     oceanShaders["background"]->SetUniform("bWater", getLightScattering());
     glCullFace(GL_FRONT);
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->SetDrawingMode(DrawingMode::RAW);
-    ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->DrawObject(oceanBoxObj, -1, glm::mat4(1.f));
+    ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->DrawObject(oceanBoxObj, -1, glm::mat4(1.f), false); //Scaled in the shader
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->SetDrawingMode(DrawingMode::UNDERWATER);
     glCullFace(GL_BACK);
     OpenGLState::UseProgram(0);
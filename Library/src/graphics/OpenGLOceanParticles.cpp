@@ -42,6 +42,7 @@ namespace sf
     
 GLuint OpenGLOceanParticles::flakeTexture = 0;
 GLuint OpenGLOceanParticles::noiseTexture = 0;
+GLuint OpenGLOceanParticles::materialUBO = 0;
 GLSLShader* OpenGLOceanParticles::renderShader = nullptr;
 GLSLShader* OpenGLOceanParticles::renderIdShader = nullptr;
 GLSLShader* OpenGLOceanParticles::updateShader = nullptr;
@@ -118,6 +119,7 @@ void OpenGLOceanParticles::Draw(OpenGLView* view, OpenGLOcean* glOcn)
     renderShader->SetUniform("cWater", glOcn->getLightAttenuation());
     renderShader->SetUniform("bWater", glOcn->getLightScattering());
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SSBO_PARTICLE_POS, particlePosSSBO);
+    glBindBufferBase(GL_UNIFORM_BUFFER, UBO_MATERIAL, materialUBO);
     OpenGLState::BindTexture(TEX_MAT_ALBEDO, GL_TEXTURE_2D, flakeTexture);
     OpenGLState::EnableBlend();
     glBlendFunc(GL_ONE, GL_ONE);
@@ -188,11 +190,7 @@ void OpenGLOceanParticles::Init()
     renderShader->AddUniform("FC", ParameterType::FLOAT);
     renderShader->AddUniform("eyePos", ParameterType::VEC3);
     renderShader->AddUniform("viewDir", ParameterType::VEC3);
-    renderShader->AddUniform("color", ParameterType::VEC4);
     renderShader->AddUniform("texAlbedo", ParameterType::INT);
-    renderShader->AddUniform("enableAlbedoTex", ParameterType::BOOLEAN);
-    renderShader->AddUniform("enableNormalTex", ParameterType::BOOLEAN);
-    renderShader->AddUniform("reflectivity", ParameterType::FLOAT);
     renderShader->AddUniform("cWater", ParameterType::VEC3);
     renderShader->AddUniform("bWater", ParameterType::VEC3);
     renderShader->AddUniform("transmittance_texture", ParameterType::INT);
@@ -200,19 +198,25 @@ void OpenGLOceanParticles::Init()
     renderShader->AddUniform("irradiance_texture", ParameterType::INT);
     renderShader->BindUniformBlock("SunSky", UBO_SUNSKY);
     renderShader->BindUniformBlock("Lights", UBO_LIGHTS);
+    renderShader->BindUniformBlock("Material", UBO_MATERIAL);
     renderShader->BindShaderStorageBlock("Positions", SSBO_PARTICLE_POS);
 
     renderShader->Use();
     renderShader->SetUniform("texAlbedo", TEX_MAT_ALBEDO);
-    renderShader->SetUniform("enableAlbedoTex", true);
-    renderShader->SetUniform("enableNormalTex", false);
     renderShader->SetUniform("transmittance_texture", TEX_ATM_TRANSMITTANCE);
     renderShader->SetUniform("scattering_texture", TEX_ATM_SCATTERING);
     renderShader->SetUniform("irradiance_texture", TEX_ATM_IRRADIANCE);
-    renderShader->SetUniform("reflectivity", 0.f);
-    renderShader->SetUniform("color", glm::vec4(0.f,0.f,0.f,0.3f));
     OpenGLState::UseProgram(0);
 
+    MaterialUBO material;
+    memset(&material, 0, sizeof(MaterialUBO));
+    material.color = glm::vec4(0.f,0.f,0.f,0.3f);
+    material.enableAlbedoTex = 1;
+    glGenBuffers(1, &materialUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, materialUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(MaterialUBO), &material, GL_STATIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
     sources.clear();
     sources.push_back(GLSLSource(GL_VERTEX_SHADER, "particle.vert"));
     sources.push_back(GLSLSource(GL_FRAGMENT_SHADER, "oceanParticleSegmentation.frag"));
@@ -260,6 +264,7 @@ void OpenGLOceanParticles::Destroy()
     if(renderIdShader != nullptr) delete renderIdShader;
     if(flakeTexture != 0) glDeleteTextures(1, &flakeTexture);
     if(noiseTexture != 0) glDeleteTextures(1, &noiseTexture);
+    if(materialUBO != 0) glDeleteBuffers(1, &materialUBO);
 }
     
 }
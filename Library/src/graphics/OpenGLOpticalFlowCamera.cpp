@@ -48,6 +48,8 @@ OpenGLOpticalFlowCamera::OpenGLOpticalFlowCamera(glm::vec3 eyePosition, glm::vec
     _needsUpdate = false;
     continuous = continuousUpdate;
     newData = false;
+    outputRead = false;
+    displayRead = false;
     camera = nullptr;
     noiseVel = glm::vec2(0.f);
     maxVel = width/2.f;
@@ -145,20 +147,26 @@ void OpenGLOpticalFlowCamera::UpdateTransform()
     //Inform camera to run callback
     if(newData)
     {
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
-        GLubyte* src = (GLubyte*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src)
+        if(displayRead)
         {
-            camera->NewDataReady(src, 0);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
+            GLubyte* src = (GLubyte*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+            if(src)
+            {
+                camera->NewDataReady(src, 0);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            }
         }
         
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
-        GLfloat* src2 = (GLfloat*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src2)
+        if(outputRead)
         {
-            camera->NewDataReady(src2, 1);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
+            GLfloat* src2 = (GLfloat*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+            if(src2)
+            {
+                camera->NewDataReady(src2, 1);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            }
         }
         glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
         newData = false;
@@ -316,17 +324,20 @@ void OpenGLOpticalFlowCamera::ComputeOutput(std::vector<Renderable>& objects)
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->DrawSAQ();
     
     //Color mapped velocity display
-    OpenGLState::BindFramebuffer(displayFBO);
-    OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
-    glClear(GL_COLOR_BUFFER_BIT);
-    OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, renderFlowTex[1]);
-    opticalFlowVisualizeShader->Use();
-    opticalFlowVisualizeShader->SetUniform("texFlow", TEX_POSTPROCESS1);
-    opticalFlowVisualizeShader->SetUniform("maxVel", maxVel);
-    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-    OpenGLState::BindVertexArray(displayVAO);
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    OpenGLState::BindVertexArray(0);
+    if(camera == nullptr || camera->isOutputRequired(VisionOutput::DISPLAY))
+    {
+        OpenGLState::BindFramebuffer(displayFBO);
+        OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
+        glClear(GL_COLOR_BUFFER_BIT);
+        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, renderFlowTex[1]);
+        opticalFlowVisualizeShader->Use();
+        opticalFlowVisualizeShader->SetUniform("texFlow", TEX_POSTPROCESS1);
+        opticalFlowVisualizeShader->SetUniform("maxVel", maxVel);
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        OpenGLState::BindVertexArray(displayVAO);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        OpenGLState::BindVertexArray(0);
+    }
     OpenGLState::BindFramebuffer(0);
     OpenGLState::UseProgram(0);
     OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
@@ -358,14 +369,22 @@ void OpenGLOpticalFlowCamera::DrawLDR(GLuint destinationFBO, bool updated)
     //Copy texture to camera buffer
     if(camera != nullptr && updated)
     {
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, renderFlowTex[1]);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
-        glGetTexImage(GL_TEXTURE_2D, 0, GL_RG, GL_FLOAT, NULL);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, displayFlowTex);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
-        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        outputRead = camera->isOutputSubscribed(VisionOutput::RAW);
+        displayRead = camera->isOutputSubscribed(VisionOutput::DISPLAY);
+        if(outputRead)
+        {
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, renderFlowTex[1]);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RG, GL_FLOAT, NULL);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+        if(displayRead)
+        {
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, displayFlowTex);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
         OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
         newData = true;
     }
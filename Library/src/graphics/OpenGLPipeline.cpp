@@ -43,9 +43,11 @@
 #include "graphics/OpenGLAtmosphere.h"
 #include "graphics/OpenGLLight.h"
 #include "graphics/OpenGLOceanParticles.h"
+#include "graphics/OpenGLHelperArena.h"
 #include "utils/SystemUtil.hpp"
 #include "entities/forcefields/Ocean.h"
 #include "entities/forcefields/Atmosphere.h"
+#include "entities/statics/TiledTerrain.h"
 #include "core/GraphicalSimulationApp.h"
 
 namespace sf
@@ -69,6 +71,7 @@ OpenGLPipeline::OpenGLPipeline(RenderSettings s, HelperSettings h) : rSettings(s
     OpenGLEventBasedCamera::Init();
     OpenGLSonar::Init();
     OpenGLOceanParticles::Init();
+    OpenGLHelperArena::Init(hSettings);
     content = new OpenGLContent();
     
     //Create display framebuffer
@@ -88,6 +91,7 @@ OpenGLPipeline::OpenGLPipeline(RenderSettings s, HelperSettings h) : rSettings(s
         cError("Display FBO initialization failed!");
     OpenGLState::BindFramebuffer(0);
     lastSimTime = Scalar(-1);
+    frameCount = 0;
 }
 
 OpenGLPipeline::~OpenGLPipeline()
@@ -100,6 +104,7 @@ OpenGLPipeline::~OpenGLPipeline()
     OpenGLEventBasedCamera::Destroy();
     OpenGLSonar::Destroy();
     OpenGLOceanParticles::Destroy();
+    OpenGLHelperArena::Destroy();
     OpenGLLight::Destroy();
     delete content;
     
@@ -133,6 +138,34 @@ OpenGLContent* OpenGLPipeline::getContent()
     return content;
 }
 
+unsigned int OpenGLPipeline::getFrameCount() const
+{
+    return frameCount;
+}
+
+bool OpenGLPipeline::isShadowCacheValid(const glm::mat4& VP) const
+{
+    if(dirtySpheres.empty())
+        return true;
+    
+    glm::vec4 frustum[6];
+    OpenGLView::ExtractFrustumFromVP(frustum, VP);
+    for(size_t i=0; i<dirtySpheres.size(); ++i)
+        if(OpenGLView::SphereInFrustum(frustum, dirtySpheres[i]))
+            return false;
+    return true;
+}
+
+bool OpenGLPipeline::hasDynamicObjects(const glm::mat4& VP) const
+{
+    glm::vec4 frustum[6];
+    OpenGLView::ExtractFrustumFromVP(frustum, VP);
+    for(size_t i=0; i<objectDynamic.size(); ++i)
+        if(objectDynamic[i] && OpenGLView::SphereInFrustum(frustum, objectSpheres[i]))
+            return true;
+    return false;
+}
+
 void OpenGLPipeline::AddToDrawingQueue(const Renderable& r)
 {
     drawingQueue.push_back(r);
@@ -188,12 +221,87 @@ void OpenGLPipeline::PerformDrawingQueueCopy(SimulationManager* sim)
         //Enable update of drawing queue by clearing old queue
         drawingQueue.clear(); 
         selectedDrawingQueue.clear();
+        //Helper vertices follow the drawing queue
+        OpenGLHelperArena::Swap();
     }
 
     SDL_UnlockMutex(drawingQueueMutex);
+    
+    OpenGLHelperArena::Upload();
+
+    //Sort objects by material to reduce uniform/texture switching (stable to keep the order of draws of each object)
+    std::stable_sort(drawingQueueCopy.begin(), drawingQueueCopy.end(), Renderable::SortByMaterial);
+    
+    //Find out which objects moved since the last frame
+    UpdateObjectMotion();
+}
 
-    //Sort objects by material to reduce uniform/texture switching
-    std::sort(drawingQueueCopy.begin(), drawingQueueCopy.end(), Renderable::SortByMaterial);
+void OpenGLPipeline::UpdateObjectMotion()
+{
+    ++frameCount;
+    dirtySpheres.clear();
+    objectSpheres.assign(drawingQueueCopy.size(), glm::vec4(0.f));
+    objectDynamic.assign(drawingQueueCopy.size(), 0);
+    objectDraws.clear();
+    
+    for(size_t i=0; i<drawingQueueCopy.size(); ++i)
+    {
+        const Renderable& r = drawingQueueCopy[i];
+        if(r.type == RenderableType::CABLE) //Cables are always dynamic
+        {
+            auto nodes = r.getDataAsCableNodes();
+            if(nodes->empty())
+                continue;
+            glm::vec3 c(0.f);
+            for(size_t h=0; h<nodes->size(); ++h)
+                c += glm::vec3(nodes->at(h).posCoord);
+            c /= (GLfloat)nodes->size();
+            GLfloat radius = 0.f;
+            for(size_t h=0; h<nodes->size(); ++h)
+                radius = glm::max(radius, glm::length(glm::vec3(nodes->at(h).posCoord) - c));
+            objectSpheres[i] = glm::vec4(c, radius + r.model[0][0]);
+            objectDynamic[i] = 1;
+        }
+        else if(r.type == RenderableType::SOLID)
+        {
+            objectSpheres[i] = content->getBoundingSphere(r.objectId, r.model);
+            uint64_t key = ((uint64_t)(uint32_t)r.objectId << 32) | objectDraws[r.objectId]++; //Each draw of a shared object tracked separately
+            auto it = objectMotion.find(key);
+            if(it == objectMotion.end()) //New object
+            {
+                objectMotion[key] = ObjectMotion{r.model, objectSpheres[i], 0, frameCount};
+                objectDynamic[i] = 1;
+                continue;
+            }
+            
+            ObjectMotion& m = it->second;
+            if(m.model != r.model) //Moved
+            {
+                if(m.staticFrames >= SHADOW_STATIC_FRAMES) //Remove from static shadows
+                    dirtySpheres.push_back(m.sphere);
+                m.model = r.model;
+                m.sphere = objectSpheres[i];
+                m.staticFrames = 0;
+            }
+            else if(++m.staticFrames == SHADOW_STATIC_FRAMES) //Became static
+                dirtySpheres.push_back(m.sphere);
+            m.lastFrame = frameCount;
+            objectDynamic[i] = m.staticFrames < SHADOW_STATIC_FRAMES ? 1 : 0;
+        }
+    }
+    
+    //Forget objects that are not drawn anymore
+    for(auto it = objectMotion.begin(); it != objectMotion.end();)
+    {
+        if(it->second.lastFrame != frameCount)
+        {
+            if(it->second.staticFrames >= SHADOW_STATIC_FRAMES)
+                dirtySpheres.push_back(it->second.sphere);
+            it = objectMotion.erase(it);
+        }
+        else
+            ++it;
+    }
 }
 
 void OpenGLPipeline::DrawDisplay()
@@ -203,10 +311,13 @@ void OpenGLPipeline::DrawDisplay()
     glBlitFramebuffer(0, 0, rSettings.windowW, rSettings.windowH, 0, 0, rSettings.windowW, rSettings.windowH, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 }
 
-void OpenGLPipeline::DrawObjects()
+void OpenGLPipeline::DrawObjects(ObjectFilter filter)
 {
     for(size_t i=0; i<drawingQueueCopy.size(); ++i)
     {
+        if(filter != ObjectFilter::ALL && (objectDynamic[i] != 0) != (filter == ObjectFilter::DYNAMIC))
+            continue;
+        
 		if (drawingQueueCopy[i].type == RenderableType::SOLID)
         {
 			content->DrawObject(drawingQueueCopy[i].objectId, drawingQueueCopy[i].lookId, drawingQueueCopy[i].model);
@@ -245,13 +356,13 @@ void OpenGLPipeline::DrawHelpers()
         for(size_t h=0; h<drawingQueueCopy.size(); ++h)
         {
             if(drawingQueueCopy[h].type == RenderableType::MULTIBODY_AXIS)
-                content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(1.f,0.5f,1.f,1.f), drawingQueueCopy[h].model);
+                content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(1.f,0.5f,1.f,1.f), drawingQueueCopy[h].model);
             else if(drawingQueueCopy[h].type == RenderableType::JOINT_LINES)
-                content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(1.f,0.5f,1.f,1.f), drawingQueueCopy[h].model);
+                content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(1.f,0.5f,1.f,1.f), drawingQueueCopy[h].model);
             else if(drawingQueueCopy[h].type == RenderableType::PATH_POINTS)
-                content->DrawPrimitives(PrimitiveType::POINTS, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(1.f,0.5f,1.f,1.f), drawingQueueCopy[h].model);
+                content->DrawPrimitives(PrimitiveType::POINTS, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(1.f,0.5f,1.f,1.f), drawingQueueCopy[h].model);
             else if(drawingQueueCopy[h].type == RenderableType::PATH_LINE_STRIP)
-                content->DrawPrimitives(PrimitiveType::LINE_STRIP, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(1.f,0.5f,1.f,1.f), drawingQueueCopy[h].model);
+                content->DrawPrimitives(PrimitiveType::LINE_STRIP, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(1.f,0.5f,1.f,1.f), drawingQueueCopy[h].model);
         }
     }
     
@@ -263,11 +374,11 @@ void OpenGLPipeline::DrawHelpers()
             if(drawingQueueCopy[h].type == RenderableType::SENSOR_CS)
                 content->DrawCoordSystem(drawingQueueCopy[h].model, 0.25f);
             else if(drawingQueueCopy[h].type == RenderableType::SENSOR_POINTS)
-                content->DrawPrimitives(PrimitiveType::POINTS, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(1.f,1.f,0,1.f), drawingQueueCopy[h].model);
+                content->DrawPrimitives(PrimitiveType::POINTS, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(1.f,1.f,0,1.f), drawingQueueCopy[h].model);
             else if(drawingQueueCopy[h].type == RenderableType::SENSOR_LINES)
-                content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(1.f,1.f,0,1.f), drawingQueueCopy[h].model);
+                content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(1.f,1.f,0,1.f), drawingQueueCopy[h].model);
             else if(drawingQueueCopy[h].type == RenderableType::SENSOR_LINE_STRIP)
-                content->DrawPrimitives(PrimitiveType::LINE_STRIP, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(1.f,1.f,0,1.f), drawingQueueCopy[h].model);
+                content->DrawPrimitives(PrimitiveType::LINE_STRIP, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(1.f,1.f,0,1.f), drawingQueueCopy[h].model);
         }
     }
     
@@ -277,7 +388,7 @@ void OpenGLPipeline::DrawHelpers()
         for(size_t h=0; h<drawingQueueCopy.size(); ++h)
         {
             if(drawingQueueCopy[h].type == RenderableType::ACTUATOR_LINES)
-                content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(1.f,0.5f,0,1.f), drawingQueueCopy[h].model);
+                content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(1.f,0.5f,0,1.f), drawingQueueCopy[h].model);
         }
     }
     
@@ -293,27 +404,27 @@ void OpenGLPipeline::DrawHelpers()
                     break;
                     
                 case RenderableType::HYDRO_CYLINDER:
-                    content->DrawCylinder(drawingQueueCopy[h].model, drawingQueueCopy[h].getDataAsPoints().get()->at(0), glm::vec4(0.2f, 0.5f, 1.f, 1.f));
+                    content->DrawCylinder(drawingQueueCopy[h].model, OpenGLHelperArena::getVertex(drawingQueueCopy[h].getDataAsHelperRange(), 0), glm::vec4(0.2f, 0.5f, 1.f, 1.f));
                     break;
                     
                 case RenderableType::HYDRO_ELLIPSOID:
-                    content->DrawEllipsoid(drawingQueueCopy[h].model, drawingQueueCopy[h].getDataAsPoints().get()->at(0), glm::vec4(0.2f, 0.5f, 1.f, 1.f));
+                    content->DrawEllipsoid(drawingQueueCopy[h].model, OpenGLHelperArena::getVertex(drawingQueueCopy[h].getDataAsHelperRange(), 0), glm::vec4(0.2f, 0.5f, 1.f, 1.f));
                     break;
                     
                 case RenderableType::HYDRO_POINTS:
-                    content->DrawPrimitives(PrimitiveType::POINTS, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(0.3f, 0.7f, 1.f, 1.f), drawingQueueCopy[h].model);
+                    content->DrawPrimitives(PrimitiveType::POINTS, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(0.3f, 0.7f, 1.f, 1.f), drawingQueueCopy[h].model);
                     break;
                     
                 case RenderableType::HYDRO_LINES:
-                    content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(0.2f, 0.5f, 1.f, 1.f), drawingQueueCopy[h].model);
+                    content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(0.2f, 0.5f, 1.f, 1.f), drawingQueueCopy[h].model);
                     break;
                     
                 case RenderableType::HYDRO_LINE_STRIP:
-                    content->DrawPrimitives(PrimitiveType::LINE_STRIP, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(0.2f, 0.5f, 1.f, 1.f), drawingQueueCopy[h].model);
+                    content->DrawPrimitives(PrimitiveType::LINE_STRIP, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(0.2f, 0.5f, 1.f, 1.f), drawingQueueCopy[h].model);
                     break;
 
                 case RenderableType::HYDRO_TRIANGLES:
-                    content->DrawPrimitives(PrimitiveType::TRIANGLES, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(0.2f, 0.5f, 1.f, 1.f), drawingQueueCopy[h].model);
+                    content->DrawPrimitives(PrimitiveType::TRIANGLES, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(0.2f, 0.5f, 1.f, 1.f), drawingQueueCopy[h].model);
                     break;
                     
                 default:
@@ -330,15 +441,15 @@ void OpenGLPipeline::DrawHelpers()
             switch(drawingQueueCopy[h].type)
             {
                 case RenderableType::FORCE_BUOYANCY:
-                    content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(0.f,0.f,1.f,1.f), drawingQueueCopy[h].model);
+                    content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(0.f,0.f,1.f,1.f), drawingQueueCopy[h].model);
                     break;
         
                 case RenderableType::FORCE_LINEAR_DRAG:
-                    content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(0.f,1.f,1.f,1.f), drawingQueueCopy[h].model);
+                    content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(0.f,1.f,1.f,1.f), drawingQueueCopy[h].model);
                     break;
                     
                 case RenderableType::FORCE_QUADRATIC_DRAG:
-                    content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsPoints().get(), glm::vec4(1.f,0.f,1.f,1.f), drawingQueueCopy[h].model);
+                    content->DrawPrimitives(PrimitiveType::LINES, drawingQueueCopy[h].getDataAsHelperRange(), glm::vec4(1.f,0.f,1.f,1.f), drawingQueueCopy[h].model);
                     break;
         
                 default:
@@ -357,6 +468,12 @@ void OpenGLPipeline::Render(SimulationManager* sim)
 
     //Double-buffering of drawing queue
     PerformDrawingQueueCopy(sim);
+    
+    //Stream meshes of paged terrains
+    Entity* ent;
+    for(unsigned int i=0; (ent = sim->getEntity(i)) != nullptr; ++i)
+        if(ent->getType() == EntityType::STATIC && ((StaticEntity*)ent)->getStaticType() == StaticEntityType::TILED_TERRAIN)
+            ((TiledTerrain*)ent)->UpdateGraphics(content);
 	
     //Choose rendering mode
     unsigned int renderMode = 0; //Defaults to rendering without ocean
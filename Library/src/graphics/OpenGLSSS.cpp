@@ -36,9 +36,6 @@
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 
-#define SSS_VRES_FACTOR 0.2f
-#define SSS_HRES_FACTOR 100.f
-
 namespace sf
 {
 
@@ -279,20 +276,26 @@ void OpenGLSSS::UpdateTransform()
     //Inform sonar to run callback
     if(newData_)
     {
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO_);
-        void* src = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src)
+        if(displayRead_)
         {
-            sonar_->NewDataReady(src, 0);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO_);
+            void* src = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+            if(src)
+            {
+                sonar_->NewDataReady(src, 0);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            }
         }
         
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO_);
-        src = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src)
+        if(outputRead_)
         {
-            sonar_->NewDataReady(src, 1);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO_);
+            void* src = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+            if(src)
+            {
+                sonar_->NewDataReady(src, 1);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            }
         }
         glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
         newData_ = false;
@@ -350,13 +353,15 @@ void OpenGLSSS::ComputeOutput(std::vector<Renderable>& objects)
     {
         //Compute matrices
         glm::mat4 VP = GetProjectionMatrix() * views_[i] * GetViewMatrix();
+        content->SetCullingFrustum(VP, GetEyePosition(), range_.y);
         //Clear color and depth for particular framebuffer layer
         glDrawBuffer(GL_COLOR_ATTACHMENT0 + (GLuint)i);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         //Draw objects
         for(size_t h=0; h<objects.size(); ++h)
         {
-            if(objects[h].type != RenderableType::SOLID)
+            if(objects[h].type != RenderableType::SOLID
+               || !content->isVisible(objects[h].objectId, objects[h].model))
                 continue;
             const Object& obj = content->getObject(objects[h].objectId);
             const Look& look = content->getLook(objects[h].lookId);
@@ -374,6 +379,7 @@ void OpenGLSSS::ComputeOutput(std::vector<Renderable>& objects)
             content->DrawObject(objects[h].objectId, objects[h].lookId, objects[h].model);
         }
     }
+    content->ResetCullingFrustum();
     glEnable(GL_DEPTH_CLAMP);
     OpenGLState::UnbindTexture(TEX_MAT_NORMAL);
     OpenGLState::BindFramebuffer(0);
@@ -422,17 +428,21 @@ void OpenGLSSS::ComputeOutput(std::vector<Renderable>& objects)
     glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
     glDispatchCompute((GLuint)ceilf(viewportWidth/2.f/64.f), 2, 1);
     
-    OpenGLState::BindFramebuffer(displayFBO_);
-    OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
-    glClear(GL_COLOR_BUFFER_BIT);
-    OpenGLState::BindTexture(TEX_POSTPROCESS2, GL_TEXTURE_2D, outputTex_[1-pingpong_ + 1]);
-    sonarVisualizeShader_[outputFormat_ == SonarOutputFormat::U32 ? 1 : 0]->Use();
-    sonarVisualizeShader_[outputFormat_ == SonarOutputFormat::U32 ? 1 : 0]->SetUniform("texSonarData", TEX_POSTPROCESS2);
-    sonarVisualizeShader_[outputFormat_ == SonarOutputFormat::U32 ? 1 : 0]->SetUniform("colorMap", static_cast<GLint>(cMap_));
-    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-    OpenGLState::BindVertexArray(displayVAO_);
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    OpenGLState::BindVertexArray(0);
+    //Color mapped display (skipped when not shown or subscribed)
+    if(sonar_ == nullptr || sonar_->isOutputRequired(VisionOutput::DISPLAY))
+    {
+        OpenGLState::BindFramebuffer(displayFBO_);
+        OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
+        glClear(GL_COLOR_BUFFER_BIT);
+        OpenGLState::BindTexture(TEX_POSTPROCESS2, GL_TEXTURE_2D, outputTex_[1-pingpong_ + 1]);
+        sonarVisualizeShader_[outputFormat_ == SonarOutputFormat::U32 ? 1 : 0]->Use();
+        sonarVisualizeShader_[outputFormat_ == SonarOutputFormat::U32 ? 1 : 0]->SetUniform("texSonarData", TEX_POSTPROCESS2);
+        sonarVisualizeShader_[outputFormat_ == SonarOutputFormat::U32 ? 1 : 0]->SetUniform("colorMap", static_cast<GLint>(cMap_));
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        OpenGLState::BindVertexArray(displayVAO_);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        OpenGLState::BindVertexArray(0);
+    }
     OpenGLState::BindFramebuffer(0);
     OpenGLState::UseProgram(0);
     OpenGLState::UnbindTexture(TEX_POSTPROCESS2);
@@ -469,29 +479,37 @@ void OpenGLSSS::DrawLDR(GLuint destinationFBO, bool updated)
     //Copy texture to sonar buffer
     if(sonar_ != nullptr && updated)
     {
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, outputTex_[pingpong_+1]);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO_);
-        switch (outputFormat_)
+        outputRead_ = sonar_->isOutputSubscribed(VisionOutput::RAW);
+        displayRead_ = sonar_->isOutputSubscribed(VisionOutput::DISPLAY);
+        if(outputRead_)
         {
-            case SonarOutputFormat::U8:
-                glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_BYTE, NULL);
-                break;
-            case SonarOutputFormat::U16:
-                glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_SHORT, NULL);
-                break;
-            case SonarOutputFormat::U32:
-                glGetTexImage(GL_TEXTURE_2D, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
-                break;
-            case SonarOutputFormat::F32:
-                glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, NULL);
-                break;
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, outputTex_[pingpong_+1]);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO_);
+            switch (outputFormat_)
+            {
+                case SonarOutputFormat::U8:
+                    glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_BYTE, NULL);
+                    break;
+                case SonarOutputFormat::U16:
+                    glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_SHORT, NULL);
+                    break;
+                case SonarOutputFormat::U32:
+                    glGetTexImage(GL_TEXTURE_2D, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+                    break;
+                case SonarOutputFormat::F32:
+                    glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, NULL);
+                    break;
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
         }
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, displayTex_);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO_);
-        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        if(displayRead_)
+        {
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, displayTex_);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO_);
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
         OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
         newData_ = true;
     }
@@ -49,6 +49,8 @@ OpenGLSegmentationCamera::OpenGLSegmentationCamera(glm::vec3 eyePosition, glm::v
     _needsUpdate = false;
     continuous = continuousUpdate;
     newData = false;
+    outputRead = false;
+    displayRead = false;
     camera = nullptr;
     this->range = range;
     
@@ -144,20 +146,26 @@ void OpenGLSegmentationCamera::UpdateTransform()
     //Inform camera to run callback
     if(newData)
     {
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
-        GLubyte* src = (GLubyte*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src)
+        if(displayRead)
         {
-            camera->NewDataReady(src, 0);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
+            GLubyte* src = (GLubyte*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+            if(src)
+            {
+                camera->NewDataReady(src, 0);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            }
         }
         
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
-        GLushort* src2 = (GLushort*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src2)
+        if(outputRead)
         {
-            camera->NewDataReady(src2, 1);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
+            GLushort* src2 = (GLushort*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+            if(src2)
+            {
+                camera->NewDataReady(src2, 1);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            }
         }
         glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
         newData = false;
@@ -291,16 +299,19 @@ void OpenGLSegmentationCamera::ComputeOutput(std::vector<Renderable>& objects, O
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->DrawSAQ();
     
     //Color mapped segmentation display
-    OpenGLState::BindFramebuffer(displayFBO);
-    OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
-    glClear(GL_COLOR_BUFFER_BIT);
-    OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, renderSegTex[1]);
-    segmentationVisualizeShader->Use();
-    segmentationVisualizeShader->SetUniform("texSeg", TEX_POSTPROCESS1);
-    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-    OpenGLState::BindVertexArray(displayVAO);
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    OpenGLState::BindVertexArray(0);
+    if(camera == nullptr || camera->isOutputRequired(VisionOutput::DISPLAY))
+    {
+        OpenGLState::BindFramebuffer(displayFBO);
+        OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
+        glClear(GL_COLOR_BUFFER_BIT);
+        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, renderSegTex[1]);
+        segmentationVisualizeShader->Use();
+        segmentationVisualizeShader->SetUniform("texSeg", TEX_POSTPROCESS1);
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        OpenGLState::BindVertexArray(displayVAO);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        OpenGLState::BindVertexArray(0);
+    }
     OpenGLState::BindFramebuffer(0);
     OpenGLState::UseProgram(0);
     OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
@@ -332,14 +343,22 @@ void OpenGLSegmentationCamera::DrawLDR(GLuint destinationFBO, bool updated)
     //Copy texture to camera buffer
     if(camera != nullptr && updated)
     {
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, renderSegTex[1]);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
-        glGetTexImage(GL_TEXTURE_2D, 0, GL_RED_INTEGER, GL_UNSIGNED_SHORT, NULL);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, displaySegTex);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
-        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        outputRead = camera->isOutputSubscribed(VisionOutput::RAW);
+        displayRead = camera->isOutputSubscribed(VisionOutput::DISPLAY);
+        if(outputRead)
+        {
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, renderSegTex[1]);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RED_INTEGER, GL_UNSIGNED_SHORT, NULL);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+        if(displayRead)
+        {
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, displaySegTex);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
         OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
         newData = true;
     }
@@ -46,6 +46,8 @@ OpenGLSonar::OpenGLSonar(glm::vec3 eyePosition, glm::vec3 direction, glm::vec3 s
     needsUpdate_ = false;
     continuous = false;
     newData_ = false;
+    outputRead_ = false;
+    displayRead_ = false;
     range_ = range;
     gain_ = 1.f;
     settingsUpdated_ = true;
@@ -43,6 +43,12 @@ OpenGLSpotLight::OpenGLSpotLight(glm::vec3 position, glm::vec3 direction, GLfloa
     GLfloat S = 2.f*M_PI*(1.f-cosf(coneAngle/2.f));
     colorLi = glm::vec4(color, lum/S);
     clipSpace = glm::mat4();
+    shadowFBO = 0;
+    shadowCacheFBO = 0;
+    shadowLayer = 0;
+    shadowVP = glm::mat4(0.f);
+    shadowFrame = 0;
+    shadowDynamic = false;
 	GLfloat near = getSourceRadius()/tanf(coneAngle/2.f);
     zNear = glm::max(0.05f, near);
     zFar = sqrtf(colorLi.a/MIN_INTENSITY_THRESHOLD);
@@ -79,6 +85,7 @@ OpenGLSpotLight::OpenGLSpotLight(glm::vec3 position, glm::vec3 direction, GLfloa
 OpenGLSpotLight::~OpenGLSpotLight()
 {
     if(shadowFBO != 0) glDeleteFramebuffers(1, &shadowFBO);
+    if(shadowCacheFBO != 0) glDeleteFramebuffers(1, &shadowCacheFBO);
 }
 
 void OpenGLSpotLight::InitShadowmap(GLint shadowmapLayer)
@@ -94,7 +101,19 @@ void OpenGLSpotLight::InitShadowmap(GLint shadowmapLayer)
     if(status != GL_FRAMEBUFFER_COMPLETE)
         printf("FBO initialization failed.\n");
     
+    //Create shadowmap cache framebuffer
+    glGenFramebuffers(1, &shadowCacheFBO);
+    OpenGLState::BindFramebuffer(shadowCacheFBO);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, spotShadowCacheArrayTex, 0, shadowmapLayer);
+    glReadBuffer(GL_NONE);
+    glDrawBuffer(GL_NONE);
+    
+    status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if(status != GL_FRAMEBUFFER_COMPLETE)
+        printf("FBO initialization failed.\n");
+    
     OpenGLState::BindFramebuffer(0);
+    shadowLayer = shadowmapLayer;
 }
 
 LightType OpenGLSpotLight::getType() const
@@ -158,18 +177,44 @@ void OpenGLSpotLight::BakeShadowmap(OpenGLPipeline* pipe)
                    0.f, 0.5f, 0.f, 0.f,
                    0.f, 0.f, 0.5f, 0.f,
                    0.5f, 0.5f, 0.5f, 1.f);
-    clipSpace = bias * (proj * view);
+    glm::mat4 VP = proj * view;
+    clipSpace = bias * VP;
+    
+    //Check what has to be rendered
+    bool cacheValid = shadowFrame > 0 && shadowFrame + 1 == pipe->getFrameCount() 
+                      && VP == shadowVP && pipe->isShadowCacheValid(VP);
+    bool dynamic = pipe->hasDynamicObjects(VP);
+    bool update = !cacheValid || dynamic || shadowDynamic;
+    shadowFrame = pipe->getFrameCount();
+    shadowVP = VP;
+    shadowDynamic = dynamic;
+    if(!update) //Nothing changed in the frustum
+        return;
     
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->SetProjectionMatrix(proj);
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->SetViewMatrix(view);
-    
-    OpenGLState::BindFramebuffer(shadowFBO);
     OpenGLState::Viewport(0, 0, SPOT_LIGHT_SHADOWMAP_SIZE, SPOT_LIGHT_SHADOWMAP_SIZE);
-    glClear(GL_DEPTH_BUFFER_BIT);
-    //glEnable(GL_POLYGON_OFFSET_FILL);
-    //glPolygonOffset(4.0f, 32.0f);
-    pipe->DrawObjects();
-    //glDisable(GL_POLYGON_OFFSET_FILL);
+    
+    //Render static objects to cache
+    if(!cacheValid)
+    {
+        OpenGLState::BindFramebuffer(shadowCacheFBO);
+        glClear(GL_DEPTH_BUFFER_BIT);
+        pipe->DrawObjects(ObjectFilter::STATIC);
+    }
+    
+    //Compose cached static objects with dynamic objects
+    glCopyImageSubData(spotShadowCacheArrayTex, GL_TEXTURE_2D_ARRAY, 0, 0, 0, shadowLayer,
+                       spotShadowArrayTex, GL_TEXTURE_2D_ARRAY, 0, 0, 0, shadowLayer,
+                       SPOT_LIGHT_SHADOWMAP_SIZE, SPOT_LIGHT_SHADOWMAP_SIZE, 1);
+    if(dynamic)
+    {
+        OpenGLState::BindFramebuffer(shadowFBO);
+        //glEnable(GL_POLYGON_OFFSET_FILL);
+        //glPolygonOffset(4.0f, 32.0f);
+        pipe->DrawObjects(ObjectFilter::DYNAMIC);
+        //glDisable(GL_POLYGON_OFFSET_FILL);
+    }
     OpenGLState::BindFramebuffer(0);
 }
 
@@ -42,7 +42,7 @@ GLSLShader* OpenGLThermalCamera::thermalOutputShader = nullptr;
 OpenGLThermalCamera::OpenGLThermalCamera(glm::vec3 eyePosition, glm::vec3 direction, glm::vec3 cameraUp,
                           GLint originX, GLint originY, GLint width, GLint height, GLfloat horizontalFOVDeg, 
                           glm::vec2 tempRange, glm::vec2 depthRange, bool continuousUpdate)
- : OpenGLView(originX, originY, width, height), camera(nullptr), _needsUpdate(false), newData(false), temperatureNoise(0.f), randDist(0.f, 1.f)
+ : OpenGLView(originX, originY, width, height), camera(nullptr), _needsUpdate(false), newData(false), outputRead(false), displayRead(false), temperatureNoise(0.f), randDist(0.f, 1.f)
 {
     continuous = continuousUpdate;
     this->depthRange = depthRange;
@@ -140,20 +140,26 @@ void OpenGLThermalCamera::UpdateTransform()
     //Inform camera to run callback
     if(newData)
     {
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
-        GLubyte* src = (GLubyte*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src)
+        if(displayRead)
         {
-            camera->NewDataReady(src, 0);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
+            GLubyte* src = (GLubyte*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+            if(src)
+            {
+                camera->NewDataReady(src, 0);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            }
         }
         
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
-        GLfloat* src2 = (GLfloat*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src2)
+        if(outputRead)
         {
-            camera->NewDataReady(src2, 1);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
+            GLfloat* src2 = (GLfloat*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+            if(src2)
+            {
+                camera->NewDataReady(src2, 1);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+            }
         }
         glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
         newData = false;
@@ -275,18 +281,21 @@ void OpenGLThermalCamera::ComputeOutput()
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->DrawSAQ();
     
     //Color mapped temperature display
-    OpenGLState::BindFramebuffer(displayFBO);
-    OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
-    glClear(GL_COLOR_BUFFER_BIT);
-    OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, renderTex[1]);
-    thermalVisualizeShader->Use();
-    thermalVisualizeShader->SetUniform("texTemperature", TEX_POSTPROCESS1);
-    thermalVisualizeShader->SetUniform("colorMap", (GLint)colorMap);
-    thermalVisualizeShader->SetUniform("displayRange", displayRange);
-    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-    OpenGLState::BindVertexArray(displayVAO);
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    OpenGLState::BindVertexArray(0);
+    if(camera == nullptr || camera->isOutputRequired(VisionOutput::DISPLAY))
+    {
+        OpenGLState::BindFramebuffer(displayFBO);
+        OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
+        glClear(GL_COLOR_BUFFER_BIT);
+        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, renderTex[1]);
+        thermalVisualizeShader->Use();
+        thermalVisualizeShader->SetUniform("texTemperature", TEX_POSTPROCESS1);
+        thermalVisualizeShader->SetUniform("colorMap", (GLint)colorMap);
+        thermalVisualizeShader->SetUniform("displayRange", displayRange);
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        OpenGLState::BindVertexArray(displayVAO);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        OpenGLState::BindVertexArray(0);
+    }
     OpenGLState::BindFramebuffer(0);
     OpenGLState::UseProgram(0);
     OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
@@ -319,14 +328,22 @@ void OpenGLThermalCamera::DrawLDR(GLuint destinationFBO, bool updated)
     //Copy texture to camera buffer
     if(camera != nullptr && updated)
     {
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, renderTex[1]);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
-        glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, NULL);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, displayTex);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
-        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        outputRead = camera->isOutputSubscribed(VisionOutput::RAW);
+        displayRead = camera->isOutputSubscribed(VisionOutput::DISPLAY);
+        if(outputRead)
+        {
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, renderTex[1]);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, NULL);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+        if(displayRead)
+        {
+            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, displayTex);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
         OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
         newData = true;
     }
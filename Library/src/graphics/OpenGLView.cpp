@@ -137,4 +137,15 @@ void OpenGLView::ExtractFrustumFromVP(glm::vec4 frustum[6], const glm::mat4& VP)
 	frustum[5] = glm::normalize(frustum[5]);
 }
 
+bool OpenGLView::SphereInFrustum(const glm::vec4 frustum[6], const glm::vec4& sphere)
+{
+    for(int i=0; i<6; ++i)
+    {
+        glm::vec4 plane = frustum[i] / glm::length(glm::vec3(frustum[i])); //Metric distance
+        if(glm::dot(glm::vec3(plane), glm::vec3(sphere)) + plane.w < -sphere.w)
+            return false;
+    }
+    return true;
+}
+
 }
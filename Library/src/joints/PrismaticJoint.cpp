@@ -26,6 +26,7 @@
 #include "joints/PrismaticJoint.h"
 
 #include "entities/SolidEntity.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -126,11 +127,13 @@ void PrismaticJoint::ApplyDamping()
 std::vector<Renderable> PrismaticJoint::Render()
 {
     std::vector<Renderable> items(0);
+    if(!OpenGLHelperArena::isEnabled(RenderableType::JOINT_LINES))
+        return items;
+    
     Renderable item;
     item.model = glm::mat4(1.f);
     item.type = RenderableType::JOINT_LINES;
-    item.data = std::make_shared<std::vector<glm::vec3>>();
-    auto points = item.getDataAsPoints();
+    auto& points = OpenGLHelperArena::Begin();
     
     btTypedConstraint* slider = getConstraint();
     Vector3 A = slider->getRigidBodyA().getCenterOfMassPosition();
@@ -144,14 +147,15 @@ std::vector<Renderable> PrismaticJoint::Render()
     Vector3 C1 = pivot + e1 * axis;
     Vector3 C2 = pivot + e2 * axis;
     
-    points->push_back(glm::vec3(A.getX(), A.getY(), A.getZ()));
-    points->push_back(glm::vec3(C1.getX(), C1.getY(), C1.getZ()));
-    points->push_back(glm::vec3(B.getX(), B.getY(), B.getZ()));
-    points->push_back(glm::vec3(C2.getX(), C2.getY(), C2.getZ()));
+    points.push_back(glm::vec3(A.getX(), A.getY(), A.getZ()));
+    points.push_back(glm::vec3(C1.getX(), C1.getY(), C1.getZ()));
+    points.push_back(glm::vec3(B.getX(), B.getY(), B.getZ()));
+    points.push_back(glm::vec3(C2.getX(), C2.getY(), C2.getZ()));
     
-    points->push_back(glm::vec3(C1.getX(), C1.getY(), C1.getZ()));
-    points->push_back(glm::vec3(C2.getX(), C2.getY(), C2.getZ()));
+    points.push_back(glm::vec3(C1.getX(), C1.getY(), C1.getZ()));
+    points.push_back(glm::vec3(C2.getX(), C2.getY(), C2.getZ()));
     
+    item.data = OpenGLHelperArena::Commit();
     items.push_back(item);
     return items;
 }
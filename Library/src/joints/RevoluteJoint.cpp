@@ -29,6 +29,7 @@
 #include "utils/GeometryFileUtil.h"
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -182,11 +183,13 @@ bool RevoluteJoint::SolvePositionIC(Scalar linearTolerance, Scalar angularTolera
 std::vector<Renderable> RevoluteJoint::Render()
 {
     std::vector<Renderable> items(0);
+    if(!OpenGLHelperArena::isEnabled(RenderableType::JOINT_LINES))
+        return items;
+    
     Renderable item;
     item.model = glm::mat4(1.f);
     item.type = RenderableType::JOINT_LINES;
-    item.data = std::make_shared<std::vector<glm::vec3>>();
-    auto points = item.getDataAsPoints();
+    auto& points = OpenGLHelperArena::Begin();
     
     btTypedConstraint* revo = getConstraint();
     Vector3 A = revo->getRigidBodyA().getCenterOfMassPosition();
@@ -197,9 +200,10 @@ std::vector<Renderable> RevoluteJoint::Render()
     //Calculate axis ends
     Vector3 C1 = pivot;
     Vector3 C2 = pivot + axis * btMax(0.05, btFabs((A-B).safeNorm())/Scalar(2));
-    points->push_back(glm::vec3(C1.getX(), C1.getY(), C1.getZ()));
-    points->push_back(glm::vec3(C2.getX(), C2.getY(), C2.getZ()));
+    points.push_back(glm::vec3(C1.getX(), C1.getY(), C1.getZ()));
+    points.push_back(glm::vec3(C2.getX(), C2.getY(), C2.getZ()));
     
+    item.data = OpenGLHelperArena::Commit();
     items.push_back(item);
     
     return items;
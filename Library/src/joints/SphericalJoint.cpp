@@ -28,6 +28,7 @@
 #include "BulletDynamics/Featherstone/btMultiBodyPoint2Point.h"
 #include "entities/SolidEntity.h"
 #include "entities/FeatherstoneEntity.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -130,25 +131,28 @@ void SphericalJoint::ApplyDamping()
 std::vector<Renderable> SphericalJoint::Render()
 {
     std::vector<Renderable> items(0);
+    if(!OpenGLHelperArena::isEnabled(RenderableType::JOINT_LINES))
+        return items;
+    
     btTypedConstraint* c = getConstraint();
     if(c != nullptr)
     {
         Renderable item;
         item.model = glm::mat4(1.f);
         item.type = RenderableType::JOINT_LINES;
-        item.data = std::make_shared<std::vector<glm::vec3>>();
-        auto points = item.getDataAsPoints();
+        auto& points = OpenGLHelperArena::Begin();
         
         btPoint2PointConstraint* p2p = (btPoint2PointConstraint*)getConstraint();
         Vector3 pivot = p2p->getRigidBodyA().getCenterOfMassTransform()(p2p->getPivotInA());
         Vector3 A = p2p->getRigidBodyA().getCenterOfMassPosition();
         Vector3 B = p2p->getRigidBodyB().getCenterOfMassPosition();
         
-        points->push_back(glm::vec3(A.getX(), A.getY(), A.getZ()));
-        points->push_back(glm::vec3(pivot.getX(), pivot.getY(), pivot.getZ()));
-        points->push_back(glm::vec3(B.getX(), B.getY(), B.getZ()));
-        points->push_back(glm::vec3(pivot.getX(), pivot.getY(), pivot.getZ()));
+        points.push_back(glm::vec3(A.getX(), A.getY(), A.getZ()));
+        points.push_back(glm::vec3(pivot.getX(), pivot.getY(), pivot.getZ()));
+        points.push_back(glm::vec3(B.getX(), B.getY(), B.getZ()));
+        points.push_back(glm::vec3(pivot.getX(), pivot.getY(), pivot.getZ()));
         
+        item.data = OpenGLHelperArena::Commit();
         items.push_back(item);
     }
     return items;
@@ -28,6 +28,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "entities/SolidEntity.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -100,18 +101,21 @@ JointType SpringJoint::getType() const
 std::vector<Renderable> SpringJoint::Render()
 {
     std::vector<Renderable> items(0);
+    if(!OpenGLHelperArena::isEnabled(RenderableType::JOINT_LINES))
+        return items;
+    
     btGeneric6DofSpring2Constraint* c = (btGeneric6DofSpring2Constraint*)getConstraint();
     if(c != nullptr)
     {
         Renderable item;
         item.model = glm::mat4(1.f);
         item.type = RenderableType::JOINT_LINES;
-        item.data = std::make_shared<std::vector<glm::vec3>>();
-        auto points = item.getDataAsPoints();
+        auto& points = OpenGLHelperArena::Begin();
         Vector3 A = (c->getRigidBodyA().getCenterOfMassTransform() * c->getFrameOffsetA()).getOrigin();
         Vector3 B = (c->getRigidBodyB().getCenterOfMassTransform() * c->getFrameOffsetB()).getOrigin();   
-        points->push_back(glm::vec3(A.getX(), A.getY(), A.getZ()));
-        points->push_back(glm::vec3(B.getX(), B.getY(), B.getZ()));
+        points.push_back(glm::vec3(A.getX(), A.getY(), A.getZ()));
+        points.push_back(glm::vec3(B.getX(), B.getY(), B.getZ()));
+        item.data = OpenGLHelperArena::Commit();
         items.push_back(item);    
     }
     return items;
@@ -30,6 +30,7 @@
 #include "graphics/OpenGLPipeline.h"
 #include "entities/SolidEntity.h"
 #include "utils/ScientificFileUtil.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -176,7 +177,7 @@ std::vector<Renderable> Contact::Render()
 {
     std::vector<Renderable> items(0);
     
-    if(points.size() == 0)
+    if(points.size() == 0 || !OpenGLHelperArena::isEnabled(RenderableType::SENSOR_LINES))
         return items;
     
     //Drawing points
@@ -189,7 +190,7 @@ std::vector<Renderable> Contact::Render()
     OpenGLContent::getInstance()->DrawPrimitives(PrimitiveType::POINTS, vertices, CONTACT_COLOR);*/
     
     //Drawing lines
-    std::vector<glm::vec3> vertices;
+    auto& vertices = OpenGLHelperArena::Begin();
     
     if(displayMask & CONTACT_DISPLAY_LAST_SLIP_VELOCITY_A)
     {
@@ -234,8 +235,7 @@ std::vector<Renderable> Contact::Render()
         Renderable item;
         item.model = glm::mat4(1.f);
         item.type = RenderableType::SENSOR_LINES;
-        item.data = std::make_shared<std::vector<glm::vec3>>();
-        *item.getDataAsPoints() = vertices;
+        item.data = OpenGLHelperArena::Commit();
         items.push_back(item);
     }
         
@@ -245,15 +245,15 @@ std::vector<Renderable> Contact::Render()
         Renderable item;
         item.model = glm::mat4(1.f);
         item.type = RenderableType::SENSOR_POINTS;
-        item.data = std::make_shared<std::vector<glm::vec3>>();
-        auto itemPoints = item.getDataAsPoints();
+        auto& itemPoints = OpenGLHelperArena::Begin();
         
         for(size_t i = 0; i < points.size(); ++i)
         {	
             Vector3 p = points[i].locationA;
-            itemPoints->push_back(glm::vec3((GLfloat)p.getX(), (GLfloat)p.getY(), (GLfloat)p.getZ()));
+            itemPoints.push_back(glm::vec3((GLfloat)p.getX(), (GLfloat)p.getY(), (GLfloat)p.getZ()));
         }
         
+        item.data = OpenGLHelperArena::Commit();
         items.push_back(item);
     }
     
@@ -262,15 +262,15 @@ std::vector<Renderable> Contact::Render()
         Renderable item;
         item.model = glm::mat4(1.f);
         item.type = RenderableType::SENSOR_POINTS;
-        item.data = std::make_shared<std::vector<glm::vec3>>();
-        auto itemPoints = item.getDataAsPoints();
+        auto& itemPoints = OpenGLHelperArena::Begin();
         
         for(size_t i = 0; i < points.size(); ++i)
         {	
             Vector3 p = points[i].locationB;
-            itemPoints->push_back(glm::vec3((GLfloat)p.getX(), (GLfloat)p.getY(), (GLfloat)p.getZ()));
+            itemPoints.push_back(glm::vec3((GLfloat)p.getX(), (GLfloat)p.getY(), (GLfloat)p.getZ()));
         }
         
+        item.data = OpenGLHelperArena::Commit();
         items.push_back(item);
     }
     
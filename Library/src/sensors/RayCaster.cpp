@@ -0,0 +1,343 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RayCaster.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "sensors/RayCaster.h"
+
+#include <algorithm>
+#include "BulletSoftBody/btSoftMultiBodyDynamicsWorld.h"
+#include "core/SimulationApp.h"
+#include "core/SimulationManager.h"
+
+namespace sf
+{
+
+//Exact intersection with the most common primitive shapes, avoiding the iterative convex cast (returns false if shape not supported)
+static bool RayTestPrimitive(const btCollisionObject* co, const Vector3& from, const Vector3& to, Scalar& fraction, Vector3& normal)
+{
+    const btCollisionShape* shape = co->getCollisionShape();
+    const Transform& trans = co->getWorldTransform();
+    fraction = Scalar(1);
+    
+    switch(shape->getShapeType())
+    {
+        case SPHERE_SHAPE_PROXYTYPE:
+        {
+            Scalar r = ((const btSphereShape*)shape)->getRadius();
+            Vector3 d = to - from;
+            Vector3 oc = from - trans.getOrigin();
+            Scalar a = d.dot(d);
+            Scalar b = oc.dot(d);
+            Scalar c = oc.dot(oc) - r*r;
+            Scalar disc = b*b - a*c;
+            if(c < Scalar(0) || b >= Scalar(0) || disc < Scalar(0)) //Inside, moving away or missing
+                return true;
+            Scalar t = (-b - btSqrt(disc))/a;
+            if(t <= Scalar(1))
+            {
+                fraction = t;
+                normal = (oc + d * t).normalized();
+            }
+        }
+            return true;
+            
+        case BOX_SHAPE_PROXYTYPE:
+        {
+            Vector3 half = ((const btBoxShape*)shape)->getHalfExtentsWithMargin();
+            Vector3 lFrom = trans.invXform(from);
+            Vector3 lDir = trans.getBasis().transpose() * (to - from);
+            Scalar tEnter(-BT_LARGE_FLOAT);
+            Scalar tExit(BT_LARGE_FLOAT);
+            int axis = -1;
+            for(int i=0; i<3; ++i)
+            {
+                if(btFabs(lDir[i]) < SIMD_EPSILON)
+                {
+                    if(btFabs(lFrom[i]) > half[i])
+                        return true;
+                    continue;
+                }
+                Scalar t1 = (-half[i] - lFrom[i])/lDir[i];
+                Scalar t2 = (half[i] - lFrom[i])/lDir[i];
+                if(t1 > t2) btSwap(t1, t2);
+                if(t1 > tEnter) { tEnter = t1; axis = i; }
+                tExit = btMin(tExit, t2);
+            }
+            if(axis < 0 || tEnter > tExit || tEnter < Scalar(0) || tEnter > Scalar(1)) //Inside or missing
+                return true;
+            fraction = tEnter;
+            Vector3 lNormal(0,0,0);
+            lNormal[axis] = lDir[axis] > Scalar(0) ? Scalar(-1) : Scalar(1);
+            normal = trans.getBasis() * lNormal;
+        }
+            return true;
+            
+        case STATIC_PLANE_PROXYTYPE:
+        {
+            const btStaticPlaneShape* plane = (const btStaticPlaneShape*)shape;
+            const Vector3& n = plane->getPlaneNormal();
+            Scalar dA = n.dot(trans.invXform(from)) - plane->getPlaneConstant();
+            Scalar dB = n.dot(trans.invXform(to)) - plane->getPlaneConstant();
+            if(dA * dB >= Scalar(0)) //Not crossing
+                return true;
+            fraction = dA/(dA - dB);
+            normal = trans.getBasis() * (dA > Scalar(0) ? n : -n);
+        }
+            return true;
+            
+        default:
+            return false;
+    }
+}
+
+RayCaster::RayCaster()
+{
+}
+
+void RayCaster::Update(const Vector3& center, Scalar radius)
+{
+    leaves.clear();
+    nodes.clear();
+    unbounded.clear();
+    
+    //Collect objects overlapping the region of interest
+    Vector3 rMin = center - Vector3(radius, radius, radius);
+    Vector3 rMax = center + Vector3(radius, radius, radius);
+    btCollisionObjectArray& objects = SimulationApp::getApp()->getSimulationManager()->getDynamicsWorld()->getCollisionObjectArray();
+    
+    for(int i=0; i<objects.size(); ++i)
+    {
+        btCollisionObject* co = objects[i];
+        if(co->getInternalType() == btCollisionObject::CO_GHOST_OBJECT) //Force fields
+            continue;
+        
+        Leaf leaf;
+        leaf.object = co;
+        co->getCollisionShape()->getAabb(co->getWorldTransform(), leaf.aabbMin, leaf.aabbMax); //Current pose (broadphase may be one step behind)
+        if(!TestAabbAgainstAabb2(leaf.aabbMin, leaf.aabbMax, rMin, rMax))
+            continue;
+        
+        leaves.push_back(leaf);
+    }
+    
+    //Planes and other huge objects are moved to the end and tested by every ray
+    auto isBounded = [](const Leaf& l)
+    {
+        Vector3 size = l.aabbMax - l.aabbMin;
+        return size[size.maxAxis()] <= Scalar(1e6);
+    };
+    int nBounded = (int)(std::stable_partition(leaves.begin(), leaves.end(), isBounded) - leaves.begin());
+    for(int i=nBounded; i<(int)leaves.size(); ++i)
+        unbounded.push_back(i);
+    
+    //Build top-level tree over bounded objects
+    
+    if(nBounded > 0)
+    {
+        nodes.reserve(2*nBounded);
+        Build(0, nBounded);
+    }
+}
+
+int RayCaster::Build(int first, int count)
+{
+    int id = (int)nodes.size();
+    nodes.push_back(Node());
+    
+    Vector3 aabbMin = leaves[first].aabbMin;
+    Vector3 aabbMax = leaves[first].aabbMax;
+    Vector3 cMin = (leaves[first].aabbMin + leaves[first].aabbMax)/Scalar(2);
+    Vector3 cMax = cMin;
+    for(int i=first+1; i<first+count; ++i)
+    {
+        aabbMin.setMin(leaves[i].aabbMin);
+        aabbMax.setMax(leaves[i].aabbMax);
+        Vector3 c = (leaves[i].aabbMin + leaves[i].aabbMax)/Scalar(2);
+        cMin.setMin(c);
+        cMax.setMax(c);
+    }
+    nodes[id].aabbMin = aabbMin;
+    nodes[id].aabbMax = aabbMax;
+    nodes[id].first = first;
+    nodes[id].count = count;
+    nodes[id].left = -1;
+    nodes[id].right = -1;
+    
+    if(count <= 2)
+        return id;
+    
+    //Median split along the longest axis of centroids
+    int axis = (cMax - cMin).maxAxis();
+    int half = count/2;
+    std::nth_element(leaves.begin() + first, leaves.begin() + first + half, leaves.begin() + first + count,
+                     [axis](const Leaf& a, const Leaf& b)
+                     {
+                         return a.aabbMin[axis] + a.aabbMax[axis] < b.aabbMin[axis] + b.aabbMax[axis];
+                     });
+    
+    int left = Build(first, half);
+    int right = Build(first + half, count - half);
+    nodes[id].left = left;
+    nodes[id].right = right;
+    return id;
+}
+
+void RayCaster::Query(const Vector3& aabbMin, const Vector3& aabbMax, std::vector<int>& leafIds) const
+{
+    leafIds = unbounded;
+    if(nodes.empty())
+        return;
+    
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while(top > 0)
+    {
+        const Node& node = nodes[stack[--top]];
+        if(!TestAabbAgainstAabb2(node.aabbMin, node.aabbMax, aabbMin, aabbMax))
+            continue;
+        
+        if(node.left < 0)
+        {
+            for(int i=node.first; i<node.first+node.count; ++i)
+                if(TestAabbAgainstAabb2(leaves[i].aabbMin, leaves[i].aabbMax, aabbMin, aabbMax))
+                    leafIds.push_back(i);
+        }
+        else
+        {
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+        }
+    }
+}
+
+void RayCaster::CastRays(unsigned int width, unsigned int height, const RayGenerator& generator, std::vector<RayHit>& hits) const
+{
+    hits.resize((size_t)width * height);
+    unsigned int tilesX = (width + RAYCASTER_TILE_SIZE - 1)/RAYCASTER_TILE_SIZE;
+    unsigned int tilesY = (height + RAYCASTER_TILE_SIZE - 1)/RAYCASTER_TILE_SIZE;
+    ThreadPool* threads = SimulationApp::getApp()->getPhysicsThreadPool();
+    
+    for(unsigned int ty=0; ty<tilesY; ++ty)
+    {
+        if(threads != nullptr)
+        {
+            threads->enqueue([this, ty, tilesX, width, height, &generator, &hits]()
+            {
+                for(unsigned int tx=0; tx<tilesX; ++tx)
+                    CastTile(tx * RAYCASTER_TILE_SIZE, ty * RAYCASTER_TILE_SIZE, width, height, generator, hits);
+            });
+        }
+        else
+        {
+            for(unsigned int tx=0; tx<tilesX; ++tx)
+                CastTile(tx * RAYCASTER_TILE_SIZE, ty * RAYCASTER_TILE_SIZE, width, height, generator, hits);
+        }
+    }
+    
+    if(threads != nullptr)
+        threads->waitAll();
+}
+
+void RayCaster::CastTile(unsigned int x0, unsigned int y0, unsigned int width, unsigned int height, 
+                         const RayGenerator& generator, std::vector<RayHit>& hits) const
+{
+    unsigned int x1 = std::min(x0 + RAYCASTER_TILE_SIZE, width);
+    unsigned int y1 = std::min(y0 + RAYCASTER_TILE_SIZE, height);
+    
+    //Generate rays of the tile
+    Vector3 from[RAYCASTER_TILE_SIZE * RAYCASTER_TILE_SIZE];
+    Vector3 to[RAYCASTER_TILE_SIZE * RAYCASTER_TILE_SIZE];
+    Vector3 tMin(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+    Vector3 tMax(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+    unsigned int n = 0;
+    for(unsigned int y=y0; y<y1; ++y)
+        for(unsigned int x=x0; x<x1; ++x, ++n)
+        {
+            generator(x, y, from[n], to[n]);
+            tMin.setMin(from[n]);
+            tMin.setMin(to[n]);
+            tMax.setMax(from[n]);
+            tMax.setMax(to[n]);
+        }
+    
+    //Cull objects for the whole tile
+    std::vector<int> candidates;
+    Query(tMin, tMax, candidates);
+    
+    //Cast rays against candidates
+    n = 0;
+    for(unsigned int y=y0; y<y1; ++y)
+        for(unsigned int x=x0; x<x1; ++x, ++n)
+        {
+            RayHit& hit = hits[(size_t)y * width + x];
+            hit.fraction = Scalar(1);
+            hit.normal = V0();
+            hit.object = nullptr;
+            if(candidates.empty())
+                continue;
+            
+            Vector3 dir = to[n] - from[n];
+            Vector3 invDir(dir.getX() != Scalar(0) ? Scalar(1)/dir.getX() : BT_LARGE_FLOAT,
+                           dir.getY() != Scalar(0) ? Scalar(1)/dir.getY() : BT_LARGE_FLOAT,
+                           dir.getZ() != Scalar(0) ? Scalar(1)/dir.getZ() : BT_LARGE_FLOAT);
+            unsigned int signs[3] = {invDir.getX() < Scalar(0), invDir.getY() < Scalar(0), invDir.getZ() < Scalar(0)};
+            Transform rayFrom(Quaternion::getIdentity(), from[n]);
+            Transform rayTo(Quaternion::getIdentity(), to[n]);
+            btCollisionWorld::ClosestRayResultCallback closest(from[n], to[n]);
+            
+            for(size_t i=0; i<candidates.size(); ++i)
+            {
+                const Leaf& leaf = leaves[candidates[i]];
+                Vector3 bounds[2] = {leaf.aabbMin, leaf.aabbMax};
+                Scalar tNear;
+                if(!btRayAabb2(from[n], invDir, signs, bounds, tNear, Scalar(0), closest.m_closestHitFraction))
+                    continue;
+                
+                Scalar fraction;
+                Vector3 normal;
+                if(RayTestPrimitive(leaf.object, from[n], to[n], fraction, normal))
+                {
+                    if(fraction < closest.m_closestHitFraction)
+                    {
+                        closest.m_closestHitFraction = fraction;
+                        closest.m_hitNormalWorld = normal;
+                        closest.m_collisionObject = leaf.object;
+                    }
+                }
+                else
+                    btSoftMultiBodyDynamicsWorld::rayTestSingle(rayFrom, rayTo, leaf.object, leaf.object->getCollisionShape(), 
+                                                                leaf.object->getWorldTransform(), closest);
+            }
+            
+            if(closest.hasHit())
+            {
+                hit.fraction = closest.m_closestHitFraction;
+                hit.normal = closest.m_hitNormalWorld;
+                hit.object = closest.m_collisionObject;
+            }
+        }
+}
+
+}
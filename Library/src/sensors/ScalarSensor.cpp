@@ -54,6 +54,11 @@ Sample ScalarSensor::getLastSample() const
         return Sample(std::vector<Scalar>(getNumOfChannels(), Scalar(0)), true);
 }
 
+uint64_t ScalarSensor::getNumOfSamples() const
+{
+    return sampleCount;
+}
+
 const std::vector<Sample>* ScalarSensor::getHistory()
 {
     SDL_LockMutex(updateMutex);
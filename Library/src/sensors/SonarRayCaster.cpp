@@ -0,0 +1,132 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SonarRayCaster.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "sensors/SonarRayCaster.h"
+
+#include "entities/StaticEntity.h"
+#include "entities/MovingEntity.h"
+
+namespace sf
+{
+
+//Restitution of the material of the body owning the collision object (no echo from unknown objects)
+static Scalar getRestitution(const btCollisionObject* co)
+{
+    Entity* ent = (Entity*)co->getUserPointer();
+    if(ent == nullptr)
+        return Scalar(0);
+    
+    switch(ent->getType())
+    {
+        case EntityType::STATIC:
+            return ((StaticEntity*)ent)->getMaterial().restitution;
+            
+        case EntityType::SOLID:
+        case EntityType::ANIMATED:
+            return ((MovingEntity*)ent)->getMaterial().restitution;
+            
+        default:
+            return Scalar(0);
+    }
+}
+
+SonarRayCaster::SonarRayCaster()
+{
+}
+
+void SonarRayCaster::CastEchoes(const Vector3& origin, unsigned int width, unsigned int height, const RayGenerator& generator, std::vector<SonarEcho>& echoes)
+{
+    std::vector<Vector3> from(width * height);
+    std::vector<Vector3> to(width * height);
+    CastRays(width, height, [&](unsigned int x, unsigned int y, Vector3& f, Vector3& t)
+    {
+        generator(x, y, f, t);
+        from[y * width + x] = f;
+        to[y * width + x] = t;
+    }, hits);
+    
+    echoes.resize(hits.size());
+    const btCollisionObject* lastObject = nullptr;
+    Scalar restitution(0);
+    
+    for(size_t i=0; i<hits.size(); ++i)
+    {
+        if(hits[i].object == nullptr)
+        {
+            echoes[i].range = -1.f;
+            echoes[i].intensity = 0.f;
+            continue;
+        }
+        
+        if(hits[i].object != lastObject) //Consecutive rays tend to hit the same body
+        {
+            lastObject = hits[i].object;
+            restitution = getRestitution(lastObject);
+        }
+        
+        Vector3 toEye = origin - (from[i] + (to[i] - from[i]) * hits[i].fraction);
+        Scalar len = toEye.length();
+        Scalar cosInc = len > Scalar(0) ? hits[i].normal.dot(toEye)/len : Scalar(1);
+        echoes[i].range = (GLfloat)len;
+        echoes[i].intensity = (GLfloat)(btClamped(cosInc, Scalar(0), Scalar(1)) * restitution);
+    }
+}
+
+size_t SonarRayCaster::getSampleSize(SonarOutputFormat format)
+{
+    switch(format)
+    {
+        case SonarOutputFormat::U8:
+            return sizeof(GLubyte);
+        case SonarOutputFormat::U16:
+            return sizeof(GLushort);
+        case SonarOutputFormat::U32:
+            return sizeof(GLuint);
+        case SonarOutputFormat::F32:
+        default:
+            return sizeof(GLfloat);
+    }
+}
+
+void SonarRayCaster::StoreSample(void* data, size_t index, GLfloat value, SonarOutputFormat format)
+{
+    switch(format)
+    {
+        case SonarOutputFormat::U8:
+            ((GLubyte*)data)[index] = (GLubyte)roundf(value * 255.f);
+            break;
+        case SonarOutputFormat::U16:
+            ((GLushort*)data)[index] = (GLushort)roundf(value * 65535.f);
+            break;
+        case SonarOutputFormat::U32:
+            ((GLuint*)data)[index] = (GLuint)((double)value * 4294967295.0);
+            break;
+        case SonarOutputFormat::F32:
+            ((GLfloat*)data)[index] = value;
+            break;
+    }
+}
+
+}
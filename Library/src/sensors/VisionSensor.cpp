@@ -35,11 +35,12 @@ namespace sf
 
 VisionSensor::VisionSensor(std::string uniqueName, Scalar frequency) : Sensor(uniqueName, frequency)
 {
-    if(!SimulationApp::getApp()->hasGraphics())
-        cCritical("Not possible to use vision sensors in console simulation! Use graphical simulation if possible.");
-    
     attach = nullptr;
     o2s = Transform::getIdentity();
+    subscribers[0] = 0;
+    subscribers[1] = 0;
+    callbackOutputs[0] = false;
+    callbackOutputs[1] = false;
 }
 
 VisionSensor::~VisionSensor()
@@ -51,6 +52,41 @@ void VisionSensor::setRelativeSensorFrame(const Transform& origin)
     o2s = origin;
 }
 
+void VisionSensor::SubscribeOutput(VisionOutput output)
+{
+    ++subscribers[(size_t)output];
+}
+
+void VisionSensor::UnsubscribeOutput(VisionOutput output)
+{
+    unsigned int count = subscribers[(size_t)output].load();
+    while(count > 0 && !subscribers[(size_t)output].compare_exchange_weak(count, count - 1)) {}
+}
+
+bool VisionSensor::isOutputSubscribed(VisionOutput output) const
+{
+    return subscribers[(size_t)output].load() > 0;
+}
+
+void VisionSensor::SubscribeCallbackOutputs(bool installed, bool display)
+{
+    //Subscribe before unsubscribing, so that a replaced callback does not miss a frame
+    bool outputs[2] = {installed, installed && display};
+    for(size_t i=0; i<2; ++i)
+    {
+        if(outputs[i] && !callbackOutputs[i])
+            SubscribeOutput((VisionOutput)i);
+        else if(!outputs[i] && callbackOutputs[i])
+            UnsubscribeOutput((VisionOutput)i);
+        callbackOutputs[i] = outputs[i];
+    }
+}
+
+bool VisionSensor::isOutputRequired(VisionOutput output) const
+{
+    return isOutputSubscribed(output);
+}
+
 Transform VisionSensor::getSensorFrame() const
 {
     if(attach != nullptr)
@@ -83,13 +119,30 @@ SensorType VisionSensor::getType() const
     return SensorType::VISION;
 }
 
+bool VisionSensor::InitHeadless()
+{
+    return false;
+}
+
+bool VisionSensor::Init()
+{
+    if(!SimulationApp::getApp()->hasGraphics())
+    {
+        if(!InitHeadless())
+            cCritical("Vision sensor '%s' is not supported in console simulation! Use graphical simulation if possible.", getName().c_str());
+        return false; //No particles in console simulation
+    }
+    
+    bool seesParticles = false;
+    InitGraphics(seesParticles);
+    return seesParticles && SimulationApp::getApp()->getSimulationManager()->isOceanEnabled();
+}
+
 void VisionSensor::AttachToWorld(const Transform& origin)
 {
     attach = nullptr;
     o2s = origin;
-    bool seesParticles = false;
-    InitGraphics(seesParticles);
-    if(seesParticles && SimulationApp::getApp()->getSimulationManager()->isOceanEnabled())
+    if(Init())
         SimulationApp::getApp()->getSimulationManager()->getOcean()->getOpenGLOcean()->AllocateParticles(getOpenGLView());
 }
 
@@ -99,9 +152,7 @@ void VisionSensor::AttachToStatic(StaticEntity* body, const Transform& origin)
     {
         attach = body;
         o2s = origin;
-        bool seesParticles = false;
-        InitGraphics(seesParticles);
-        if(seesParticles && SimulationApp::getApp()->getSimulationManager()->isOceanEnabled())
+        if(Init())
             SimulationApp::getApp()->getSimulationManager()->getOcean()->getOpenGLOcean()->AllocateParticles(getOpenGLView());
     }
 }
@@ -112,10 +163,7 @@ void VisionSensor::AttachToSolid(MovingEntity* body, const Transform& origin)
     {
         attach = body;
         o2s = origin;
-        bool seesParticles = false;
-        InitGraphics(seesParticles);
-
-        if(seesParticles && SimulationApp::getApp()->getSimulationManager()->isOceanEnabled())
+        if(Init())
             SimulationApp::getApp()->getSimulationManager()->getOcean()->getOpenGLOcean()->AssignParticles(getOpenGLView(), body->getOceanParticles());
     }
 }
@@ -30,6 +30,7 @@
 #include "core/NED.h"
 #include "entities/MovingEntity.h"
 #include "sensors/Sample.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -237,7 +238,7 @@ ScalarSensorType INS::getScalarSensorType() const
 std::vector<Renderable> INS::Render()
 {
     std::vector<Renderable> items = LinkSensor::Render();
-    if(isRenderable())
+    if(isRenderable() && OpenGLHelperArena::isEnabled(RenderableType::SENSOR_LINES))
     {
         Renderable item1;
         item1.type = RenderableType::SENSOR_CS;
@@ -247,10 +248,10 @@ std::vector<Renderable> INS::Render()
         Renderable item2;
         item2.type = RenderableType::SENSOR_LINES;
         item2.model = glMatrixFromTransform(getSensorFrame());
-        item2.data = std::make_shared<std::vector<glm::vec3>>();
-        auto points = item2.getDataAsPoints();
-        points->push_back(glm::vec3(0.f));
-        points->push_back(glVectorFromVector(out.getOrigin()));
+        auto& points = OpenGLHelperArena::Begin();
+        points.push_back(glm::vec3(0.f));
+        points.push_back(glVectorFromVector(out.getOrigin()));
+        item2.data = OpenGLHelperArena::Commit();
         items.push_back(item2);
     }
     return items;
@@ -31,6 +31,7 @@
 #include "utils/UnitSystem.h"
 #include "sensors/Sample.h"
 #include "graphics/OpenGLPipeline.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -86,19 +87,19 @@ void Multibeam::InternalUpdate(Scalar dt)
 std::vector<Renderable> Multibeam::Render()
 {
     std::vector<Renderable> items = Sensor::Render();
-    if(isRenderable())
+    if(isRenderable() && OpenGLHelperArena::isEnabled(RenderableType::SENSOR_LINES))
     {
         Renderable item;
         item.type = RenderableType::SENSOR_LINES;
         item.model = glMatrixFromTransform(getSensorFrame());    
-        item.data = std::make_shared<std::vector<glm::vec3>>();
-        auto points = item.getDataAsPoints();
+        auto& points = OpenGLHelperArena::Begin();
         for(unsigned int i=0; i <= angSteps; ++i)
         {
             Vector3 dir = Vector3(1, 0, 0) * btCos(angles[i]) + Vector3(0, 1, 0) * btSin(angles[i]);
-            points->push_back(glm::vec3(0,0,0));
-            points->push_back(glm::vec3(dir.x() * distances[i], dir.y() * distances[i], dir.z() * distances[i]));
+            points.push_back(glm::vec3(0,0,0));
+            points.push_back(glm::vec3(dir.x() * distances[i], dir.y() * distances[i], dir.z() * distances[i]));
         }        
+        item.data = OpenGLHelperArena::Commit();
         items.push_back(item);
     }
     return items;
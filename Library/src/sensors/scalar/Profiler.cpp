@@ -31,6 +31,7 @@
 #include "utils/UnitSystem.h"
 #include "sensors/Sample.h"
 #include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -101,7 +102,7 @@ void Profiler::InternalUpdate(Scalar dt)
 std::vector<Renderable> Profiler::Render()
 {
     std::vector<Renderable> items = Sensor::Render();
-    if(isRenderable())
+    if(isRenderable() && OpenGLHelperArena::isEnabled(RenderableType::SENSOR_LINES))
     {
         Scalar currentAngle = currentAngStep/(Scalar)angSteps * angRange - Scalar(0.5) * angRange;
         Vector3 dir = Vector3(1, 0, 0) * btCos(currentAngle) + Vector3(0, 1, 0) * btSin(currentAngle);
@@ -109,10 +110,10 @@ std::vector<Renderable> Profiler::Render()
         Renderable item;
         item.type = RenderableType::SENSOR_LINES;
         item.model = glMatrixFromTransform(getSensorFrame());
-        item.data = std::make_shared<std::vector<glm::vec3>>();
-        auto points = item.getDataAsPoints();
-        points->push_back(glm::vec3(0,0,0));
-        points->push_back(glm::vec3(dir.x()*distance, dir.y()*distance, dir.z()*distance));
+        auto& points = OpenGLHelperArena::Begin();
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(dir.x()*distance, dir.y()*distance, dir.z()*distance));
+        item.data = OpenGLHelperArena::Commit();
         items.push_back(item);
     }
     return items;
@@ -26,6 +26,7 @@
 #include "sensors/vision/Camera.h"
 
 #include "entities/SolidEntity.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -61,6 +62,11 @@ void Camera::setDisplayOnScreen(bool display, unsigned int x, unsigned int y, fl
     screenScale = scale;
 }
 
+bool Camera::isOutputRequired(VisionOutput output) const
+{
+    return isOutputSubscribed(output) || (output == VisionOutput::DISPLAY && screen);
+}
+
 bool Camera::getDisplayOnScreen(unsigned int& x, unsigned int& y, float& scale) const
 {
     x = screenX;
@@ -81,13 +87,12 @@ void Camera::UpdateTransform()
 std::vector<Renderable> Camera::Render()
 {
     std::vector<Renderable> items = Sensor::Render();
-    if(isRenderable())
+    if(isRenderable() && OpenGLHelperArena::isEnabled(RenderableType::SENSOR_LINES))
     {
         Renderable item;
         item.model = glMatrixFromTransform(getSensorFrame());
         item.type = RenderableType::SENSOR_LINES;
-        item.data = std::make_shared<std::vector<glm::vec3>>();
-        auto points = item.getDataAsPoints();
+        auto& points = OpenGLHelperArena::Begin();
         
         //Create camera dummy
         GLfloat iconSize = 0.5f;
@@ -95,29 +100,30 @@ std::vector<Renderable> Camera::Render()
         GLfloat aspect = (GLfloat)resX/(GLfloat)resY;
         GLfloat y = x/aspect;
         
-        points->push_back(glm::vec3(0,0,0));
-        points->push_back(glm::vec3(x, -y, iconSize));
-        points->push_back(glm::vec3(0,0,0));
-        points->push_back(glm::vec3(x,  y, iconSize));
-        points->push_back(glm::vec3(0,0,0));
-        points->push_back(glm::vec3(-x, -y, iconSize));
-        points->push_back(glm::vec3(0,0,0));
-        points->push_back(glm::vec3(-x,  y, iconSize));
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(x, -y, iconSize));
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(x,  y, iconSize));
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(-x, -y, iconSize));
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(-x,  y, iconSize));
         
-        points->push_back(glm::vec3(x, -y, iconSize));
-        points->push_back(glm::vec3(x, y, iconSize));
-        points->push_back(glm::vec3(x, y, iconSize));
-        points->push_back(glm::vec3(-x, y, iconSize));
-        points->push_back(glm::vec3(-x, y, iconSize));
-        points->push_back(glm::vec3(-x, -y, iconSize));
-        points->push_back(glm::vec3(-x, -y, iconSize));
-        points->push_back(glm::vec3(x, -y, iconSize));
+        points.push_back(glm::vec3(x, -y, iconSize));
+        points.push_back(glm::vec3(x, y, iconSize));
+        points.push_back(glm::vec3(x, y, iconSize));
+        points.push_back(glm::vec3(-x, y, iconSize));
+        points.push_back(glm::vec3(-x, y, iconSize));
+        points.push_back(glm::vec3(-x, -y, iconSize));
+        points.push_back(glm::vec3(-x, -y, iconSize));
+        points.push_back(glm::vec3(x, -y, iconSize));
         
-        points->push_back(glm::vec3(-0.5f*x, -y, iconSize));
-        points->push_back(glm::vec3(0.f, -1.5f*y, iconSize));
-        points->push_back(glm::vec3(0.f, -1.5f*y, iconSize));
-        points->push_back(glm::vec3(0.5f*x, -y, iconSize));
+        points.push_back(glm::vec3(-0.5f*x, -y, iconSize));
+        points.push_back(glm::vec3(0.f, -1.5f*y, iconSize));
+        points.push_back(glm::vec3(0.f, -1.5f*y, iconSize));
+        points.push_back(glm::vec3(0.5f*x, -y, iconSize));
         
+        item.data = OpenGLHelperArena::Commit();
         items.push_back(item);
     }
     return items;
@@ -42,11 +42,14 @@ DepthCamera::DepthCamera(std::string uniqueName, unsigned int resolutionX, unsig
     newDataCallback = nullptr;
     imageData = nullptr;
     glCamera = nullptr;
+    rayCaster = nullptr;
 }
 
 DepthCamera::~DepthCamera()
 {
     glCamera = nullptr;
+    if(rayCaster != nullptr)
+        delete rayCaster;
 }
 
 void DepthCamera::setNoise(float depthStdDev)
@@ -92,8 +95,18 @@ void DepthCamera::InitGraphics(bool& seesParticles)
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->AddView(glCamera);
 }
 
+bool DepthCamera::InitHeadless()
+{
+    rayCaster = new RayCaster();
+    rayDepth.resize(resX*resY, 0.f);
+    return true;
+}
+
 void DepthCamera::SetupCamera(const Vector3& eye, const Vector3& dir, const Vector3& up)
 {
+    if(glCamera == nullptr)
+        return;
+    
     glm::vec3 eye_ = glm::vec3((GLfloat)eye.x(), (GLfloat)eye.y(), (GLfloat)eye.z());
     glm::vec3 dir_ = glm::vec3((GLfloat)dir.x(), (GLfloat)dir.y(), (GLfloat)dir.z());
     glm::vec3 up_ = glm::vec3((GLfloat)up.x(), (GLfloat)up.y(), (GLfloat)up.z());
@@ -117,7 +130,55 @@ void DepthCamera::NewDataReady(void* data, unsigned int index)
 
 void DepthCamera::InternalUpdate(Scalar dt)
 {
-    glCamera->Update();
+    if(glCamera != nullptr)
+        glCamera->Update();
+    else
+        RayTrace();
+}
+
+void DepthCamera::RayTrace()
+{
+    Transform cameraTransform = getSensorFrame();
+    Vector3 eye = cameraTransform.getOrigin(); //O
+    Vector3 dir = cameraTransform.getBasis().getColumn(2); //Z
+    Vector3 up = -cameraTransform.getBasis().getColumn(1); //-Y
+    Vector3 right = dir.cross(up);
+    
+    //Same frustum as the OpenGL camera
+    Scalar tanX = btTan(fovH/Scalar(360)*M_PI);
+    Scalar tanY = tanX * Scalar(resY)/Scalar(resX);
+    Scalar zNear = Scalar(depthRange.x);
+    Scalar zFar = Scalar(depthRange.y);
+    unsigned int w = resX;
+    unsigned int h = resY;
+    
+    rayCaster->Update(eye, zFar * btSqrt(Scalar(1) + tanX*tanX + tanY*tanY));
+    rayCaster->CastRays(w, h, [&](unsigned int x, unsigned int y, Vector3& from, Vector3& to)
+    {
+        Scalar u = Scalar(2)*(Scalar(x) + Scalar(0.5))/Scalar(w) - Scalar(1);
+        Scalar v = Scalar(1) - Scalar(2)*(Scalar(y) + Scalar(0.5))/Scalar(h);
+        Vector3 d = dir + right * (u * tanX) + up * (v * tanY); //Unit depth along the optical axis
+        from = eye + d * zNear;
+        to = eye + d * zFar;
+    }, rayHits);
+    
+    //Linear depth (0 where nothing is seen, like the OpenGL camera)
+    std::normal_distribution<GLfloat> noise(0.f, 1.f);
+    for(size_t i=0; i<rayHits.size(); ++i)
+    {
+        if(rayHits[i].object == nullptr)
+        {
+            rayDepth[i] = 0.f;
+            continue;
+        }
+        
+        GLfloat depth = (GLfloat)(zNear + rayHits[i].fraction * (zFar - zNear));
+        if(noiseStdDev > 0.f)
+            depth += depth * depth * noiseStdDev * noise(randomGenerator);
+        rayDepth[i] = depth;
+    }
+    
+    NewDataReady(rayDepth.data(), 0);
 }
 
 }
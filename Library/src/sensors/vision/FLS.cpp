@@ -29,6 +29,7 @@
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "graphics/OpenGLFLS.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -50,11 +51,13 @@ FLS::FLS(std::string uniqueName, unsigned int numOfBeams, unsigned int numOfBins
     displayData = NULL;
     newDataCallback = NULL;
     glFLS = nullptr;
+    rayCaster = nullptr;
 }
 
 FLS::~FLS()
 {
     if(displayData != NULL) delete [] displayData;
+    if(rayCaster != nullptr) delete rayCaster;
     glFLS = nullptr;
 }
 
@@ -152,35 +155,45 @@ void FLS::InitGraphics(bool& seesParticles)
     displayData = new GLubyte[w*h*3];
 }
 
+bool FLS::InitHeadless()
+{
+    rayCaster = new SonarRayCaster();
+    return true;
+}
+
 void FLS::SetupCamera(const Vector3& eye, const Vector3& dir, const Vector3& up)
 {
+    if(glFLS == nullptr)
+        return;
+    
     glm::vec3 eye_ = glm::vec3((GLfloat)eye.x(), (GLfloat)eye.y(), (GLfloat)eye.z());
     glm::vec3 dir_ = glm::vec3((GLfloat)dir.x(), (GLfloat)dir.y(), (GLfloat)dir.z());
     glm::vec3 up_ = glm::vec3((GLfloat)up.x(), (GLfloat)up.y(), (GLfloat)up.z());
     glFLS->SetupSonar(eye_, dir_, up_);
 }
 
-void FLS::InstallNewDataHandler(std::function<void(FLS*)> callback)
+void FLS::InstallNewDataHandler(std::function<void(FLS*)> callback, bool display)
 {
     newDataCallback = callback;
+    SubscribeCallbackOutputs(newDataCallback != NULL, display);
 }
 
 void FLS::NewDataReady(void* data, unsigned int index)
 {
-    if(newDataCallback != NULL)
+    if(index == 0)
     {
-        if(index == 0)
+        if(isOutputSubscribed(VisionOutput::DISPLAY))
         {
             unsigned int w, h;
             getDisplayResolution(w, h);
             memcpy(displayData, data, w*h*3);
         }
-        else
-        {
-            sonarData = data;
-            newDataCallback(this);
-            sonarData = NULL;
-        }
+    }
+    else if(newDataCallback != NULL)
+    {
+        sonarData = data;
+        newDataCallback(this);
+        sonarData = NULL;
     }
 }
 
@@ -188,18 +201,101 @@ void FLS::InternalUpdate(Scalar dt)
 {
     if(glFLS != nullptr)
         glFLS->Update();
+    else if(rayCaster != nullptr)
+        RayTrace();
+}
+
+void FLS::RayTrace()
+{
+    Transform sonarTransform = getSensorFrame();
+    Vector3 eye = sonarTransform.getOrigin(); //O
+    Vector3 dir = sonarTransform.getBasis().getColumn(2); //Z
+    Vector3 up = -sonarTransform.getBasis().getColumn(1); //-Y
+    Vector3 right = dir.cross(up);
+    
+    //Same sampling density as the OpenGL sonar
+    unsigned int nBeams = resX;
+    unsigned int nBins = resY;
+    unsigned int nSamples = btMin((unsigned int)ceil(fovV * Scalar(nBins) * Scalar(FLS_VRES_FACTOR)), 2048u);
+    Scalar hFov = btRadians(fovH);
+    Scalar vFov = btRadians(fovV);
+    Scalar rMin = Scalar(range.x);
+    Scalar rMax = Scalar(range.y);
+    
+    //Cast vertical fans of rays, one for each beam
+    rayCaster->Update(eye, rMax);
+    rayCaster->CastEchoes(eye, nBeams, nSamples, [&](unsigned int x, unsigned int y, Vector3& from, Vector3& to)
+    {
+        Scalar alpha = (Scalar(x) + Scalar(0.5))/Scalar(nBeams) * hFov - hFov/Scalar(2);
+        Scalar beta = vFov/Scalar(2) - (Scalar(y) + Scalar(0.5))/Scalar(nSamples) * vFov;
+        Vector3 d = (dir * btCos(alpha) + right * btSin(alpha)) * btCos(beta) + up * btSin(beta);
+        from = eye + d * rMin/Scalar(2);
+        to = eye + d * rMax;
+    }, echoes);
+    
+    //Bin echoes of each beam
+    std::normal_distribution<GLfloat> stdNormal(0.f, 1.f);
+    GLfloat binSize = (range.y - range.x)/(GLfloat)nBins;
+    GLfloat g = (GLfloat)gain;
+    beamData.assign(nBeams * nBins, 0.f);
+    std::vector<glm::vec2> histogram(nBins);
+    
+    for(unsigned int x=0; x<nBeams; ++x)
+    {
+        std::fill(histogram.begin(), histogram.end(), glm::vec2(0.f));
+        for(unsigned int y=0; y<nSamples; ++y)
+        {
+            const SonarEcho& echo = echoes[y * nBeams + x];
+            if(echo.range < range.x || echo.range >= range.y) //Outside valid range?
+                continue;
+            
+            GLfloat factor = nSamples > 1 ? (GLfloat)y/(GLfloat)(nSamples-1) : 0.5f;
+            unsigned int bin = btMin((unsigned int)floorf((echo.range - range.x)/binSize), nBins-1);
+            histogram[bin].x += echo.intensity * glm::smoothstep(0.f, 0.2f, factor) * (1.f - glm::smoothstep(0.8f, 1.f, factor)); //Lobe intensity correction
+            histogram[bin].y += 1.f;
+        }
+        
+        GLfloat mulNoise = 1.f + noise.x * stdNormal(randomGenerator); //Gaussian beam gain noise
+        for(unsigned int i=0; i<nBins; ++i)
+        {
+            GLfloat data = g * noise.y * stdNormal(randomGenerator); //Gaussian background noise
+            if(histogram[i].y > 0.f)
+                data += g * histogram[i].x/histogram[i].y * mulNoise;
+            beamData[(nBins-1-i) * nBeams + x] = data;
+        }
+    }
+    
+    //Blur (beam interference and insufficient beam sampling) and convert to output format
+    static const GLfloat weights[5] = {0.0613595f, 0.2447701f, 0.3877409f, 0.2447701f, 0.0613595f}; //Gaussian, sigma = 1
+    outputData.resize(nBeams * nBins * SonarRayCaster::getSampleSize(outputFormat_));
+    
+    for(unsigned int h=0; h<nBins; ++h)
+        for(unsigned int x=0; x<nBeams; ++x)
+        {
+            GLfloat value = 0.f;
+            for(int i=-2; i<=2; ++i)
+                for(int j=-2; j<=2; ++j)
+                {
+                    int sx = (int)x + i;
+                    int sy = (int)h + j;
+                    if(sx >= 0 && sx < (int)nBeams && sy >= 0 && sy < (int)nBins)
+                        value += weights[i+2] * weights[j+2] * beamData[sy * nBeams + sx];
+                }
+            SonarRayCaster::StoreSample(outputData.data(), h * nBeams + x, glm::clamp(value, 0.f, 1.f), outputFormat_);
+        }
+    
+    NewDataReady(outputData.data(), 1);
 }
 
 std::vector<Renderable> FLS::Render()
 {
     std::vector<Renderable> items = Sensor::Render();
-    if(isRenderable())
+    if(isRenderable() && OpenGLHelperArena::isEnabled(RenderableType::SENSOR_LINES))
     {
         Renderable item;
         item.model = glMatrixFromTransform(getSensorFrame());
         item.type = RenderableType::SENSOR_LINES;    
-        item.data = std::make_shared<std::vector<glm::vec3>>();
-        auto points = item.getDataAsPoints();
+        auto& points = OpenGLHelperArena::Begin();
         
         //Create sonar dummy
         int div = 12;
@@ -212,9 +308,9 @@ std::vector<Renderable> FLS::Render()
         {
             GLfloat z = cosf(hAngle) * cosVAngle;
             GLfloat x = sinf(hAngle) * cosVAngle;
-            points->push_back(glm::vec3(x, sinVAngle, z));
+            points.push_back(glm::vec3(x, sinVAngle, z));
             if(i > 0 && i < div)
-                points->push_back(glm::vec3(x, sinVAngle, z));
+                points.push_back(glm::vec3(x, sinVAngle, z));
             hAngle += fovStep;
         }
         hAngle = -fovStep*(div/2);
@@ -222,9 +318,9 @@ std::vector<Renderable> FLS::Render()
         {
             GLfloat z = cosf(hAngle) * cosVAngle;
             GLfloat x = sinf(hAngle) * cosVAngle;
-            points->push_back(glm::vec3(x, -sinVAngle, z));
+            points.push_back(glm::vec3(x, -sinVAngle, z));
             if(i > 0 && i < div)
-                points->push_back(glm::vec3(x, -sinVAngle, z));
+                points.push_back(glm::vec3(x, -sinVAngle, z));
             hAngle += fovStep;
         }
         //Max Arcs
@@ -235,9 +331,9 @@ std::vector<Renderable> FLS::Render()
         {
             GLfloat z = cosf(hAngle) * cosVAngle;
             GLfloat x = sinf(hAngle) * cosVAngle;
-            points->push_back(glm::vec3(x, sinVAngle, z));
+            points.push_back(glm::vec3(x, sinVAngle, z));
             if(i > 0 && i < div)
-                points->push_back(glm::vec3(x, sinVAngle, z));
+                points.push_back(glm::vec3(x, sinVAngle, z));
             hAngle += fovStep;
         }
         hAngle = -fovStep*(div/2);
@@ -245,32 +341,33 @@ std::vector<Renderable> FLS::Render()
         {
             GLfloat z = cosf(hAngle) * cosVAngle;
             GLfloat x = sinf(hAngle) * cosVAngle;
-            points->push_back(glm::vec3(x, -sinVAngle, z));
+            points.push_back(glm::vec3(x, -sinVAngle, z));
             if(i > 0 && i < div)
-                points->push_back(glm::vec3(x, -sinVAngle, z));
+                points.push_back(glm::vec3(x, -sinVAngle, z));
             hAngle += fovStep;
         }
         //Ends
         hAngle = -fovStep*(div/2);
         GLfloat zs = cosf(hAngle) * cosVAngle;
         GLfloat xs = sinf(hAngle) * cosVAngle;
-        points->push_back(glm::vec3(xs, sinVAngle, zs));
-        points->push_back(glm::vec3(xs, -sinVAngle, zs));
+        points.push_back(glm::vec3(xs, sinVAngle, zs));
+        points.push_back(glm::vec3(xs, -sinVAngle, zs));
         hAngle = fovStep*(div/2);
         GLfloat ze = cosf(hAngle) * cosVAngle;
         GLfloat xe = sinf(hAngle) * cosVAngle;
-        points->push_back(glm::vec3(xe, sinVAngle, ze));
-        points->push_back(glm::vec3(xe, -sinVAngle, ze));
+        points.push_back(glm::vec3(xe, sinVAngle, ze));
+        points.push_back(glm::vec3(xe, -sinVAngle, ze));
         //Pyramid
-        points->push_back(glm::vec3(0,0,0));
-        points->push_back(glm::vec3(xs, sinVAngle, zs));
-        points->push_back(glm::vec3(0,0,0));
-        points->push_back(glm::vec3(xs, -sinVAngle, zs));
-        points->push_back(glm::vec3(0,0,0));
-        points->push_back(glm::vec3(xe, sinVAngle, ze));
-        points->push_back(glm::vec3(0,0,0));
-        points->push_back(glm::vec3(xe, -sinVAngle, ze));
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(xs, sinVAngle, zs));
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(xs, -sinVAngle, zs));
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(xe, sinVAngle, ze));
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(xe, -sinVAngle, ze));
 
+        item.data = OpenGLHelperArena::Commit();
         items.push_back(item);
     }
     return items;
@@ -29,6 +29,7 @@
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "graphics/OpenGLMSIS.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -53,11 +54,13 @@ MSIS::MSIS(std::string uniqueName, Scalar stepAngleDeg, unsigned int numOfBins,
     displayData = NULL;
     newDataCallback = NULL;
     glMSIS = nullptr;
+    rayCaster = nullptr;
 }
 
 MSIS::~MSIS()
 {
     if(displayData != NULL) delete [] displayData;
+    if(rayCaster != nullptr) delete rayCaster;
     glMSIS = nullptr;
 }
 
@@ -199,35 +202,48 @@ void MSIS::InitGraphics(bool& seesParticles)
     displayData = new GLubyte[w*h*3];
 }
 
+bool MSIS::InitHeadless()
+{
+    rayCaster = new SonarRayCaster();
+    outputData.resize(resX * resY * SonarRayCaster::getSampleSize(outputFormat_), 0);
+    outputSettings = glm::vec3(range.x, range.y, (GLfloat)gain);
+    outputRoi = roi;
+    return true;
+}
+
 void MSIS::SetupCamera(const Vector3& eye, const Vector3& dir, const Vector3& up)
 {
+    if(glMSIS == nullptr)
+        return;
+    
     glm::vec3 eye_ = glm::vec3((GLfloat)eye.x(), (GLfloat)eye.y(), (GLfloat)eye.z());
     glm::vec3 dir_ = glm::vec3((GLfloat)dir.x(), (GLfloat)dir.y(), (GLfloat)dir.z());
     glm::vec3 up_ = glm::vec3((GLfloat)up.x(), (GLfloat)up.y(), (GLfloat)up.z());
     glMSIS->SetupSonar(eye_, dir_, up_);
 }
 
-void MSIS::InstallNewDataHandler(std::function<void(MSIS*)> callback)
+void MSIS::InstallNewDataHandler(std::function<void(MSIS*)> callback, bool display)
 {
     newDataCallback = callback;
+    SubscribeCallbackOutputs(newDataCallback != nullptr, display);
 }
 
 void MSIS::NewDataReady(void* data, unsigned int index)
 {
-    if(newDataCallback != nullptr)
+    if(index == 0)
     {
-        if(index == 0)
+        if(isOutputSubscribed(VisionOutput::DISPLAY))
         {
             unsigned int w, h;
             getDisplayResolution(w, h);
             memcpy(displayData, data, w*h*3);
         }
-        else
-        {
-            sonarData = data;
-            newDataCallback(this);
-            sonarData = nullptr;
-        }
+    }
+    else if(data != nullptr && newDataCallback != nullptr)
+    {
+        sonarData = data;
+        newDataCallback(this);
+        sonarData = nullptr;
     }
 
     if(index == 1)
@@ -255,18 +271,96 @@ void MSIS::InternalUpdate(Scalar dt)
 {
     if(glMSIS != nullptr)
         glMSIS->Update();
+    else if(rayCaster != nullptr)
+        RayTrace();
+}
+
+void MSIS::RayTrace()
+{
+    //Clear image if settings changed
+    glm::vec3 settings(range.x, range.y, (GLfloat)gain);
+    if(settings != outputSettings || roi != outputRoi)
+    {
+        std::fill(outputData.begin(), outputData.end(), 0);
+        outputSettings = settings;
+        outputRoi = roi;
+    }
+    
+    Transform sonarTransform = getSensorFrame();
+    Vector3 eye = sonarTransform.getOrigin(); //O
+    Vector3 dir = sonarTransform.getBasis().getColumn(2); //Z
+    Vector3 up = -sonarTransform.getBasis().getColumn(1); //-Y
+    Vector3 right = dir.cross(up);
+    
+    //Beam direction for the current rotation step
+    Scalar rotAngle = Scalar(currentStep) * stepSize;
+    Vector3 center = dir * btCos(rotAngle) + right * btSin(rotAngle);
+    Vector3 side = center.cross(up);
+    
+    //Same sampling density as the OpenGL sonar
+    unsigned int nBins = resY;
+    unsigned int nHSamples = btMin((unsigned int)ceil(fovH * Scalar(nBins) * Scalar(MSIS_RES_FACTOR)), 2048u);
+    unsigned int nVSamples = btMin((unsigned int)ceil(fovV * Scalar(nBins) * Scalar(MSIS_RES_FACTOR)), 2048u);
+    Scalar hFov = btRadians(fovH);
+    Scalar vFov = btRadians(fovV);
+    Scalar rMin = Scalar(range.x);
+    Scalar rMax = Scalar(range.y);
+    auto fraction = [](unsigned int i, unsigned int n) { return ((GLfloat)i + 0.5f)/(GLfloat)n; };
+    
+    rayCaster->Update(eye, rMax);
+    rayCaster->CastEchoes(eye, nHSamples, nVSamples, [&](unsigned int x, unsigned int y, Vector3& from, Vector3& to)
+    {
+        Scalar alpha = (Scalar(fraction(x, nHSamples)) - Scalar(0.5)) * hFov;
+        Scalar beta = (Scalar(0.5) - Scalar(fraction(y, nVSamples))) * vFov;
+        Vector3 d = (center * btCos(alpha) - side * btSin(alpha)) * btCos(beta) + up * btSin(beta);
+        from = eye + d * rMin/Scalar(2);
+        to = eye + d * rMax;
+    }, echoes);
+    
+    //Build beam histogram
+    GLfloat binSize = (range.y - range.x)/(GLfloat)nBins;
+    std::vector<glm::vec2> histogram(nBins, glm::vec2(0.f));
+    for(unsigned int y=0; y<nVSamples; ++y)
+    {
+        GLfloat vFrac = (fraction(y, nVSamples) - 0.5f) * 2.f;
+        for(unsigned int x=0; x<nHSamples; ++x)
+        {
+            const SonarEcho& echo = echoes[y * nHSamples + x];
+            if(echo.range < range.x || echo.range >= range.y) //Outside valid range?
+                continue;
+            
+            GLfloat hFrac = (fraction(x, nHSamples) - 0.5f) * 2.f;
+            unsigned int bin = btMin((unsigned int)floorf((echo.range - range.x)/binSize), nBins-1);
+            histogram[bin].x += echo.intensity * glm::clamp(1.f - (hFrac*hFrac + vFrac*vFrac)/2.f, 0.f, 1.f); //Beam pattern
+            histogram[bin].y += 1.f;
+        }
+    }
+    
+    //Update beam in the sonar image
+    std::normal_distribution<GLfloat> stdNormal(0.f, 1.f);
+    GLfloat g = (GLfloat)gain;
+    GLfloat mulNoise = 1.f + noise.x * stdNormal(randomGenerator);
+    unsigned int column = (unsigned int)(currentStep + (int)(resX/2));
+    for(unsigned int i=0; i<nBins; ++i)
+    {
+        GLfloat value = g * ((GLfloat)i/(GLfloat)btMax(nBins-1, 1u) * 0.5f + 0.5f) * noise.y * stdNormal(randomGenerator); //Distance dependent additive noise
+        if(histogram[i].y > 0.f)
+            value += histogram[i].x/histogram[i].y * g * mulNoise;
+        SonarRayCaster::StoreSample(outputData.data(), (nBins - 1 - i) * resX + column, glm::clamp(value, 0.f, 1.f), outputFormat_);
+    }
+    
+    NewDataReady(outputData.data(), 1);
 }
 
 std::vector<Renderable> MSIS::Render()
 {
     std::vector<Renderable> items = Sensor::Render();
-    if(isRenderable())
+    if(isRenderable() && OpenGLHelperArena::isEnabled(RenderableType::SENSOR_LINES))
     {
         Renderable item;
         item.model = glMatrixFromTransform(getSensorFrame());
         item.type = RenderableType::SENSOR_LINES;    
-        item.data = std::make_shared<std::vector<glm::vec3>>();
-        auto points = item.getDataAsPoints();
+        auto& points = OpenGLHelperArena::Begin();
         
         //Create sonar dummy
         int div = 24;
@@ -281,9 +375,9 @@ std::vector<Renderable> MSIS::Render()
         {
             GLfloat z = cosf(hAngle) * cosVAngle;
             GLfloat x = sinf(hAngle) * cosVAngle;
-            points->push_back(glm::vec3(x, sinVAngle, z));
+            points.push_back(glm::vec3(x, sinVAngle, z));
             if(i > 0 && i < div)
-                points->push_back(glm::vec3(x, sinVAngle, z));
+                points.push_back(glm::vec3(x, sinVAngle, z));
             hAngle += fovStep;
         }
         hAngle = glm::radians(l1Deg);
@@ -291,9 +385,9 @@ std::vector<Renderable> MSIS::Render()
         {
             GLfloat z = cosf(hAngle) * cosVAngle;
             GLfloat x = sinf(hAngle) * cosVAngle;
-            points->push_back(glm::vec3(x, -sinVAngle, z));
+            points.push_back(glm::vec3(x, -sinVAngle, z));
             if(i > 0 && i < div)
-                points->push_back(glm::vec3(x, -sinVAngle, z));
+                points.push_back(glm::vec3(x, -sinVAngle, z));
             hAngle += fovStep;
         }
         //Arcs max
@@ -304,9 +398,9 @@ std::vector<Renderable> MSIS::Render()
         {
             GLfloat z = cosf(hAngle) * cosVAngle;
             GLfloat x = sinf(hAngle) * cosVAngle;
-            points->push_back(glm::vec3(x, sinVAngle, z));
+            points.push_back(glm::vec3(x, sinVAngle, z));
             if(i > 0 && i < div)
-                points->push_back(glm::vec3(x, sinVAngle, z));
+                points.push_back(glm::vec3(x, sinVAngle, z));
             hAngle += fovStep;
         }
         hAngle = glm::radians(l1Deg);
@@ -314,21 +408,21 @@ std::vector<Renderable> MSIS::Render()
         {
             GLfloat z = cosf(hAngle) * cosVAngle;
             GLfloat x = sinf(hAngle) * cosVAngle;
-            points->push_back(glm::vec3(x, -sinVAngle, z));
+            points.push_back(glm::vec3(x, -sinVAngle, z));
             if(i > 0 && i < div)
-                points->push_back(glm::vec3(x, -sinVAngle, z));
+                points.push_back(glm::vec3(x, -sinVAngle, z));
             hAngle += fovStep;
         }
         //Current beam position
         hAngle = currentStep * stepSize;
         GLfloat zc = cosf(hAngle) * cosVAngle;
         GLfloat xc = sinf(hAngle) * cosVAngle;
-        points->push_back(glm::vec3(0,0,0));
-        points->push_back(glm::vec3(xc, sinVAngle, zc));
-        points->push_back(glm::vec3(xc, sinVAngle, zc));
-        points->push_back(glm::vec3(xc, -sinVAngle, zc));
-        points->push_back(glm::vec3(xc, -sinVAngle, zc));
-        points->push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(xc, sinVAngle, zc));
+        points.push_back(glm::vec3(xc, sinVAngle, zc));
+        points.push_back(glm::vec3(xc, -sinVAngle, zc));
+        points.push_back(glm::vec3(xc, -sinVAngle, zc));
+        points.push_back(glm::vec3(0,0,0));
         
         if(!fullRotation)
         {
@@ -336,24 +430,25 @@ std::vector<Renderable> MSIS::Render()
             hAngle = glm::radians(l1Deg);
             GLfloat zs = cosf(hAngle) * cosVAngle;
             GLfloat xs = sinf(hAngle) * cosVAngle;
-            points->push_back(glm::vec3(xs, sinVAngle, zs));
-            points->push_back(glm::vec3(xs, -sinVAngle, zs));
+            points.push_back(glm::vec3(xs, sinVAngle, zs));
+            points.push_back(glm::vec3(xs, -sinVAngle, zs));
             hAngle = glm::radians(l2Deg);
             GLfloat ze = cosf(hAngle) * cosVAngle;
             GLfloat xe = sinf(hAngle) * cosVAngle;
-            points->push_back(glm::vec3(xe, sinVAngle, ze));
-            points->push_back(glm::vec3(xe, -sinVAngle, ze));
+            points.push_back(glm::vec3(xe, sinVAngle, ze));
+            points.push_back(glm::vec3(xe, -sinVAngle, ze));
             //Pyramid
-            points->push_back(glm::vec3(0,0,0));
-            points->push_back(glm::vec3(xs, sinVAngle, zs));
-            points->push_back(glm::vec3(0,0,0));
-            points->push_back(glm::vec3(xs, -sinVAngle, zs));
-            points->push_back(glm::vec3(0,0,0));
-            points->push_back(glm::vec3(xe, sinVAngle, ze));
-            points->push_back(glm::vec3(0,0,0));
-            points->push_back(glm::vec3(xe, -sinVAngle, ze));
+            points.push_back(glm::vec3(0,0,0));
+            points.push_back(glm::vec3(xs, sinVAngle, zs));
+            points.push_back(glm::vec3(0,0,0));
+            points.push_back(glm::vec3(xs, -sinVAngle, zs));
+            points.push_back(glm::vec3(0,0,0));
+            points.push_back(glm::vec3(xe, sinVAngle, ze));
+            points.push_back(glm::vec3(0,0,0));
+            points.push_back(glm::vec3(xe, -sinVAngle, ze));
         }
 
+        item.data = OpenGLHelperArena::Commit();
         items.push_back(item);
     }
     return items;
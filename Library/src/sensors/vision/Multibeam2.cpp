@@ -29,6 +29,7 @@
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "graphics/OpenGLDepthCamera.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -40,6 +41,7 @@ Multibeam2::Multibeam2(std::string uniqueName, unsigned int horizontalRes, unsig
     range.x = minRange < Scalar(0.01) ? 0.01f : (GLfloat)minRange;
     range.y = maxRange > Scalar(0.01) ? (GLfloat)maxRange : 1.f;
     newDataCallback = NULL;
+    rayCaster = nullptr;
     dataCounter = 0;
     imageData = new GLfloat[resX*resY]; // Buffer for storing image data
     memset(imageData, 0, resX*resY*sizeof(GLfloat));
@@ -53,6 +55,8 @@ Multibeam2::~Multibeam2()
         delete [] imageData;
     if(rangeData != NULL)
         delete [] rangeData;
+    if(rayCaster != nullptr)
+        delete rayCaster;
     cameras.clear();
 }
     
@@ -92,10 +96,8 @@ OpenGLView* Multibeam2::getOpenGLView() const
         return nullptr;
 }
     
-void Multibeam2::InitGraphics(bool& seesParticles)
+void Multibeam2::SetupCameras()
 {
-    seesParticles = false;
-
     if(fovH <= Scalar(MULTIBEAM_MAX_SINGLE_FOV))
     {
         CamData cd;
@@ -147,15 +149,33 @@ void Multibeam2::InitGraphics(bool& seesParticles)
         }
     }
     
+    //Compute data offsets
+    size_t accResX = 0;
+    for(size_t i=0; i<cameras.size(); ++i)
+    {
+        cameras[i].dataOffset = accResX*resY;
+        accResX += cameras[i].width;
+    }
+}
+
+bool Multibeam2::InitHeadless()
+{
+    SetupCameras();
+    rayCaster = new RayCaster();
+    return true;
+}
+
+void Multibeam2::InitGraphics(bool& seesParticles)
+{
+    seesParticles = false;
+    SetupCameras();
+    
     //Create depth cameras
-    GLint accResX = 0;
     for(size_t i=0; i<cameras.size(); ++i)
     {
         cameras[i].cam = new OpenGLDepthCamera(glm::vec3(0,0,0), glm::vec3(0,0,1.f), glm::vec3(0,-1.f,0),
-                                                            accResX, 0, cameras[i].width, resY, cameras[i].fovH, range.x, range.y, true, (GLfloat)fovV);
+                                               (GLint)(cameras[i].dataOffset/resY), 0, cameras[i].width, resY, cameras[i].fovH, range.x, range.y, true, (GLfloat)fovV);
         cameras[i].cam->setCamera(this, (unsigned int)i);
-        cameras[i].dataOffset = accResX*resY;
-        accResX += cameras[i].width;
     }
     
     //Update camera transformations
@@ -171,12 +191,88 @@ void Multibeam2::InitGraphics(bool& seesParticles)
 
 void Multibeam2::InternalUpdate(Scalar dt)
 {
+    if(rayCaster != nullptr)
+    {
+        RayTrace();
+        return;
+    }
+    
     for(size_t i=0; i<cameras.size(); ++i)
         cameras[i].cam->Update();
 }
+
+void Multibeam2::RayTrace()
+{
+    Transform mbTransform = getSensorFrame();
+    Vector3 eyePosition = mbTransform.getOrigin(); //O
+    Vector3 direction = mbTransform.getBasis().getColumn(2); //Z
+    Vector3 cameraUp = -mbTransform.getBasis().getColumn(1); //-Y
+    Scalar zNear = Scalar(range.x);
+    Scalar zFar = Scalar(range.y);
+    
+    //Collect geometry within reach of the widest frustum corner
+    Scalar maxCorner(1);
+    for(size_t i=0; i<cameras.size(); ++i)
+    {
+        Scalar tanX = btTan(cameras[i].fovH/Scalar(360)*M_PI);
+        Scalar tanY = tanX * Scalar(resY)/Scalar(cameras[i].width);
+        maxCorner = btMax(maxCorner, btSqrt(Scalar(1) + tanX*tanX + tanY*tanY));
+    }
+    rayCaster->Update(eyePosition, zFar * maxCorner);
+    
+    //Trace each camera with the same frustum as the OpenGL depth cameras
+    Scalar accFov(0);
+    Scalar offset = fovH/Scalar(360)*M_PI;
+    
+    for(size_t i=0; i<cameras.size(); ++i)
+    {
+        Scalar halfFov = cameras[i].fovH/Scalar(360)*M_PI;
+        Vector3 dir = direction.rotate(cameraUp, offset - accFov - halfFov);
+        Vector3 right = dir.cross(cameraUp);
+        accFov += Scalar(2)*halfFov;
+        
+        Scalar tanX = btTan(halfFov);
+        Scalar tanY = tanX * Scalar(resY)/Scalar(cameras[i].width);
+        unsigned int w = (unsigned int)cameras[i].width;
+        unsigned int h = resY;
+        
+        rayCaster->CastRays(w, h, [&](unsigned int x, unsigned int y, Vector3& from, Vector3& to)
+        {
+            Scalar u = Scalar(2)*(Scalar(x) + Scalar(0.5))/Scalar(w) - Scalar(1);
+            Scalar v = Scalar(1) - Scalar(2)*(Scalar(y) + Scalar(0.5))/Scalar(h);
+            Vector3 d = dir + right * (u * tanX) + cameraUp * (v * tanY); //Unit depth along the optical axis
+            from = eyePosition + d * zNear;
+            to = eyePosition + d * zFar;
+        }, rayHits);
+        
+        //Ranges clamped to limits (maximum range where nothing is seen)
+        rayRange.resize(rayHits.size());
+        for(size_t k=0; k<rayHits.size(); ++k)
+        {
+            if(rayHits[k].object == nullptr)
+            {
+                rayRange[k] = range.y;
+                continue;
+            }
+            
+            unsigned int x = (unsigned int)(k % w);
+            unsigned int y = (unsigned int)(k / w);
+            Scalar u = Scalar(2)*(Scalar(x) + Scalar(0.5))/Scalar(w) - Scalar(1);
+            Scalar v = Scalar(1) - Scalar(2)*(Scalar(y) + Scalar(0.5))/Scalar(h);
+            Scalar depth = zNear + rayHits[k].fraction * (zFar - zNear);
+            Scalar r = depth * btSqrt(Scalar(1) + u*u*tanX*tanX + v*v*tanY*tanY);
+            rayRange[k] = (GLfloat)btClamped(r, zNear, zFar);
+        }
+        
+        NewDataReady(rayRange.data(), (unsigned int)i);
+    }
+}
     
 void Multibeam2::UpdateTransform()
 {
+    if(rayCaster != nullptr) //Not rendered
+        return;
+
     Transform mbTransform = getSensorFrame();
     Vector3 eyePosition = mbTransform.getOrigin(); //O
     Vector3 direction = mbTransform.getBasis().getColumn(2); //Z
@@ -249,13 +345,12 @@ void Multibeam2::NewDataReady(void* data, unsigned int index)
 std::vector<Renderable> Multibeam2::Render()
 {
     std::vector<Renderable> items = Sensor::Render();
-    if(isRenderable())
+    if(isRenderable() && OpenGLHelperArena::isEnabled(RenderableType::SENSOR_LINES))
     {
         Renderable item;
         item.model = glMatrixFromTransform(getSensorFrame());
         item.type = RenderableType::SENSOR_LINES;
-        item.data = std::make_shared<std::vector<glm::vec3>>();
-        auto points = item.getDataAsPoints();
+        auto& points = OpenGLHelperArena::Begin();
         
         unsigned int div = (unsigned int)ceil(fovH/5.0);
         GLfloat iconSize = 0.5f;
@@ -277,31 +372,32 @@ std::vector<Renderable> Multibeam2::Render()
             GLfloat x1 = sinf(theta1) * r;
             GLfloat x2 = sinf(theta2) * r;
             
-            points->push_back(glm::vec3(x1,y,z1));
-            points->push_back(glm::vec3(x2,y,z2));
-            points->push_back(glm::vec3(x1,-y,z1));
-            points->push_back(glm::vec3(x2,-y,z2));
+            points.push_back(glm::vec3(x1,y,z1));
+            points.push_back(glm::vec3(x2,y,z2));
+            points.push_back(glm::vec3(x1,-y,z1));
+            points.push_back(glm::vec3(x2,-y,z2));
             
             if(i == 0) //End 1
             {
-                points->push_back(glm::vec3(x1,y,z1));
-                points->push_back(glm::vec3(x1,-y,z1));
-                points->push_back(glm::vec3(x1,y,z1));
-                points->push_back(glm::vec3(0,0,0));
-                points->push_back(glm::vec3(x1,-y,z1));
-                points->push_back(glm::vec3(0,0,0));
+                points.push_back(glm::vec3(x1,y,z1));
+                points.push_back(glm::vec3(x1,-y,z1));
+                points.push_back(glm::vec3(x1,y,z1));
+                points.push_back(glm::vec3(0,0,0));
+                points.push_back(glm::vec3(x1,-y,z1));
+                points.push_back(glm::vec3(0,0,0));
             }
             else if(i == div-1) //End 2
             {
-                points->push_back(glm::vec3(x2,y,z2));
-                points->push_back(glm::vec3(x2,-y,z2));
-                points->push_back(glm::vec3(x2,y,z2));
-                points->push_back(glm::vec3(0,0,0));
-                points->push_back(glm::vec3(x2,-y,z2));
-                points->push_back(glm::vec3(0,0,0));
+                points.push_back(glm::vec3(x2,y,z2));
+                points.push_back(glm::vec3(x2,-y,z2));
+                points.push_back(glm::vec3(x2,y,z2));
+                points.push_back(glm::vec3(0,0,0));
+                points.push_back(glm::vec3(x2,-y,z2));
+                points.push_back(glm::vec3(0,0,0));
             }
         }
         
+        item.data = OpenGLHelperArena::Commit();
         items.push_back(item);
     }
     return items;
@@ -111,27 +111,28 @@ void OpticalFlowCamera::SetupCamera(const Vector3& eye, const Vector3& dir, cons
     glCamera->SetupCamera(eye_, dir_, up_);
 }
 
-void OpticalFlowCamera::InstallNewDataHandler(std::function<void(OpticalFlowCamera*)> callback)
+void OpticalFlowCamera::InstallNewDataHandler(std::function<void(OpticalFlowCamera*)> callback, bool display)
 {
     newDataCallback = callback;
+    SubscribeCallbackOutputs(newDataCallback != nullptr, display);
 }
 
 void OpticalFlowCamera::NewDataReady(void* data, unsigned int index)
 {
-    if(newDataCallback != nullptr)
+    if(index == 0)
     {
-        if(index == 0)
+        if(isOutputSubscribed(VisionOutput::DISPLAY))
         {
             unsigned int w, h;
             getResolution(w, h);
             memcpy(displayData, data, w*h*3);
         }
-        else
-        {
-            flowData = (GLfloat*)data;
-            newDataCallback(this);
-            flowData = nullptr;
-        }
+    }
+    else if(newDataCallback != nullptr)
+    {
+        flowData = (GLfloat*)data;
+        newDataCallback(this);
+        flowData = nullptr;
     }
 }
 
@@ -29,6 +29,7 @@
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "graphics/OpenGLSSS.h"
+#include "graphics/OpenGLHelperArena.h"
 
 namespace sf
 {
@@ -51,11 +52,13 @@ SSS::SSS(std::string uniqueName, unsigned int numOfBins, unsigned int numOfLines
     displayData = NULL;
     newDataCallback = NULL;
     glSSS = nullptr;
+    rayCaster = nullptr;
 }
 
 SSS::~SSS()
 {
     if(displayData != NULL) delete [] displayData;
+    if(rayCaster != nullptr) delete rayCaster;
     glSSS = nullptr;
 }
 
@@ -151,35 +154,46 @@ void SSS::InitGraphics(bool& seesParticles)
     displayData = new GLubyte[w*h*3];
 }
 
+bool SSS::InitHeadless()
+{
+    rayCaster = new SonarRayCaster();
+    outputData.resize(resX * resY * SonarRayCaster::getSampleSize(outputFormat_), 0);
+    return true;
+}
+
 void SSS::SetupCamera(const Vector3& eye, const Vector3& dir, const Vector3& up)
 {
+    if(glSSS == nullptr)
+        return;
+    
     glm::vec3 eye_ = glm::vec3((GLfloat)eye.x(), (GLfloat)eye.y(), (GLfloat)eye.z());
     glm::vec3 dir_ = glm::vec3((GLfloat)dir.x(), (GLfloat)dir.y(), (GLfloat)dir.z());
     glm::vec3 up_ = glm::vec3((GLfloat)up.x(), (GLfloat)up.y(), (GLfloat)up.z());
     glSSS->SetupSonar(eye_, dir_, up_);
 }
 
-void SSS::InstallNewDataHandler(std::function<void(SSS*)> callback)
+void SSS::InstallNewDataHandler(std::function<void(SSS*)> callback, bool display)
 {
     newDataCallback = callback;
+    SubscribeCallbackOutputs(newDataCallback != NULL, display);
 }
 
 void SSS::NewDataReady(void* data, unsigned int index)
 {
-    if(newDataCallback != NULL)
+    if(index == 0)
     {
-        if(index == 0)
+        if(isOutputSubscribed(VisionOutput::DISPLAY))
         {
             unsigned int w, h;
             getDisplayResolution(w, h);
             memcpy(displayData, data, w*h*3);
         }
-        else
-        {
-            sonarData = data;
-            newDataCallback(this);
-            sonarData = NULL;
-        }
+    }
+    else if(newDataCallback != NULL)
+    {
+        sonarData = data;
+        newDataCallback(this);
+        sonarData = NULL;
     }
 }
 
@@ -187,17 +201,105 @@ void SSS::InternalUpdate(Scalar dt)
 {
     if(glSSS != nullptr)
         glSSS->Update();
+    else if(rayCaster != nullptr)
+        RayTrace();
+}
+
+void SSS::RayTrace()
+{
+    Transform sonarTransform = getSensorFrame();
+    Vector3 eye = sonarTransform.getOrigin(); //O
+    Vector3 dir = sonarTransform.getBasis().getColumn(2); //Z
+    Vector3 forward = -sonarTransform.getBasis().getColumn(1); //-Y
+    Vector3 right = dir.cross(forward);
+    
+    //Same sampling density as the OpenGL sonar
+    unsigned int nHalfBins = resX/2;
+    unsigned int nVSamples = btMin((unsigned int)ceil(fovH * Scalar(nHalfBins) * Scalar(SSS_VRES_FACTOR)), 2048u);
+    unsigned int nHSamples = btMin((unsigned int)ceil(fovV * Scalar(SSS_HRES_FACTOR)), 2048u);
+    Scalar vFov = btRadians(fovH);
+    Scalar hFov = btRadians(fovV);
+    Scalar tiltRad = btRadians(tilt);
+    Scalar rMin = Scalar(range.x);
+    Scalar rMax = Scalar(range.y);
+    auto fraction = [](unsigned int i, unsigned int n) { return n > 1 ? (GLfloat)i/(GLfloat)(n-1) : 0.5f; };
+    
+    //Cast rays of both transducers (port in the upper half of the grid)
+    rayCaster->Update(eye, rMax);
+    rayCaster->CastEchoes(eye, nVSamples, 2*nHSamples, [&](unsigned int x, unsigned int y, Vector3& from, Vector3& to)
+    {
+        Scalar side = y < nHSamples ? Scalar(-1) : Scalar(1);
+        Scalar theta = tiltRad + (Scalar(fraction(x, nVSamples)) - Scalar(0.5)) * vFov; //Angle below the horizontal plane
+        Scalar phi = (Scalar(fraction(y % nHSamples, nHSamples)) - Scalar(0.5)) * hFov;
+        Vector3 d = (dir * btSin(theta) + right * (side * btCos(theta))) * btCos(phi) + forward * btSin(phi);
+        from = eye + d * rMin/Scalar(2);
+        to = eye + d * rMax;
+    }, echoes);
+    
+    //Shift the waterfall by one line
+    size_t lineSize = resX * SonarRayCaster::getSampleSize(outputFormat_);
+    memmove(outputData.data() + lineSize, outputData.data(), lineSize * (resY-1));
+    
+    //Compute new line
+    std::normal_distribution<GLfloat> stdNormal(0.f, 1.f);
+    GLfloat binSize = (range.y - range.x)/(GLfloat)nHalfBins;
+    GLfloat g = (GLfloat)gain;
+    GLfloat mulNoise = 1.f + noise.x * stdNormal(randomGenerator);
+    std::vector<glm::vec2> histogram(nHalfBins);
+    std::vector<glm::vec2> line(nHalfBins);
+    
+    for(unsigned int s=0; s<2; ++s)
+    {
+        std::fill(line.begin(), line.end(), glm::vec2(0.f));
+        
+        for(unsigned int x=0; x<nVSamples; ++x)
+        {
+            std::fill(histogram.begin(), histogram.end(), glm::vec2(0.f));
+            for(unsigned int y=0; y<nHSamples; ++y)
+            {
+                const SonarEcho& echo = echoes[(s * nHSamples + y) * nVSamples + x];
+                if(echo.range < range.x || echo.range >= range.y) //Outside valid range?
+                    continue;
+                
+                GLfloat hFrac2 = (fraction(y, nHSamples) - 0.5f) * 2.f;
+                hFrac2 *= hFrac2;
+                unsigned int bin = btMin((unsigned int)floorf((echo.range - range.x)/binSize), nHalfBins-1);
+                histogram[bin].x += echo.intensity * glm::clamp(1.f - hFrac2/2.f, 0.f, 1.f); //Beam pattern
+                histogram[bin].y += 1.f;
+            }
+            
+            GLfloat factor = fraction(x, nVSamples);
+            GLfloat theta = (GLfloat)tiltRad + (factor - 0.5f) * (GLfloat)vFov;
+            GLfloat lobe = glm::smoothstep(0.f, 0.2f, factor) * (1.f - glm::smoothstep(0.8f, 1.f, factor));
+            GLfloat compensation = 1.f/glm::clamp(sinf(theta), 0.01f, 1.f); //Flat bottom model
+            for(unsigned int i=0; i<nHalfBins; ++i)
+            {
+                line[i].x += histogram[i].x * lobe * compensation;
+                line[i].y += histogram[i].y;
+            }
+        }
+        
+        for(unsigned int i=0; i<nHalfBins; ++i)
+        {
+            GLfloat value = g * ((GLfloat)i/(GLfloat)btMax(nHalfBins-1, 1u) * 0.5f + 0.5f) * noise.y * stdNormal(randomGenerator); //Distance dependent additive noise
+            if(line[i].y > 0.f)
+                value += 0.7f * line[i].x/line[i].y * g * mulNoise;
+            unsigned int bin = s == 0 ? nHalfBins - 1 - i : nHalfBins + i;
+            SonarRayCaster::StoreSample(outputData.data(), bin, glm::clamp(value, 0.f, 1.f), outputFormat_);
+        }
+    }
+    
+    NewDataReady(outputData.data(), 1);
 }
 
 std::vector<Renderable> SSS::Render()
 {
     std::vector<Renderable> items = Sensor::Render();
-    if(isRenderable())
+    if(isRenderable() && OpenGLHelperArena::isEnabled(RenderableType::SENSOR_LINES))
     {
         Renderable item1;
         item1.type = RenderableType::SENSOR_LINES; 
-        item1.data = std::make_shared<std::vector<glm::vec3>>();
-        auto points = item1.getDataAsPoints();   
+        auto& points = OpenGLHelperArena::Begin();
         
         //Create single transducer dummy
         int div = 12;
@@ -210,9 +312,9 @@ std::vector<Renderable> SSS::Render()
         {
             GLfloat z = cosf(hAngle) * cosVAngle;
             GLfloat x = sinf(hAngle) * cosVAngle;
-            points->push_back(glm::vec3(x, sinVAngle, z));
+            points.push_back(glm::vec3(x, sinVAngle, z));
             if(i > 0 && i < div)
-                points->push_back(glm::vec3(x, sinVAngle, z));
+                points.push_back(glm::vec3(x, sinVAngle, z));
             hAngle += fovStep;
         }
         hAngle = -fovStep*(div/2);
@@ -220,9 +322,9 @@ std::vector<Renderable> SSS::Render()
         {
             GLfloat z = cosf(hAngle) * cosVAngle;
             GLfloat x = sinf(hAngle) * cosVAngle;
-            points->push_back(glm::vec3(x, -sinVAngle, z));
+            points.push_back(glm::vec3(x, -sinVAngle, z));
             if(i > 0 && i < div)
-                points->push_back(glm::vec3(x, -sinVAngle, z));
+                points.push_back(glm::vec3(x, -sinVAngle, z));
             hAngle += fovStep;
         }
         //Arcs max
@@ -233,9 +335,9 @@ std::vector<Renderable> SSS::Render()
         {
             GLfloat z = cosf(hAngle) * cosVAngle;
             GLfloat x = sinf(hAngle) * cosVAngle;
-            points->push_back(glm::vec3(x, sinVAngle, z));
+            points.push_back(glm::vec3(x, sinVAngle, z));
             if(i > 0 && i < div)
-                points->push_back(glm::vec3(x, sinVAngle, z));
+                points.push_back(glm::vec3(x, sinVAngle, z));
             hAngle += fovStep;
         }
         hAngle = -fovStep*(div/2);
@@ -243,31 +345,31 @@ std::vector<Renderable> SSS::Render()
         {
             GLfloat z = cosf(hAngle) * cosVAngle;
             GLfloat x = sinf(hAngle) * cosVAngle;
-            points->push_back(glm::vec3(x, -sinVAngle, z));
+            points.push_back(glm::vec3(x, -sinVAngle, z));
             if(i > 0 && i < div)
-                points->push_back(glm::vec3(x, -sinVAngle, z));
+                points.push_back(glm::vec3(x, -sinVAngle, z));
             hAngle += fovStep;
         }
         //Ends
         hAngle = -fovStep*(div/2);
         GLfloat zs = cosf(hAngle) * cosVAngle;
         GLfloat xs = sinf(hAngle) * cosVAngle;
-        points->push_back(glm::vec3(xs, sinVAngle, zs));
-        points->push_back(glm::vec3(xs, -sinVAngle, zs));
+        points.push_back(glm::vec3(xs, sinVAngle, zs));
+        points.push_back(glm::vec3(xs, -sinVAngle, zs));
         hAngle = fovStep*(div/2);
         GLfloat ze = cosf(hAngle) * cosVAngle;
         GLfloat xe = sinf(hAngle) * cosVAngle;
-        points->push_back(glm::vec3(xe, sinVAngle, ze));
-        points->push_back(glm::vec3(xe, -sinVAngle, ze));
+        points.push_back(glm::vec3(xe, sinVAngle, ze));
+        points.push_back(glm::vec3(xe, -sinVAngle, ze));
         //Pyramid
-        points->push_back(glm::vec3(0,0,0));
-        points->push_back(glm::vec3(xs, sinVAngle, zs));
-        points->push_back(glm::vec3(0,0,0));
-        points->push_back(glm::vec3(xs, -sinVAngle, zs));
-        points->push_back(glm::vec3(0,0,0));
-        points->push_back(glm::vec3(xe, sinVAngle, ze));
-        points->push_back(glm::vec3(0,0,0));
-        points->push_back(glm::vec3(xe, -sinVAngle, ze));
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(xs, sinVAngle, zs));
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(xs, -sinVAngle, zs));
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(xe, sinVAngle, ze));
+        points.push_back(glm::vec3(0,0,0));
+        points.push_back(glm::vec3(xe, -sinVAngle, ze));
 
         //Add two transducer dummies
         GLfloat offsetAngle = M_PI_2 - glm::radians(tilt);
@@ -275,6 +377,7 @@ std::vector<Renderable> SSS::Render()
         views[0] = glm::rotate(-offsetAngle, glm::vec3(0.f,1.f,0.f));
         views[1] = glm::rotate(offsetAngle, glm::vec3(0.f,1.f,0.f));
         item1.model = glMatrixFromTransform(getSensorFrame()) * views[0];
+        item1.data = OpenGLHelperArena::Commit();
         items.push_back(item1);
 
         Renderable item2;
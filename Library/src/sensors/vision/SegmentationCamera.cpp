@@ -92,27 +92,28 @@ void SegmentationCamera::SetupCamera(const Vector3& eye, const Vector3& dir, con
     glCamera->SetupCamera(eye_, dir_, up_);
 }
 
-void SegmentationCamera::InstallNewDataHandler(std::function<void(SegmentationCamera*)> callback)
+void SegmentationCamera::InstallNewDataHandler(std::function<void(SegmentationCamera*)> callback, bool display)
 {
     newDataCallback = callback;
+    SubscribeCallbackOutputs(newDataCallback != nullptr, display);
 }
 
 void SegmentationCamera::NewDataReady(void* data, unsigned int index)
 {
-    if(newDataCallback != nullptr)
+    if(index == 0)
     {
-        if(index == 0)
+        if(isOutputSubscribed(VisionOutput::DISPLAY))
         {
             unsigned int w, h;
             getResolution(w, h);
             memcpy(displayData, data, w*h*3);
         }
-        else
-        {
-            segmentationData = (GLushort*)data;
-            newDataCallback(this);
-            segmentationData = nullptr;
-        }
+    }
+    else if(newDataCallback != nullptr)
+    {
+        segmentationData = (GLushort*)data;
+        newDataCallback(this);
+        segmentationData = nullptr;
     }
 }
 
@@ -128,27 +128,28 @@ void ThermalCamera::SetupCamera(const Vector3& eye, const Vector3& dir, const Ve
     glCamera->SetupCamera(eye_, dir_, up_);
 }
 
-void ThermalCamera::InstallNewDataHandler(std::function<void(ThermalCamera*)> callback)
+void ThermalCamera::InstallNewDataHandler(std::function<void(ThermalCamera*)> callback, bool display)
 {
     newDataCallback = callback;
+    SubscribeCallbackOutputs(newDataCallback != nullptr, display);
 }
 
 void ThermalCamera::NewDataReady(void* data, unsigned int index)
 {
-    if(newDataCallback != nullptr)
+    if(index == 0)
     {
-        if(index == 0)
+        if(isOutputSubscribed(VisionOutput::DISPLAY))
         {
             unsigned int w, h;
             getResolution(w, h);
             memcpy(displayData, data, w*h*3);
         }
-        else
-        {
-            temperatureData = (GLfloat*)data;
-            newDataCallback(this);
-            temperatureData = nullptr;
-        }
+    }
+    else if(newDataCallback != nullptr)
+    {
+        temperatureData = (GLfloat*)data;
+        newDataCallback(this);
+        temperatureData = nullptr;
     }
 }
 
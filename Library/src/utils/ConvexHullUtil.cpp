@@ -0,0 +1,808 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  ConvexHullUtil.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "utils/ConvexHullUtil.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include "LinearMath/btConvexHullComputer.h"
+#include "core/SimulationApp.h"
+#include "graphics/OpenGLDataStructs.h"
+#include "utils/SystemUtil.hpp"
+
+namespace sf
+{
+
+//Convex hull with polygonal faces and outward normals
+struct HullFaces
+{
+    std::vector<Vector3> vertices;
+    std::vector<std::vector<int>> faces;
+    std::vector<Vector3> normals;
+    std::vector<Scalar> offsets;
+};
+
+static bool ComputeHull(const std::vector<Vector3>& points, HullFaces& hull)
+{
+    hull.vertices.clear();
+    hull.faces.clear();
+    hull.normals.clear();
+    hull.offsets.clear();
+    if(points.size() < 4)
+        return false;
+
+    btConvexHullComputer computer;
+    computer.compute(&points[0].x(), (int)sizeof(Vector3), (int)points.size(), Scalar(0), Scalar(0));
+    if(computer.vertices.size() < 4 || computer.faces.size() < 4) //Flat or degenerate
+        return false;
+
+    Vector3 center(0,0,0);
+    for(int i=0; i<computer.vertices.size(); ++i)
+    {
+        hull.vertices.push_back(computer.vertices[i]);
+        center += computer.vertices[i];
+    }
+    center /= Scalar(hull.vertices.size());
+
+    for(int i=0; i<computer.faces.size(); ++i)
+    {
+        std::vector<int> face;
+        const btConvexHullComputer::Edge* first = &computer.edges[computer.faces[i]];
+        const btConvexHullComputer::Edge* edge = first;
+        do
+        {
+            face.push_back(edge->getSourceVertex());
+            edge = edge->getNextEdgeOfFace();
+        }
+        while(edge != first);
+
+        //Area vector of the polygon, oriented outwards
+        Vector3 n(0,0,0);
+        for(size_t h=0; h<face.size(); ++h)
+            n += hull.vertices[face[h]].cross(hull.vertices[face[(h+1) % face.size()]]);
+        Scalar len = n.length();
+        if(len < SIMD_EPSILON)
+            continue;
+        n /= len;
+        Scalar d = n.dot(hull.vertices[face[0]]);
+        if(n.dot(center) > d)
+        {
+            n = -n;
+            d = -d;
+            std::reverse(face.begin(), face.end());
+        }
+        hull.faces.push_back(face);
+        hull.normals.push_back(n);
+        hull.offsets.push_back(d);
+    }
+    return hull.faces.size() >= 4;
+}
+
+static Scalar HullVolume(const HullFaces& hull)
+{
+    Scalar volume(0);
+    const Vector3& o = hull.vertices[0];
+    for(size_t i=0; i<hull.faces.size(); ++i)
+    {
+        const std::vector<int>& face = hull.faces[i];
+        const Vector3& a = hull.vertices[face[0]];
+        for(size_t h=1; h+1<face.size(); ++h)
+            volume += (a - o).dot((hull.vertices[face[h]] - o).cross(hull.vertices[face[h+1]] - o));
+    }
+    return volume/Scalar(6);
+}
+
+static Vector3 ClosestPointOnTriangle(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c)
+{
+    Vector3 ab = b - a;
+    Vector3 ac = c - a;
+    Vector3 ap = p - a;
+    Scalar d1 = ab.dot(ap);
+    Scalar d2 = ac.dot(ap);
+    if(d1 <= Scalar(0) && d2 <= Scalar(0))
+        return a;
+
+    Vector3 bp = p - b;
+    Scalar d3 = ab.dot(bp);
+    Scalar d4 = ac.dot(bp);
+    if(d3 >= Scalar(0) && d4 <= d3)
+        return b;
+
+    Scalar vc = d1 * d4 - d3 * d2;
+    if(vc <= Scalar(0) && d1 >= Scalar(0) && d3 <= Scalar(0))
+        return a + ab * (d1/(d1 - d3));
+
+    Vector3 cp = p - c;
+    Scalar d5 = ab.dot(cp);
+    Scalar d6 = ac.dot(cp);
+    if(d6 >= Scalar(0) && d5 <= d6)
+        return c;
+
+    Scalar vb = d5 * d2 - d1 * d6;
+    if(vb <= Scalar(0) && d2 >= Scalar(0) && d6 <= Scalar(0))
+        return a + ac * (d2/(d2 - d6));
+
+    Scalar va = d3 * d6 - d5 * d4;
+    if(va <= Scalar(0) && (d4 - d3) >= Scalar(0) && (d5 - d6) >= Scalar(0))
+        return b + (c - b) * ((d4 - d3)/((d4 - d3) + (d5 - d6)));
+
+    Scalar denom = Scalar(1)/(va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+//Euclidean distance of a point from the hull (zero inside)
+static Scalar HullDistance(const HullFaces& hull, const Vector3& p)
+{
+    Scalar maxPlane(-BT_LARGE_FLOAT);
+    for(size_t i=0; i<hull.faces.size(); ++i)
+        maxPlane = btMax(maxPlane, hull.normals[i].dot(p) - hull.offsets[i]);
+    if(maxPlane <= Scalar(0))
+        return Scalar(0);
+
+    //The closest point lies on one of the faces visible from the point
+    Scalar minDist2(BT_LARGE_FLOAT);
+    for(size_t i=0; i<hull.faces.size(); ++i)
+    {
+        if(hull.normals[i].dot(p) - hull.offsets[i] <= Scalar(0))
+            continue;
+        const std::vector<int>& face = hull.faces[i];
+        const Vector3& a = hull.vertices[face[0]];
+        for(size_t h=1; h+1<face.size(); ++h)
+            minDist2 = btMin(minDist2, ClosestPointOnTriangle(p, a, hull.vertices[face[h]], hull.vertices[face[h+1]]).distance2(p));
+    }
+    return btSqrt(minDist2);
+}
+
+std::vector<Vector3> ReduceConvexHull(const std::vector<Vector3>& points, Scalar tolerance, unsigned int maxVertices)
+{
+    HullFaces full;
+    if(!ComputeHull(points, full))
+        return points;
+
+    const std::vector<Vector3>& V = full.vertices;
+    if(V.size() <= 4 || (tolerance <= Scalar(0) && (maxVertices == 0 || V.size() <= maxVertices)))
+        return V;
+
+    //Initial tetrahedron spanned by extreme points
+    size_t id[4] = {0, 0, 0, 0};
+    for(size_t i=1; i<V.size(); ++i)
+        if(V[i].x() < V[id[0]].x())
+            id[0] = i;
+    Scalar best(0);
+    for(size_t i=0; i<V.size(); ++i)
+        if(V[i].distance2(V[id[0]]) > best)
+        {
+            best = V[i].distance2(V[id[0]]);
+            id[1] = i;
+        }
+    Vector3 axis = V[id[1]] - V[id[0]];
+    best = Scalar(0);
+    for(size_t i=0; i<V.size(); ++i)
+        if((V[i] - V[id[0]]).cross(axis).length2() > best)
+        {
+            best = (V[i] - V[id[0]]).cross(axis).length2();
+            id[2] = i;
+        }
+    Vector3 normal = axis.cross(V[id[2]] - V[id[0]]).normalized();
+    best = Scalar(0);
+    for(size_t i=0; i<V.size(); ++i)
+        if(btFabs((V[i] - V[id[0]]).dot(normal)) > best)
+        {
+            best = btFabs((V[i] - V[id[0]]).dot(normal));
+            id[3] = i;
+        }
+
+    std::vector<Vector3> selected;
+    std::vector<unsigned int> stamp(V.size(), 0);
+    HullFaces reduced;
+    for(unsigned int i=0; i<4; ++i)
+    {
+        selected.push_back(V[id[i]]);
+        stamp[id[i]] = UINT32_MAX;
+    }
+    if(!ComputeHull(selected, reduced))
+        return V;
+    unsigned int generation = 1;
+
+    //Lazy greedy selection of the furthest point (distances to a growing hull never increase, so old values are upper bounds)
+    std::priority_queue<std::pair<Scalar, size_t>> queue;
+    for(size_t i=0; i<V.size(); ++i)
+    {
+        if(stamp[i] == UINT32_MAX)
+            continue;
+        Scalar d = HullDistance(reduced, V[i]);
+        stamp[i] = generation;
+        if(d > tolerance)
+            queue.push(std::make_pair(d, i));
+    }
+
+    while(!queue.empty() && (maxVertices == 0 || selected.size() < maxVertices))
+    {
+        size_t i = queue.top().second;
+        queue.pop();
+
+        if(stamp[i] != generation) //Outdated upper bound
+        {
+            Scalar d = HullDistance(reduced, V[i]);
+            stamp[i] = generation;
+            if(d > tolerance)
+                queue.push(std::make_pair(d, i));
+            continue;
+        }
+
+        selected.push_back(V[i]);
+        stamp[i] = UINT32_MAX;
+        ComputeHull(selected, reduced);
+        ++generation;
+    }
+    return selected;
+}
+
+Scalar ConvexHullVolume(const std::vector<Vector3>& points)
+{
+    HullFaces hull;
+    return ComputeHull(points, hull) ? HullVolume(hull) : Scalar(0);
+}
+
+//// Convex decomposition
+
+struct DecompositionGrid
+{
+    int n[3];
+    Vector3 origin; //Corner of the grid
+    Scalar h; //Edge of a voxel
+    std::vector<uint8_t> solid;
+
+    size_t Index(int i, int j, int k) const
+    {
+        return ((size_t)k * n[1] + j) * n[0] + i;
+    }
+
+    Vector3 Center(int i, int j, int k) const
+    {
+        return origin + Vector3(i + Scalar(0.5), j + Scalar(0.5), k + Scalar(0.5)) * h;
+    }
+};
+
+struct DecompositionPart
+{
+    int lo[3]; //Tight bounds of the voxels (inclusive)
+    int hi[3];
+    int cut[3][2]; //Cutting planes at voxel boundaries (-1 if not cut)
+    size_t voxels;
+    Scalar concavity;
+};
+
+static void Voxelize(const std::vector<Vector3>& triangles, unsigned int resolution, DecompositionGrid& grid)
+{
+    Vector3 bmin = VMAX();
+    Vector3 bmax = -VMAX();
+    for(size_t i=0; i<triangles.size(); ++i)
+    {
+        bmin.setMin(triangles[i]);
+        bmax.setMax(triangles[i]);
+    }
+    Vector3 ext = bmax - bmin;
+    grid.h = btMax(ext.x(), btMax(ext.y(), ext.z()))/Scalar(btMax(resolution, 1u));
+    for(int a=0; a<3; ++a)
+        grid.n[a] = btMax(1, (int)std::ceil(ext[a]/grid.h));
+    grid.origin = (bmin + bmax)/Scalar(2) - Vector3(grid.n[0], grid.n[1], grid.n[2]) * grid.h/Scalar(2);
+    grid.solid.assign((size_t)grid.n[0] * grid.n[1] * grid.n[2], 0);
+
+    //Parity of the crossings of rays along x (slightly offset from the voxel centres to avoid hitting edges)
+    const Scalar offset[2] = {Scalar(0.5001237), Scalar(0.5002713)};
+    std::vector<std::vector<Scalar>> rows((size_t)grid.n[1] * grid.n[2]);
+    for(size_t t=0; t<triangles.size(); t+=3)
+    {
+        const Vector3& a = triangles[t];
+        const Vector3& b = triangles[t+1];
+        const Vector3& c = triangles[t+2];
+        Scalar area = (b.y() - a.y()) * (c.z() - a.z()) - (b.z() - a.z()) * (c.y() - a.y());
+        if(btFuzzyZero(area)) //Parallel to the rays
+            continue;
+
+        int range[2][2];
+        for(int a2=0; a2<2; ++a2)
+        {
+            Scalar lo = (btMin(a[a2+1], btMin(b[a2+1], c[a2+1])) - grid.origin[a2+1])/grid.h - offset[a2];
+            Scalar hi = (btMax(a[a2+1], btMax(b[a2+1], c[a2+1])) - grid.origin[a2+1])/grid.h - offset[a2];
+            range[a2][0] = btMax(0, (int)std::ceil(lo));
+            range[a2][1] = btMin(grid.n[a2+1]-1, (int)std::floor(hi));
+        }
+
+        for(int k=range[1][0]; k<=range[1][1]; ++k)
+            for(int j=range[0][0]; j<=range[0][1]; ++j)
+            {
+                Scalar y = grid.origin.y() + (j + offset[0]) * grid.h;
+                Scalar z = grid.origin.z() + (k + offset[1]) * grid.h;
+                Scalar w0 = (c.y() - b.y()) * (z - b.z()) - (c.z() - b.z()) * (y - b.y());
+                Scalar w1 = (a.y() - c.y()) * (z - c.z()) - (a.z() - c.z()) * (y - c.y());
+                Scalar w2 = area - w0 - w1;
+                if(area < Scalar(0))
+                {
+                    w0 = -w0;
+                    w1 = -w1;
+                    w2 = -w2;
+                }
+                if(w0 < Scalar(0) || w1 < Scalar(0) || w2 < Scalar(0))
+                    continue;
+                rows[(size_t)k * grid.n[1] + j].push_back((w0 * a.x() + w1 * b.x() + w2 * c.x())/btFabs(area));
+            }
+    }
+
+    std::vector<uint8_t> empty(rows.size(), 1);
+    for(int k=0; k<grid.n[2]; ++k)
+        for(int j=0; j<grid.n[1]; ++j)
+        {
+            std::vector<Scalar>& row = rows[(size_t)k * grid.n[1] + j];
+            std::sort(row.begin(), row.end());
+            for(size_t h=0; h+1<row.size(); h+=2)
+            {
+                int ilo = btMax(0, (int)std::ceil((row[h] - grid.origin.x())/grid.h - Scalar(0.5)));
+                int ihi = btMin(grid.n[0]-1, (int)std::floor((row[h+1] - grid.origin.x())/grid.h - Scalar(0.5)));
+                for(int i=ilo; i<=ihi; ++i)
+                {
+                    grid.solid[grid.Index(i, j, k)] = 1;
+                    empty[(size_t)k * grid.n[1] + j] = 0;
+                }
+            }
+        }
+
+    //Features thinner than a voxel, missed by all rays of a row (marking other rows would break the convexity of convex meshes)
+    for(size_t t=0; t<triangles.size(); ++t)
+    {
+        int id[3];
+        for(int a=0; a<3; ++a)
+            id[a] = btMax(0, btMin(grid.n[a]-1, (int)std::floor((triangles[t][a] - grid.origin[a])/grid.h)));
+        if(empty[(size_t)id[2] * grid.n[1] + id[1]])
+            grid.solid[grid.Index(id[0], id[1], id[2])] = 2;
+    }
+}
+
+//Voxel centres at the ends of each row of the part, padded to cubes (enough to span the hull), and the number of voxels
+static size_t PartPoints(const DecompositionGrid& grid, const int lo[3], const int hi[3], Scalar pad, bool interiorOnly, std::vector<Vector3>& points)
+{
+    size_t count = 0;
+    points.clear();
+    for(int k=lo[2]; k<=hi[2]; ++k)
+        for(int j=lo[1]; j<=hi[1]; ++j)
+        {
+            int first = -1;
+            int last = -1;
+            for(int i=lo[0]; i<=hi[0]; ++i)
+                if(grid.solid[grid.Index(i, j, k)] == 1 || (!interiorOnly && grid.solid[grid.Index(i, j, k)]))
+                {
+                    if(first < 0)
+                        first = i;
+                    last = i;
+                    ++count;
+                }
+            if(first >= 0)
+                for(int q=0; q<4; ++q)
+                {
+                    Vector3 offset(Scalar(0), (q & 1) ? pad : -pad, (q >> 1) ? pad : -pad);
+                    points.push_back(grid.Center(first, j, k) + offset - Vector3(pad, 0, 0));
+                    points.push_back(grid.Center(last, j, k) + offset + Vector3(pad, 0, 0));
+                }
+        }
+    return count;
+}
+
+static bool TightenPart(const DecompositionGrid& grid, DecompositionPart& part)
+{
+    int lo[3] = {INT32_MAX, INT32_MAX, INT32_MAX};
+    int hi[3] = {-1, -1, -1};
+    part.voxels = 0;
+    for(int k=part.lo[2]; k<=part.hi[2]; ++k)
+        for(int j=part.lo[1]; j<=part.hi[1]; ++j)
+            for(int i=part.lo[0]; i<=part.hi[0]; ++i)
+                if(grid.solid[grid.Index(i, j, k)])
+                {
+                    int id[3] = {i, j, k};
+                    for(int a=0; a<3; ++a)
+                    {
+                        lo[a] = std::min(lo[a], id[a]);
+                        hi[a] = std::max(hi[a], id[a]);
+                    }
+                    ++part.voxels;
+                }
+    if(part.voxels == 0)
+        return false;
+    for(int a=0; a<3; ++a)
+    {
+        part.lo[a] = lo[a];
+        part.hi[a] = hi[a];
+    }
+    return true;
+}
+
+//Fraction of the solid voxels, which are empty but inside the hull of the interior voxel centres of the part (none for a convex part)
+static Scalar PartConcavity(const DecompositionGrid& grid, const DecompositionPart& part, size_t totalVoxels)
+{
+    //Small padding keeps the hull of flat parts non-degenerate
+    Scalar pad = grid.h * Scalar(0.01);
+    std::vector<Vector3> points;
+    PartPoints(grid, part.lo, part.hi, pad, true, points);
+    HullFaces hull;
+    if(!ComputeHull(points, hull))
+        return Scalar(0);
+
+    size_t empty = 0;
+    for(int k=part.lo[2]; k<=part.hi[2]; ++k)
+        for(int j=part.lo[1]; j<=part.hi[1]; ++j)
+            for(int i=part.lo[0]; i<=part.hi[0]; ++i)
+            {
+                if(grid.solid[grid.Index(i, j, k)])
+                    continue;
+                Vector3 c = grid.Center(i, j, k);
+                size_t f = 0;
+                for(; f<hull.faces.size(); ++f)
+                    if(hull.normals[f].dot(c) - hull.offsets[f] > pad)
+                        break;
+                if(f == hull.faces.size())
+                    ++empty;
+            }
+    return Scalar(empty)/Scalar(totalVoxels);
+}
+
+//Axis-aligned split minimising the sum of the volumes of the hulls of both halves
+static bool SplitPart(const DecompositionGrid& grid, const DecompositionPart& part, DecompositionPart& left, DecompositionPart& right)
+{
+    Scalar bestCost(BT_LARGE_FLOAT);
+    int bestAxis = -1;
+    int bestPlane = -1;
+    Scalar pad = grid.h/Scalar(2);
+    std::vector<Vector3> points;
+    PartPoints(grid, part.lo, part.hi, pad, false, points);
+    Scalar hullVolume = ConvexHullVolume(points);
+    Scalar voxelVolume = Scalar(part.voxels) * grid.h * grid.h * grid.h;
+
+    for(int a=0; a<3; ++a)
+    {
+        int len = part.hi[a] - part.lo[a] + 1;
+        if(len < 2)
+            continue;
+        int steps = std::min(len - 1, 16);
+        for(int s=1; s<=steps; ++s)
+        {
+            int plane = part.lo[a] + (s * len)/(steps + 1); //First voxel of the right half
+            if(plane <= part.lo[a] || plane > part.hi[a])
+                continue;
+
+            int lo[3] = {part.lo[0], part.lo[1], part.lo[2]};
+            int hi[3] = {part.hi[0], part.hi[1], part.hi[2]};
+            hi[a] = plane - 1;
+            if(PartPoints(grid, lo, hi, pad, false, points) == 0)
+                continue;
+            Scalar cost = ConvexHullVolume(points);
+            hi[a] = part.hi[a];
+            lo[a] = plane;
+            if(PartPoints(grid, lo, hi, pad, false, points) == 0)
+                continue;
+            cost += ConvexHullVolume(points);
+
+            if(cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = a;
+                bestPlane = plane;
+            }
+        }
+    }
+
+    //A single cut through a hole (e.g. of a torus) does not reduce the hulls, so the part is halved along its longest side
+    if(bestAxis < 0 || hullVolume - bestCost < Scalar(0.1) * (hullVolume - voxelVolume))
+    {
+        bestAxis = -1;
+        int longest = 1;
+        for(int a=0; a<3; ++a)
+            if(part.hi[a] - part.lo[a] + 1 > longest)
+            {
+                longest = part.hi[a] - part.lo[a] + 1;
+                bestAxis = a;
+            }
+        if(bestAxis < 0)
+            return false;
+        bestPlane = part.lo[bestAxis] + longest/2;
+    }
+
+    left = part;
+    right = part;
+    left.hi[bestAxis] = bestPlane - 1;
+    left.cut[bestAxis][1] = bestPlane;
+    right.lo[bestAxis] = bestPlane;
+    right.cut[bestAxis][0] = bestPlane;
+    return TightenPart(grid, left) && TightenPart(grid, right);
+}
+
+static void ClipPolygon(std::vector<Vector3>& polygon, int axis, Scalar value, Scalar sign, std::vector<Vector3>& buffer)
+{
+    buffer.clear();
+    for(size_t i=0; i<polygon.size(); ++i)
+    {
+        const Vector3& cur = polygon[i];
+        const Vector3& next = polygon[(i+1) % polygon.size()];
+        Scalar dc = sign * (cur[axis] - value);
+        Scalar dn = sign * (next[axis] - value);
+        if(dc >= Scalar(0))
+            buffer.push_back(cur);
+        if((dc >= Scalar(0)) != (dn >= Scalar(0)))
+            buffer.push_back(cur + (next - cur) * (dc/(dc - dn)));
+    }
+    polygon.swap(buffer);
+}
+
+//Points of the part: mesh triangles clipped by the cutting planes and voxel faces lying on the cutting planes
+static void PartHullPoints(const DecompositionGrid& grid, const DecompositionPart& part, const std::vector<Vector3>& triangles, std::vector<Vector3>& points)
+{
+    points.clear();
+    std::vector<Vector3> polygon;
+    std::vector<Vector3> buffer;
+    Scalar eps = grid.h * Scalar(1e-4);
+    for(size_t t=0; t<triangles.size(); t+=3)
+    {
+        polygon.assign(triangles.begin() + t, triangles.begin() + t + 3);
+        for(int a=0; a<3 && !polygon.empty(); ++a)
+        {
+            if(part.cut[a][0] >= 0)
+                ClipPolygon(polygon, a, grid.origin[a] + part.cut[a][0] * grid.h - eps, Scalar(1), buffer);
+            if(part.cut[a][1] >= 0 && !polygon.empty())
+                ClipPolygon(polygon, a, grid.origin[a] + part.cut[a][1] * grid.h + eps, Scalar(-1), buffer);
+        }
+        points.insert(points.end(), polygon.begin(), polygon.end());
+    }
+
+    for(int a=0; a<3; ++a)
+    {
+        int b = (a + 1) % 3;
+        int c = (a + 2) % 3;
+        for(int side=0; side<2; ++side)
+        {
+            if(part.cut[a][side] < 0)
+                continue;
+            int layer = side == 0 ? part.cut[a][0] : part.cut[a][1] - 1;
+            if(layer < part.lo[a] || layer > part.hi[a])
+                continue;
+            for(int v=part.lo[c]; v<=part.hi[c]; ++v)
+                for(int u=part.lo[b]; u<=part.hi[b]; ++u)
+                {
+                    int id[3];
+                    id[a] = layer;
+                    id[b] = u;
+                    id[c] = v;
+                    if(!grid.solid[grid.Index(id[0], id[1], id[2])])
+                        continue;
+                    Vector3 corner = grid.origin;
+                    corner[a] += part.cut[a][side] * grid.h;
+                    for(int q=0; q<4; ++q)
+                    {
+                        Vector3 p = corner;
+                        p[b] += (u + (q & 1)) * grid.h;
+                        p[c] += (v + (q >> 1)) * grid.h;
+                        points.push_back(p);
+                    }
+                }
+        }
+    }
+}
+
+static uint64_t DecompositionKey(const std::vector<Vector3>& triangles, const ConvexDecompositionSettings& settings)
+{
+    //FNV-1a
+    const uint32_t version = 1;
+    uint64_t hash = 14695981039346656037ULL;
+    auto add = [&hash](const void* data, size_t size)
+    {
+        const uint8_t* bytes = (const uint8_t*)data;
+        for(size_t i=0; i<size; ++i)
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    };
+    add(&version, sizeof(version));
+    for(size_t i=0; i<triangles.size(); ++i)
+    {
+        float v[3] = {(float)triangles[i].x(), (float)triangles[i].y(), (float)triangles[i].z()};
+        add(v, sizeof(v));
+    }
+    double params[2] = {(double)settings.concavity, (double)settings.hullTolerance};
+    uint32_t iparams[2] = {settings.resolution, settings.maxParts};
+    add(params, sizeof(params));
+    add(iparams, sizeof(iparams));
+    return hash;
+}
+
+static std::string DecompositionCachePath(uint64_t key)
+{
+    std::string path = GetCachePath();
+    if(path == "")
+        return "";
+    path = (std::filesystem::path(path) / "hulls").string() + "/";
+    std::error_code ec;
+    std::filesystem::create_directories(path, ec);
+    if(ec)
+        return "";
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+    return path + name.str();
+}
+
+static bool LoadDecomposition(const std::string& path, uint64_t key, std::vector<std::vector<Vector3>>& parts)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if(!file.is_open())
+        return false;
+
+    //Sizes read from the file are validated against its length before allocating (truncated or corrupted cache = miss)
+    std::streamoff remaining = file.tellg();
+    file.seekg(0);
+    uint64_t storedKey = 0;
+    uint32_t numParts = 0;
+    file.read((char*)&storedKey, sizeof(storedKey));
+    file.read((char*)&numParts, sizeof(numParts));
+    remaining -= sizeof(storedKey) + sizeof(numParts);
+    if(!file || storedKey != key || numParts == 0 || (uint64_t)numParts * sizeof(uint32_t) > (uint64_t)remaining)
+        return false;
+
+    std::vector<std::vector<Vector3>> loaded(numParts);
+    for(uint32_t i=0; i<numParts; ++i)
+    {
+        uint32_t count = 0;
+        file.read((char*)&count, sizeof(count));
+        remaining -= sizeof(count);
+        if(!file || (uint64_t)count * 3 * sizeof(double) > (uint64_t)remaining)
+            return false;
+        std::vector<double> data((size_t)count * 3);
+        file.read((char*)data.data(), data.size() * sizeof(double));
+        remaining -= data.size() * sizeof(double);
+        if(!file)
+            return false;
+        loaded[i].resize(count);
+        for(uint32_t h=0; h<count; ++h)
+            loaded[i][h] = Vector3(data[h*3], data[h*3+1], data[h*3+2]);
+    }
+    if(remaining != 0)
+        return false;
+    parts.swap(loaded);
+    return true;
+}
+
+static void SaveDecomposition(const std::string& path, uint64_t key, const std::vector<std::vector<Vector3>>& parts)
+{
+    //Write to a temporary file first, so that concurrent instances never read a partial result
+    std::string tmpPath = path + "." + std::to_string(GetTimeInMicroseconds()) + ".tmp";
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if(!file.is_open())
+        return;
+    uint32_t numParts = (uint32_t)parts.size();
+    file.write((const char*)&key, sizeof(key));
+    file.write((const char*)&numParts, sizeof(numParts));
+    for(size_t i=0; i<parts.size(); ++i)
+    {
+        uint32_t count = (uint32_t)parts[i].size();
+        std::vector<double> data(count * 3);
+        for(uint32_t h=0; h<count; ++h)
+        {
+            data[h*3] = parts[i][h].x();
+            data[h*3+1] = parts[i][h].y();
+            data[h*3+2] = parts[i][h].z();
+        }
+        file.write((const char*)&count, sizeof(count));
+        file.write((const char*)data.data(), data.size() * sizeof(double));
+    }
+    file.close();
+
+    std::error_code ec;
+    if(file.fail())
+        std::filesystem::remove(tmpPath, ec);
+    else
+    {
+        std::filesystem::rename(tmpPath, path, ec);
+        if(ec)
+            std::filesystem::remove(tmpPath, ec);
+    }
+}
+
+std::vector<std::vector<Vector3>> DecomposeConvex(const Mesh* mesh, const ConvexDecompositionSettings& settings)
+{
+    std::vector<std::vector<Vector3>> parts;
+    std::vector<Vector3> triangles;
+    triangles.reserve(mesh->faces.size() * 3);
+    for(size_t i=0; i<mesh->faces.size(); ++i)
+        for(unsigned short h=0; h<3; ++h)
+        {
+            glm::vec3 p = mesh->getVertexPos(i, h);
+            triangles.push_back(Vector3(p.x, p.y, p.z));
+        }
+    if(triangles.empty())
+        return parts;
+
+    uint64_t key = DecompositionKey(triangles, settings);
+    std::string cachePath = DecompositionCachePath(key);
+    if(cachePath != "" && LoadDecomposition(cachePath, key, parts))
+        return parts;
+
+    int64_t start = GetTimeInMicroseconds();
+    DecompositionGrid grid;
+    Voxelize(triangles, settings.resolution, grid);
+
+    std::vector<DecompositionPart> pending(1);
+    DecompositionPart& root = pending[0];
+    for(int a=0; a<3; ++a)
+    {
+        root.lo[a] = 0;
+        root.hi[a] = grid.n[a]-1;
+        root.cut[a][0] = root.cut[a][1] = -1;
+    }
+    if(!TightenPart(grid, root))
+        return parts;
+    size_t totalVoxels = root.voxels;
+    root.concavity = PartConcavity(grid, root, totalVoxels);
+
+    //Best-first splitting of the most concave part
+    while(pending.size() < btMax(settings.maxParts, 1u))
+    {
+        size_t worst = 0;
+        for(size_t i=1; i<pending.size(); ++i)
+            if(pending[i].concavity > pending[worst].concavity)
+                worst = i;
+        if(pending[worst].concavity <= settings.concavity)
+            break;
+
+        DecompositionPart left, right;
+        if(!SplitPart(grid, pending[worst], left, right))
+        {
+            pending[worst].concavity = Scalar(0);
+            continue;
+        }
+        left.concavity = PartConcavity(grid, left, totalVoxels);
+        right.concavity = PartConcavity(grid, right, totalVoxels);
+        pending[worst] = left;
+        pending.push_back(right);
+    }
+
+    std::vector<Vector3> points;
+    size_t vertices = 0;
+    for(size_t i=0; i<pending.size(); ++i)
+    {
+        PartHullPoints(grid, pending[i], triangles, points);
+        if(points.size() < 4)
+            continue;
+        parts.push_back(ReduceConvexHull(points, btMax(settings.hullTolerance, Scalar(0))));
+        vertices += parts.back().size();
+    }
+
+    cInfo("Decomposed mesh into %lu convex parts with %lu vertices in total (%1.3lf s).",
+          parts.size(), vertices, (GetTimeInMicroseconds() - start)/1e6);
+
+    if(cachePath != "" && !parts.empty())
+        SaveDecomposition(cachePath, key, parts);
+    return parts;
+}
+
+}
@@ -0,0 +1,996 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  BenchmarkManager.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "BenchmarkManager.h"
+
+#include <core/FeatherstoneRobot.h>
+#include <core/ScenarioParser.h>
+#include <entities/statics/Plane.h>
+#include <entities/statics/Obstacle.h>
+#include <entities/solids/Box.h>
+#include <entities/solids/Sphere.h>
+#include <entities/solids/Cylinder.h>
+#include <entities/solids/Polyhedron.h>
+#include <entities/solids/Torus.h>
+#include <entities/CableEntity.h>
+#include <entities/forcefields/Ocean.h>
+#include <entities/forcefields/Trigger.h>
+#include <actuators/Servo.h>
+#include <actuators/SuctionCup.h>
+#include <sensors/scalar/IMU.h>
+#include <sensors/scalar/Odometry.h>
+#include <sensors/scalar/Pressure.h>
+#include <sensors/scalar/RotaryEncoder.h>
+#include <sensors/scalar/Multibeam.h>
+#include <sensors/Contact.h>
+#include <utils/SystemUtil.hpp>
+#include <utils/UnitSystem.h>
+#include <iostream>
+#include <filesystem>
+#include <map>
+#include <set>
+
+BenchmarkManager::BenchmarkManager(BenchmarkScenario scenario, unsigned int size, unsigned int steps, unsigned int warmupSteps, sf::Scalar stepsPerSecond)
+    : SimulationManager(stepsPerSecond, sf::Solver::SI, sf::CollisionFilter::EXCLUSIVE), 
+      scenario(scenario), size(size), steps(steps), warmup(warmupSteps), counter(0), finished(false),
+      physicsTime(0.0), hydroTime(0.0), contacts(0), allocCount(0), allocBytes(0), controlTime(0.0),
+      checks(false), failedChecks(0), controllers(true), terrain(nullptr)
+{
+}
+
+void BenchmarkManager::BuildScenario()
+{
+    setICSolverParams(false);
+
+    ///////MATERIALS////////
+    CreateMaterial("Ground", 1000.0, 0.5);
+    CreateMaterial("Steel", sf::UnitSystem::Density(sf::CGS, sf::MKS, 7.8), 0.2);
+    CreateMaterial("Plastic", sf::UnitSystem::Density(sf::CGS, sf::MKS, 1.05), 0.3);
+    SetMaterialsInteraction("Ground", "Ground", 0.5, 0.3);
+    SetMaterialsInteraction("Ground", "Steel", 0.5, 0.3);
+    SetMaterialsInteraction("Ground", "Plastic", 0.6, 0.4);
+    SetMaterialsInteraction("Steel", "Steel", 0.3, 0.2);
+    SetMaterialsInteraction("Steel", "Plastic", 0.4, 0.3);
+    SetMaterialsInteraction("Plastic", "Plastic", 0.5, 0.4);
+
+    switch(scenario)
+    {
+        case BenchmarkScenario::FALLING:
+            BuildFalling();
+            break;
+
+        case BenchmarkScenario::PILE:
+            BuildPile(size);
+            break;
+
+        case BenchmarkScenario::HULLS:
+            BuildHulls(false);
+            break;
+
+        case BenchmarkScenario::HULLS_REDUCED:
+            BuildHulls(true);
+            break;
+
+        case BenchmarkScenario::SEABED:
+            BuildSeabed();
+            break;
+
+        case BenchmarkScenario::CABLE:
+            BuildCable();
+            break;
+
+        case BenchmarkScenario::MULTIBEAM:
+            BuildMultibeam();
+            break;
+
+        case BenchmarkScenario::ROBOTS:
+            BuildRobots();
+            break;
+
+        case BenchmarkScenario::SUCTION:
+            BuildSuction();
+            break;
+
+        case BenchmarkScenario::TRIGGERS:
+            BuildTriggers();
+            break;
+
+        case BenchmarkScenario::MESHES:
+            BuildMeshes(-1.0, false);
+            break;
+
+        case BenchmarkScenario::MESHES_REDUCED:
+            BuildMeshes(0.001, false);
+            break;
+
+        case BenchmarkScenario::MESHES_DECOMPOSED:
+            BuildMeshes(0.001, true);
+            break;
+
+        case BenchmarkScenario::TORI:
+            BuildTori();
+            break;
+
+        case BenchmarkScenario::ARMS:
+        case BenchmarkScenario::ARMS_BATCHED:
+            BuildArms();
+            break;
+
+        case BenchmarkScenario::REPLAY:
+            BuildReplay();
+            break;
+
+        case BenchmarkScenario::TERRAIN:
+            BuildTerrain();
+            break;
+
+        case BenchmarkScenario::CONSOLE_TEST:
+            BuildParsed("console_test.scn");
+            break;
+    }
+}
+
+//N bodies of mixed shapes falling on a plane (few contacts until landing)
+void BenchmarkManager::BuildFalling()
+{
+    sf::Plane* floor = new sf::Plane("Floor", 10000.0, "Ground");
+    AddStaticEntity(floor, sf::I4());
+
+    sf::PhysicsSettings phy;
+    phy.mode = sf::PhysicsMode::SURFACE;
+    phy.collisions = true;
+
+    unsigned int row = (unsigned int)ceil(sqrt((double)size));
+    for(unsigned int i=0; i<size; ++i)
+    {
+        sf::SolidEntity* solid;
+        switch(i % 3)
+        {
+            case 0:
+                solid = new sf::Sphere("Sphere", phy, 0.15, sf::I4(), "Steel", "");
+                break;
+            case 1:
+                solid = new sf::Box("Box", phy, sf::Vector3(0.3, 0.2, 0.1), sf::I4(), "Plastic", "");
+                break;
+            default:
+                solid = new sf::Cylinder("Cylinder", phy, 0.1, 0.3, sf::I4(), "Plastic", "");
+                break;
+        }
+        sf::Vector3 pos((i % row) * 1.0, (i / row) * 1.0, -2.0 - 0.5 * (i % 5));
+        AddSolidEntity(solid, sf::Transform(sf::Quaternion(0.1*i, 0.2*i, 0.3*i), pos));
+    }
+}
+
+//N boxes dropped as a dense column into a bin (contact-heavy)
+void BenchmarkManager::BuildPile(unsigned int boxes)
+{
+    sf::Plane* floor = new sf::Plane("Floor", 10000.0, "Ground");
+    AddStaticEntity(floor, sf::I4());
+
+    const sf::Scalar b = 0.2;
+    const sf::Scalar binSize = 6 * b;
+    for(unsigned int i=0; i<4; ++i)
+    {
+        sf::Scalar angle = i * M_PI_2;
+        sf::Obstacle* wall = new sf::Obstacle("Wall", sf::Vector3(binSize, 0.05, 1.0), sf::I4(), "Ground");
+        AddStaticEntity(wall, sf::Transform(sf::Quaternion(angle, 0, 0), 
+                                            sf::Vector3(btSin(angle) * binSize/2, -btCos(angle) * binSize/2, -0.5) + sf::Vector3(binSize/2 - b/2, binSize/2 - b/2, 0)));
+    }
+
+    sf::PhysicsSettings phy;
+    phy.mode = sf::PhysicsMode::SURFACE;
+    phy.collisions = true;
+
+    for(unsigned int i=0; i<boxes; ++i)
+    {
+        sf::Box* box = new sf::Box("Box", phy, sf::Vector3(b, b, b) * 0.95, sf::I4(), "Plastic", "");
+        sf::Vector3 pos((i % 5) * b * 1.05, ((i / 5) % 5) * b * 1.05, -b/2 - 0.01 - (i / 25) * b * 1.05);
+        AddSolidEntity(box, sf::Transform(sf::Quaternion(0.01*i, 0, 0), pos));
+    }
+}
+
+//M submerged polyhedral hulls with different physics mesh face counts (optionally with the reduced-order drag model)
+void BenchmarkManager::BuildHulls(bool reducedDrag)
+{
+    EnableOcean(0.0);
+    
+    const std::vector<std::pair<std::string, sf::Scalar>> meshes = {
+        {"icosphere.obj", 0.5},
+        {"duct_hydro.obj", 1.0},
+        {"sphere_R=1.obj", 0.3},
+        {"hull_hydro.obj", 1.0}
+    };
+
+    sf::PhysicsSettings phy;
+    phy.mode = sf::PhysicsMode::SUBMERGED;
+    phy.collisions = true;
+    phy.buoyancy = true;
+    phy.reducedDrag = reducedDrag;
+
+    unsigned int row = (unsigned int)ceil(sqrt((double)size));
+    for(unsigned int i=0; i<size; ++i)
+    {
+        const auto& mesh = meshes[i % meshes.size()];
+        sf::Polyhedron* hull = new sf::Polyhedron("Hull", phy, sf::GetDataPath() + mesh.first, mesh.second, sf::I4(), "Plastic", "");
+        AddSolidEntity(hull, sf::Transform(sf::IQ(), sf::Vector3((i % row) * 4.0, (i / row) * 4.0, 5.0)));
+    }
+}
+
+//M polyhedral hulls resting on the seabed, with the detection of hydrodynamic quiescence
+void BenchmarkManager::BuildSeabed()
+{
+    BuildHulls(false);
+    getOcean()->setHydrodynamicsQuiescence(0.01, 0.01, 0.005, 0.005);
+    
+    sf::Plane* seabed = new sf::Plane("Seabed", 10000.0, "Ground");
+    AddStaticEntity(seabed, sf::Transform(sf::IQ(), sf::Vector3(0, 0, 7.0)));
+}
+
+//A long submerged cable with N segments hanging from a fixed point
+void BenchmarkManager::BuildCable()
+{
+    EnableOcean(0.0);
+
+    sf::PhysicsSettings phy;
+    phy.mode = sf::PhysicsMode::SUBMERGED;
+    phy.collisions = true;
+    
+    sf::Scalar length = size * 0.05;
+    sf::CableEntity* cable = new sf::CableEntity("Cable", phy, sf::Vector3(0, 0, 1.0), sf::Vector3(length, 0, 1.0), size, 0.02, "Steel", "");
+    cable->AttachToWorld(sf::CableEnds::FIRST);
+    AddEntity(cable);
+}
+
+//K multibeams with 512 beams each, updated every step
+void BenchmarkManager::BuildMultibeam()
+{
+    sf::Plane* floor = new sf::Plane("Floor", 10000.0, "Ground");
+    AddStaticEntity(floor, sf::I4());
+    for(unsigned int i=0; i<8; ++i)
+    {
+        sf::Scalar angle = i * M_PI_4;
+        sf::Obstacle* pillar = new sf::Obstacle("Pillar", 0.5, 4.0, sf::I4(), "Ground");
+        AddStaticEntity(pillar, sf::Transform(sf::IQ(), sf::Vector3(btCos(angle) * 6.0, btSin(angle) * 6.0, -2.0)));
+    }
+
+    sf::PhysicsSettings phy;
+    phy.mode = sf::PhysicsMode::SURFACE;
+    phy.collisions = true;
+    sf::Box* mount = new sf::Box("Mount", phy, sf::Vector3(0.5, 0.5, 0.5), sf::I4(), "Steel", "");
+    AddSolidEntity(mount, sf::Transform(sf::IQ(), sf::Vector3(0, 0, -0.25)));
+
+    for(unsigned int i=0; i<size; ++i)
+    {
+        sf::Multibeam* mb = new sf::Multibeam("Multibeam", 120.0, 512);
+        mb->setRange(0.1, 50.0);
+        mb->AttachToSolid(mount, sf::Transform(sf::Quaternion(i * 2.0 * M_PI / size, 0, M_PI_2), sf::Vector3(0, 0, -0.5)));
+        AddSensor(mb);
+    }
+}
+
+//K multibody robots with joint servos and a typical navigation sensor suite
+void BenchmarkManager::BuildRobots()
+{
+    sf::Plane* floor = new sf::Plane("Floor", 10000.0, "Ground");
+    AddStaticEntity(floor, sf::I4());
+
+    sf::PhysicsSettings phy;
+    phy.mode = sf::PhysicsMode::SURFACE;
+    phy.collisions = true;
+
+    unsigned int row = (unsigned int)ceil(sqrt((double)size));
+    for(unsigned int i=0; i<size; ++i)
+    {
+        std::string name = "Robot" + std::to_string(i);
+        sf::Box* base = new sf::Box(name + "/Base", phy, sf::Vector3(0.5, 0.4, 0.2), sf::I4(), "Steel", "");
+        sf::Box* link1 = new sf::Box(name + "/Link1", phy, sf::Vector3(0.05, 0.05, 0.3), sf::Transform(sf::IQ(), sf::Vector3(0, 0, -0.15)), "Plastic", "");
+        sf::Box* link2 = new sf::Box(name + "/Link2", phy, sf::Vector3(0.05, 0.05, 0.3), sf::Transform(sf::IQ(), sf::Vector3(0, 0, -0.15)), "Plastic", "");
+
+        sf::FeatherstoneRobot* robot = new sf::FeatherstoneRobot(name, false);
+        robot->DefineLinks(base, {link1, link2});
+        robot->DefineRevoluteJoint(name + "/Joint1", name + "/Base", name + "/Link1", sf::Transform(sf::IQ(), sf::Vector3(0, 0, -0.1)), sf::VY());
+        robot->DefineRevoluteJoint(name + "/Joint2", name + "/Link1", name + "/Link2", sf::Transform(sf::IQ(), sf::Vector3(0, 0, -0.3)), sf::VY());
+        robot->BuildKinematicStructure();
+
+        sf::Servo* servo1 = new sf::Servo(name + "/Servo1", 1.0, 1.0, 10.0);
+        sf::Servo* servo2 = new sf::Servo(name + "/Servo2", 1.0, 1.0, 10.0);
+        servo1->setDesiredPosition(0.5);
+        servo2->setDesiredPosition(-0.5);
+        robot->AddJointActuator(servo1, name + "/Joint1");
+        robot->AddJointActuator(servo2, name + "/Joint2");
+
+        robot->AddLinkSensor(new sf::IMU(name + "/IMU"), name + "/Base", sf::I4());
+        robot->AddLinkSensor(new sf::Odometry(name + "/Odom"), name + "/Base", sf::I4());
+        robot->AddLinkSensor(new sf::Pressure(name + "/Pressure"), name + "/Base", sf::I4());
+        robot->AddJointSensor(new sf::RotaryEncoder(name + "/Encoder1"), name + "/Joint1");
+        robot->AddJointSensor(new sf::RotaryEncoder(name + "/Encoder2"), name + "/Joint2");
+        
+        AddRobot(robot, sf::Transform(sf::IQ(), sf::Vector3((i % row) * 2.0, (i / row) * 2.0, -0.11)));
+    }
+}
+
+//K grippers with pumping suction cups and contact sensors, resting next to a bin of 250 boxes (post-tick contact queries)
+void BenchmarkManager::BuildSuction()
+{
+    BuildPile(250);
+    sf::Entity* floor = getEntity(0);
+
+    sf::PhysicsSettings phy;
+    phy.mode = sf::PhysicsMode::SURFACE;
+    phy.collisions = true;
+
+    for(unsigned int i=0; i<size; ++i)
+    {
+        std::string name = "Gripper" + std::to_string(i);
+        sf::Box* gripper = new sf::Box(name, phy, sf::Vector3(0.1, 0.1, 0.1), sf::I4(), "Steel", "");
+        AddSolidEntity(gripper, sf::Transform(sf::IQ(), sf::Vector3(-1.0 - (i % 10) * 0.3, (i / 10) * 0.3, -0.05)));
+
+        sf::SuctionCup* cup = new sf::SuctionCup(name + "/Cup");
+        cup->AttachToSolid(gripper, sf::I4());
+        cup->setPump(true);
+        AddActuator(cup);
+
+        AddContact(new sf::Contact(name + "/Contact", gripper, floor));
+    }
+}
+
+//K horizontal slab triggers spanning the pile of 250 boxes, each watching all of them
+void BenchmarkManager::BuildTriggers()
+{
+    BuildPile(250);
+    std::vector<sf::SolidEntity*> boxes;
+    sf::Entity* ent;
+    for(unsigned int i=0; (ent = getEntity(i)) != nullptr; ++i)
+        if(ent->getType() == sf::EntityType::SOLID)
+            boxes.push_back((sf::SolidEntity*)ent);
+
+    const sf::Scalar height = 2.5;
+    for(unsigned int i=0; i<size; ++i)
+    {
+        sf::Trigger* trigger = new sf::Trigger("Trigger" + std::to_string(i), sf::Vector3(1.2, 1.2, height/size), 
+                                               sf::Transform(sf::IQ(), sf::Vector3(0.5, 0.5, -(i + 0.5) * height/size)));
+        for(size_t h=0; h<boxes.size(); ++h)
+            trigger->AddActiveSolid(boxes[h]);
+        AddEntity(trigger);
+    }
+}
+
+//N mesh bodies dropped into a bin, colliding using full-vertex hulls, reduced hulls or decomposed compounds of hulls
+void BenchmarkManager::BuildMeshes(sf::Scalar hullTolerance, bool decompose)
+{
+    sf::Plane* floor = new sf::Plane("Floor", 10000.0, "Ground");
+    AddStaticEntity(floor, sf::I4());
+
+    const sf::Scalar b = 0.45;
+    const sf::Scalar binSize = 5 * b;
+    for(unsigned int i=0; i<4; ++i)
+    {
+        sf::Scalar angle = i * M_PI_2;
+        sf::Obstacle* wall = new sf::Obstacle("Wall", sf::Vector3(binSize, 0.05, 1.0), sf::I4(), "Ground");
+        AddStaticEntity(wall, sf::Transform(sf::Quaternion(angle, 0, 0), 
+                                            sf::Vector3(btSin(angle) * binSize/2, -btCos(angle) * binSize/2, -0.5) + sf::Vector3(binSize/2 - b/2, binSize/2 - b/2, 0)));
+    }
+
+    const std::vector<std::pair<std::string, sf::Scalar>> meshes = {
+        {"duct_hydro.obj", 1.0},
+        {"torus_R=1_r=025.obj", 0.15},
+        {"funnel.obj", 0.3},
+        {"hull_hydro.obj", 0.25}
+    };
+
+    sf::PhysicsSettings phy;
+    phy.mode = sf::PhysicsMode::SURFACE;
+    phy.collisions = true;
+
+    sf::ConvexDecompositionSettings cds;
+    cds.hullTolerance = hullTolerance;
+    for(unsigned int i=0; i<size; ++i)
+    {
+        const auto& mesh = meshes[i % meshes.size()];
+        sf::Polyhedron* poly = new sf::Polyhedron("Mesh", phy, sf::GetDataPath() + mesh.first, mesh.second, sf::I4(), "Plastic", "");
+        poly->setHullReduction(hullTolerance);
+        if(decompose)
+            poly->setConvexDecomposition(cds);
+        sf::Vector3 pos((i % 5) * b, ((i / 5) % 5) * b, -b/2 - 0.01 - (i / 25) * b);
+        AddSolidEntity(poly, sf::Transform(sf::Quaternion(0.3*i, 0.2*i, 0.1*i), pos));
+    }
+}
+
+//N rings dropped on a floor scattered with boxes and spheres (analytic torus contacts)
+void BenchmarkManager::BuildTori()
+{
+    sf::Plane* floor = new sf::Plane("Floor", 10000.0, "Ground");
+    AddStaticEntity(floor, sf::I4());
+
+    sf::PhysicsSettings phy;
+    phy.mode = sf::PhysicsMode::SURFACE;
+    phy.collisions = true;
+
+    unsigned int row = (unsigned int)ceil(sqrt((double)size));
+    for(unsigned int i=0; i<size; ++i)
+    {
+        sf::Vector3 pos((i % row) * 1.0, (i / row) * 1.0, 0.0);
+        sf::SolidEntity* obstacle;
+        if(i % 2 == 0)
+            obstacle = new sf::Box("Box", phy, sf::Vector3(0.3, 0.3, 0.2), sf::I4(), "Steel", "");
+        else
+            obstacle = new sf::Sphere("Sphere", phy, 0.15, sf::I4(), "Steel", "");
+        AddSolidEntity(obstacle, sf::Transform(sf::IQ(), pos - sf::Vector3(0, 0, 0.2)));
+
+        sf::Torus* ring = new sf::Torus("Ring", phy, 0.3, 0.04, sf::I4(), "Plastic", "");
+        AddSolidEntity(ring, sf::Transform(sf::Quaternion(0.3*i, 0.2*i, 0.1*i), pos - sf::Vector3(0, 0, 1.0)));
+    }
+}
+
+//N fixed-base arms with 30 damped revolute joints driven by motors, commanded after every step through the per-index or the batched joint API
+void BenchmarkManager::BuildArms()
+{
+    const unsigned int dof = 30;
+    sf::PhysicsSettings phy;
+    phy.mode = sf::PhysicsMode::SURFACE;
+    phy.collisions = false;
+
+    unsigned int row = (unsigned int)ceil(sqrt((double)size));
+    for(unsigned int i=0; i<size; ++i)
+    {
+        std::string name = "Arm" + std::to_string(i);
+        sf::Box* base = new sf::Box(name + "/Base", phy, sf::Vector3(0.2, 0.2, 0.1), sf::I4(), "Steel", "");
+        std::vector<sf::SolidEntity*> links;
+        for(unsigned int h=0; h<dof; ++h)
+            links.push_back(new sf::Box(name + "/Link" + std::to_string(h+1), phy, sf::Vector3(0.04, 0.04, 0.1), sf::Transform(sf::IQ(), sf::Vector3(0, 0, -0.05 - 0.1 * h)), "Plastic", ""));
+
+        sf::FeatherstoneRobot* robot = new sf::FeatherstoneRobot(name, true);
+        robot->DefineLinks(base, links);
+        for(unsigned int h=0; h<dof; ++h)
+        {
+            std::string parent = h == 0 ? name + "/Base" : name + "/Link" + std::to_string(h);
+            robot->DefineRevoluteJoint(name + "/Joint" + std::to_string(h+1), parent, name + "/Link" + std::to_string(h+1), 
+                                       sf::Transform(sf::IQ(), sf::Vector3(0, 0, -0.05 - 0.1 * h)), h % 2 == 0 ? sf::VY() : sf::VX(), 
+                                       std::make_pair(sf::Scalar(1), sf::Scalar(-1)), 0.05);
+        }
+        robot->BuildKinematicStructure();
+        for(unsigned int h=0; h<dof; ++h)
+            robot->getDynamics()->AddJointMotor(h, 20.0);
+        arms.push_back(robot->getDynamics());
+        
+        AddRobot(robot, sf::Transform(sf::IQ(), sf::Vector3((i % row) * 4.0, (i / row) * 4.0, -4.0)));
+    }
+
+    //Precomputed periodic joint trajectory
+    armTargets.resize(64 * dof);
+    for(unsigned int k=0; k<64; ++k)
+        for(unsigned int h=0; h<dof; ++h)
+            armTargets[k * dof + h] = 0.3 * sin(2.0 * M_PI * k/64.0 + 0.2 * h);
+    armBuffers.resize(5 * dof);
+}
+
+void BenchmarkManager::ControlArms(bool batched)
+{
+    const unsigned int dof = (unsigned int)(armTargets.size()/64);
+    const sf::Scalar* target = &armTargets[(counter % 64) * dof];
+    sf::Scalar* q = &armBuffers[0];
+    sf::Scalar* dq = &armBuffers[dof];
+    sf::Scalar* vel = &armBuffers[2 * dof];
+    sf::Scalar* kp = &armBuffers[3 * dof];
+    sf::Scalar* kd = &armBuffers[4 * dof];
+    
+    for(size_t i=0; i<arms.size(); ++i)
+    {
+        if(batched)
+        {
+            arms[i]->getJointPositions(q);
+            arms[i]->getJointVelocities(dq);
+            for(unsigned int h=0; h<dof; ++h)
+            {
+                vel[h] = 2.0 * (target[h] - q[h]) - 0.1 * dq[h];
+                kp[h] = 1.0;
+                kd[h] = 0.5;
+            }
+            arms[i]->MotorPositionSetpoints(target, kp);
+            arms[i]->MotorVelocitySetpoints(vel, kd);
+        }
+        else
+        {
+            btMultibodyLink::eFeatherstoneJointType jt;
+            for(unsigned int h=0; h<dof; ++h)
+            {
+                arms[i]->getJointPosition(h, q[h], jt);
+                arms[i]->getJointVelocity(h, dq[h], jt);
+                arms[i]->MotorPositionSetpoint(h, target[h], 1.0);
+                arms[i]->MotorVelocitySetpoint(h, 2.0 * (target[h] - q[h]) - 0.1 * dq[h], 0.5);
+            }
+        }
+    }
+}
+
+//K robots with servos, K arms with joint motors and K free boxes (runtime commands, external wrenches and pose overrides to be journaled)
+void BenchmarkManager::BuildReplay()
+{
+    BuildRobots();
+    BuildArms();
+
+    sf::Actuator* act;
+    for(unsigned int i=0; (act = getActuator(i)) != nullptr; ++i)
+        if(act->getType() == sf::ActuatorType::SERVO)
+            replayServos.push_back((sf::Servo*)act);
+
+    sf::PhysicsSettings phy;
+    phy.mode = sf::PhysicsMode::SURFACE;
+    phy.collisions = true;
+
+    for(unsigned int i=0; i<size; ++i)
+    {
+        sf::Box* box = new sf::Box("Pushed" + std::to_string(i), phy, sf::Vector3(0.3, 0.3, 0.3), sf::I4(), "Plastic", "");
+        AddSolidEntity(box, sf::Transform(sf::IQ(), sf::Vector3(-2.0, i * 1.0, -0.16)));
+        replayBoxes.push_back(box);
+    }
+}
+
+void BenchmarkManager::CommandReplay()
+{
+    //New servo setpoints every 50 steps
+    if(counter % 50 == 0)
+        for(size_t i=0; i<replayServos.size(); ++i)
+            replayServos[i]->setDesiredPosition(0.5 * sin(0.01 * counter + 0.7 * i));
+    
+    //New joint efforts of the arms every 25 steps
+    if(counter % 25 == 0 && !arms.empty())
+    {
+        std::vector<sf::Scalar> efforts(arms[0]->getNumOfMovingJoints());
+        for(size_t i=0; i<arms.size(); ++i)
+        {
+            for(size_t h=0; h<efforts.size(); ++h)
+                efforts[h] = 0.5 * sin(0.03 * counter + 0.1 * h + i);
+            arms[i]->setJointEfforts(efforts.data());
+        }
+    }
+    
+    //Boxes pushed in every step and one of them moved back every 100 steps
+    for(size_t i=0; i<replayBoxes.size(); ++i)
+    {
+        sf::Scalar phase = 0.02 * counter + 1.3 * i;
+        ApplyExternalWrench(replayBoxes[i], sf::Vector3(20.0 * cos(phase), 20.0 * sin(phase), 0.0), sf::Vector3(0.0, 0.0, 2.0 * sin(phase)));
+    }
+    if(counter % 100 == 0 && !replayBoxes.empty())
+    {
+        size_t i = (counter/100) % replayBoxes.size();
+        OverridePose(replayBoxes[i], sf::Transform(sf::Quaternion(0.1 * counter, 0, 0), sf::Vector3(-2.0, i * 1.0, -0.5)));
+    }
+}
+
+//Synthetic bathymetry of the terrain scenario (z coordinate of the seabed, positive down) [m]
+static sf::Scalar TerrainHeight(sf::Scalar x, sf::Scalar y)
+{
+    return 10.0 + 4.0 * sin(x/40.0) * cos(y/30.0) + 0.5 * sin(x/6.0 + y/9.0);
+}
+
+//Probes circle around the centre of the terrain, 0.5 m per step, 1 m above the seabed
+static sf::Vector3 ProbePosition(size_t i, unsigned int step)
+{
+    sf::Scalar radius = 60.0 + 20.0 * (i % 8);
+    sf::Scalar angle = 0.5 * step/radius + 0.9 * i;
+    sf::Scalar x = 256.0 + radius * cos(angle);
+    sf::Scalar y = 256.0 + radius * sin(angle);
+    return sf::Vector3(x, y, TerrainHeight(x, y) - 1.3);
+}
+
+//N probes moving fast over a 512 x 512 m tiled terrain (int16 storage), paging the collidable tiles around them
+void BenchmarkManager::BuildTerrain()
+{
+    const uint32_t nodes = 513;
+    std::vector<float> heights((size_t)nodes * nodes);
+    for(uint32_t j=0; j<nodes; ++j)
+        for(uint32_t i=0; i<nodes; ++i)
+            heights[(size_t)j * nodes + i] = (float)TerrainHeight(i * 1.0, j * 1.0);
+    
+    std::string path = (std::filesystem::temp_directory_path() / "stonefish_bench_terrain.sftt").string();
+    if(!sf::TiledTerrain::WriteTerrainData(path, heights.data(), nodes, nodes, 1.0, 1.0, 32, sf::TiledTerrainFormat::INT16))
+        return;
+    terrain = new sf::TiledTerrain("Terrain", path, "Ground", "", 1.f, 20.0, 30.0, 400.0);
+    AddStaticEntity(terrain, sf::I4());
+    
+    sf::PhysicsSettings phy;
+    phy.mode = sf::PhysicsMode::SURFACE;
+    phy.collisions = true;
+    
+    for(unsigned int i=0; i<size; ++i)
+    {
+        sf::Sphere* probe = new sf::Sphere("Probe" + std::to_string(i), phy, 0.3, sf::I4(), "Steel", "");
+        AddSolidEntity(probe, sf::Transform(sf::IQ(), ProbePosition(i, 0)));
+        probes.push_back(probe);
+    }
+}
+
+void BenchmarkManager::MoveProbes()
+{
+    //Gravity compensated, so that the probes keep their height between the pose overrides
+    for(size_t i=0; i<probes.size(); ++i)
+    {
+        OverridePose(probes[i], sf::Transform(sf::IQ(), ProbePosition(i, counter)));
+        ApplyExternalWrench(probes[i], -probes[i]->getMass() * getGravity(), sf::V0());
+    }
+}
+
+//Scenario shipped with the tests, parsed from its XML description and commanded through its thrusters and dynamic bodies
+void BenchmarkManager::BuildParsed(const std::string& filename)
+{
+    sf::ScenarioParser parser(this);
+    if(!parser.Parse(sf::GetDataPath() + filename))
+    {
+        std::vector<sf::ConsoleMessage> log = parser.getLog();
+        for(size_t i=0; i<log.size(); ++i)
+            if(log[i].type != sf::MessageType::INFO)
+                std::cout << "[" << getScenarioName(scenario) << "] " << log[i].text << std::endl;
+        ++failedChecks;
+    }
+
+    sf::Actuator* act;
+    for(unsigned int i=0; (act = getActuator(i)) != nullptr; ++i)
+        if(act->getType() == sf::ActuatorType::THRUSTER)
+            parsedThrusters.push_back((sf::Thruster*)act);
+
+    sf::Entity* ent;
+    for(unsigned int i=0; (ent = getEntity(i)) != nullptr; ++i)
+        if(ent->getType() == sf::EntityType::SOLID)
+            parsedSolids.push_back((sf::SolidEntity*)ent);
+}
+
+void BenchmarkManager::CommandParsed()
+{
+    //New thruster setpoints every 50 steps
+    if(counter % 50 == 0)
+        for(size_t i=0; i<parsedThrusters.size(); ++i)
+            parsedThrusters[i]->setSetpoint(0.5 * sin(0.013 * counter + 0.9 * i));
+
+    //Dynamic bodies pushed in every step
+    for(size_t i=0; i<parsedSolids.size(); ++i)
+    {
+        sf::Scalar phase = 0.01 * counter + 1.7 * i;
+        ApplyExternalWrench(parsedSolids[i], sf::Vector3(5.0 * cos(phase), 5.0 * sin(phase), 0.0), sf::Vector3(0.0, 0.0, 0.5 * sin(phase)));
+    }
+}
+
+void BenchmarkManager::SimulationStepCompleted(sf::Scalar timeStep)
+{
+    if(finished)
+        return;
+
+    ++counter;
+    if(controllers && scenario == BenchmarkScenario::REPLAY)
+        CommandReplay();
+    if(controllers && scenario == BenchmarkScenario::TERRAIN)
+        MoveProbes();
+    if(controllers && scenario == BenchmarkScenario::CONSOLE_TEST)
+        CommandParsed();
+    if(controllers && !arms.empty())
+    {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        ControlArms(scenario == BenchmarkScenario::ARMS_BATCHED);
+        if(counter > warmup)
+            controlTime += std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - t0).count();
+    }
+    if(checks && scenario == BenchmarkScenario::TRIGGERS && !CheckTriggers())
+        ++failedChecks;
+    if(checks && controllers && scenario == BenchmarkScenario::ARMS && !CheckArms())
+        ++failedChecks;
+    if(checks && scenario == BenchmarkScenario::TERRAIN && !CheckTerrain())
+        ++failedChecks;
+    if(counter == warmup)
+    {
+        start = std::chrono::high_resolution_clock::now();
+        allocCount = GetAllocationCount();
+        allocBytes = GetAllocatedBytes();
+    }
+    else if(counter > warmup)
+    {
+        physicsTime += getPerformanceMonitor().getPhysicsTime();
+        if(isOceanEnabled())
+            hydroTime += getPerformanceMonitor().getHydrodynamicsTime();
+        btDispatcher* dispatcher = getDynamicsWorld()->getDispatcher();
+        for(int i=0; i<dispatcher->getNumManifolds(); ++i)
+            contacts += dispatcher->getManifoldByIndexInternal(i)->getNumContacts();
+
+        if(counter == warmup + steps)
+        {
+            end = std::chrono::high_resolution_clock::now();
+            allocCount = GetAllocationCount() - allocCount;
+            allocBytes = GetAllocatedBytes() - allocBytes;
+            finished = true;
+        }
+    }
+}
+
+bool BenchmarkManager::isFinished() const
+{
+    return finished;
+}
+
+void BenchmarkManager::EnableChecks()
+{
+    checks = true;
+}
+
+unsigned int BenchmarkManager::getFailedChecks() const
+{
+    return failedChecks;
+}
+
+void BenchmarkManager::DisableControllers()
+{
+    controllers = false;
+}
+
+//Compares the bodies tracked by the trigger ghosts with the pairs of the world pair cache (previous implementation)
+bool BenchmarkManager::CheckTriggers()
+{
+    std::map<const btCollisionObject*, std::set<const btCollisionObject*>> pairs;
+    btBroadphasePairArray& pairArray = getDynamicsWorld()->getPairCache()->getOverlappingPairArray();
+    for(int i=0; i<pairArray.size(); ++i)
+    {
+        const btCollisionObject* co1 = (const btCollisionObject*)pairArray[i].m_pProxy0->m_clientObject;
+        const btCollisionObject* co2 = (const btCollisionObject*)pairArray[i].m_pProxy1->m_clientObject;
+        pairs[co1].insert(co2);
+        pairs[co2].insert(co1);
+    }
+    
+    bool ok = true;
+    sf::Entity* ent;
+    for(unsigned int i=0; (ent = getEntity(i)) != nullptr; ++i)
+    {
+        if(ent->getType() != sf::EntityType::FORCEFIELD || ((sf::ForcefieldEntity*)ent)->getForcefieldType() != sf::ForcefieldType::TRIGGER)
+            continue;
+        
+        sf::Trigger* trigger = (sf::Trigger*)ent;
+        btGhostObject* ghost = trigger->getGhost();
+        std::set<const btCollisionObject*> members;
+        for(int h=0; h<ghost->getNumOverlappingObjects(); ++h)
+            members.insert(ghost->getOverlappingObject(h));
+        
+        //Previous activation: any dynamic solid in the pairs of the ghost (all solids are watched in this scenario)
+        const std::set<const btCollisionObject*>& expected = pairs[ghost];
+        bool active = false;
+        for(auto it = expected.begin(); it != expected.end(); ++it)
+        {
+            const btRigidBody* rb = btRigidBody::upcast(*it);
+            if(rb != nullptr && !rb->isStaticOrKinematicObject() && ((sf::Entity*)rb->getUserPointer())->getType() == sf::EntityType::SOLID)
+                active = true;
+        }
+        
+        if(members != expected || trigger->isActive() != active)
+        {
+            std::cout << "[" << getScenarioName(scenario) << "_" << size << "] membership of " << trigger->getName() << " differs at step " 
+                      << counter << " (" << members.size() << " tracked, " << expected.size() << " in the pair cache)" << std::endl;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+//Compares the batched joint API with the per-index one (values read and motor commands written by the per-index controller)
+bool BenchmarkManager::CheckArms()
+{
+    const unsigned int dof = (unsigned int)(armTargets.size()/64);
+    std::vector<sf::Scalar> batched(4 * dof);
+    std::vector<sf::Scalar> perIndex(4 * dof);
+    std::vector<std::vector<sf::Scalar>> commands(arms.size());
+    
+    bool ok = true;
+    for(size_t i=0; i<arms.size(); ++i)
+    {
+        arms[i]->getJointPositions(&batched[0]);
+        arms[i]->getJointVelocities(&batched[dof]);
+        arms[i]->getJointTorques(&batched[2 * dof]);
+        arms[i]->getMotorForceTorques(&batched[3 * dof]);
+        
+        btMultibodyLink::eFeatherstoneJointType jt;
+        for(unsigned int h=0; h<dof; ++h)
+        {
+            arms[i]->getJointPosition(h, perIndex[h], jt);
+            arms[i]->getJointVelocity(h, perIndex[dof + h], jt);
+            perIndex[2 * dof + h] = arms[i]->getJointTorque(h);
+            perIndex[3 * dof + h] = arms[i]->getMotorForceTorque(h);
+        }
+        
+        if(batched != perIndex)
+        {
+            std::cout << "[" << getScenarioName(scenario) << "_" << size << "] batched joint state of " << arms[i]->getName() 
+                      << " differs at step " << counter << std::endl;
+            ok = false;
+        }
+        arms[i]->getCommandState(commands[i]);
+    }
+    
+    //Same setpoints written through the batched API have to leave the same motor commands
+    ControlArms(true);
+    std::vector<sf::Scalar> state;
+    for(size_t i=0; i<arms.size(); ++i)
+    {
+        state.clear();
+        arms[i]->getCommandState(state);
+        if(state != commands[i])
+        {
+            std::cout << "[" << getScenarioName(scenario) << "_" << size << "] batched motor setpoints of " << arms[i]->getName() 
+                      << " differ at step " << counter << std::endl;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+//Checks the decoding of the int16 heights, the paging of the tiles under the probes and the selection of the levels of detail
+bool BenchmarkManager::CheckTerrain()
+{
+    std::string name = "[" + getScenarioName(scenario) + "_" + std::to_string(size) + "] ";
+    if(terrain == nullptr)
+    {
+        std::cout << name << "failed to write the terrain data" << std::endl;
+        return false;
+    }
+    
+    bool ok = true;
+    if(counter == 1) //Levels of detail: full resolution up to 30 m, halved with every doubling of the distance, none beyond 400 m
+    {
+        int last = 0;
+        for(sf::Scalar d = 0.0; d <= 400.0; d += 0.5)
+        {
+            int lod = terrain->getLevelOfDetail(d);
+            if(lod < last || lod > 3 || (d <= 30.0 && lod != 0))
+            {
+                std::cout << name << "level of detail " << lod << " selected at " << d << " m" << std::endl;
+                ok = false;
+                break;
+            }
+            last = lod;
+        }
+        if(terrain->getLevelOfDetail(400.5) != -1)
+        {
+            std::cout << name << "tiles rendered beyond the drawing range" << std::endl;
+            ok = false;
+        }
+    }
+    
+    //Int16 storage: scale is range/65534, so the nodes have to be within half of it from the original heights
+    sf::Scalar tolerance = (14.5 - 5.5)/65534.0 * 0.5 + 1e-5;
+    for(size_t i=0; i<probes.size(); ++i)
+    {
+        sf::Vector3 p = probes[i]->getCGTransform().getOrigin();
+        sf::Scalar nx = floor(p.x());
+        sf::Scalar ny = floor(p.y());
+        for(int h=0; h<4; ++h)
+        {
+            sf::Scalar x = nx + (h & 1);
+            sf::Scalar y = ny + (h >> 1);
+            if(btFabs(terrain->getHeight(x, y) - (sf::Scalar)(float)TerrainHeight(x, y)) > tolerance)
+            {
+                std::cout << name << "height of node (" << x << ", " << y << ") differs by more than " << tolerance << " m" << std::endl;
+                ok = false;
+            }
+        }
+        
+        //The tile under the probe has to be collidable
+        sf::Vector3 to(p.x(), p.y(), terrain->getHeight(p.x(), p.y()) + 1.0);
+        btCollisionWorld::ClosestRayResultCallback closest(p, to);
+        closest.m_collisionFilterGroup = sf::MASK_DYNAMIC;
+        closest.m_collisionFilterMask = sf::MASK_STATIC;
+        getDynamicsWorld()->rayTest(p, to, closest);
+        if(!closest.hasHit() || btFabs(closest.m_hitPointWorld.z() - terrain->getHeight(p.x(), p.y())) > 0.05)
+        {
+            std::cout << name << "no terrain collision under " << probes[i]->getName() << " at step " << counter << std::endl;
+            ok = false;
+        }
+    }
+    
+    //Tiles kept up to 1.5 of the paging radius (30 m), i.e., at most 3 x 3 tiles of 32 m per probe
+    if(terrain->getNumOfLoadedTiles() > 9 * probes.size())
+    {
+        std::cout << name << terrain->getNumOfLoadedTiles() << " tiles loaded at step " << counter << std::endl;
+        ok = false;
+    }
+    return ok;
+}
+
+BenchmarkResult BenchmarkManager::getResult() const
+{
+    BenchmarkResult r;
+    r.scenario = getScenarioName(scenario);
+    r.name = r.scenario + "_" + std::to_string(size);
+    r.size = size;
+    r.steps = steps;
+    r.stepSize = 1.0/getStepsPerSecond();
+    r.wallTime = std::chrono::duration<double>(end - start).count();
+    r.stepsPerSecond = r.wallTime > 0.0 ? steps/r.wallTime : 0.0;
+    r.realtimeFactor = r.stepsPerSecond * r.stepSize;
+    r.physicsTime = steps > 0 ? physicsTime/steps : 0.0;
+    r.hydroTime = steps > 0 ? hydroTime/steps : 0.0;
+    r.overheadTime = steps > 0 ? r.wallTime * 1e6/steps - r.physicsTime : 0.0;
+    r.contactsPerSecond = r.wallTime > 0.0 ? contacts/r.wallTime : 0.0;
+    r.controlTime = steps > 0 ? controlTime/steps : 0.0;
+    r.peakRSS = GetPeakRSS();
+    r.allocations = allocCount;
+    r.allocatedBytes = allocBytes;
+    return r;
+}
+
+std::string BenchmarkManager::getScenarioName(BenchmarkScenario scenario)
+{
+    switch(scenario)
+    {
+        case BenchmarkScenario::FALLING:
+            return "falling";
+        case BenchmarkScenario::PILE:
+            return "pile";
+        case BenchmarkScenario::HULLS:
+            return "hulls";
+        case BenchmarkScenario::HULLS_REDUCED:
+            return "hulls_reduced";
+        case BenchmarkScenario::SEABED:
+            return "seabed";
+        case BenchmarkScenario::CABLE:
+            return "cable";
+        case BenchmarkScenario::MULTIBEAM:
+            return "multibeam";
+        case BenchmarkScenario::ROBOTS:
+            return "robots";
+        case BenchmarkScenario::SUCTION:
+            return "suction";
+        case BenchmarkScenario::TRIGGERS:
+            return "triggers";
+        case BenchmarkScenario::MESHES:
+            return "meshes";
+        case BenchmarkScenario::MESHES_REDUCED:
+            return "meshes_reduced";
+        case BenchmarkScenario::MESHES_DECOMPOSED:
+            return "meshes_decomposed";
+        case BenchmarkScenario::TORI:
+            return "tori";
+        case BenchmarkScenario::ARMS:
+            return "arms";
+        case BenchmarkScenario::ARMS_BATCHED:
+            return "arms_batched";
+        case BenchmarkScenario::REPLAY:
+            return "replay";
+        case BenchmarkScenario::TERRAIN:
+            return "terrain";
+        case BenchmarkScenario::CONSOLE_TEST:
+            return "console_test";
+    }
+    return "";
+}
+
+bool BenchmarkManager::ParseScenarioName(const std::string& name, BenchmarkScenario& scenario)
+{
+    for(BenchmarkScenario s : {BenchmarkScenario::FALLING, BenchmarkScenario::PILE, BenchmarkScenario::HULLS, 
+                               BenchmarkScenario::HULLS_REDUCED, BenchmarkScenario::SEABED, BenchmarkScenario::CABLE, BenchmarkScenario::MULTIBEAM, BenchmarkScenario::ROBOTS,
+                               BenchmarkScenario::SUCTION, BenchmarkScenario::TRIGGERS, BenchmarkScenario::MESHES, BenchmarkScenario::MESHES_REDUCED,
+                               BenchmarkScenario::MESHES_DECOMPOSED, BenchmarkScenario::TORI, BenchmarkScenario::ARMS, BenchmarkScenario::ARMS_BATCHED,
+                               BenchmarkScenario::REPLAY, BenchmarkScenario::TERRAIN, BenchmarkScenario::CONSOLE_TEST})
+        if(getScenarioName(s) == name)
+        {
+            scenario = s;
+            return true;
+        }
+    return false;
+}
@@ -0,0 +1,117 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  BenchmarkManager.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish__BenchmarkManager__
+#define __Stonefish__BenchmarkManager__
+
+#include <core/SimulationManager.h>
+#include <entities/FeatherstoneEntity.h>
+#include <actuators/Servo.h>
+#include <actuators/Thruster.h>
+#include <entities/statics/TiledTerrain.h>
+#include <atomic>
+#include <chrono>
+#include "BenchmarkUtil.h"
+
+//! An enum defining available benchmark scenarios.
+enum class BenchmarkScenario {FALLING, PILE, HULLS, HULLS_REDUCED, SEABED, CABLE, MULTIBEAM, ROBOTS, SUCTION, TRIGGERS, MESHES, MESHES_REDUCED, MESHES_DECOMPOSED, TORI, ARMS, ARMS_BATCHED, REPLAY, TERRAIN, CONSOLE_TEST};
+
+class BenchmarkManager : public sf::SimulationManager
+{
+public:
+    BenchmarkManager(BenchmarkScenario scenario, unsigned int size, unsigned int steps, unsigned int warmupSteps, sf::Scalar stepsPerSecond);
+    
+    void BuildScenario();
+    void SimulationStepCompleted(sf::Scalar timeStep);
+    
+    bool isFinished() const;
+    BenchmarkResult getResult() const;
+    
+    //! A method enabling the consistency checks performed in every step of the scenario (affects the measurements).
+    void EnableChecks();
+    
+    //! A method returning the number of failed consistency checks.
+    unsigned int getFailedChecks() const;
+    
+    //! A method disabling the controllers commanding the scenario at runtime (used when replaying a command journal).
+    void DisableControllers();
+
+    static std::string getScenarioName(BenchmarkScenario scenario);
+    static bool ParseScenarioName(const std::string& name, BenchmarkScenario& scenario);
+    
+private:
+    void BuildFalling();
+    void BuildPile(unsigned int boxes);
+    void BuildHulls(bool reducedDrag);
+    void BuildSeabed();
+    void BuildCable();
+    void BuildMultibeam();
+    void BuildRobots();
+    void BuildSuction();
+    void BuildTriggers();
+    void BuildMeshes(sf::Scalar hullTolerance, bool decompose);
+    void BuildTori();
+    void BuildArms();
+    void ControlArms(bool batched);
+    void BuildReplay();
+    void CommandReplay();
+    void BuildTerrain();
+    void MoveProbes();
+    void BuildParsed(const std::string& filename);
+    void CommandParsed();
+    bool CheckTriggers();
+    bool CheckArms();
+    bool CheckTerrain();
+    
+    BenchmarkScenario scenario;
+    unsigned int size;
+    unsigned int steps;
+    unsigned int warmup;
+    unsigned int counter;
+    std::atomic<bool> finished;
+    std::chrono::high_resolution_clock::time_point start;
+    std::chrono::high_resolution_clock::time_point end;
+    double physicsTime;
+    double hydroTime;
+    uint64_t contacts;
+    uint64_t allocCount;
+    uint64_t allocBytes;
+    double controlTime;
+    bool checks;
+    unsigned int failedChecks;
+    bool controllers;
+    std::vector<sf::FeatherstoneEntity*> arms;
+    std::vector<sf::Scalar> armTargets;
+    std::vector<sf::Scalar> armBuffers;
+    std::vector<sf::Servo*> replayServos;
+    std::vector<sf::SolidEntity*> replayBoxes;
+    sf::TiledTerrain* terrain;
+    std::vector<sf::SolidEntity*> probes;
+    std::vector<sf::Thruster*> parsedThrusters;
+    std::vector<sf::SolidEntity*> parsedSolids;
+};
+
+#endif
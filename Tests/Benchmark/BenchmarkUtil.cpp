@@ -0,0 +1,279 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  BenchmarkUtil.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "BenchmarkUtil.h"
+
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstdio>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <version.h>
+#if defined(__linux__)
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+#if defined(__linux__) || defined(__APPLE__)
+    #include <sys/resource.h>
+#endif
+
+//Allocation counting (replaces global allocation functions of the whole process)
+static std::atomic<uint64_t> allocCount(0);
+static std::atomic<uint64_t> allocBytes(0);
+
+static void* CountedAlloc(std::size_t size)
+{
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(size, std::memory_order_relaxed);
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if(ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(std::size_t size) { return CountedAlloc(size); }
+void* operator new[](std::size_t size) { return CountedAlloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { try { return CountedAlloc(size); } catch(...) { return nullptr; } }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { try { return CountedAlloc(size); } catch(...) { return nullptr; } }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+uint64_t GetAllocationCount()
+{
+    return allocCount.load(std::memory_order_relaxed);
+}
+
+uint64_t GetAllocatedBytes()
+{
+    return allocBytes.load(std::memory_order_relaxed);
+}
+
+void ResetPeakRSS()
+{
+#if defined(__linux__)
+    //Writing "5" to clear_refs resets the VmHWM counter (Linux >= 4.0)
+    int fd = open("/proc/self/clear_refs", O_WRONLY);
+    if(fd >= 0)
+    {
+        ssize_t n = write(fd, "5", 1);
+        (void)n;
+        close(fd);
+    }
+#endif
+}
+
+uint64_t GetPeakRSS()
+{
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while(std::getline(status, line))
+        if(line.rfind("VmHWM:", 0) == 0)
+            return std::strtoull(line.c_str() + 6, nullptr, 10);
+#endif
+#if defined(__linux__) || defined(__APPLE__)
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0)
+    #if defined(__APPLE__)
+        return (uint64_t)usage.ru_maxrss / 1024; //Bytes on macOS
+    #else
+        return (uint64_t)usage.ru_maxrss;
+    #endif
+#endif
+    return 0;
+}
+
+bool WriteResults(const std::string& path, const std::vector<BenchmarkResult>& results, unsigned int threads)
+{
+    std::ofstream out(path);
+    if(!out.is_open())
+        return false;
+    
+    out << std::setprecision(9);
+    out << "{\n";
+    out << "  \"stonefish\": \"" << STONEFISH_VER << "\",\n";
+    out << "  \"threads\": " << threads << ",\n";
+    out << "  \"results\": [\n";
+    for(size_t i=0; i<results.size(); ++i)
+    {
+        const BenchmarkResult& r = results[i];
+        out << "    {";
+        out << "\"name\": \"" << r.name << "\", ";
+        out << "\"scenario\": \"" << r.scenario << "\", ";
+        out << "\"size\": " << r.size << ", ";
+        out << "\"steps\": " << r.steps << ", ";
+        out << "\"step_size\": " << r.stepSize << ", ";
+        out << "\"wall_time_s\": " << r.wallTime << ", ";
+        out << "\"steps_per_second\": " << r.stepsPerSecond << ", ";
+        out << "\"realtime_factor\": " << r.realtimeFactor << ", ";
+        out << "\"physics_us\": " << r.physicsTime << ", ";
+        out << "\"hydrodynamics_us\": " << r.hydroTime << ", ";
+        out << "\"overhead_us\": " << r.overheadTime << ", ";
+        out << "\"contacts_per_second\": " << r.contactsPerSecond << ", ";
+        out << "\"control_us\": " << r.controlTime << ", ";
+        out << "\"peak_rss_kb\": " << r.peakRSS << ", ";
+        out << "\"allocations\": " << r.allocations << ", ";
+        out << "\"allocations_per_step\": " << (r.steps > 0 ? (double)r.allocations/(double)r.steps : 0.0) << ", ";
+        out << "\"allocated_bytes\": " << r.allocatedBytes;
+        out << (i < results.size()-1 ? "},\n" : "}\n");
+    }
+    out << "  ]\n";
+    out << "}\n";
+    return out.good();
+}
+
+//Minimal reader of the flat objects stored in the "results" array
+bool ReadBaseline(const std::string& path, std::map<std::string, std::map<std::string, double>>& baseline)
+{
+    std::ifstream in(path);
+    if(!in.is_open())
+        return false;
+    std::stringstream ss;
+    ss << in.rdbuf();
+    std::string json = ss.str();
+
+    size_t pos = json.find("\"results\"");
+    if(pos == std::string::npos)
+        return false;
+    pos = json.find('[', pos);
+    if(pos == std::string::npos)
+        return false;
+
+    auto readString = [&json](size_t& p) -> std::string
+    {
+        size_t start = json.find('"', p);
+        size_t end = json.find('"', start + 1);
+        if(start == std::string::npos || end == std::string::npos)
+        {
+            p = std::string::npos;
+            return "";
+        }
+        p = end + 1;
+        return json.substr(start + 1, end - start - 1);
+    };
+
+    baseline.clear();
+    while(true)
+    {
+        size_t objStart = json.find('{', pos);
+        size_t arrEnd = json.find(']', pos);
+        if(objStart == std::string::npos || (arrEnd != std::string::npos && arrEnd < objStart))
+            break;
+        size_t objEnd = json.find('}', objStart);
+        if(objEnd == std::string::npos)
+            return false;
+
+        std::string name;
+        std::map<std::string, double> fields;
+        size_t p = objStart + 1;
+        while(p < objEnd)
+        {
+            size_t keyStart = json.find('"', p);
+            if(keyStart == std::string::npos || keyStart > objEnd)
+                break;
+            p = keyStart;
+            std::string key = readString(p);
+            p = json.find(':', p) + 1;
+            while(p < objEnd && std::isspace((unsigned char)json[p]))
+                ++p;
+            if(json[p] == '"')
+            {
+                std::string value = readString(p);
+                if(key == "name")
+                    name = value;
+            }
+            else
+            {
+                char* end;
+                fields[key] = std::strtod(json.c_str() + p, &end);
+                p = end - json.c_str();
+            }
+            p = json.find_first_of(",}", p);
+            if(p == std::string::npos)
+                return false;
+            ++p;
+        }
+        if(!name.empty())
+            baseline[name] = fields;
+        pos = objEnd + 1;
+    }
+    return true;
+}
+
+unsigned int CompareWithBaseline(const std::vector<BenchmarkResult>& results, 
+                                 const std::map<std::string, std::map<std::string, double>>& baseline, double tolerance)
+{
+    unsigned int regressions = 0;
+    std::cout << std::left << std::setw(20) << "Benchmark" 
+              << std::right << std::setw(14) << "Steps/s" << std::setw(14) << "Baseline" << std::setw(10) << "Change"
+              << std::setw(14) << "Allocs/step" << std::setw(14) << "Baseline" << "  Status" << std::endl;
+    
+    for(size_t i=0; i<results.size(); ++i)
+    {
+        const BenchmarkResult& r = results[i];
+        double allocsPerStep = r.steps > 0 ? (double)r.allocations/(double)r.steps : 0.0;
+        auto it = baseline.find(r.name);
+        if(it == baseline.end())
+        {
+            std::cout << std::left << std::setw(20) << r.name << std::right << std::setw(14) << std::fixed << std::setprecision(1) << r.stepsPerSecond
+                      << std::setw(14) << "-" << std::setw(10) << "-" << std::setw(14) << allocsPerStep << std::setw(14) << "-" << "  NEW" << std::endl;
+            continue;
+        }
+
+        auto field = [&it](const char* key) -> double
+        {
+            auto f = it->second.find(key);
+            return f == it->second.end() ? 0.0 : f->second;
+        };
+        double baseSps = field("steps_per_second");
+        double baseAllocs = field("allocations_per_step");
+        double baseRSS = field("peak_rss_kb");
+        double change = baseSps > 0.0 ? (r.stepsPerSecond - baseSps)/baseSps * 100.0 : 0.0;
+
+        std::string status = "OK";
+        if(baseSps > 0.0 && r.stepsPerSecond < baseSps * (1.0 - tolerance))
+            status = "SLOWER";
+        else if(allocsPerStep > baseAllocs * (1.0 + tolerance) + 1.0)
+            status = "MORE ALLOCS";
+        else if(baseRSS > 0.0 && (double)r.peakRSS > baseRSS * (1.0 + tolerance))
+            status = "MORE MEMORY";
+        if(status != "OK")
+            ++regressions;
+
+        std::cout << std::left << std::setw(20) << r.name << std::right << std::fixed << std::setprecision(1) 
+                  << std::setw(14) << r.stepsPerSecond << std::setw(14) << baseSps << std::setw(9) << change << "%"
+                  << std::setw(14) << allocsPerStep << std::setw(14) << baseAllocs << "  " << status << std::endl;
+    }
+    return regressions;
+}
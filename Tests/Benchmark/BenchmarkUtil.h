@@ -0,0 +1,84 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  BenchmarkUtil.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish__BenchmarkUtil__
+#define __Stonefish__BenchmarkUtil__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+
+//! A structure holding the measurements of a single benchmark run.
+struct BenchmarkResult
+{
+    std::string name;
+    std::string scenario;
+    unsigned int size;
+    unsigned int steps;
+    double stepSize;
+    double wallTime;        // [s]
+    double stepsPerSecond;
+    double realtimeFactor;
+    double physicsTime;     // Average per step [us]
+    double hydroTime;       // Average per step [us]
+    double overheadTime;    // Average per step [us]
+    double contactsPerSecond;
+    double controlTime;     // Average per step, spent in the controller [us]
+    uint64_t peakRSS;       // [kB]
+    uint64_t allocations;
+    uint64_t allocatedBytes;
+};
+
+//! A method returning the number of heap allocations performed by the process so far.
+uint64_t GetAllocationCount();
+
+//! A method returning the number of bytes allocated on the heap by the process so far.
+uint64_t GetAllocatedBytes();
+
+//! A method resetting the peak resident set size tracking (if supported by the OS).
+void ResetPeakRSS();
+
+//! A method returning the peak resident set size of the process [kB].
+uint64_t GetPeakRSS();
+
+//! A method writing benchmark results to a JSON file.
+bool WriteResults(const std::string& path, const std::vector<BenchmarkResult>& results, unsigned int threads);
+
+//! A method reading the numeric fields of benchmark results from a JSON file written by WriteResults.
+bool ReadBaseline(const std::string& path, std::map<std::string, std::map<std::string, double>>& baseline);
+
+//! A method comparing results against a baseline and printing a report.
+/*!
+ \param results the current results
+ \param baseline the baseline loaded with ReadBaseline
+ \param tolerance the allowed relative degradation
+ \return number of detected regressions
+ */
+unsigned int CompareWithBaseline(const std::vector<BenchmarkResult>& results, 
+                                 const std::map<std::string, std::map<std::string, double>>& baseline, double tolerance);
+
+#endif
@@ -0,0 +1,164 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  ChannelBenchmark.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "ChannelBenchmark.h"
+
+#include <comms/ChannelModel.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#define CHANNEL_PAYLOAD_SIZE  (1 << 20)
+#define CHANNEL_SOURCE_ID     1
+#define CHANNEL_DEST_ID       2
+
+struct ChannelCase
+{
+    std::string name;
+    sf::Scalar errorRate;
+    bool burst;
+    sf::Scalar goodLength;
+    sf::Scalar burstLength;
+    sf::Scalar burstErrorRate;
+};
+
+static void ConfigureChannel(sf::ChannelModel& channel, const ChannelCase& c)
+{
+    if(c.burst)
+        channel.setBurstErrors(c.goodLength, c.burstLength, c.burstErrorRate);
+    else
+        channel.setIndependentErrors();
+}
+
+static double ExpectedErrorRate(const ChannelCase& c)
+{
+    if(!c.burst)
+        return c.errorRate;
+    return (c.goodLength * c.errorRate + c.burstLength * c.burstErrorRate)/(c.goodLength + c.burstLength);
+}
+
+//Checks that the same seed reproduces the errors, another seed does not and that each reported error changed a byte
+static bool CheckReproducibility(const ChannelCase& c, const std::vector<uint8_t>& payload)
+{
+    sf::ChannelModel a(1234);
+    sf::ChannelModel b(1234);
+    sf::ChannelModel d(4321);
+    ConfigureChannel(a, c);
+    ConfigureChannel(b, c);
+    ConfigureChannel(d, c);
+
+    for(unsigned int m=0; m<4; ++m)
+    {
+        std::vector<uint8_t> da(payload);
+        std::vector<uint8_t> db(payload);
+        std::vector<uint8_t> dd(payload);
+        size_t errors = a.ApplyErrors(da, CHANNEL_SOURCE_ID, CHANNEL_DEST_ID, c.errorRate);
+        b.ApplyErrors(db, CHANNEL_SOURCE_ID, CHANNEL_DEST_ID, c.errorRate);
+        d.ApplyErrors(dd, CHANNEL_SOURCE_ID, CHANNEL_DEST_ID, c.errorRate);
+
+        size_t changed = 0;
+        for(size_t i=0; i<payload.size(); ++i)
+            changed += da[i] != payload[i] ? 1 : 0;
+        if(da != db || da == dd || changed != errors)
+            return false;
+    }
+    return true;
+}
+
+unsigned int RunChannelBenchmark(std::vector<BenchmarkResult>& results, unsigned int messages)
+{
+    std::vector<ChannelCase> cases;
+    cases.push_back({"channel_independent_1e-3", 1e-3, false, 0, 0, 0});
+    cases.push_back({"channel_independent_1e-5", 1e-5, false, 0, 0, 0});
+    cases.push_back({"channel_burst", 1e-5, true, 10000, 100, 0.2});
+
+    std::vector<uint8_t> payload(CHANNEL_PAYLOAD_SIZE);
+    for(size_t i=0; i<payload.size(); ++i)
+        payload[i] = (uint8_t)(i * 31 + 7);
+
+    unsigned int failures = 0;
+    for(size_t i=0; i<cases.size(); ++i)
+    {
+        const ChannelCase& c = cases[i];
+        sf::ChannelModel channel(42);
+        ConfigureChannel(channel, c);
+        std::vector<uint8_t> data(payload);
+        channel.ApplyErrors(data, CHANNEL_SOURCE_ID, CHANNEL_DEST_ID, c.errorRate); //Creates the link
+
+        ResetPeakRSS();
+        uint64_t allocCount = GetAllocationCount();
+        uint64_t allocBytes = GetAllocatedBytes();
+        uint64_t errors = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for(unsigned int m=0; m<messages; ++m)
+            errors += channel.ApplyErrors(data, CHANNEL_SOURCE_ID, CHANNEL_DEST_ID, c.errorRate);
+        auto end = std::chrono::high_resolution_clock::now();
+        allocCount = GetAllocationCount() - allocCount;
+        allocBytes = GetAllocatedBytes() - allocBytes;
+
+        BenchmarkResult r;
+        r.scenario = "channel";
+        r.name = c.name + "_1MB";
+        r.size = CHANNEL_PAYLOAD_SIZE/1024;
+        r.steps = messages;
+        r.stepSize = 0.0;
+        r.wallTime = std::chrono::duration<double>(end - start).count();
+        r.stepsPerSecond = r.wallTime > 0.0 ? messages/r.wallTime : 0.0;
+        r.realtimeFactor = 0.0;
+        r.physicsTime = 0.0;
+        r.hydroTime = 0.0;
+        r.overheadTime = messages > 0 ? r.wallTime * 1e6/messages : 0.0;
+        r.contactsPerSecond = 0.0;
+        r.controlTime = 0.0;
+        r.peakRSS = GetPeakRSS();
+        r.allocations = allocCount;
+        r.allocatedBytes = allocBytes;
+        results.push_back(r);
+
+        //Statistics: 5 sigma for independent errors, 10% of the stationary rate for bursts (errors are clustered)
+        double bytes = (double)messages * CHANNEL_PAYLOAD_SIZE;
+        double expected = ExpectedErrorRate(c) * bytes;
+        double measured = (double)errors;
+        double tolerance = c.burst ? 0.1 * expected : 5.0 * std::sqrt(expected * (1.0 - ExpectedErrorRate(c)));
+        bool statsOk = bytes == 0.0 || std::abs(measured - expected) <= tolerance;
+        bool reproOk = CheckReproducibility(c, payload);
+
+        std::cout << "[" << r.name << "] " << r.stepsPerSecond << " messages/s, " << r.overheadTime << " us/message, "
+                  << "error rate " << (bytes > 0.0 ? measured/bytes : 0.0) << " (expected " << ExpectedErrorRate(c) << "), "
+                  << r.allocations << " allocations" << std::endl;
+        if(!statsOk)
+        {
+            std::cout << "[" << r.name << "] error rate outside of tolerance" << std::endl;
+            ++failures;
+        }
+        if(!reproOk)
+        {
+            std::cout << "[" << r.name << "] errors not reproducible for the same seed" << std::endl;
+            ++failures;
+        }
+    }
+    return failures;
+}
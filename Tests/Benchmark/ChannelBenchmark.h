@@ -0,0 +1,42 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  ChannelBenchmark.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish__ChannelBenchmark__
+#define __Stonefish__ChannelBenchmark__
+
+#include "BenchmarkUtil.h"
+
+//! A method measuring the throughput of the channel error model on megabyte payloads and checking its statistics.
+/*!
+ Each case passes the given number of 1 MiB messages through a link of the channel model. The measured error rates
+ are compared with the expected ones and the errors are checked to be reproducible for the same seed.
+ \param results a vector to which the results are appended (messages per second reported as steps per second)
+ \param messages the number of measured messages per case
+ \return number of failed checks
+ */
+unsigned int RunChannelBenchmark(std::vector<BenchmarkResult>& results, unsigned int messages);
+
+#endif
@@ -0,0 +1,173 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  ModelChecks.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "ModelChecks.h"
+
+#include <entities/SolidEntity.h>
+#include <graphics/OpenGLContent.h>
+#include <core/TorusShape.h>
+#include <core/TorusCollisionAlgorithm.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h>
+#include <BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h>
+#include <BulletCollision/NarrowPhaseCollision/btPointCollector.h>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//Centroid of the volume enclosed by a closed mesh (sum of signed tetrahedra)
+static sf::Vector3 ComputeVolumeCentroid(const sf::Mesh* mesh)
+{
+    glm::vec3 c(0.f);
+    GLfloat V(0.f);
+    for(size_t i=0; i<mesh->faces.size(); ++i)
+    {
+        glm::vec3 p1 = mesh->getVertexPos(i, 0);
+        glm::vec3 p2 = mesh->getVertexPos(i, 1);
+        glm::vec3 p3 = mesh->getVertexPos(i, 2);
+        GLfloat v = glm::dot(p1, glm::cross(p2, p3))/6.f;
+        V += v;
+        c += v * (p1 + p2 + p3)/4.f;
+    }
+    if(glm::abs(V) > 1e-9f)
+        c /= V;
+    return sf::Vector3(c.x, c.y, c.z);
+}
+
+unsigned int CheckReducedDragModels(const std::string& dataPath)
+{
+    std::vector<std::pair<std::string, sf::Mesh*>> meshes;
+    meshes.push_back(std::make_pair("icosphere", sf::OpenGLContent::LoadMesh(dataPath + "icosphere.obj", 0.5f, false)));
+    meshes.push_back(std::make_pair("duct_hydro", sf::OpenGLContent::LoadMesh(dataPath + "duct_hydro.obj", 1.f, false)));
+    meshes.push_back(std::make_pair("hull_hydro", sf::OpenGLContent::LoadMesh(dataPath + "hull_hydro.obj", 1.f, false)));
+    meshes.push_back(std::make_pair("box", sf::OpenGLContent::BuildBox(glm::vec3(1.f, 0.4f, 0.2f))));
+    meshes.push_back(std::make_pair("cylinder", sf::OpenGLContent::BuildCylinder(0.3f, 2.f)));
+
+    unsigned int failures = 0;
+    for(size_t i=0; i<meshes.size(); ++i)
+    {
+        std::string name = "drag_model_" + meshes[i].first;
+        if(meshes[i].second == nullptr || meshes[i].second->faces.empty())
+        {
+            std::cout << "[" << name << "] failed to load the mesh" << std::endl;
+            ++failures;
+            continue;
+        }
+
+        sf::ReducedDragModel model;
+        sf::SolidEntity::BuildReducedDragModel(meshes[i].second, ComputeVolumeCentroid(meshes[i].second), model);
+        bool ok = model.forceError <= DRAG_MODEL_MAX_ERROR && model.torqueError <= DRAG_MODEL_MAX_ERROR;
+        std::cout << "[" << name << "] max. error of form drag: force " << model.forceError * 100.0 << "%, torque " 
+                  << model.torqueError * 100.0 << "% (limit " << DRAG_MODEL_MAX_ERROR * 100.0 << "%)" << std::endl;
+        if(!ok)
+        {
+            std::cout << "[" << name << "] reduced drag model error above the limit" << std::endl;
+            ++failures;
+        }
+        delete meshes[i].second;
+    }
+    return failures;
+}
+
+//Reference contact computed by the algorithm used before for the pair (GJK/EPA or the support point for planes)
+static bool ComputeReferenceContact(const sf::TorusShape* torus, const sf::Transform& torusTrans, 
+                                    const btCollisionShape* shape, const sf::Transform& shapeTrans, sf::TorusContact& contact)
+{
+    if(shape->getShapeType() == STATIC_PLANE_PROXYTYPE)
+    {
+        const btStaticPlaneShape* plane = (const btStaticPlaneShape*)shape;
+        sf::Vector3 n = shapeTrans.getBasis() * plane->getPlaneNormal();
+        sf::Scalar offset = n.dot(shapeTrans(plane->getPlaneNormal() * plane->getPlaneConstant()));
+        sf::Vector3 p = torusTrans(torus->localGetSupportingVertex(torusTrans.getBasis().transpose() * -n));
+        contact.distance = n.dot(p) - offset;
+        contact.normal = -n;
+        contact.point = p - n * contact.distance;
+        return true;
+    }
+    
+    btVoronoiSimplexSolver simplexSolver;
+    btGjkEpaPenetrationDepthSolver epaSolver;
+    btGjkPairDetector gjk(torus, (const btConvexShape*)shape, &simplexSolver, &epaSolver);
+    btGjkPairDetector::ClosestPointInput input;
+    input.m_transformA = torusTrans;
+    input.m_transformB = shapeTrans;
+    btPointCollector result;
+    gjk.getClosestPoints(input, result, nullptr);
+    contact.distance = result.m_distance;
+    contact.normal = -result.m_normalOnBInWorld;
+    contact.point = result.m_pointInWorld;
+    return result.m_hasResult;
+}
+
+unsigned int CheckTorusContacts()
+{
+    sf::TorusShape torus(0.5, 0.1);
+    btSphereShape sphere(0.2);
+    btBoxShape box(sf::Vector3(0.3, 0.2, 0.1));
+    btCapsuleShape capsule(0.08, 0.5);
+    btStaticPlaneShape plane(sf::Vector3(0, 0, -1), 0);
+    const std::vector<std::pair<std::string, btCollisionShape*>> shapes = {{"sphere", &sphere}, {"box", &box}, {"capsule", &capsule}, {"plane", &plane}};
+    
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<sf::Scalar> uniform(-1.0, 1.0);
+    unsigned int failures = 0;
+    for(size_t i=0; i<shapes.size(); ++i)
+    {
+        std::string name = "torus_contacts_" + shapes[i].first;
+        sf::Scalar maxDistErr(0);
+        sf::Scalar maxPointErr(0);
+        sf::Scalar maxNormalErr(0);
+        unsigned int n = 0;
+        for(unsigned int h=0; h<20000; ++h)
+        {
+            sf::Transform torusTrans(sf::Quaternion(uniform(rng) * 3, uniform(rng) * 3, uniform(rng) * 3), sf::Vector3(uniform(rng), uniform(rng), uniform(rng)) * 0.2);
+            sf::Transform shapeTrans(sf::Quaternion(uniform(rng) * 3, uniform(rng) * 3, uniform(rng) * 3), sf::Vector3(uniform(rng), uniform(rng), uniform(rng)) * 0.9);
+            sf::TorusContact contact;
+            sf::TorusContact reference;
+            if(!sf::TorusCollisionAlgorithm::ComputeContact(&torus, torusTrans, shapes[i].second, shapeTrans, contact) 
+               || contact.distance < -0.01 || contact.distance > 0.05
+               || !ComputeReferenceContact(&torus, torusTrans, shapes[i].second, shapeTrans, reference))
+                continue;
+            
+            maxDistErr = btMax(maxDistErr, btFabs(contact.distance - reference.distance));
+            maxNormalErr = btMax(maxNormalErr, (contact.normal - reference.normal).length());
+            if(btFabs(contact.normal.dot(torusTrans.getBasis().getColumn(1))) < sf::Scalar(0.999)) //Not facing the flat side of the torus
+                maxPointErr = btMax(maxPointErr, (contact.point - reference.point).length());
+            ++n;
+        }
+        
+        bool ok = n > 0 && maxDistErr <= TORUS_CONTACT_MAX_DISTANCE_ERROR && maxPointErr <= TORUS_CONTACT_MAX_POINT_ERROR 
+                  && maxNormalErr <= TORUS_CONTACT_MAX_NORMAL_ERROR;
+        std::cout << "[" << name << "] " << n << " poses, max. error: distance " << maxDistErr << " m, point " << maxPointErr 
+                  << " m, normal " << maxNormalErr << std::endl;
+        if(!ok)
+        {
+            std::cout << "[" << name << "] contacts differ from the reference above the tolerance" << std::endl;
+            ++failures;
+        }
+    }
+    return failures;
+}
@@ -0,0 +1,60 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  ModelChecks.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish__ModelChecks__
+#define __Stonefish__ModelChecks__
+
+#include <string>
+
+//! Maximum relative error of the reduced drag model w.r.t. the integration over faces.
+#define DRAG_MODEL_MAX_ERROR 0.05
+//! Maximum difference of the signed distance between the analytic torus contacts and the reference [m].
+#define TORUS_CONTACT_MAX_DISTANCE_ERROR 0.001
+//! Maximum distance between the contact points of the analytic torus contacts and the reference [m].
+#define TORUS_CONTACT_MAX_POINT_ERROR 0.002
+//! Maximum length of the difference of the contact normals of the analytic torus contacts and the reference.
+#define TORUS_CONTACT_MAX_NORMAL_ERROR 0.05
+
+//! A method checking the accuracy of the reduced drag model on a set of hull meshes.
+/*!
+ The model is built for each mesh, with the centre of gravity at the centroid of its volume, and the maximum relative
+ errors of the form drag force and torque, measured against the integration over faces, are compared with DRAG_MODEL_MAX_ERROR.
+ \param dataPath a path to the directory containing the mesh files
+ \return number of failed checks
+ */
+unsigned int CheckReducedDragModels(const std::string& dataPath);
+
+//! A method checking the analytic torus contacts against the collision algorithms used before for the same pairs.
+/*!
+ The contacts with spheres, boxes and capsules are compared with the GJK/EPA algorithm and the contacts with planes with
+ the support point of the torus (as in the convex-plane algorithm of Bullet), for random poses with the signed distance
+ between -1 cm and 5 cm. The contact points are not compared when the contact normal is almost parallel to the axis of the torus,
+ because the flat side of the torus makes them ill-conditioned.
+ \return number of failed checks
+ */
+unsigned int CheckTorusContacts();
+
+#endif
@@ -0,0 +1,296 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  main.cpp
+//  Benchmark
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "BenchmarkApp.h"
+#include "BenchmarkManager.h"
+#include "BenchmarkUtil.h"
+#include "ChannelBenchmark.h"
+#include "ModelChecks.h"
+#include <core/CommandJournal.h>
+#include <iostream>
+#include <cstring>
+#include <filesystem>
+
+static void PrintUsage()
+{
+    std::cout << "Usage: stonefish_bench [options]" << std::endl
+              << "  --scenario NAME[:SIZE]  run a single scenario (can be repeated); available: falling, pile, hulls, hulls_reduced, seabed, cable, multibeam, robots, suction, triggers, meshes, meshes_reduced, meshes_decomposed, tori, arms, arms_batched, replay, terrain, console_test" << std::endl
+              << "  --steps N               number of measured simulation steps (default 2000)" << std::endl
+              << "  --warmup N              number of steps skipped before measuring (default 100)" << std::endl
+              << "  --rate HZ               simulation steps per second (default 500)" << std::endl
+              << "  --threads N             maximum number of physics threads (default: physical cores)" << std::endl
+              << "  --output FILE           write results to a JSON file" << std::endl
+              << "  --baseline FILE         compare results against a JSON file written by --output" << std::endl
+              << "  --tolerance F           allowed relative degradation w.r.t. baseline (default 0.1)" << std::endl
+              << "  --replay-check          record each run in a command journal and check that its replay is bit-identical" << std::endl
+              << "  --channel               run the communication channel error model benchmark (part of the default suite)" << std::endl
+              << "  --checks                run the accuracy and consistency checks of the optimised models (part of the default suite)" << std::endl;
+}
+
+//Runs a scenario with the consistency checks enabled in every step, outside of the measurements
+static unsigned int RunScenarioChecks(BenchmarkScenario scenario, unsigned int size, unsigned int steps, sf::Scalar rate, unsigned int threads)
+{
+    BenchmarkManager* simulationManager = new BenchmarkManager(scenario, size, steps, 0, rate);
+    simulationManager->EnableChecks();
+    BenchmarkApp app(std::string(DATA_DIR_PATH), simulationManager);
+    if(threads > 0)
+        app.setMaxPhysicsThreads(threads);
+    app.Run(true, true, sf::Scalar(1)/rate);
+    unsigned int failures = simulationManager->getFailedChecks();
+    std::cout << "[" << BenchmarkManager::getScenarioName(scenario) << "_" << size << "] " << steps << " steps checked, " 
+              << failures << " failed" << std::endl;
+    delete simulationManager;
+    return failures > 0 ? 1 : 0;
+}
+
+//Replays a command journal with the controllers of the scenario disabled, so that only the journal drives the run
+static unsigned int VerifyReplay(BenchmarkScenario scenario, unsigned int size, unsigned int steps, unsigned int warmup, sf::Scalar rate, 
+                                 unsigned int threads, const std::string& journalPath)
+{
+    std::string name = BenchmarkManager::getScenarioName(scenario) + "_" + std::to_string(size);
+    BenchmarkManager* replayManager = new BenchmarkManager(scenario, size, steps, warmup, rate);
+    replayManager->DisableControllers();
+    replayManager->EnableCommandJournal(journalPath, sf::JournalMode::VERIFY);
+    BenchmarkApp app(std::string(DATA_DIR_PATH), replayManager);
+    if(threads > 0)
+        app.setMaxPhysicsThreads(threads);
+    app.Run(true, true, sf::Scalar(1)/rate);
+    
+    unsigned int failures = 0;
+    sf::CommandJournal* journal = replayManager->getCommandJournal();
+    if(journal == nullptr || !journal->isOpen())
+    {
+        std::cout << "[" << name << "] replay failed to open the journal" << std::endl;
+        failures = 1;
+    }
+    else if(journal->getFirstDivergingTick() >= 0)
+    {
+        std::cout << "[" << name << "] replay diverged at tick " << journal->getFirstDivergingTick() << std::endl;
+        failures = 1;
+    }
+    else
+        std::cout << "[" << name << "] replay bit-identical over " << journal->getNumOfTicks() << " ticks" << std::endl;
+    delete replayManager;
+    return failures;
+}
+
+//Records a run of a scenario commanded at runtime and verifies its replay, outside of the measurements
+static unsigned int RunReplayCheck(BenchmarkScenario scenario, unsigned int size, unsigned int steps, sf::Scalar rate, unsigned int threads)
+{
+    std::string journalPath = (std::filesystem::temp_directory_path() / "stonefish_bench_check.sfj").string();
+    BenchmarkManager* simulationManager = new BenchmarkManager(scenario, size, steps, 0, rate);
+    simulationManager->EnableCommandJournal(journalPath, sf::JournalMode::RECORD);
+    unsigned int failures = 0;
+    {
+        BenchmarkApp app(std::string(DATA_DIR_PATH), simulationManager);
+        if(threads > 0)
+            app.setMaxPhysicsThreads(threads);
+        app.Run(true, true, sf::Scalar(1)/rate);
+        if(simulationManager->getFailedChecks() > 0)
+        {
+            std::cout << "[" << BenchmarkManager::getScenarioName(scenario) << "_" << size << "] recorded run failed" << std::endl;
+            failures = 1;
+        }
+        delete simulationManager;
+    }
+    failures += VerifyReplay(scenario, size, steps, 0, rate, threads, journalPath);
+    std::filesystem::remove(journalPath);
+    return failures;
+}
+
+int main(int argc, const char * argv[])
+{
+    std::vector<std::pair<BenchmarkScenario, unsigned int>> runs;
+    unsigned int steps = 2000;
+    unsigned int warmup = 100;
+    sf::Scalar rate = 500.0;
+    unsigned int threads = 0;
+    std::string outputPath;
+    std::string baselinePath;
+    double tolerance = 0.1;
+    bool replayCheck = false;
+    bool channel = false;
+    bool checks = false;
+
+    for(int i=1; i<argc; ++i)
+    {
+        std::string arg(argv[i]);
+        bool hasValue = i+1 < argc;
+        if(arg == "--scenario" && hasValue)
+        {
+            std::string spec(argv[++i]);
+            size_t colon = spec.find(':');
+            BenchmarkScenario s;
+            if(!BenchmarkManager::ParseScenarioName(spec.substr(0, colon), s))
+            {
+                std::cerr << "Unknown scenario: " << spec << std::endl;
+                return 2;
+            }
+            unsigned int size = colon != std::string::npos ? (unsigned int)std::stoul(spec.substr(colon+1)) : 10;
+            runs.push_back(std::make_pair(s, size));
+        }
+        else if(arg == "--steps" && hasValue)
+            steps = (unsigned int)std::stoul(argv[++i]);
+        else if(arg == "--warmup" && hasValue)
+            warmup = (unsigned int)std::stoul(argv[++i]);
+        else if(arg == "--rate" && hasValue)
+            rate = std::stod(argv[++i]);
+        else if(arg == "--threads" && hasValue)
+            threads = (unsigned int)std::stoul(argv[++i]);
+        else if(arg == "--output" && hasValue)
+            outputPath = argv[++i];
+        else if(arg == "--baseline" && hasValue)
+            baselinePath = argv[++i];
+        else if(arg == "--tolerance" && hasValue)
+            tolerance = std::stod(argv[++i]);
+        else if(arg == "--replay-check")
+            replayCheck = true;
+        else if(arg == "--channel")
+            channel = true;
+        else if(arg == "--checks")
+            checks = true;
+        else
+        {
+            PrintUsage();
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+
+    if(runs.empty() && !channel && !checks) //Default suite
+    {
+        channel = true;
+        checks = true;
+        runs.push_back(std::make_pair(BenchmarkScenario::FALLING, 100));
+        runs.push_back(std::make_pair(BenchmarkScenario::FALLING, 1000));
+        runs.push_back(std::make_pair(BenchmarkScenario::PILE, 250));
+        runs.push_back(std::make_pair(BenchmarkScenario::HULLS, 8));
+        runs.push_back(std::make_pair(BenchmarkScenario::HULLS, 32));
+        runs.push_back(std::make_pair(BenchmarkScenario::HULLS_REDUCED, 32));
+        runs.push_back(std::make_pair(BenchmarkScenario::SEABED, 32));
+        runs.push_back(std::make_pair(BenchmarkScenario::CABLE, 500));
+        runs.push_back(std::make_pair(BenchmarkScenario::MULTIBEAM, 16));
+        runs.push_back(std::make_pair(BenchmarkScenario::ROBOTS, 20));
+        runs.push_back(std::make_pair(BenchmarkScenario::SUCTION, 1));
+        runs.push_back(std::make_pair(BenchmarkScenario::SUCTION, 32));
+        runs.push_back(std::make_pair(BenchmarkScenario::TRIGGERS, 64));
+        runs.push_back(std::make_pair(BenchmarkScenario::MESHES, 100));
+        runs.push_back(std::make_pair(BenchmarkScenario::MESHES_REDUCED, 100));
+        runs.push_back(std::make_pair(BenchmarkScenario::MESHES_DECOMPOSED, 100));
+        runs.push_back(std::make_pair(BenchmarkScenario::TORI, 100));
+        runs.push_back(std::make_pair(BenchmarkScenario::ARMS, 16));
+        runs.push_back(std::make_pair(BenchmarkScenario::ARMS_BATCHED, 16));
+        runs.push_back(std::make_pair(BenchmarkScenario::TERRAIN, 8));
+    }
+
+    std::vector<BenchmarkResult> results;
+    std::string journalPath = (std::filesystem::temp_directory_path() / "stonefish_bench.sfj").string();
+    unsigned int divergences = 0;
+    for(size_t i=0; i<runs.size(); ++i)
+    {
+        ResetPeakRSS();
+        BenchmarkManager* simulationManager = new BenchmarkManager(runs[i].first, runs[i].second, steps, warmup, rate);
+        if(replayCheck)
+            simulationManager->EnableCommandJournal(journalPath, sf::JournalMode::RECORD);
+        {
+            BenchmarkApp app(std::string(DATA_DIR_PATH), simulationManager);
+            if(threads > 0)
+                app.setMaxPhysicsThreads(threads);
+            else
+                threads = app.getMaxPhysicsThreads();
+            app.Run(true, true, sf::Scalar(1)/rate);
+            results.push_back(simulationManager->getResult());
+            delete simulationManager;
+        }
+        
+        const BenchmarkResult& r = results.back();
+        std::cout << "[" << r.name << "] " << r.stepsPerSecond << " steps/s, physics " << r.physicsTime << " us/step, hydrodynamics " 
+                  << r.hydroTime << " us/step, " << r.contactsPerSecond << " contacts/s, control " << r.controlTime << " us/step, peak RSS " << r.peakRSS << " kB, " << r.allocations << " allocations" << std::endl;
+        
+        if(replayCheck) //Replay the journal written by the measured run
+            divergences += VerifyReplay(runs[i].first, runs[i].second, steps, warmup, rate, threads, journalPath);
+    }
+    
+    if(replayCheck)
+        std::filesystem::remove(journalPath);
+
+    unsigned int channelFailures = 0;
+    if(channel)
+        channelFailures = RunChannelBenchmark(results, 64);
+
+    unsigned int checkFailures = 0;
+    if(checks)
+    {
+        checkFailures += CheckReducedDragModels(std::string(DATA_DIR_PATH));
+        checkFailures += CheckTorusContacts();
+        checkFailures += RunScenarioChecks(BenchmarkScenario::TRIGGERS, 64, steps, rate, threads);
+        checkFailures += RunScenarioChecks(BenchmarkScenario::ARMS, 4, steps, rate, threads);
+        checkFailures += RunReplayCheck(BenchmarkScenario::REPLAY, 4, steps, rate, threads);
+        checkFailures += RunReplayCheck(BenchmarkScenario::CONSOLE_TEST, 1, steps, rate, threads);
+        checkFailures += RunScenarioChecks(BenchmarkScenario::TERRAIN, 8, steps, rate, threads);
+    }
+
+    if(!outputPath.empty() && !WriteResults(outputPath, results, threads))
+    {
+        std::cerr << "Failed to write results to: " << outputPath << std::endl;
+        return 2;
+    }
+
+    if(!baselinePath.empty())
+    {
+        std::map<std::string, std::map<std::string, double>> baseline;
+        if(!ReadBaseline(baselinePath, baseline))
+        {
+            std::cerr << "Failed to read baseline from: " << baselinePath << std::endl;
+            return 2;
+        }
+        unsigned int regressions = CompareWithBaseline(results, baseline, tolerance);
+        if(regressions > 0)
+        {
+            std::cout << regressions << " performance regression(s) detected." << std::endl;
+            return 1;
+        }
+    }
+    
+    if(divergences > 0)
+    {
+        std::cout << divergences << " non-deterministic replay(s) detected." << std::endl;
+        return 1;
+    }
+    
+    if(channelFailures > 0)
+    {
+        std::cout << channelFailures << " channel model check(s) failed." << std::endl;
+        return 1;
+    }
+    
+    if(checkFailures > 0)
+    {
+        std::cout << checkFailures << " model check(s) failed." << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
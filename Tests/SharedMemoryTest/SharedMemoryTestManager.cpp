@@ -0,0 +1,85 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SharedMemoryTestManager.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "SharedMemoryTestManager.h"
+
+#include <utils/UnitSystem.h>
+#include <entities/statics/Plane.h>
+#include <entities/solids/Box.h>
+#include <entities/solids/Sphere.h>
+#include <sensors/scalar/RotaryEncoder.h>
+#include <core/FeatherstoneRobot.h>
+#include <actuators/Motor.h>
+#include <actuators/Servo.h>
+
+SharedMemoryTestManager::SharedMemoryTestManager(sf::Scalar stepsPerSecond)
+   : SimulationManager(stepsPerSecond, sf::Solver::DANTZIG, sf::CollisionFilter::EXCLUSIVE)
+{
+}
+
+void SharedMemoryTestManager::BuildScenario()
+{
+    // Materials
+    CreateMaterial("Ground", 1000.0, 1.0);
+    CreateMaterial("Steel", sf::UnitSystem::Density(sf::CGS, sf::MKS, 1.0), 0.1);
+    SetMaterialsInteraction("Ground", "Ground", 0.5, 0.3);
+    SetMaterialsInteraction("Ground", "Steel", 0.5, 0.3);
+    SetMaterialsInteraction("Steel", "Steel", 0.5, 0.3);
+    
+    // Environment
+    sf::Plane* floor = new sf::Plane("Floor", 10000.f, "Ground");
+    AddStaticEntity(floor, sf::Transform::getIdentity());
+
+    sf::PhysicsSettings phy;
+    phy.mode = sf::PhysicsMode::SURFACE;
+    phy.collisions = false;
+
+    // Two-link arm driven by an external controller
+    sf::FeatherstoneRobot* robot = new sf::FeatherstoneRobot("Robot", true);
+    sf::Sphere* base = new sf::Sphere("Base", phy, 0.1, sf::I4(), "Steel", "");
+    sf::Box* link1 = new sf::Box("Link1", phy, sf::Vector3(0.12,0.12,0.8), sf::Transform(sf::IQ(), sf::Vector3(0.0, 0.0, 0.4)), "Steel", "");
+    sf::Box* link2 = new sf::Box("Link2", phy, sf::Vector3(0.1,0.1,0.6), sf::Transform(sf::IQ(), sf::Vector3(0.0, 0.0, 0.3)), "Steel", "");
+    std::vector<sf::SolidEntity*> links;
+    links.push_back(link1);
+    links.push_back(link2);
+    robot->DefineLinks(base, links, false);
+    robot->DefineRevoluteJoint("Joint1", "Base", "Link1", sf::I4(), sf::Vector3(0,1,0));
+    robot->DefineRevoluteJoint("Joint2", "Link1", "Link2", sf::Transform(sf::IQ(), sf::Vector3(0.0, 0.0, 0.8)), sf::Vector3(0,1,0));
+    robot->BuildKinematicStructure();
+
+    // Actuators
+    sf::Servo* servo = new sf::Servo("Servo", 1.0, 1.0, 100.0);
+    robot->AddJointActuator(servo, "Joint1");
+    sf::Motor* motor = new sf::Motor("Motor");
+    robot->AddJointActuator(motor, "Joint2");
+
+    // Sensors
+    sf::RotaryEncoder* enc1 = new sf::RotaryEncoder("Encoder1");
+    sf::RotaryEncoder* enc2 = new sf::RotaryEncoder("Encoder2");
+    robot->AddJointSensor(enc1, "Joint1");
+    robot->AddJointSensor(enc2, "Joint2");
+    
+    AddRobot(robot, sf::Transform(sf::IQ(), sf::Vector3(0.0,0.0,-2.0)));
+}
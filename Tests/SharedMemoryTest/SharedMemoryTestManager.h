@@ -0,0 +1,39 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SharedMemoryTestManager.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish__SharedMemoryTestManager__
+#define __Stonefish__SharedMemoryTestManager__
+
+#include <core/SimulationManager.h>
+
+class SharedMemoryTestManager : public sf::SimulationManager 
+{
+public:
+    SharedMemoryTestManager(sf::Scalar stepsPerSecond);
+    
+    void BuildScenario() override;
+};
+
+#endif
@@ -0,0 +1,147 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  main.cpp
+//  SharedMemoryTest
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include <core/ConsoleSimulationApp.h>
+#include <core/SharedMemoryBridge.h>
+#include <core/SharedMemoryClient.h>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+#include "SharedMemoryTestManager.h"
+
+// Controller running in a separate process, communicating only through the shared memory segment
+int controller(const std::string& segment)
+{
+    sf::SharedMemoryClient client;
+    if(!client.Connect(segment, 10.0))
+    {
+        std::cerr << "Controller: failed to connect to '" << segment << "'" << std::endl;
+        return 1;
+    }
+
+    int robot = client.getRobotIndex("Robot");
+    if(robot < 0)
+    {
+        std::cerr << "Controller: robot not found" << std::endl;
+        return 1;
+    }
+    const sf::ShmRobotDescriptor* desc = client.getRobot(robot);
+    const sf::ShmSensorDescriptor* enc2 = client.getSensor(robot, client.getSensorIndex(robot, "Encoder2"));
+    int servo = client.getActuatorIndex(robot, "Servo");
+    int motor = client.getActuatorIndex(robot, "Motor");
+
+    // Serve until the simulation closes the bridge
+    while(client.isConnected())
+    {
+        // Wait for the next sensor frame
+        const sf::ShmSensorFrameHeader* frame = client.AcquireSensorFrame(robot);
+        if(frame == nullptr)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        const double* channels = sf::SharedMemoryClient::getChannels(frame, desc->numSensors);
+        double angle2 = channels[enc2->firstChannel];
+        double velocity2 = channels[enc2->firstChannel + 1];
+        double t = frame->simulationTime;
+        uint64_t tick = frame->tick;
+        client.ReleaseSensorFrame(robot);
+
+        // Compute and send commands
+        sf::ShmActuatorCommand* cmds = client.AcquireCommandFrame(robot, tick);
+        if(cmds == nullptr)
+            continue;
+        cmds[servo].flags = SF_SHM_COMMAND_VALID;
+        cmds[servo].mode = 0;
+        cmds[servo].value[0] = 0.5 * sin(t);
+        cmds[motor].flags = SF_SHM_COMMAND_VALID;
+        cmds[motor].value[0] = -20.0 * angle2 - 2.0 * velocity2;
+        client.CommitCommandFrame(robot);
+    }
+    return 0;
+}
+
+int main(int argc, const char * argv[])
+{
+#ifdef _WIN32
+    std::cerr << "SharedMemoryTest requires a POSIX system." << std::endl;
+    return 1;
+#else
+    unsigned int steps = argc > 1 ? (unsigned int)std::stoul(argv[1]) : 10000;
+    std::string segment = "stonefish_shm_test";
+
+    // Start the controller process before creating the application
+    pid_t pid = fork();
+    if(pid == 0)
+        return controller(segment);
+    else if(pid < 0)
+    {
+        std::cerr << "Failed to start the controller process." << std::endl;
+        return 1;
+    }
+
+    // Run the simulation in lockstep with the controller
+    SharedMemoryTestManager* simulationManager = new SharedMemoryTestManager(1000.0);
+    sf::Scalar meanLatency, maxLatency;
+    uint64_t roundTrips;
+    uint64_t dropped;
+    {
+        sf::ConsoleSimulationApp app("SharedMemoryTest", std::string(DATA_DIR_PATH), simulationManager);
+        app.EnableSharedMemoryBridge(sf::SharedMemoryBridgeSettings(segment, 16, true, 1.0));
+        app.StartLockstep();
+
+        // Wait for the controller to connect and respond to the first frame
+        for(unsigned int i=0; i<steps && simulationManager->getSharedMemoryBridge()->getRoundTripLatency(meanLatency, maxLatency) == 0; ++i)
+        {
+            app.Step(1, false);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        app.Step(steps - 1, false);
+        double wallTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        
+        roundTrips = simulationManager->getSharedMemoryBridge()->getRoundTripLatency(meanLatency, maxLatency);
+        dropped = simulationManager->getSharedMemoryBridge()->getNumOfDroppedFrames();
+        std::cout << "Steps per second: " << (steps - 1)/wallTime << std::endl;
+        app.StopLockstep();
+        delete simulationManager;
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    
+    std::cout << "Round trips: " << roundTrips << ", dropped frames: " << dropped << std::endl;
+    std::cout << "Round-trip latency: mean " << meanLatency * 1e6 << " us, max " << maxLatency * 1e6 << " us" << std::endl;
+    return (WIFEXITED(status) && WEXITSTATUS(status) == 0 && roundTrips > 0) ? 0 : 1;
+#endif
+}
@@ -0,0 +1,110 @@
+/*
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+//
+//  main.cpp
+//  TerrainConverter
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include <entities/statics/TiledTerrain.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstring>
+
+static void PrintUsage()
+{
+    std::cout << "Usage: stonefish_terrain INPUT OUTPUT.sftt [options]" << std::endl
+              << "  INPUT                   heightmap image (8 or 16 bit greyscale) or raw grid of float32 heights (with --raw)" << std::endl
+              << "  --raw NX NY             read INPUT as NX x NY float32 heights in native byte order, row by row (x fastest) [m]" << std::endl
+              << "  --spacing SX SY         distance between nodes along x and y (default 1 1) [m]" << std::endl
+              << "  --height H              height of the black pixels of a heightmap image (default 10) [m]" << std::endl
+              << "  --tile N                number of cells along the edge of a tile, power of 2 (default 64)" << std::endl
+              << "  --float                 store heights as float32 instead of int16 with scale and offset" << std::endl;
+}
+
+int main(int argc, const char * argv[])
+{
+    if(argc < 3)
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    std::string inputPath(argv[1]);
+    std::string outputPath(argv[2]);
+    bool raw = false;
+    uint32_t size[2] = {0, 0};
+    double spacing[2] = {1.0, 1.0};
+    double height = 10.0;
+    uint32_t tile = 64;
+    sf::TiledTerrainFormat format = sf::TiledTerrainFormat::INT16;
+
+    for(int i=3; i<argc; ++i)
+    {
+        std::string arg(argv[i]);
+        if(arg == "--raw" && i + 2 < argc)
+        {
+            raw = true;
+            size[0] = (uint32_t)std::stoul(argv[++i]);
+            size[1] = (uint32_t)std::stoul(argv[++i]);
+        }
+        else if(arg == "--spacing" && i + 2 < argc)
+        {
+            spacing[0] = std::stod(argv[++i]);
+            spacing[1] = std::stod(argv[++i]);
+        }
+        else if(arg == "--height" && i + 1 < argc)
+            height = std::stod(argv[++i]);
+        else if(arg == "--tile" && i + 1 < argc)
+            tile = (uint32_t)std::stoul(argv[++i]);
+        else if(arg == "--float")
+            format = sf::TiledTerrainFormat::FLOAT32;
+        else
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    bool ok;
+    if(raw)
+    {
+        std::vector<float> heights((size_t)size[0] * size[1]);
+        std::ifstream file(inputPath, std::ios::binary);
+        if(!file.read((char*)heights.data(), heights.size() * sizeof(float)))
+        {
+            std::cerr << "Failed to read " << size[0] << " x " << size[1] << " heights from: " << inputPath << std::endl;
+            return 1;
+        }
+        ok = sf::TiledTerrain::WriteTerrainData(outputPath, heights.data(), size[0], size[1], spacing[0], spacing[1], tile, format);
+    }
+    else
+        ok = sf::TiledTerrain::ConvertHeightmap(inputPath, outputPath, spacing[0], spacing[1], height, tile, format);
+
+    if(!ok)
+    {
+        std::cerr << "Conversion failed." << std::endl;
+        return 1;
+    }
+    std::cout << "Tiled terrain written to: " << outputPath << std::endl;
+    return 0;
+}